@@ -3,6 +3,7 @@
 #ifdef _DEBUG
 #include "DirectXCommon.h"
 #include "WinApp.h"
+#include <algorithm>
 #include <imgui_impl_dx12.h>
 #include <imgui_impl_win32.h>
 #endif
@@ -35,8 +36,11 @@ void ImGuiManager::Initialize(
 	ImGui::StyleColorsDark();
 	// プラットフォームとレンダラーのバックエンドを設定する
 	ImGui_ImplWin32_Init(winApp->GetHwnd());
+	// 頂点バッファはGPUが処理中のフレーム数分必要
 	ImGui_ImplDX12_Init(
-	    dxCommon_->GetDevice(), static_cast<int>(dxCommon_->GetBackBufferCount()),
+	    dxCommon_->GetDevice(),
+	    static_cast<int>(
+	        std::max<size_t>(dxCommon_->GetBackBufferCount(), dxCommon_->GetFrameCount())),
 	    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, srvHeap_.Get(),
 	    srvHeap_->GetCPUDescriptorHandleForHeapStart(),
 	    srvHeap_->GetGPUDescriptorHandleForHeapStart());
@@ -0,0 +1,55 @@
+#include "RectanglePacker.h"
+
+// imgui_draw.cppの実装とぶつからないよう、このファイル内だけで使う
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+std::vector<RectanglePacker::Placement> RectanglePacker::Pack(
+    const std::vector<std::pair<uint32_t, uint32_t>>& sizes, uint32_t pageSize,
+    uint32_t padding, Statistics& statistics) {
+	std::vector<Placement> placements(sizes.size());
+	statistics = {};
+
+	// 未配置の画像
+	std::vector<stbrp_rect> pending(sizes.size());
+	for (size_t i = 0; i < sizes.size(); i++) {
+		pending[i].id = int(i);
+		pending[i].w = int(sizes[i].first + padding * 2);
+		pending[i].h = int(sizes[i].second + padding * 2);
+	}
+
+	std::vector<stbrp_node> nodes(pageSize);
+	while (!pending.empty()) {
+		stbrp_context context{};
+		stbrp_init_target(&context, int(pageSize), int(pageSize), nodes.data(), int(nodes.size()));
+		stbrp_pack_rects(&context, pending.data(), int(pending.size()));
+
+		// 入った分を確定し、入らなかった分は次のページへ
+		std::vector<stbrp_rect> rest;
+		for (const stbrp_rect& rect : pending) {
+			if (!rect.was_packed) {
+				rest.push_back(rect);
+				continue;
+			}
+			Placement& placement = placements[rect.id];
+			placement.page = statistics.pageCount;
+			placement.x = uint32_t(rect.x) + padding;
+			placement.y = uint32_t(rect.y) + padding;
+			statistics.packedCount++;
+			statistics.usedPixels += uint64_t(sizes[rect.id].first) * sizes[rect.id].second;
+		}
+
+		// 空のページにすら入らないものは諦める
+		if (rest.size() == pending.size()) {
+			statistics.failedCount = uint32_t(rest.size());
+			break;
+		}
+
+		statistics.pageCount++;
+		pending = std::move(rest);
+	}
+
+	statistics.pagePixels = uint64_t(statistics.pageCount) * pageSize * pageSize;
+	return placements;
+}
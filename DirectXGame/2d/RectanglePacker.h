@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// 矩形のパッキング（ファイルやGPUに触れないので、エンジン無しでテストできる）
+/// </summary>
+class RectanglePacker {
+public:
+	// ページに入らなかった画像のページ番号
+	static constexpr uint32_t kInvalidPage = UINT32_MAX;
+
+	/// <summary>
+	/// パッキング結果（1画像分）
+	/// </summary>
+	struct Placement {
+		// ページ番号
+		uint32_t page = kInvalidPage;
+		// 左上X座標[px]
+		uint32_t x = 0;
+		// 左上Y座標[px]
+		uint32_t y = 0;
+	};
+
+	/// <summary>
+	/// 占有率などの統計情報
+	/// </summary>
+	struct Statistics {
+		// ページ数
+		uint32_t pageCount = 0;
+		// 配置できた画像数
+		uint32_t packedCount = 0;
+		// 配置できなかった画像数
+		uint32_t failedCount = 0;
+		// 画像が占めるピクセル数（余白を除く）
+		uint64_t usedPixels = 0;
+		// 全ページのピクセル数
+		uint64_t pagePixels = 0;
+
+		/// <summary>
+		/// 占有率の取得
+		/// </summary>
+		/// <returns>0～1</returns>
+		double GetOccupancy() const {
+			return pagePixels ? double(usedPixels) / double(pagePixels) : 0.0;
+		}
+	};
+
+	/// <summary>
+	/// 矩形のパッキング。1ページに入りきらなければページを増やす
+	/// </summary>
+	/// <param name="sizes">各画像の幅と高さ[px]</param>
+	/// <param name="pageSize">ページの一辺[px]</param>
+	/// <param name="padding">画像の周囲の余白[px]</param>
+	/// <param name="statistics">統計情報の出力先</param>
+	/// <returns>sizesと同じ順の配置。空のページにも入らない画像はkInvalidPage</returns>
+	static std::vector<Placement> Pack(
+	    const std::vector<std::pair<uint32_t, uint32_t>>& sizes, uint32_t pageSize,
+	    uint32_t padding, Statistics& statistics);
+};
@@ -0,0 +1,308 @@
+#include "SpriteBatch.h"
+#include "DebugText.h"
+#include "DirectXCommon.h"
+#include "ShaderUtility.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <cassert>
+#include <d3dx12.h>
+
+using namespace Microsoft::WRL;
+
+// 描画要求はブレンドモードを値で持つ
+static_assert(uint32_t(Sprite::BlendMode::kNormal) == SpriteBatchBuilder::Item{}.blendMode);
+
+namespace {
+
+// ブレンドモード毎のブレンド設定
+D3D12_RENDER_TARGET_BLEND_DESC MakeBlendDesc(Sprite::BlendMode blendMode) {
+	D3D12_RENDER_TARGET_BLEND_DESC blenddesc{};
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	switch (blendMode) {
+	case Sprite::BlendMode::kNone:
+		blenddesc.BlendEnable = false;
+		break;
+	case Sprite::BlendMode::kNormal:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	case Sprite::BlendMode::kAdd:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kSubtract:
+		blenddesc.BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kMultiply:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_ZERO;
+		blenddesc.DestBlend = D3D12_BLEND_SRC_COLOR;
+		break;
+	case Sprite::BlendMode::kScreen:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kExclusion:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		blenddesc.DestBlend = D3D12_BLEND_INV_SRC_COLOR;
+		break;
+	default:
+		break;
+	}
+	return blenddesc;
+}
+
+} // namespace
+
+SpriteBatch* SpriteBatch::GetInstance() {
+	static SpriteBatch instance;
+	return &instance;
+}
+
+void SpriteBatch::Initialize(
+    ID3D12Device* device, int window_width, int window_height, const std::wstring& directoryPath) {
+	assert(device);
+
+	HRESULT result = S_FALSE;
+	device_ = device;
+	screenSize_ = {float(window_width), float(window_height)};
+
+	CreatePipelines(directoryPath);
+
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+
+	// 頂点バッファ生成（フレーム毎の領域を同時に処理中になりうるフレーム数分）
+	frameCount_ = DirectXCommon::GetInstance()->GetFrameCount();
+	UINT sizeVB = UINT(sizeof(Vertex) * 4 * kMaxQuadCount * frameCount_);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeVB);
+	result = device_->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&vertBuff_));
+	assert(SUCCEEDED(result));
+
+	// 永続マップ
+	result = vertBuff_->Map(0, nullptr, reinterpret_cast<void**>(&vertMap_));
+	assert(SUCCEEDED(result));
+
+	vbView_.gpuAddress = vertBuff_->GetGPUVirtualAddress();
+	vbView_.sizeInBytes = sizeVB;
+	vbView_.strideInBytes = sizeof(Vertex);
+
+	// インデックスバッファ生成（全四角形共通）
+	UINT sizeIB = UINT(sizeof(uint16_t) * 6 * kMaxQuadCount);
+	resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeIB);
+	result = device_->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&indexBuff_));
+	assert(SUCCEEDED(result));
+
+	uint16_t* indexMap = nullptr;
+	result = indexBuff_->Map(0, nullptr, reinterpret_cast<void**>(&indexMap));
+	assert(SUCCEEDED(result));
+	for (uint32_t i = 0; i < kMaxQuadCount; i++) {
+		uint16_t base = uint16_t(i * 4);
+		indexMap[i * 6 + 0] = uint16_t(base + 0);
+		indexMap[i * 6 + 1] = uint16_t(base + 1);
+		indexMap[i * 6 + 2] = uint16_t(base + 2);
+		indexMap[i * 6 + 3] = uint16_t(base + 1);
+		indexMap[i * 6 + 4] = uint16_t(base + 3);
+		indexMap[i * 6 + 5] = uint16_t(base + 2);
+	}
+	indexBuff_->Unmap(0, nullptr);
+
+	ibView_.gpuAddress = indexBuff_->GetGPUVirtualAddress();
+	ibView_.is32Bit = false;
+	ibView_.sizeInBytes = sizeIB;
+
+	// デバッグフォント
+	fontTextureHandle_ = TextureManager::Load("debugfont.png");
+
+	items_.reserve(kMaxQuadCount);
+}
+
+void SpriteBatch::BeginFrame() {
+	lastStatistics_ = statistics_;
+	statistics_ = {};
+	// DirectXCommonが完了を待ったフレーム番号の領域を使う
+	frameIndex_ = DirectXCommon::GetInstance()->GetFrameIndex();
+	assert(frameIndex_ < frameCount_);
+	quadCursor_ = 0;
+}
+
+void SpriteBatch::Begin(ID3D12GraphicsCommandList* commandList) {
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	assert(commandList == dxCommon->GetCommandList());
+	(void)commandList;
+	Begin(dxCommon->GetRenderCommandList());
+}
+
+void SpriteBatch::Begin(RenderCommandList* commandList) {
+	assert(commandList_ == nullptr);
+	commandList_ = commandList;
+	items_.clear();
+}
+
+void SpriteBatch::End() {
+	assert(commandList_);
+
+	// 今のフレームの領域の残りに入る分だけ描く
+	SpriteBatchBuilder::BuildBatches(items_, kMaxQuadCount - quadCursor_, batches_, statistics_);
+	uint32_t baseQuad = frameIndex_ * kMaxQuadCount + quadCursor_;
+	uint32_t quadCount = std::min(uint32_t(items_.size()), kMaxQuadCount - quadCursor_);
+
+	uint32_t textureHandle = UINT32_MAX;
+	Vector2 textureSize{};
+	for (uint32_t i = 0; i < quadCount; i++) {
+		if (items_[i].textureHandle != textureHandle) {
+			textureHandle = items_[i].textureHandle;
+			D3D12_RESOURCE_DESC desc = TextureManager::GetInstance()->GetResoureDesc(textureHandle);
+			textureSize = {float(desc.Width), float(desc.Height)};
+		}
+		SpriteBatchBuilder::BuildQuad(
+		    items_[i], textureSize, screenSize_, &vertMap_[(baseQuad + i) * 4]);
+	}
+	commandList_->AddUploadBytes(sizeof(Vertex) * 4 * quadCount);
+
+	// 共通の状態をセット
+	commandList_->SetRootSignature(rootSignature_.Get());
+	commandList_->SetPrimitiveTopology(RenderCommandList::PrimitiveTopology::kTriangleList);
+	commandList_->SetVertexBuffer(vbView_);
+	commandList_->SetIndexBuffer(ibView_);
+
+	// 状態が変わる時だけ切り替えて描画
+	for (const Batch& batch : batches_) {
+		if (batch.isPipelineChanged) {
+			assert(batch.blendMode < pipelineStates_.size());
+			commandList_->SetPipelineState(pipelineStates_[batch.blendMode].Get());
+		}
+		if (batch.isTextureChanged) {
+			commandList_->SetTexture(0, batch.textureHandle);
+		}
+		commandList_->DrawIndexed(
+		    batch.quadCount * 6, 1, 0, int32_t((baseQuad + batch.quadStart) * 4), 0);
+	}
+
+	quadCursor_ += quadCount;
+	items_.clear();
+	commandList_ = nullptr;
+}
+
+void SpriteBatch::Draw(
+    const Sprite& sprite, const Vector2& texBase, const Vector2& texSize, BlendMode blendMode,
+    int32_t layer) {
+	Item item;
+	item.textureHandle = sprite.GetTextureHandle();
+	item.blendMode = uint32_t(blendMode);
+	item.layer = layer;
+	item.position = sprite.GetPosition();
+	item.size = sprite.GetSize();
+	item.anchorPoint = sprite.GetAnchorPoint();
+	item.rotation = sprite.GetRotation();
+	item.color = sprite.GetColor();
+	item.texBase = texBase;
+	item.texSize = texSize;
+	item.isFlipX = sprite.GetIsFlipX();
+	item.isFlipY = sprite.GetIsFlipY();
+	items_.push_back(item);
+}
+
+void SpriteBatch::Print(const std::string& text, float x, float y, float scale) {
+	Item item;
+	item.textureHandle = fontTextureHandle_;
+	item.size = {DebugText::kFontWidth * scale, DebugText::kFontHeight * scale};
+	item.texSize = {float(DebugText::kFontWidth), float(DebugText::kFontHeight)};
+
+	for (size_t i = 0; i < text.size(); i++) {
+		// ASCIIコードの2段分飛ばした番号
+		int fontIndex = text[i] - 32;
+		if (fontIndex < 0 || fontIndex >= 0x7f) {
+			fontIndex = 0;
+		}
+
+		int fontIndexY = fontIndex / DebugText::kFontLineCount;
+		int fontIndexX = fontIndex % DebugText::kFontLineCount;
+
+		item.position = {x + item.size.x * float(i), y};
+		item.texBase = {
+		    float(fontIndexX * DebugText::kFontWidth), float(fontIndexY * DebugText::kFontHeight)};
+		items_.push_back(item);
+	}
+}
+
+void SpriteBatch::CreatePipelines(const std::wstring& directoryPath) {
+	HRESULT result = S_FALSE;
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(directoryPath + L"shaders/SpriteBatchVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(directoryPath + L"shaders/SpriteBatchPS.hlsl", "ps_5_0");
+
+	// 頂点レイアウト
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// ルートシグネチャ（テクスチャのみ）
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 レジスタ
+
+	CD3DX12_ROOT_PARAMETER rootparams[1];
+	rootparams[0].InitAsDescriptorTable(1, &descRangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc =
+	    CD3DX12_STATIC_SAMPLER_DESC(0, D3D12_FILTER_MIN_MAG_MIP_POINT);
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 1, &samplerDesc,
+	    D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device_->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	// グラフィックスパイプライン
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	// 2Dなので常に上書き
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	gpipeline.DepthStencilState.DepthEnable = false;
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	gpipeline.SampleDesc.Count = 1;
+	gpipeline.pRootSignature = rootSignature_.Get();
+
+	for (size_t i = 0; i < pipelineStates_.size(); i++) {
+		gpipeline.BlendState.RenderTarget[0] = MakeBlendDesc(BlendMode(i));
+		result = device_->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineStates_[i]));
+		assert(SUCCEEDED(result));
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "Sprite.h"
+#include "SpriteBatchBuilder.h"
+#include "Vector2.h"
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// スプライトバッチ（全スプライトの四角形を1本の頂点バッファに詰めて、まとめて描画する）
+/// </summary>
+class SpriteBatch {
+public:
+	using BlendMode = Sprite::BlendMode;
+	using Vertex = SpriteBatchBuilder::Vertex;
+	using Item = SpriteBatchBuilder::Item;
+	using Batch = SpriteBatchBuilder::Batch;
+	using Statistics = SpriteBatchBuilder::Statistics;
+
+	// 1フレームに描画できる最大四角形数
+	static const uint32_t kMaxQuadCount = 4096;
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static SpriteBatch* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="window_width">画面幅</param>
+	/// <param name="window_height">画面高さ</param>
+	void Initialize(
+	    ID3D12Device* device, int window_width, int window_height,
+	    const std::wstring& directoryPath = L"Resources/");
+
+	/// <summary>
+	/// フレーム開始（頂点バッファの使用領域を次に進める）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 描画前処理
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト（DirectXCommonのもの）</param>
+	void Begin(ID3D12GraphicsCommandList* commandList);
+
+	/// <summary>
+	/// 描画前処理
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト</param>
+	void Begin(RenderCommandList* commandList);
+
+	/// <summary>
+	/// 描画後処理（溜めた要求をまとめて描画）
+	/// </summary>
+	void End();
+
+	/// <summary>
+	/// 描画要求を積む
+	/// </summary>
+	/// <param name="item">描画要求</param>
+	void Draw(const Item& item) { items_.push_back(item); }
+
+	/// <summary>
+	/// スプライトの内容で描画要求を積む
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="texBase">テクスチャ始点[px]</param>
+	/// <param name="texSize">テクスチャ幅、高さ[px]。0ならテクスチャ全体</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">描画順</param>
+	void Draw(
+	    const Sprite& sprite, const Vector2& texBase = {0.0f, 0.0f},
+	    const Vector2& texSize = {0.0f, 0.0f}, BlendMode blendMode = BlendMode::kNormal,
+	    int32_t layer = 0);
+
+	/// <summary>
+	/// デバッグ文字列を積む（DebugTextと同じフォント画像を使う）
+	/// </summary>
+	/// <param name="text">文字列</param>
+	/// <param name="x">表示座標X</param>
+	/// <param name="y">表示座標Y</param>
+	/// <param name="scale">倍率</param>
+	void Print(const std::string& text, float x, float y, float scale = 1.0f);
+
+	/// <summary>
+	/// 直前のフレームの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return lastStatistics_; }
+
+private:
+	SpriteBatch() = default;
+	~SpriteBatch() = default;
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	/// <summary>
+	/// パイプライン生成
+	/// </summary>
+	void CreatePipelines(const std::wstring& directoryPath);
+
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// コマンドリスト
+	RenderCommandList* commandList_ = nullptr;
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	// パイプラインステートオブジェクト
+	std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, size_t(BlendMode::kCountOfBlendMode)>
+	    pipelineStates_;
+	// 頂点バッファ（同時に処理中になりうるフレーム数分のリング）
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff_;
+	// インデックスバッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	// 頂点バッファマップ
+	Vertex* vertMap_ = nullptr;
+	// 頂点バッファビュー
+	RenderCommandList::VertexBufferView vbView_{};
+	// インデックスバッファビュー
+	RenderCommandList::IndexBufferView ibView_{};
+	// 画面サイズ
+	Vector2 screenSize_ = {0.0f, 0.0f};
+	// デバッグフォントのテクスチャハンドル
+	uint32_t fontTextureHandle_ = 0;
+	// リング内の領域数
+	uint32_t frameCount_ = 0;
+	// 今のフレームが使うリング内の領域番号
+	uint32_t frameIndex_ = 0;
+	// 今のフレームで使用済みの四角形数
+	uint32_t quadCursor_ = 0;
+	// 溜めている描画要求
+	std::vector<Item> items_;
+	// バッチ（使い回し）
+	std::vector<Batch> batches_;
+	// 今のフレームの統計情報
+	Statistics statistics_;
+	// 直前のフレームの統計情報
+	Statistics lastStatistics_;
+};
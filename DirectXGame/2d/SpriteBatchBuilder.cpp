@@ -0,0 +1,90 @@
+#include "SpriteBatchBuilder.h"
+#include <algorithm>
+#include <cmath>
+
+void SpriteBatchBuilder::BuildBatches(
+    std::vector<Item>& items, uint32_t quadCapacity, std::vector<Batch>& batches,
+    Statistics& statistics) {
+	batches.clear();
+
+	// 半透明の四角形が重なると描く順番で結果が変わるので、並べ替えるのはレイヤーだけ
+	std::stable_sort(items.begin(), items.end(), [](const Item& lhs, const Item& rhs) {
+		return lhs.layer < rhs.layer;
+	});
+
+	uint32_t quadCount = std::min(uint32_t(items.size()), quadCapacity);
+	statistics.droppedQuadCount += uint32_t(items.size()) - quadCount;
+	statistics.quadCount += quadCount;
+
+	// 連続する同じ状態だけをまとめる（間に別の状態が挟まれば別のバッチ）
+	for (uint32_t i = 0; i < quadCount; i++) {
+		const Item& item = items[i];
+		if (!batches.empty() && batches.back().textureHandle == item.textureHandle &&
+		    batches.back().blendMode == item.blendMode) {
+			batches.back().quadCount++;
+			continue;
+		}
+
+		// 状態が変わる時だけ切り替える
+		Batch batch{item.textureHandle, item.blendMode, i, 1, true, true};
+		if (!batches.empty()) {
+			batch.isPipelineChanged = batches.back().blendMode != item.blendMode;
+			batch.isTextureChanged = batches.back().textureHandle != item.textureHandle;
+		}
+		statistics.pipelineChangeCount += batch.isPipelineChanged;
+		statistics.textureChangeCount += batch.isTextureChanged;
+		batches.push_back(batch);
+	}
+	statistics.drawCallCount += uint32_t(batches.size());
+}
+
+void SpriteBatchBuilder::BuildQuad(
+    const Item& item, const Vector2& textureSize, const Vector2& screenSize, Vertex* vertices) {
+	// 4頂点
+	enum { LB, LT, RB, RT };
+
+	float left = (0.0f - item.anchorPoint.x) * item.size.x;
+	float right = (1.0f - item.anchorPoint.x) * item.size.x;
+	float top = (0.0f - item.anchorPoint.y) * item.size.y;
+	float bottom = (1.0f - item.anchorPoint.y) * item.size.y;
+	if (item.isFlipX) { // 左右入れ替え
+		left = -left;
+		right = -right;
+	}
+	if (item.isFlipY) { // 上下入れ替え
+		top = -top;
+		bottom = -bottom;
+	}
+
+	// テクスチャ範囲。未指定ならテクスチャ全体
+	Vector2 texBase = item.texBase;
+	Vector2 texSize = item.texSize;
+	if (texSize.x == 0.0f || texSize.y == 0.0f) {
+		texBase = {0.0f, 0.0f};
+		texSize = textureSize;
+	}
+	float texLeft = texBase.x / textureSize.x;
+	float texRight = (texBase.x + texSize.x) / textureSize.x;
+	float texTop = texBase.y / textureSize.y;
+	float texBottom = (texBase.y + texSize.y) / textureSize.y;
+
+	const float localX[4] = {left, left, right, right};
+	const float localY[4] = {bottom, top, bottom, top};
+	const Vector2 uv[4] = {
+	    {texLeft, texBottom},
+	    {texLeft, texTop},
+	    {texRight, texBottom},
+	    {texRight, texTop},
+	};
+
+	// 回転、平行移動してからスクリーン座標→クリップ空間
+	float sinRotation = std::sin(item.rotation);
+	float cosRotation = std::cos(item.rotation);
+	for (int i = LB; i <= RT; i++) {
+		float x = localX[i] * cosRotation - localY[i] * sinRotation + item.position.x;
+		float y = localX[i] * sinRotation + localY[i] * cosRotation + item.position.y;
+		vertices[i].pos = {x * 2.0f / screenSize.x - 1.0f, 1.0f - y * 2.0f / screenSize.y, 0.0f};
+		vertices[i].uv = uv[i];
+		vertices[i].color = item.color;
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// スプライトバッチの組み立て（描画要求をレイヤー順に並べ、同じ状態の並びをまとめて頂点を作る）
+/// </summary>
+/// <remarks>
+/// ブレンドモードはSprite::BlendModeの値をそのまま持ち、同じかどうかだけを見る。
+/// GPUやファイルに触れない。
+/// </remarks>
+class SpriteBatchBuilder {
+public:
+	/// <summary>
+	/// 頂点データ構造体
+	/// </summary>
+	struct Vertex {
+		Vector3 pos;  // クリップ空間座標
+		Vector2 uv;   // uv座標
+		Vector4 color; // 色 (RGBA)
+	};
+
+	/// <summary>
+	/// 描画要求（四角形1枚分）
+	/// </summary>
+	struct Item {
+		// テクスチャハンドル
+		uint32_t textureHandle = 0;
+		// ブレンドモード（Sprite::BlendModeの値。既定はkNormal）
+		uint32_t blendMode = 1;
+		// 描画順（小さい方が先。同じ値の中では積んだ順）
+		int32_t layer = 0;
+		// 座標
+		Vector2 position = {0.0f, 0.0f};
+		// サイズ
+		Vector2 size = {100.0f, 100.0f};
+		// アンカーポイント
+		Vector2 anchorPoint = {0.0f, 0.0f};
+		// Z軸回りの回転角
+		float rotation = 0.0f;
+		// 色
+		Vector4 color = {1, 1, 1, 1};
+		// テクスチャ始点[px]
+		Vector2 texBase = {0.0f, 0.0f};
+		// テクスチャ幅、高さ[px]。0ならテクスチャ全体
+		Vector2 texSize = {0.0f, 0.0f};
+		// 左右反転
+		bool isFlipX = false;
+		// 上下反転
+		bool isFlipY = false;
+	};
+
+	/// <summary>
+	/// 同じテクスチャ、ブレンドモードで一度に描ける範囲
+	/// </summary>
+	struct Batch {
+		uint32_t textureHandle = 0;
+		uint32_t blendMode = 0;
+		// 先頭の四角形番号
+		uint32_t quadStart = 0;
+		// 四角形数
+		uint32_t quadCount = 0;
+		// 直前のバッチとパイプラインが違う（先頭は常にtrue）
+		bool isPipelineChanged = false;
+		// 直前のバッチとテクスチャが違う（先頭は常にtrue）
+		bool isTextureChanged = false;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 描画した四角形数
+		uint32_t quadCount = 0;
+		// ドローコール数
+		uint32_t drawCallCount = 0;
+		// パイプライン切り替え数
+		uint32_t pipelineChangeCount = 0;
+		// テクスチャ切り替え数
+		uint32_t textureChangeCount = 0;
+		// 容量不足で描けなかった四角形数
+		uint32_t droppedQuadCount = 0;
+	};
+
+	/// <summary>
+	/// 描画要求を並び替えてバッチにまとめる
+	/// </summary>
+	/// <param name="items">描画要求。レイヤー順に並び替えられる（同じレイヤーの中は積んだ順のまま）</param>
+	/// <param name="quadCapacity">描ける四角形数。超えた分は後ろから捨てる</param>
+	/// <param name="batches">バッチの出力先</param>
+	/// <param name="statistics">統計情報の加算先</param>
+	static void BuildBatches(
+	    std::vector<Item>& items, uint32_t quadCapacity, std::vector<Batch>& batches,
+	    Statistics& statistics);
+
+	/// <summary>
+	/// 四角形の頂点生成
+	/// </summary>
+	/// <param name="item">描画要求</param>
+	/// <param name="textureSize">テクスチャサイズ[px]</param>
+	/// <param name="screenSize">画面サイズ[px]</param>
+	/// <param name="vertices">頂点4つの出力先（左下、左上、右下、右上）</param>
+	static void BuildQuad(
+	    const Item& item, const Vector2& textureSize, const Vector2& screenSize, Vertex* vertices);
+};
@@ -0,0 +1,182 @@
+#include "TextureAtlas.h"
+#include "MemoryTracker.h"
+#include "Sprite.h"
+#include "SpriteBatch.h"
+#include "StringUtility.h"
+#include "TextureManager.h"
+#include <DirectXTex.h>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace DirectX;
+
+HRESULT TextureAtlas::Build(
+    const std::string& directoryPath, const std::vector<std::string>& names,
+    const std::string& atlasName, Statistics& statistics, uint32_t pageSize, uint32_t padding) {
+	HRESULT result;
+
+	// 画像読み込み（RGBA8に揃える）
+	std::vector<ScratchImage> images(names.size());
+	std::vector<std::pair<uint32_t, uint32_t>> sizes(names.size());
+	for (size_t i = 0; i < names.size(); i++) {
+		std::wstring filePath = ConvertStringMultiByteToWide(directoryPath + names[i]);
+		result = LoadFromWICFile(filePath.c_str(), WIC_FLAGS_NONE, nullptr, images[i]);
+		if (FAILED(result)) {
+			return result;
+		}
+		if (images[i].GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			ScratchImage converted{};
+			result = Convert(
+			    *images[i].GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, TEX_FILTER_DEFAULT,
+			    TEX_THRESHOLD_DEFAULT, converted);
+			if (FAILED(result)) {
+				return result;
+			}
+			images[i] = std::move(converted);
+		}
+		sizes[i] = {uint32_t(images[i].GetMetadata().width), uint32_t(images[i].GetMetadata().height)};
+	}
+
+	std::vector<Placement> placements = RectanglePacker::Pack(sizes, pageSize, padding, statistics);
+	if (statistics.failedCount > 0) {
+		return E_INVALIDARG;
+	}
+
+	// ページ画像の作成と書き出し
+	std::filesystem::path manifestPath(directoryPath + atlasName + ".atlas");
+	std::filesystem::create_directories(manifestPath.parent_path());
+	std::ofstream manifest(manifestPath);
+	if (!manifest) {
+		return E_FAIL;
+	}
+	for (uint32_t page = 0; page < statistics.pageCount; page++) {
+		ScratchImage pageImage{};
+		result = pageImage.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, pageSize, pageSize, 1, 1);
+		if (FAILED(result)) {
+			return result;
+		}
+		std::memset(pageImage.GetPixels(), 0, pageImage.GetPixelsSize());
+
+		for (size_t i = 0; i < names.size(); i++) {
+			if (placements[i].page != page) {
+				continue;
+			}
+			Rect rect(0, 0, sizes[i].first, sizes[i].second);
+			result = CopyRectangle(
+			    *images[i].GetImage(0, 0, 0), rect, *pageImage.GetImage(0, 0, 0), TEX_FILTER_DEFAULT,
+			    placements[i].x, placements[i].y);
+			if (FAILED(result)) {
+				return result;
+			}
+		}
+
+		std::string pageName = atlasName + "_" + std::to_string(page) + ".png";
+		std::wstring pagePath = ConvertStringMultiByteToWide(directoryPath + pageName);
+		result = SaveToWICFile(
+		    *pageImage.GetImage(0, 0, 0), WIC_FLAGS_NONE, GetWICCodec(WIC_CODEC_PNG),
+		    pagePath.c_str());
+		if (FAILED(result)) {
+			return result;
+		}
+		manifest << "page " << pageName << "\n";
+	}
+
+	// 定義ファイル: image 名前 ページ x y 幅 高さ
+	for (size_t i = 0; i < names.size(); i++) {
+		manifest << "image " << names[i] << " " << placements[i].page << " " << placements[i].x
+		         << " " << placements[i].y << " " << sizes[i].first << " " << sizes[i].second
+		         << "\n";
+	}
+
+	return S_OK;
+}
+
+bool TextureAtlas::Load(const std::string& fileName, const std::string& directoryPath) {
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kUI);
+	pageTextureHandles_.clear();
+	regions_.clear();
+
+	std::ifstream manifest(directoryPath + fileName);
+	if (!manifest) {
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(manifest, line)) {
+		std::istringstream lineStream(line);
+		std::string key;
+		lineStream >> key;
+
+		if (key == "page") {
+			std::string pageName;
+			lineStream >> pageName;
+			pageTextureHandles_.push_back(TextureManager::LoadAsync(pageName));
+		} else if (key == "image") {
+			std::string name;
+			Region region;
+			lineStream >> name >> region.page >> region.texBase.x >> region.texBase.y >>
+			    region.texSize.x >> region.texSize.y;
+			assert(region.page < pageTextureHandles_.size());
+			regions_[name] = region;
+		}
+	}
+
+	return true;
+}
+
+void TextureAtlas::LoadMissingAsync(const std::vector<std::string>& names) const {
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kUI);
+	for (const std::string& name : names) {
+		if (!Find(name)) {
+			TextureManager::LoadAsync(name);
+		}
+	}
+}
+
+const TextureAtlas::Region* TextureAtlas::Find(const std::string& name) const {
+	auto it = regions_.find(name);
+	if (it == regions_.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+bool TextureAtlas::Apply(Sprite* sprite, const std::string& name) const {
+	const Region* region = Find(name);
+	if (!region) {
+		return false;
+	}
+
+	sprite->SetTextureHandle(GetTextureHandle(region->page));
+	sprite->SetTextureRect(region->texBase, region->texSize);
+	sprite->SetSize(region->texSize);
+	return true;
+}
+
+Sprite* TextureAtlas::CreateSprite(
+    const std::string& name, Vector2 position, Vector4 color, Vector2 anchorpoint) const {
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kUI);
+	const Region* region = Find(name);
+	if (!region) {
+		// アトラス未ベイク時は単体のテクスチャで描く
+		return Sprite::Create(TextureManager::Load(name), position, color, anchorpoint);
+	}
+
+	Sprite* sprite = Sprite::Create(GetTextureHandle(region->page), position, color, anchorpoint);
+	sprite->SetTextureRect(region->texBase, region->texSize);
+	sprite->SetSize(region->texSize);
+	return sprite;
+}
+
+void TextureAtlas::Draw(SpriteBatch* spriteBatch, const Sprite& sprite, const std::string& name) const {
+	const Region* region = Find(name);
+	if (!region) {
+		spriteBatch->Draw(sprite);
+		return;
+	}
+
+	spriteBatch->Draw(sprite, region->texBase, region->texSize);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "RectanglePacker.h"
+#include "Vector2.h"
+#include "Vector4.h"
+#include <Windows.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Sprite;
+class SpriteBatch;
+
+/// <summary>
+/// テクスチャアトラス（複数の画像を1枚～数枚のページにまとめる）
+/// </summary>
+class TextureAtlas {
+public:
+	// ページに入らなかった画像のページ番号
+	static constexpr uint32_t kInvalidPage = RectanglePacker::kInvalidPage;
+	// パッキング結果（1画像分）
+	using Placement = RectanglePacker::Placement;
+	// 占有率などの統計情報
+	using Statistics = RectanglePacker::Statistics;
+
+	/// <summary>
+	/// アトラス内の領域
+	/// </summary>
+	struct Region {
+		// ページ番号
+		uint32_t page = 0;
+		// テクスチャ左上座標[px]
+		Vector2 texBase = {0.0f, 0.0f};
+		// テクスチャサイズ[px]
+		Vector2 texSize = {0.0f, 0.0f};
+	};
+
+	/// <summary>
+	/// アトラスのベイク。ページ画像（atlasName_N.png）と定義ファイル（atlasName.atlas）を書き出す
+	/// </summary>
+	/// <param name="directoryPath">リソースディレクトリ</param>
+	/// <param name="names">まとめる画像のファイル名（リソースディレクトリからの相対パス）</param>
+	/// <param name="atlasName">アトラス名（リソースディレクトリからの相対パス、拡張子なし）</param>
+	/// <param name="statistics">統計情報の出力先</param>
+	/// <param name="pageSize">ページの一辺[px]</param>
+	/// <param name="padding">画像の周囲の余白[px]</param>
+	/// <returns>結果</returns>
+	static HRESULT Build(
+	    const std::string& directoryPath, const std::vector<std::string>& names,
+	    const std::string& atlasName, Statistics& statistics, uint32_t pageSize = 2048,
+	    uint32_t padding = 2);
+
+	/// <summary>
+	/// ベイク済みアトラスの読み込み（ページのテクスチャは非同期に読み込む）
+	/// </summary>
+	/// <param name="fileName">定義ファイル名（リソースディレクトリからの相対パス）</param>
+	/// <param name="directoryPath">リソースディレクトリ</param>
+	/// <returns>成否。定義ファイルが無ければfalse</returns>
+	bool Load(const std::string& fileName, const std::string& directoryPath = "Resources/");
+
+	/// <summary>
+	/// アトラスに含まれない画像を単体のテクスチャとして非同期に読み込む（CreateSpriteの前に呼ぶと、
+	/// 未ベイク時も各画像のデコードが並列に進む）
+	/// </summary>
+	/// <param name="names">画像のファイル名</param>
+	void LoadMissingAsync(const std::vector<std::string>& names) const;
+
+	/// <summary>
+	/// 領域の検索
+	/// </summary>
+	/// <param name="name">画像のファイル名</param>
+	/// <returns>領域。無ければnullptr</returns>
+	const Region* Find(const std::string& name) const;
+
+	/// <summary>
+	/// ページのテクスチャハンドルの取得
+	/// </summary>
+	/// <param name="page">ページ番号</param>
+	/// <returns>テクスチャハンドル</returns>
+	uint32_t GetTextureHandle(uint32_t page) const { return pageTextureHandles_[page]; }
+
+	/// <summary>
+	/// スプライトに領域を設定する（テクスチャ、テクスチャ範囲、サイズ）
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="name">画像のファイル名</param>
+	/// <returns>成否。アトラスに含まれなければfalse</returns>
+	bool Apply(Sprite* sprite, const std::string& name) const;
+
+	/// <summary>
+	/// スプライト生成。アトラスに含まれなければ単体のテクスチャを読み込んで生成する
+	/// </summary>
+	/// <param name="name">画像のファイル名</param>
+	/// <param name="position">座標</param>
+	/// <param name="color">色</param>
+	/// <param name="anchorpoint">アンカーポイント</param>
+	/// <returns>生成されたスプライト</returns>
+	Sprite* CreateSprite(
+	    const std::string& name, Vector2 position, Vector4 color = {1, 1, 1, 1},
+	    Vector2 anchorpoint = {0.0f, 0.0f}) const;
+
+	/// <summary>
+	/// スプライトバッチに描画要求を積む。アトラスに含まれなければテクスチャ全体を使う
+	/// </summary>
+	/// <param name="spriteBatch">スプライトバッチ</param>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="name">画像のファイル名</param>
+	void Draw(SpriteBatch* spriteBatch, const Sprite& sprite, const std::string& name) const;
+
+private:
+	// ページのテクスチャハンドル
+	std::vector<uint32_t> pageTextureHandles_;
+	// 画像名→領域
+	std::unordered_map<std::string, Region> regions_;
+};
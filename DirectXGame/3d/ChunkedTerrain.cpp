@@ -0,0 +1,82 @@
+#include "ChunkedTerrain.h"
+#include "DirectXCommon.h"
+#include "ModelRenderQueue.h"
+#include "MyMath.h"
+#include <cassert>
+#include <cstring>
+
+void ChunkedTerrain::Initialize(
+    RenderDevice* renderDevice, uint32_t quadCountX, uint32_t quadCountZ, float cellSize,
+    uint32_t patchQuadCount, uint32_t lodCount, float skirtDepth) {
+	assert(renderDevice);
+
+	patches_.Initialize(quadCountX, quadCountZ, cellSize, patchQuadCount, lodCount, skirtDepth);
+	patchVertexBytes_ = sizeof(TerrainPatches::Vertex) * patches_.GetPatchVertexCount();
+
+	// 頂点は前のフレームのGPUが読んでいる間に書き換えないようフレーム数分
+	uint32_t frameCount = DirectXCommon::GetInstance()->GetFrameCount();
+	dirtyPatches_.Initialize(patches_.GetPatchCount(), frameCount);
+	vertexBuffers_.resize(frameCount);
+	for (uint32_t i = 0; i < frameCount; i++) {
+		vertexBuffers_[i] =
+		    renderDevice->CreateUploadBuffer(size_t(patchVertexBytes_) * patches_.GetPatchCount());
+	}
+
+	// インデックスは全区画共通で変わらない
+	const std::vector<uint16_t>& indices = patches_.GetIndices();
+	indexBuffer_ = renderDevice->CreateUploadBuffer(sizeof(uint16_t) * indices.size());
+	std::memcpy(indexBuffer_.cpuAddress, indices.data(), sizeof(uint16_t) * indices.size());
+
+	material_ = Material::Create();
+	material_->Update();
+
+	statistics_ = {};
+}
+
+void ChunkedTerrain::Update(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    float lodDistance) {
+	statistics_ = {};
+
+	// 作り直した区画は全ての頂点バッファで書き込み待ちにする
+	const std::vector<uint32_t>& rebuiltPatches = patches_.Rebuild();
+	for (uint32_t patch : rebuiltPatches) {
+		dirtyPatches_.Mark(patch);
+	}
+	statistics_.rebuiltPatchCount = uint32_t(rebuiltPatches.size());
+
+	// このフレームのバッファが最後に書かれてから変わった区画だけを書き込む
+	frameIndex_ = DirectXCommon::GetInstance()->GetFrameIndex();
+	statistics_.uploadedBytes = dirtyPatches_.Upload(
+	    frameIndex_, patches_.GetVertices().data(), vertexBuffers_[frameIndex_].cpuAddress,
+	    patchVertexBytes_);
+	statistics_.fullUploadBytes = uint64_t(patchVertexBytes_) * patches_.GetPatchCount();
+
+	// 詳細度はローカル座標のカメラ位置で選ぶ
+	Vector3 cameraPosition = MultiplyMatrixVector(
+	    InverseAffine(worldTransform.matWorld_), viewProjection.translation_);
+	patches_.SelectLods(cameraPosition, lodDistance);
+	statistics_.triangleCount = patches_.GetStatistics().triangleCount;
+	statistics_.fullDetailTriangleCount = patches_.GetStatistics().fullDetailTriangleCount;
+}
+
+void ChunkedTerrain::Draw(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    uint32_t textureHandle) {
+	ModelRenderQueue* modelRenderQueue = ModelRenderQueue::GetInstance();
+	const RenderDevice::UploadBuffer& vertexBuffer = vertexBuffers_[frameIndex_];
+
+	ModelRenderQueue::MeshView mesh;
+	mesh.vertexBuffer.sizeInBytes = patchVertexBytes_;
+	mesh.vertexBuffer.strideInBytes = sizeof(TerrainPatches::Vertex);
+	mesh.indexBuffer.is32Bit = false;
+	for (uint32_t patch = 0; patch < patches_.GetPatchCount(); patch++) {
+		const TerrainPatches::Lod& lod = patches_.GetLod(patches_.GetPatchLod(patch));
+		mesh.vertexBuffer.gpuAddress =
+		    vertexBuffer.gpuAddress + uint64_t(patchVertexBytes_) * patch;
+		mesh.indexBuffer.gpuAddress = indexBuffer_.gpuAddress + sizeof(uint16_t) * lod.indexOffset;
+		mesh.indexBuffer.sizeInBytes = uint32_t(sizeof(uint16_t) * lod.indexCount);
+		mesh.indexCount = lod.indexCount;
+		modelRenderQueue->DrawMesh(mesh, *material_, worldTransform, viewProjection, textureHandle);
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "DirtyRangeTracker.h"
+#include "Material.h"
+#include "RenderBackend.h"
+#include "TerrainPatches.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// 区画分けした地形の描画（区画ごとに詳細度を選び、変わった区画だけを転送する）
+/// </summary>
+/// <remarks>
+/// 頂点はフレームごとのアップロードバッファに全区画分を置き、DirtyRangeTrackerで
+/// そのバッファが最後に書かれてから作り直された区画だけを書き込む。インデックスは
+/// 全区画共通なので初期化時に1度だけ書く。描画はModelRenderQueueに区画ごとに積む。
+/// </remarks>
+class ChunkedTerrain {
+public:
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 描いた三角形数
+		uint32_t triangleCount = 0;
+		// 全区画を最高詳細度で描いた場合の三角形数
+		uint32_t fullDetailTriangleCount = 0;
+		// 作り直した区画数
+		uint32_t rebuiltPatchCount = 0;
+		// 転送したバイト数
+		uint64_t uploadedBytes = 0;
+		// 全区画を転送した場合のバイト数
+		uint64_t fullUploadBytes = 0;
+	};
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="renderDevice">アップロードバッファの生成に使うデバイス</param>
+	/// <param name="quadCountX">横のマス数（patchQuadCountの倍数）</param>
+	/// <param name="quadCountZ">奥行のマス数（patchQuadCountの倍数）</param>
+	/// <param name="cellSize">1マスの大きさ</param>
+	/// <param name="patchQuadCount">区画の一辺のマス数（2^(lodCount-1)の倍数）</param>
+	/// <param name="lodCount">詳細度数</param>
+	/// <param name="skirtDepth">スカートを垂らす深さ</param>
+	void Initialize(
+	    RenderDevice* renderDevice, uint32_t quadCountX, uint32_t quadCountZ, float cellSize,
+	    uint32_t patchQuadCount = TerrainPatches::kDefaultPatchQuadCount, uint32_t lodCount = 4,
+	    float skirtDepth = 1.0f);
+
+	/// <summary>
+	/// 区画（高さの変更用）
+	/// </summary>
+	TerrainPatches& GetPatches() { return patches_; }
+
+	/// <summary>
+	/// マテリアル
+	/// </summary>
+	Material* GetMaterial() { return material_.get(); }
+
+	/// <summary>
+	/// 作り直し待ちの区画を作り直して転送し、詳細度を選ぶ（描画の前に毎フレーム呼ぶ）
+	/// </summary>
+	/// <param name="worldTransform">地形のワールドトランスフォーム</param>
+	/// <param name="viewProjection">描画に使うビュープロジェクション</param>
+	/// <param name="lodDistance">詳細度0で描く距離（ローカル座標）</param>
+	void Update(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    float lodDistance);
+
+	/// <summary>
+	/// 描画（ModelRenderQueueに区画ごとに積む）
+	/// </summary>
+	/// <param name="worldTransform">地形のワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHandle">テクスチャハンドル。RenderQueue::kNoTextureならマテリアルのもの</param>
+	void Draw(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHandle = RenderQueue::kNoTexture);
+
+	/// <summary>
+	/// 直前のUpdateの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	// 区画
+	TerrainPatches patches_;
+	// マテリアル
+	std::unique_ptr<Material> material_;
+	// フレームごとの頂点バッファ
+	std::vector<RenderDevice::UploadBuffer> vertexBuffers_;
+	// インデックスバッファ
+	RenderDevice::UploadBuffer indexBuffer_;
+	// 頂点バッファごとの書き込み待ちの区画
+	DirtyRangeTracker dirtyPatches_;
+	// 1区画の頂点のバイト数
+	uint32_t patchVertexBytes_ = 0;
+	// 今フレームの頂点バッファ
+	uint32_t frameIndex_ = 0;
+	// 統計情報
+	Statistics statistics_;
+};
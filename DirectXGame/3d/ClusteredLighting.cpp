@@ -0,0 +1,225 @@
+#include "ClusteredLighting.h"
+#include "ConstantBufferAllocator.h"
+#include "DirectXCommon.h"
+#include "Model.h"
+#include "ShaderUtility.h"
+#include "ShadowCasterSystem.h"
+#include "WinApp.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+using namespace Microsoft::WRL;
+
+ClusteredLighting* ClusteredLighting::GetInstance() {
+	static ClusteredLighting instance;
+	return &instance;
+}
+
+void ClusteredLighting::Initialize(
+    ID3D12Device* device, RenderDevice* renderDevice, const std::wstring& directoryPath) {
+	assert(device);
+	assert(renderDevice);
+	device_ = device;
+
+	// 点光源はフレームごとに永続バッファを持ち、変わった分だけ書き込む
+	uint32_t frameCount = DirectXCommon::GetInstance()->GetFrameCount();
+	pointLights_.assign(kMaxPointLights, PointLight{});
+	pointLightCount_ = 0;
+	dirtyPointLights_.Initialize(kMaxPointLights, frameCount);
+	pointLightBuffers_.resize(frameCount);
+	for (uint32_t i = 0; i < frameCount; i++) {
+		pointLightBuffers_[i] =
+		    renderDevice->CreateUploadBuffer(sizeof(PointLight) * kMaxPointLights);
+		assert(pointLightBuffers_[i].cpuAddress);
+	}
+
+	cluster_.Initialize(
+	    LightCluster::kDefaultTileCountX, LightCluster::kDefaultTileCountY,
+	    LightCluster::kDefaultSliceCount, kMaxLightIndices);
+	CreatePipeline(directoryPath);
+}
+
+void ClusteredLighting::Update(
+    const ViewProjection& viewProjection, const PointLight* lights, uint32_t lightCount) {
+	assert(device_);
+	isReady_ = false;
+	lightCount = std::min(lightCount, kMaxPointLights);
+
+	// 内容が変わった点光源だけ印を付ける
+	for (uint32_t i = 0; i < lightCount; i++) {
+		if (i >= pointLightCount_ ||
+		    std::memcmp(&pointLights_[i], &lights[i], sizeof(PointLight)) != 0) {
+			pointLights_[i] = lights[i];
+			dirtyPointLights_.Mark(i);
+		}
+	}
+	pointLightCount_ = lightCount;
+
+	LightCluster::Frustum frustum;
+	frustum.matView = viewProjection.matView;
+	frustum.fovAngleY = viewProjection.fovAngleY;
+	frustum.aspectRatio = viewProjection.aspectRatio;
+	frustum.nearZ = viewProjection.nearZ;
+	frustum.farZ = viewProjection.farZ;
+	cluster_.Build(frustum, pointLights_.data(), lightCount);
+
+	// このフレームのバッファが最後に書かれてからの変更を連続区間にまとめて書き込む
+	uint32_t frameIndex = DirectXCommon::GetInstance()->GetFrameIndex();
+	const RenderDevice::UploadBuffer& pointLightBuffer = pointLightBuffers_[frameIndex];
+	uploadStatistics_ = {};
+	uploadStatistics_.lightBytes = dirtyPointLights_.Upload(
+	    frameIndex, pointLights_.data(), pointLightBuffer.cpuAddress, sizeof(PointLight),
+	    kMergeGap);
+	uint64_t fullLightBytes = sizeof(PointLight) * uint64_t(lightCount);
+	uploadStatistics_.skippedLightBytes =
+	    fullLightBytes > uploadStatistics_.lightBytes ? fullLightBytes - uploadStatistics_.lightBytes
+	                                                  : 0;
+	pointLightsAddress_ = pointLightBuffer.gpuAddress;
+
+	// 空のバッファはバインドできないので最低1要素分は確保する
+	ConstantBufferAllocator* allocator = ConstantBufferAllocator::GetInstance();
+	auto upload = [this, allocator](const void* data, size_t size) -> D3D12_GPU_VIRTUAL_ADDRESS {
+		ConstantBufferAllocator::Allocation allocation =
+		    allocator->Allocate(std::max<size_t>(size, sizeof(uint32_t) * 4));
+		if (allocation.cpuAddress && size > 0) {
+			std::memcpy(allocation.cpuAddress, data, size);
+			uploadStatistics_.clusterBytes += size;
+		}
+		return allocation.gpuAddress;
+	};
+
+	const std::vector<LightCluster::Cluster>& clusters = cluster_.GetClusters();
+	const std::vector<uint32_t>& lightIndices = cluster_.GetLightIndices();
+	clustersAddress_ = upload(clusters.data(), sizeof(LightCluster::Cluster) * clusters.size());
+	lightIndicesAddress_ = upload(lightIndices.data(), sizeof(uint32_t) * lightIndices.size());
+
+	ConstBufferDataClusterParameters parameters;
+	parameters.tileCountX = cluster_.GetTileCountX();
+	parameters.tileCountY = cluster_.GetTileCountY();
+	parameters.sliceCount = cluster_.GetSliceCount();
+	parameters.pointLightCount = lightCount;
+	parameters.sliceScale = cluster_.GetSliceScale();
+	parameters.sliceBias = cluster_.GetSliceBias();
+	parameters.tileWidth = float(WinApp::kWindowWidth) / float(parameters.tileCountX);
+	parameters.tileHeight = float(WinApp::kWindowHeight) / float(parameters.tileCountY);
+	parametersAddress_ = allocator->Upload(parameters);
+	uploadStatistics_.clusterBytes += sizeof(parameters);
+
+	// 容量不足で転送できなかったフレームはLightGroupだけで描く
+	isReady_ = clustersAddress_ != 0 && lightIndicesAddress_ != 0 && parametersAddress_ != 0;
+}
+
+bool ClusteredLighting::IsReady() const {
+	return isReady_ && ShadowCasterSystem::GetInstance()->IsReady();
+}
+
+void ClusteredLighting::SetRootParameters(RenderQueue::Packet& packet) const {
+	assert(IsReady());
+	packet.rootSignature = rootSignature_.Get();
+	packet.pipelineState = pipelineState_.Get();
+	packet.constantBuffers[uint32_t(RootParameter::kClusterParameters)] = parametersAddress_;
+	packet.shaderResources[uint32_t(RootParameter::kPointLights)] = pointLightsAddress_;
+	packet.shaderResources[uint32_t(RootParameter::kClusters)] = clustersAddress_;
+	packet.shaderResources[uint32_t(RootParameter::kLightIndices)] = lightIndicesAddress_;
+	ShadowCasterSystem::GetInstance()->SetRootParameters(
+	    packet, uint32_t(RootParameter::kShadowParameters),
+	    uint32_t(RootParameter::kShadowCasters));
+}
+
+void ClusteredLighting::CreatePipeline(const std::wstring& directoryPath) {
+	HRESULT result = S_FALSE;
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(directoryPath + L"shaders/ObjVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob =
+	    CompileShader(directoryPath + L"shaders/ObjClusteredPS.hlsl", "ps_5_0");
+
+	// 頂点レイアウト（Mesh::VertexPosNormalUv）
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// ルートパラメータ（Model::RoomParameterと同じ並びに格子と丸影の分を足す）
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+
+	CD3DX12_ROOT_PARAMETER rootparams[12];
+	rootparams[uint32_t(Model::RoomParameter::kWorldTransform)].InitAsConstantBufferView(
+	    0, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[uint32_t(Model::RoomParameter::kViewProjection)].InitAsConstantBufferView(
+	    1, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[uint32_t(Model::RoomParameter::kMaterial)].InitAsConstantBufferView(
+	    2, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[uint32_t(Model::RoomParameter::kTexture)].InitAsDescriptorTable(
+	    1, &descRangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[uint32_t(Model::RoomParameter::kLight)].InitAsConstantBufferView(
+	    3, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[uint32_t(Model::RoomParameter::kObjectColor)].InitAsConstantBufferView(
+	    4, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[uint32_t(RootParameter::kClusterParameters)].InitAsConstantBufferView(
+	    5, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootparams[uint32_t(RootParameter::kPointLights)].InitAsShaderResourceView(
+	    1, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootparams[uint32_t(RootParameter::kClusters)].InitAsShaderResourceView(
+	    2, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootparams[uint32_t(RootParameter::kLightIndices)].InitAsShaderResourceView(
+	    3, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootparams[uint32_t(RootParameter::kShadowParameters)].InitAsConstantBufferView(
+	    6, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootparams[uint32_t(RootParameter::kShadowCasters)].InitAsShaderResourceView(
+	    4, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc = CD3DX12_STATIC_SAMPLER_DESC(0);
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 1, &samplerDesc,
+	    D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device_->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	// グラフィックスパイプライン
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+
+	// 通常αブレンド
+	D3D12_RENDER_TARGET_BLEND_DESC& blenddesc = gpipeline.BlendState.RenderTarget[0];
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	gpipeline.SampleDesc.Count = 1;
+	gpipeline.pRootSignature = rootSignature_.Get();
+
+	result = device_->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineState_));
+	assert(SUCCEEDED(result));
+}
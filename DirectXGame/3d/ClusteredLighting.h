@@ -0,0 +1,168 @@
+#pragma once
+
+#include "DirtyRangeTracker.h"
+#include "LightCluster.h"
+#include "RenderBackend.h"
+#include "RenderQueue.h"
+#include "ViewProjection.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// クラスタ化ライティング（大量の点光源を格子に割り当て、モデルのシェーダが自分の格子の分だけ読む）
+/// </summary>
+/// <remarks>
+/// LightGroupの平行光源、スポットライト、丸影はそのまま使い、点光源と
+/// ShadowCasterSystemが選んだ丸影をここで追加する。
+/// 点光源はフレームごとの永続バッファに変わった分だけ書き込み、
+/// 格子とライト番号一覧はカメラで変わるのでConstantBufferAllocatorから毎フレーム切り出す。
+/// </remarks>
+class ClusteredLighting {
+public:
+	/// <summary>
+	/// ルートパラメータ番号（Model::RoomParameterの後ろに続く）
+	/// </summary>
+	enum class RootParameter {
+		kClusterParameters = 6, // 格子の設定
+		kPointLights,           // 点光源
+		kClusters,              // 格子ごとのライト一覧の範囲
+		kLightIndices,          // ライト番号一覧
+		kShadowParameters,      // 丸影のキャスター数
+		kShadowCasters,         // 丸影のキャスター
+	};
+
+	using PointLight = LightCluster::PointLight;
+	using Statistics = LightCluster::Statistics;
+
+	// GPUに渡す最大点光源数
+	static const uint32_t kMaxPointLights = 4096;
+	// GPUに渡すライト番号一覧の最大長
+	static const uint32_t kMaxLightIndices = 32768;
+	// 点光源の書き込みで埋めてつなげる隙間の要素数
+	static const uint32_t kMergeGap = 4;
+
+	/// <summary>
+	/// 転送量の統計情報
+	/// </summary>
+	struct UploadStatistics {
+		// 点光源の書き込みバイト数
+		uint64_t lightBytes = 0;
+		// 点光源を毎回全て書き込んだ場合と比べて省いたバイト数
+		uint64_t skippedLightBytes = 0;
+		// 格子、ライト番号一覧、設定の書き込みバイト数
+		uint64_t clusterBytes = 0;
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static ClusteredLighting* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="renderDevice">点光源の永続バッファを作る描画デバイス</param>
+	void Initialize(
+	    ID3D12Device* device, RenderDevice* renderDevice,
+	    const std::wstring& directoryPath = L"Resources/");
+
+	/// <summary>
+	/// フレーム開始（前のフレームの割り当てを無効にする）
+	/// </summary>
+	void BeginFrame() { isReady_ = false; }
+
+	/// <summary>
+	/// 点光源を格子に割り当てて転送する（ConstantBufferAllocator::BeginFrameの後、描画の前に呼ぶ）
+	/// </summary>
+	/// <param name="viewProjection">描画に使うビュープロジェクション</param>
+	/// <param name="lights">点光源（前回と同じ番号で内容が変わったものだけ書き込む）</param>
+	/// <param name="lightCount">点光源の数（kMaxPointLightsを超えた分は使わない）</param>
+	void Update(const ViewProjection& viewProjection, const PointLight* lights, uint32_t lightCount);
+
+	/// <summary>
+	/// 点光源を格子に割り当てて転送する
+	/// </summary>
+	/// <param name="viewProjection">描画に使うビュープロジェクション</param>
+	/// <param name="lights">点光源</param>
+	void Update(const ViewProjection& viewProjection, const std::vector<PointLight>& lights) {
+		Update(viewProjection, lights.data(), uint32_t(lights.size()));
+	}
+
+	/// <summary>
+	/// 今フレームの割り当てと丸影が転送済みか（ShadowCasterSystem::Updateも必要）
+	/// </summary>
+	bool IsReady() const;
+
+	/// <summary>
+	/// 描画要求にパイプラインと格子、丸影のルートパラメータを設定する（IsReadyのときだけ）
+	/// </summary>
+	/// <param name="packet">描画要求（モデルのルートパラメータは設定済み）</param>
+	void SetRootParameters(RenderQueue::Packet& packet) const;
+
+	/// <summary>
+	/// 直前のUpdateの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return cluster_.GetStatistics(); }
+
+	/// <summary>
+	/// 直前のUpdateの転送量
+	/// </summary>
+	const UploadStatistics& GetUploadStatistics() const { return uploadStatistics_; }
+
+private:
+	/// <summary>
+	/// シェーダに渡す格子の設定
+	/// </summary>
+	struct ConstBufferDataClusterParameters {
+		uint32_t tileCountX;
+		uint32_t tileCountY;
+		uint32_t sliceCount;
+		uint32_t pointLightCount;
+		float sliceScale;
+		float sliceBias;
+		// タイルの大きさ[px]
+		float tileWidth;
+		float tileHeight;
+	};
+
+	ClusteredLighting() = default;
+	~ClusteredLighting() = default;
+	ClusteredLighting(const ClusteredLighting&) = delete;
+	ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+
+	/// <summary>
+	/// パイプライン生成
+	/// </summary>
+	void CreatePipeline(const std::wstring& directoryPath);
+
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	// パイプラインステートオブジェクト
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+	// 格子への割り当て
+	LightCluster cluster_;
+	// 点光源（CPU側の写し）
+	std::vector<PointLight> pointLights_;
+	// 使用中の点光源数
+	uint32_t pointLightCount_ = 0;
+	// 点光源の変更範囲（書き込み先はフレームごとのバッファ）
+	DirtyRangeTracker dirtyPointLights_;
+	// 点光源の永続マップ済みバッファ（フレームごと。デバイスが保持する）
+	std::vector<RenderDevice::UploadBuffer> pointLightBuffers_;
+	// 転送量の統計情報
+	UploadStatistics uploadStatistics_;
+	// 今フレームの転送先
+	D3D12_GPU_VIRTUAL_ADDRESS parametersAddress_ = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS pointLightsAddress_ = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS clustersAddress_ = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS lightIndicesAddress_ = 0;
+	// 今フレームの転送が済んでいる
+	bool isReady_ = false;
+};
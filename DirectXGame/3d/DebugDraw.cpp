@@ -0,0 +1,214 @@
+#include "DebugDraw.h"
+#include "DirectXCommon.h"
+#include "ShaderUtility.h"
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+using namespace Microsoft::WRL;
+
+namespace {
+
+// ブレンドモード毎のブレンド設定
+D3D12_RENDER_TARGET_BLEND_DESC MakeBlendDesc(DebugDraw::BlendMode blendMode) {
+	D3D12_RENDER_TARGET_BLEND_DESC blenddesc{};
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	switch (blendMode) {
+	case DebugDraw::BlendMode::kNone:
+		blenddesc.BlendEnable = false;
+		break;
+	case DebugDraw::BlendMode::kNormal:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	case DebugDraw::BlendMode::kAdd:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case DebugDraw::BlendMode::kSubtract:
+		blenddesc.BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case DebugDraw::BlendMode::kMultiply:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_ZERO;
+		blenddesc.DestBlend = D3D12_BLEND_SRC_COLOR;
+		break;
+	case DebugDraw::BlendMode::kScreen:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	default:
+		break;
+	}
+	return blenddesc;
+}
+
+} // namespace
+
+DebugDraw* DebugDraw::GetInstance() {
+	static DebugDraw instance;
+	return &instance;
+}
+
+void DebugDraw::Initialize(ID3D12Device* device, const std::wstring& directoryPath) {
+	assert(device);
+
+	device_ = device;
+	CreatePipelines(directoryPath);
+
+	// チャンクは描画する線分の数に合わせて継ぎ足すので、ここでは確保しない
+	frameChunks_.resize(DirectXCommon::GetInstance()->GetFrameCount());
+}
+
+void DebugDraw::BeginFrame() {
+	lastStatistics_ = statistics_;
+	statistics_ = {};
+	// DirectXCommonが完了を待ったフレーム番号のチャンクを使う
+	frameIndex_ = DirectXCommon::GetInstance()->GetFrameIndex();
+	assert(frameIndex_ < frameChunks_.size());
+	chunkCursor_ = 0;
+}
+
+void DebugDraw::Draw(
+    ID3D12GraphicsCommandList* commandList, const ViewProjection& viewProjection) {
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	assert(commandList == dxCommon->GetCommandList());
+	(void)commandList;
+	Draw(dxCommon->GetRenderCommandList(), viewProjection);
+}
+
+void DebugDraw::Draw(RenderCommandList* commandList, const ViewProjection& viewProjection) {
+	assert(commandList);
+	if (geometry_.GetLineCount() == 0) {
+		return;
+	}
+
+	// 共通の状態をセット
+	commandList->SetRootSignature(rootSignature_.Get());
+	commandList->SetPrimitiveTopology(RenderCommandList::PrimitiveTopology::kLineList);
+	commandList->SetConstantBuffer(0, viewProjection.GetConstBuffer()->GetGPUVirtualAddress());
+
+	// ブレンドモードごとにパイプラインを1度だけ切り替え、チャンク1つを1ドローコールで描く
+	for (size_t i = 0; i < pipelineStates_.size(); i++) {
+		BlendMode blendMode = BlendMode(i);
+		uint32_t chunkCount = geometry_.GetChunkCount(blendMode);
+		if (chunkCount == 0) {
+			continue;
+		}
+		commandList->SetPipelineState(pipelineStates_[i].Get());
+		statistics_.pipelineChangeCount++;
+
+		const std::vector<DebugGeometry::Chunk>& chunks = geometry_.GetChunks(blendMode);
+		for (uint32_t c = 0; c < chunkCount; c++) {
+			const DebugGeometry::Chunk& chunk = chunks[c];
+			size_t size = sizeof(DebugGeometry::Vertex) * chunk.vertexCount;
+			GpuChunk& gpuChunk = AllocateChunk();
+			std::memcpy(gpuChunk.vertMap, chunk.vertices.get(), size);
+			commandList->AddUploadBytes(size);
+
+			RenderCommandList::VertexBufferView vbView;
+			vbView.gpuAddress = gpuChunk.vertBuff->GetGPUVirtualAddress();
+			vbView.sizeInBytes = uint32_t(size);
+			vbView.strideInBytes = sizeof(DebugGeometry::Vertex);
+			commandList->SetVertexBuffer(vbView);
+			commandList->Draw(chunk.vertexCount, 1, 0, 0);
+
+			statistics_.drawCallCount++;
+			statistics_.uploadBytes += size;
+		}
+		statistics_.lineCount += geometry_.GetLineCount(blendMode);
+	}
+}
+
+DebugDraw::GpuChunk& DebugDraw::AllocateChunk() {
+	std::vector<GpuChunk>& chunks = frameChunks_[frameIndex_];
+	if (chunkCursor_ == chunks.size()) {
+		HRESULT result = S_FALSE;
+
+		GpuChunk chunk;
+		CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(
+		    sizeof(DebugGeometry::Vertex) * DebugGeometry::kChunkVertexCount);
+		result = device_->CreateCommittedResource(
+		    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+		    nullptr, IID_PPV_ARGS(&chunk.vertBuff));
+		assert(SUCCEEDED(result));
+
+		// 永続マップ
+		result = chunk.vertBuff->Map(0, nullptr, reinterpret_cast<void**>(&chunk.vertMap));
+		assert(SUCCEEDED(result));
+		chunks.push_back(chunk);
+	}
+	statistics_.chunkCount = uint32_t(chunks.size());
+	return chunks[chunkCursor_++];
+}
+
+void DebugDraw::CreatePipelines(const std::wstring& directoryPath) {
+	HRESULT result = S_FALSE;
+
+	// PrimitiveDrawerと同じシェーダ
+	ComPtr<ID3DBlob> vsBlob = CompileShader(directoryPath + L"shaders/PrimitiveVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(directoryPath + L"shaders/PrimitivePS.hlsl", "ps_5_0");
+
+	// 頂点レイアウト
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// ルートシグネチャ（ビュープロジェクションのみ）
+	CD3DX12_ROOT_PARAMETER rootparams[1];
+	rootparams[0].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_ALL);
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 0, nullptr,
+	    D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device_->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	// グラフィックスパイプライン
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	// 奥行きは判定するが書き込まない（重なった線が互いに隠さない）
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	gpipeline.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
+	gpipeline.NumRenderTargets = 1;
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	gpipeline.SampleDesc.Count = 1;
+	gpipeline.pRootSignature = rootSignature_.Get();
+
+	for (size_t i = 0; i < pipelineStates_.size(); i++) {
+		gpipeline.BlendState.RenderTarget[0] = MakeBlendDesc(BlendMode(i));
+		result = device_->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineStates_[i]));
+		assert(SUCCEEDED(result));
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "DebugGeometry.h"
+#include "RenderBackend.h"
+#include "ViewProjection.h"
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// デバッグ表示（溜めた線分をブレンドモードごとにまとめて1フレーム1回で描画する）
+/// </summary>
+/// <remarks>
+/// PrimitiveDrawerの線分は4096本の固定長なので、当たり判定の箱やマップの格子のように
+/// 数十万本になる表示はこちらに溜める。GPU側もDebugGeometryと同じ大きさのチャンクを
+/// フレームごとに持ち、足りなくなったら継ぎ足す。
+/// </remarks>
+class DebugDraw {
+public:
+	using BlendMode = DebugGeometry::BlendMode;
+
+	/// <summary>
+	/// 1フレーム分の統計情報
+	/// </summary>
+	struct Statistics {
+		// 描画した線分数
+		uint32_t lineCount = 0;
+		// ドローコール数
+		uint32_t drawCallCount = 0;
+		// パイプライン切り替え数
+		uint32_t pipelineChangeCount = 0;
+		// 今のフレームの領域で確保済みのチャンク数
+		uint32_t chunkCount = 0;
+		// 転送したバイト数
+		uint64_t uploadBytes = 0;
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static DebugDraw* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	void Initialize(ID3D12Device* device, const std::wstring& directoryPath = L"Resources/");
+
+	/// <summary>
+	/// フレーム開始（今のフレームが使うチャンクを切り替える）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 線分を溜める先
+	/// </summary>
+	DebugGeometry& GetGeometry() { return geometry_; }
+
+	/// <summary>
+	/// 溜めた線分を描画する（3Dオブジェクトの描画の後に1フレーム1回）
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト（DirectXCommonのもの）</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	void Draw(ID3D12GraphicsCommandList* commandList, const ViewProjection& viewProjection);
+
+	/// <summary>
+	/// 溜めた線分を描画する（3Dオブジェクトの描画の後に1フレーム1回）
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	void Draw(RenderCommandList* commandList, const ViewProjection& viewProjection);
+
+	/// <summary>
+	/// 溜めた線分を捨てる（描画しなかったフレームの分も含めて毎フレーム呼ぶ）
+	/// </summary>
+	void Reset() { geometry_.Clear(); }
+
+	/// <summary>
+	/// 直前のフレームの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return lastStatistics_; }
+
+private:
+	/// <summary>
+	/// GPU側のチャンク
+	/// </summary>
+	struct GpuChunk {
+		// 頂点バッファ
+		Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff;
+		// 頂点バッファマップ
+		DebugGeometry::Vertex* vertMap = nullptr;
+	};
+
+	DebugDraw() = default;
+	~DebugDraw() = default;
+	DebugDraw(const DebugDraw&) = delete;
+	DebugDraw& operator=(const DebugDraw&) = delete;
+
+	/// <summary>
+	/// パイプライン生成
+	/// </summary>
+	void CreatePipelines(const std::wstring& directoryPath);
+
+	/// <summary>
+	/// 今のフレームのチャンクを1つ確保する（足りなければ継ぎ足す）
+	/// </summary>
+	GpuChunk& AllocateChunk();
+
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	// パイプラインステートオブジェクト
+	std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, size_t(BlendMode::kCountOfBlendMode)>
+	    pipelineStates_;
+	// フレームごとのチャンク（同時に処理中になりうるフレーム数分）
+	std::vector<std::vector<GpuChunk>> frameChunks_;
+	// 今のフレーム番号
+	uint32_t frameIndex_ = 0;
+	// 今のフレームで使用済みのチャンク数
+	uint32_t chunkCursor_ = 0;
+	// 線分を溜める先
+	DebugGeometry geometry_;
+	// 今のフレームの統計情報
+	Statistics statistics_;
+	// 直前のフレームの統計情報
+	Statistics lastStatistics_;
+};
@@ -0,0 +1,187 @@
+#include "DebugGeometry.h"
+#include "MyMath.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace {
+
+// 箱の12辺（手前の面、奥の面、前後をつなぐ辺）
+const uint8_t kBoxEdges[12][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6},
+    {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6}, {3, 7},
+};
+
+} // namespace
+
+void DebugGeometry::Clear() {
+	for (size_t blendMode = 0; blendMode < size_t(BlendMode::kCountOfBlendMode); blendMode++) {
+		for (uint32_t i = 0; i < chunkCounts_[blendMode]; i++) {
+			chunks_[blendMode][i].vertexCount = 0;
+		}
+		chunkCounts_[blendMode] = 0;
+		lineCounts_[blendMode] = 0;
+	}
+}
+
+void DebugGeometry::AddLine(
+    const Vector3& p1, const Vector3& p2, const Vector4& color, BlendMode blendMode) {
+	Vertex* vertices = AllocateLines(blendMode, 1);
+	vertices[0] = {p1, color};
+	vertices[1] = {p2, color};
+}
+
+void DebugGeometry::AddAabb(
+    const Vector3& min, const Vector3& max, const Vector4& color, BlendMode blendMode) {
+	const Vector3 corners[8] = {
+	    {min.x, min.y, min.z},
+	    {max.x, min.y, min.z},
+	    {max.x, max.y, min.z},
+	    {min.x, max.y, min.z},
+	    {min.x, min.y, max.z},
+	    {max.x, min.y, max.z},
+	    {max.x, max.y, max.z},
+	    {min.x, max.y, max.z},
+	};
+	AddBox(corners, color, blendMode);
+}
+
+void DebugGeometry::AddBox(const Vector3 corners[8], const Vector4& color, BlendMode blendMode) {
+	Vertex* vertices = AllocateLines(blendMode, 12);
+	for (uint32_t i = 0; i < 12; i++) {
+		vertices[i * 2 + 0] = {corners[kBoxEdges[i][0]], color};
+		vertices[i * 2 + 1] = {corners[kBoxEdges[i][1]], color};
+	}
+}
+
+void DebugGeometry::AddSphere(
+    const Vector3& center, float radius, const Vector4& color, uint32_t segmentCount,
+    BlendMode blendMode) {
+	assert(segmentCount >= 3 && segmentCount * 3 <= kChunkLineCount);
+
+	// 円周上の点は3つの円で共通なので先に求める
+	float step = 2.0f * std::numbers::pi_v<float> / float(segmentCount);
+	Vertex* vertices = AllocateLines(blendMode, segmentCount * 3);
+	float prevCos = radius;
+	float prevSin = 0.0f;
+	for (uint32_t i = 1; i <= segmentCount; i++) {
+		float angle = step * float(i);
+		float cos = radius * std::cos(angle);
+		float sin = radius * std::sin(angle);
+		const Vector3 points[3][2] = {
+		    {{center.x + prevCos, center.y + prevSin, center.z},
+		     {center.x + cos, center.y + sin, center.z}},
+		    {{center.x, center.y + prevCos, center.z + prevSin},
+		     {center.x, center.y + cos, center.z + sin}},
+		    {{center.x + prevSin, center.y, center.z + prevCos},
+		     {center.x + sin, center.y, center.z + cos}},
+		};
+		for (uint32_t circle = 0; circle < 3; circle++) {
+			Vertex* line = vertices + (circle * segmentCount + i - 1) * 2;
+			line[0] = {points[circle][0], color};
+			line[1] = {points[circle][1], color};
+		}
+		prevCos = cos;
+		prevSin = sin;
+	}
+}
+
+void DebugGeometry::AddGrid(
+    const Vector3& origin, const Vector3& axisU, const Vector3& axisV, uint32_t countU,
+    uint32_t countV, const Vector4& color, BlendMode blendMode) {
+	Vector3 lengthU = {axisU.x * float(countU), axisU.y * float(countU), axisU.z * float(countU)};
+	Vector3 lengthV = {axisV.x * float(countV), axisV.y * float(countV), axisV.z * float(countV)};
+
+	// V方向に伸びる線（U方向に並ぶ）とU方向に伸びる線（V方向に並ぶ）
+	// 1チャンクに収まらない大きさもあるので、収まる分ずつ確保する
+	uint32_t lineCount = (countU + 1) + (countV + 1);
+	uint32_t line = 0;
+	while (line < lineCount) {
+		uint32_t count = std::min<uint32_t>(lineCount - line, kChunkLineCount);
+		Vertex* vertices = AllocateLines(blendMode, count);
+		for (uint32_t k = 0; k < count; k++, line++) {
+			Vector3 start;
+			Vector3 length;
+			if (line <= countU) {
+				float t = float(line);
+				start = {origin.x + axisU.x * t, origin.y + axisU.y * t, origin.z + axisU.z * t};
+				length = lengthV;
+			} else {
+				float t = float(line - (countU + 1));
+				start = {origin.x + axisV.x * t, origin.y + axisV.y * t, origin.z + axisV.z * t};
+				length = lengthU;
+			}
+			vertices[k * 2 + 0] = {start, color};
+			Vector3 end = {start.x + length.x, start.y + length.y, start.z + length.z};
+			vertices[k * 2 + 1] = {end, color};
+		}
+	}
+}
+
+void DebugGeometry::AddFrustum(
+    const Matrix4x4& matView, float fovAngleY, float aspectRatio, float nearZ, float farZ,
+    const Vector4& color, BlendMode blendMode) {
+	// ビュー空間で角を求めてワールド座標に戻す
+	Matrix4x4 matCamera = InverseAffine(matView);
+	float tanHalfY = std::tan(fovAngleY * 0.5f);
+	float tanHalfX = tanHalfY * aspectRatio;
+	Vector3 corners[8];
+	for (uint32_t plane = 0; plane < 2; plane++) {
+		float z = plane == 0 ? nearZ : farZ;
+		float x = z * tanHalfX;
+		float y = z * tanHalfY;
+		const Vector3 local[4] = {
+		    {-x, -y, z},
+		    {x, -y, z},
+		    {x, y, z},
+		    {-x, y, z},
+		};
+		for (uint32_t i = 0; i < 4; i++) {
+			corners[plane * 4 + i] = MultiplyMatrixVector(matCamera, local[i]);
+		}
+	}
+	AddBox(corners, color, blendMode);
+}
+
+uint32_t DebugGeometry::GetLineCount() const {
+	uint32_t lineCount = 0;
+	for (uint32_t count : lineCounts_) {
+		lineCount += count;
+	}
+	return lineCount;
+}
+
+uint32_t DebugGeometry::GetCapacityChunkCount() const {
+	uint32_t chunkCount = 0;
+	for (const std::vector<Chunk>& chunks : chunks_) {
+		chunkCount += uint32_t(chunks.size());
+	}
+	return chunkCount;
+}
+
+DebugGeometry::Vertex* DebugGeometry::AllocateLines(BlendMode blendMode, uint32_t lineCount) {
+	assert(blendMode < BlendMode::kCountOfBlendMode);
+	assert(lineCount > 0 && lineCount <= kChunkLineCount);
+
+	std::vector<Chunk>& chunks = chunks_[size_t(blendMode)];
+	uint32_t& chunkCount = chunkCounts_[size_t(blendMode)];
+	uint32_t vertexCount = lineCount * 2;
+
+	// 今のチャンクに収まらなければ次へ（無ければ継ぎ足す）
+	if (chunkCount == 0 ||
+	    chunks[chunkCount - 1].vertexCount + vertexCount > kChunkVertexCount) {
+		if (chunkCount == chunks.size()) {
+			Chunk chunk;
+			chunk.vertices = std::make_unique_for_overwrite<Vertex[]>(kChunkVertexCount);
+			chunks.push_back(std::move(chunk));
+		}
+		chunkCount++;
+	}
+
+	Chunk& chunk = chunks[chunkCount - 1];
+	Vertex* vertices = chunk.vertices.get() + chunk.vertexCount;
+	chunk.vertexCount += vertexCount;
+	lineCounts_[size_t(blendMode)] += lineCount;
+	return vertices;
+}
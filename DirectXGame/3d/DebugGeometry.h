@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// デバッグ表示用の線分の頂点（ブレンドモードごとに固定長のチャンクを継ぎ足して溜める）
+/// </summary>
+/// <remarks>
+/// チャンクは一度確保したらClearしても手放さず、足りなくなったら後ろに継ぎ足すだけなので、
+/// 溜めた頂点が再確保でコピーされることはない。箱や球は線分に分解して書き込む。
+/// GPUやファイルに触れない。
+/// </remarks>
+class DebugGeometry {
+public:
+	// 1チャンクの頂点数（線分2頂点が途中で切れないよう偶数）
+	static constexpr uint32_t kChunkVertexCount = 65536;
+	// 1チャンクの線分数
+	static constexpr uint32_t kChunkLineCount = kChunkVertexCount / 2;
+	// 球の既定の分割数
+	static constexpr uint32_t kDefaultSphereSegmentCount = 16;
+
+	/// <summary>
+	/// ブレンドモード（PrimitiveDrawerと同じ並び）
+	/// </summary>
+	enum class BlendMode {
+		kNone,     //!< ブレンドなし
+		kNormal,   //!< 通常αブレンド
+		kAdd,      //!< 加算
+		kSubtract, //!< 減算
+		kMultiply, //!< 乗算
+		kScreen,   //!< スクリーン
+
+		// 利用してはいけない
+		kCountOfBlendMode,
+	};
+
+	/// <summary>
+	/// 頂点（PrimitiveDrawer::VertexPosColorと同じ並び）
+	/// </summary>
+	struct Vertex {
+		Vector3 pos;   // xyz座標
+		Vector4 color; // RGBA
+	};
+
+	/// <summary>
+	/// 頂点のチャンク
+	/// </summary>
+	struct Chunk {
+		// 頂点（kChunkVertexCount個分）
+		std::unique_ptr<Vertex[]> vertices;
+		// 使用済み頂点数
+		uint32_t vertexCount = 0;
+	};
+
+	/// <summary>
+	/// 全ての線分を捨てる（チャンクは再利用のために残す）
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 線分
+	/// </summary>
+	void AddLine(
+	    const Vector3& p1, const Vector3& p2, const Vector4& color,
+	    BlendMode blendMode = BlendMode::kNormal);
+
+	/// <summary>
+	/// 軸に沿った箱（12本）
+	/// </summary>
+	/// <param name="min">最小の角</param>
+	/// <param name="max">最大の角</param>
+	void AddAabb(
+	    const Vector3& min, const Vector3& max, const Vector4& color,
+	    BlendMode blendMode = BlendMode::kNormal);
+
+	/// <summary>
+	/// 8つの角で表した箱（12本）
+	/// </summary>
+	/// <param name="corners">手前の面(0-3)と奥の面(4-7)の角。各面で同じ回り順</param>
+	void AddBox(
+	    const Vector3 corners[8], const Vector4& color, BlendMode blendMode = BlendMode::kNormal);
+
+	/// <summary>
+	/// 球（XY、YZ、ZX平面の円3つ）
+	/// </summary>
+	/// <param name="center">中心</param>
+	/// <param name="radius">半径</param>
+	/// <param name="segmentCount">円1つの分割数</param>
+	void AddSphere(
+	    const Vector3& center, float radius, const Vector4& color,
+	    uint32_t segmentCount = kDefaultSphereSegmentCount,
+	    BlendMode blendMode = BlendMode::kNormal);
+
+	/// <summary>
+	/// 格子（origin + axisU * i + axisV * j の線を引く）
+	/// </summary>
+	/// <param name="origin">角の座標</param>
+	/// <param name="axisU">1マス分のU方向のベクトル</param>
+	/// <param name="axisV">1マス分のV方向のベクトル</param>
+	/// <param name="countU">U方向のマス数</param>
+	/// <param name="countV">V方向のマス数</param>
+	void AddGrid(
+	    const Vector3& origin, const Vector3& axisU, const Vector3& axisV, uint32_t countU,
+	    uint32_t countV, const Vector4& color, BlendMode blendMode = BlendMode::kNormal);
+
+	/// <summary>
+	/// カメラの視錐台（12本）
+	/// </summary>
+	/// <param name="matView">ビュー行列</param>
+	/// <param name="fovAngleY">垂直方向視野角</param>
+	/// <param name="aspectRatio">アスペクト比</param>
+	/// <param name="nearZ">ニアクリップ距離</param>
+	/// <param name="farZ">ファークリップ距離</param>
+	void AddFrustum(
+	    const Matrix4x4& matView, float fovAngleY, float aspectRatio, float nearZ, float farZ,
+	    const Vector4& color, BlendMode blendMode = BlendMode::kNormal);
+
+	/// <summary>
+	/// 使用中のチャンク（先頭からGetChunkCount個）
+	/// </summary>
+	const std::vector<Chunk>& GetChunks(BlendMode blendMode) const {
+		return chunks_[size_t(blendMode)];
+	}
+
+	/// <summary>
+	/// 使用中のチャンク数
+	/// </summary>
+	uint32_t GetChunkCount(BlendMode blendMode) const { return chunkCounts_[size_t(blendMode)]; }
+
+	/// <summary>
+	/// ブレンドモードの線分数
+	/// </summary>
+	uint32_t GetLineCount(BlendMode blendMode) const { return lineCounts_[size_t(blendMode)]; }
+
+	/// <summary>
+	/// 全ての線分数
+	/// </summary>
+	uint32_t GetLineCount() const;
+
+	/// <summary>
+	/// 確保済みのチャンク数（全ブレンドモード）
+	/// </summary>
+	uint32_t GetCapacityChunkCount() const;
+
+private:
+	/// <summary>
+	/// 同じチャンク内に連続した線分を確保する
+	/// </summary>
+	/// <param name="lineCount">線分数（kChunkLineCount以下）</param>
+	/// <returns>lineCount * 2個の頂点の書き込み先</returns>
+	Vertex* AllocateLines(BlendMode blendMode, uint32_t lineCount);
+
+	// チャンク
+	std::vector<Chunk> chunks_[size_t(BlendMode::kCountOfBlendMode)];
+	// 使用中のチャンク数
+	uint32_t chunkCounts_[size_t(BlendMode::kCountOfBlendMode)] = {};
+	// 線分数
+	uint32_t lineCounts_[size_t(BlendMode::kCountOfBlendMode)] = {};
+};
@@ -0,0 +1,175 @@
+#include "LightCluster.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+/// <summary>
+/// 区間[minValue, maxValue]から点までの距離の2乗
+/// </summary>
+float DistanceSquaredToRange(float value, float minValue, float maxValue) {
+	float d = 0.0f;
+	if (value < minValue) {
+		d = minValue - value;
+	} else if (value > maxValue) {
+		d = value - maxValue;
+	}
+	return d * d;
+}
+
+/// <summary>
+/// タイル境界（NDC）が深度[z0, z1]で掃く範囲をビュー空間で求める
+/// </summary>
+void SweepTile(float ndcMin, float ndcMax, float tanHalf, float z0, float z1, float& viewMin,
+               float& viewMax) {
+	viewMin = std::min(ndcMin * z0, ndcMin * z1) * tanHalf;
+	viewMax = std::max(ndcMax * z0, ndcMax * z1) * tanHalf;
+}
+
+} // namespace
+
+void LightCluster::Initialize(
+    uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount, uint32_t maxIndexCount) {
+	assert(tileCountX > 0 && tileCountY > 0 && sliceCount > 0);
+
+	tileCountX_ = tileCountX;
+	tileCountY_ = tileCountY;
+	sliceCount_ = sliceCount;
+	maxIndexCount_ = maxIndexCount;
+
+	clusters_.assign(size_t(tileCountX_) * tileCountY_ * sliceCount_, Cluster{});
+	lightIndices_.clear();
+	lightIndices_.reserve(maxIndexCount_);
+	pairs_.clear();
+	sliceDepths_.assign(sliceCount_ + 1, 0.0f);
+	statistics_ = {};
+}
+
+uint32_t LightCluster::GetSliceIndex(float viewZ) const {
+	if (viewZ <= nearZ_) {
+		return 0;
+	}
+	float slice = std::floor(std::log(viewZ) * sliceScale_ + sliceBias_);
+	return uint32_t(std::clamp(slice, 0.0f, float(sliceCount_ - 1)));
+}
+
+void LightCluster::Build(const Frustum& frustum, const PointLight* lights, uint32_t lightCount) {
+	assert(!clusters_.empty());
+	assert(frustum.nearZ > 0.0f && frustum.farZ > frustum.nearZ);
+
+	statistics_ = {};
+	statistics_.lightCount = lightCount;
+
+	// 対数間隔のスライス（奥ほど厚い）
+	nearZ_ = frustum.nearZ;
+	farZ_ = frustum.farZ;
+	float logRatio = std::log(farZ_ / nearZ_);
+	sliceScale_ = float(sliceCount_) / logRatio;
+	sliceBias_ = -float(sliceCount_) * std::log(nearZ_) / logRatio;
+	for (uint32_t s = 0; s <= sliceCount_; s++) {
+		sliceDepths_[s] = nearZ_ * std::pow(farZ_ / nearZ_, float(s) / float(sliceCount_));
+	}
+
+	float tanHalfY = std::tan(frustum.fovAngleY * 0.5f);
+	float tanHalfX = tanHalfY * frustum.aspectRatio;
+	float tileNdcWidth = 2.0f / float(tileCountX_);
+	float tileNdcHeight = 2.0f / float(tileCountY_);
+
+	// 光源ごとに掛かりうる格子の範囲を絞り、球と格子のAABBが交わるものだけ組にする
+	pairs_.clear();
+	for (uint32_t i = 0; i < lightCount; i++) {
+		Vector3 center = MultiplyMatrixVector(frustum.matView, lights[i].position);
+		float radius = lights[i].radius;
+		float radiusSquared = radius * radius;
+		if (center.z + radius <= nearZ_ || center.z - radius >= farZ_) {
+			continue;
+		}
+
+		float zMin = std::max(center.z - radius, nearZ_);
+		float zMax = std::min(center.z + radius, farZ_);
+
+		// 球を囲む箱を深度[zMin, zMax]で投影したNDCの範囲
+		float left = center.x - radius;
+		float right = center.x + radius;
+		float bottom = center.y - radius;
+		float top = center.y + radius;
+		float ndcLeft = left / ((left >= 0.0f ? zMax : zMin) * tanHalfX);
+		float ndcRight = right / ((right >= 0.0f ? zMin : zMax) * tanHalfX);
+		float ndcBottom = bottom / ((bottom >= 0.0f ? zMax : zMin) * tanHalfY);
+		float ndcTop = top / ((top >= 0.0f ? zMin : zMax) * tanHalfY);
+		if (ndcRight < -1.0f || ndcLeft > 1.0f || ndcTop < -1.0f || ndcBottom > 1.0f) {
+			continue;
+		}
+		statistics_.visibleLightCount++;
+
+		auto toTile = [](float t, uint32_t count) {
+			return uint32_t(std::clamp(std::floor(t), 0.0f, float(count - 1)));
+		};
+		uint32_t x0 = toTile((ndcLeft + 1.0f) * 0.5f * float(tileCountX_), tileCountX_);
+		uint32_t x1 = toTile((ndcRight + 1.0f) * 0.5f * float(tileCountX_), tileCountX_);
+		// タイルの行は画面の上から数える
+		uint32_t y0 = toTile((1.0f - ndcTop) * 0.5f * float(tileCountY_), tileCountY_);
+		uint32_t y1 = toTile((1.0f - ndcBottom) * 0.5f * float(tileCountY_), tileCountY_);
+		uint32_t s0 = GetSliceIndex(zMin);
+		uint32_t s1 = GetSliceIndex(zMax);
+
+		for (uint32_t s = s0; s <= s1; s++) {
+			float z0 = sliceDepths_[s];
+			float z1 = sliceDepths_[s + 1];
+			float dz = DistanceSquaredToRange(center.z, z0, z1);
+			if (dz > radiusSquared) {
+				continue;
+			}
+			for (uint32_t y = y0; y <= y1; y++) {
+				float ndcMaxY = 1.0f - float(y) * tileNdcHeight;
+				float viewMinY = 0.0f;
+				float viewMaxY = 0.0f;
+				SweepTile(ndcMaxY - tileNdcHeight, ndcMaxY, tanHalfY, z0, z1, viewMinY, viewMaxY);
+				float dzy = dz + DistanceSquaredToRange(center.y, viewMinY, viewMaxY);
+				if (dzy > radiusSquared) {
+					continue;
+				}
+				for (uint32_t x = x0; x <= x1; x++) {
+					float ndcMinX = float(x) * tileNdcWidth - 1.0f;
+					float viewMinX = 0.0f;
+					float viewMaxX = 0.0f;
+					SweepTile(ndcMinX, ndcMinX + tileNdcWidth, tanHalfX, z0, z1, viewMinX, viewMaxX);
+					if (dzy + DistanceSquaredToRange(center.x, viewMinX, viewMaxX) <= radiusSquared) {
+						pairs_.push_back({GetClusterIndex(x, y, s), i});
+					}
+				}
+			}
+		}
+	}
+
+	// 格子ごとに数えて先頭位置を決める（容量を超えた分は後ろの格子から落ちる）
+	for (Cluster& cluster : clusters_) {
+		cluster = {};
+	}
+	for (const Pair& pair : pairs_) {
+		clusters_[pair.cluster].count++;
+	}
+	uint32_t offset = 0;
+	for (Cluster& cluster : clusters_) {
+		uint32_t count = std::min(cluster.count, maxIndexCount_ - offset);
+		statistics_.droppedIndexCount += cluster.count - count;
+		statistics_.maxClusterLightCount = std::max(statistics_.maxClusterLightCount, cluster.count);
+		cluster.offset = offset;
+		cluster.count = count;
+		offset += count;
+	}
+
+	// 組はライト番号順に並んでいるので、格子ごとの一覧も昇順になる
+	lightIndices_.assign(offset, 0);
+	writeCursors_.assign(clusters_.size(), 0);
+	for (const Pair& pair : pairs_) {
+		const Cluster& cluster = clusters_[pair.cluster];
+		uint32_t& cursor = writeCursors_[pair.cluster];
+		if (cursor < cluster.count) {
+			lightIndices_[cluster.offset + cursor] = pair.light;
+			cursor++;
+		}
+	}
+	statistics_.indexCount = offset;
+}
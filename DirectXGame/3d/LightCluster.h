@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// クラスタ化ライト割り当て（ビュー空間の視錐台を格子に分け、各格子に届く点光源を列挙する）
+/// </summary>
+/// <remarks>
+/// 画面をタイルに、奥行きを対数間隔のスライスに分ける。スライス番号は
+/// floor(log(z) * sliceScale + sliceBias) で、シェーダも同じ式で求める。
+/// GPUやファイルに触れない。
+/// </remarks>
+class LightCluster {
+public:
+	// 既定の横タイル数
+	static const uint32_t kDefaultTileCountX = 16;
+	// 既定の縦タイル数
+	static const uint32_t kDefaultTileCountY = 9;
+	// 既定のスライス数
+	static const uint32_t kDefaultSliceCount = 24;
+
+	/// <summary>
+	/// 点光源（シェーダのStructuredBufferと同じ並び）
+	/// </summary>
+	struct PointLight {
+		// ワールド座標
+		Vector3 position = {0.0f, 0.0f, 0.0f};
+		// 届く距離（これより遠くは0になるように減衰させる）
+		float radius = 1.0f;
+		// 色（強さ込み）
+		Vector3 color = {1.0f, 1.0f, 1.0f};
+		float pad = 0.0f;
+	};
+
+	/// <summary>
+	/// 格子1つ分のライト一覧の範囲
+	/// </summary>
+	struct Cluster {
+		// ライト番号一覧の先頭
+		uint32_t offset = 0;
+		// ライト数
+		uint32_t count = 0;
+	};
+
+	/// <summary>
+	/// 視錐台の設定（ViewProjectionの値をそのまま渡す）
+	/// </summary>
+	struct Frustum {
+		// ビュー行列
+		Matrix4x4 matView;
+		// 垂直方向視野角
+		float fovAngleY = 0.0f;
+		// アスペクト比
+		float aspectRatio = 1.0f;
+		// 手前側の深度限界
+		float nearZ = 0.1f;
+		// 奥側の深度限界
+		float farZ = 1000.0f;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 渡されたライト数
+		uint32_t lightCount = 0;
+		// 視錐台に掛かったライト数
+		uint32_t visibleLightCount = 0;
+		// ライト番号一覧の長さ
+		uint32_t indexCount = 0;
+		// 容量不足で落としたライト番号数
+		uint32_t droppedIndexCount = 0;
+		// 1格子の最大ライト数
+		uint32_t maxClusterLightCount = 0;
+	};
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="tileCountX">横タイル数</param>
+	/// <param name="tileCountY">縦タイル数</param>
+	/// <param name="sliceCount">スライス数</param>
+	/// <param name="maxIndexCount">ライト番号一覧の最大長</param>
+	void Initialize(
+	    uint32_t tileCountX = kDefaultTileCountX, uint32_t tileCountY = kDefaultTileCountY,
+	    uint32_t sliceCount = kDefaultSliceCount, uint32_t maxIndexCount = 65536);
+
+	/// <summary>
+	/// ライトを格子に割り当てる
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="lights">点光源</param>
+	/// <param name="lightCount">点光源の数</param>
+	void Build(const Frustum& frustum, const PointLight* lights, uint32_t lightCount);
+
+	/// <summary>
+	/// 格子番号（x + y * tileCountX + slice * tileCountX * tileCountY）
+	/// </summary>
+	uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const {
+		return x + (y + slice * tileCountY_) * tileCountX_;
+	}
+
+	/// <summary>
+	/// ビュー空間の深度からスライス番号を求める（範囲外は端に寄せる）
+	/// </summary>
+	uint32_t GetSliceIndex(float viewZ) const;
+
+	uint32_t GetTileCountX() const { return tileCountX_; }
+	uint32_t GetTileCountY() const { return tileCountY_; }
+	uint32_t GetSliceCount() const { return sliceCount_; }
+	uint32_t GetClusterCount() const { return uint32_t(clusters_.size()); }
+	float GetSliceScale() const { return sliceScale_; }
+	float GetSliceBias() const { return sliceBias_; }
+
+	/// <summary>
+	/// 格子ごとのライト一覧の範囲（Build後に有効）
+	/// </summary>
+	const std::vector<Cluster>& GetClusters() const { return clusters_; }
+
+	/// <summary>
+	/// ライト番号一覧（Build後に有効。格子ごとに昇順）
+	/// </summary>
+	const std::vector<uint32_t>& GetLightIndices() const { return lightIndices_; }
+
+	/// <summary>
+	/// 直前のBuildの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	/// <summary>
+	/// 格子とライトの組
+	/// </summary>
+	struct Pair {
+		uint32_t cluster;
+		uint32_t light;
+	};
+
+	// 横タイル数
+	uint32_t tileCountX_ = 0;
+	// 縦タイル数
+	uint32_t tileCountY_ = 0;
+	// スライス数
+	uint32_t sliceCount_ = 0;
+	// ライト番号一覧の最大長
+	uint32_t maxIndexCount_ = 0;
+	// スライス番号を求める係数
+	float sliceScale_ = 0.0f;
+	float sliceBias_ = 0.0f;
+	// 手前側と奥側の深度限界
+	float nearZ_ = 0.0f;
+	float farZ_ = 0.0f;
+
+	// 格子ごとのライト一覧の範囲
+	std::vector<Cluster> clusters_;
+	// ライト番号一覧
+	std::vector<uint32_t> lightIndices_;
+	// 格子とライトの組（作業用）
+	std::vector<Pair> pairs_;
+	// 格子ごとの書き込み位置（作業用）
+	std::vector<uint32_t> writeCursors_;
+	// スライスの境界の深度（sliceCount + 1個）
+	std::vector<float> sliceDepths_;
+	// 統計情報
+	Statistics statistics_;
+};
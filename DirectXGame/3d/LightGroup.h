@@ -70,6 +70,11 @@ public: // メンバ関数
 	/// </summary>
 	void Draw(ID3D12GraphicsCommandList* cmdList, UINT rootParameterIndex) const;
 
+	/// <summary>
+	/// 定数バッファの取得
+	/// </summary>
+	ID3D12Resource* GetConstBuffer() const { return constBuff_.Get(); }
+
 	/// <summary>
 	/// 定数バッファ転送
 	/// </summary>
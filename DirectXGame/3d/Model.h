@@ -53,6 +53,9 @@ public:
 	/// </summary>
 	ID3D12GraphicsCommandList* GetCommandList() const { return commandList_; }
 	ObjectColor* GetObjectColor() const { return defaultObjectColor_.get(); }
+	ID3D12RootSignature* GetRootSignature() const { return rootSignature_.Get(); }
+	ID3D12PipelineState* GetPipelineState() const { return pipelineState_.Get(); }
+	const LightGroup* GetDefaultLightGroup() const { return defaultLightGroup_.get(); }
 
 private:
 	ModelCommon() = default;
@@ -189,6 +192,12 @@ public: // メンバ関数
 	/// <param name="lightGroup">ライトグループ</param>
 	void SetLightGroup(const LightGroup* lightGroup) { lightGroup_ = lightGroup; }
 
+	/// <summary>
+	/// ライトグループを取得する
+	/// </summary>
+	/// <returns>ライトグループ。未設定ならnullptr</returns>
+	const LightGroup* GetLightGroup() const { return lightGroup_; }
+
 private: // メンバ変数
 	// 名前
 	std::string name_;
@@ -0,0 +1,170 @@
+#include "ModelRenderQueue.h"
+#include "ClusteredLighting.h"
+#include "DirectXCommon.h"
+#include <cassert>
+
+ModelRenderQueue* ModelRenderQueue::GetInstance() {
+	static ModelRenderQueue instance;
+	return &instance;
+}
+
+void ModelRenderQueue::BeginFrame() {
+	lastStatistics_ = queue_.GetStatistics();
+	queue_.ResetStatistics();
+	materialIds_.clear();
+}
+
+void ModelRenderQueue::Begin(ID3D12GraphicsCommandList* commandList) {
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	assert(commandList == dxCommon->GetCommandList());
+	(void)commandList;
+	Begin(dxCommon->GetRenderCommandList());
+}
+
+void ModelRenderQueue::Begin(RenderCommandList* commandList) {
+	assert(commandList_ == nullptr);
+	commandList_ = commandList;
+	queue_.Clear();
+}
+
+void ModelRenderQueue::End() {
+	assert(commandList_);
+	queue_.Flush(commandList_);
+	commandList_ = nullptr;
+}
+
+void ModelRenderQueue::Draw(
+    Model& model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    const ObjectColor* objectColor) {
+	PushModel(
+	    model, worldTransform.matWorld_, worldTransform.GetConstBuffer()->GetGPUVirtualAddress(),
+	    viewProjection, RenderQueue::kNoTexture, objectColor);
+}
+
+void ModelRenderQueue::Draw(
+    Model& model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    uint32_t textureHandle, const ObjectColor* objectColor) {
+	PushModel(
+	    model, worldTransform.matWorld_, worldTransform.GetConstBuffer()->GetGPUVirtualAddress(),
+	    viewProjection, textureHandle, objectColor);
+}
+
+void ModelRenderQueue::Draw(
+    Model& model, const TransformHierarchy& hierarchy, const TransformBuffer& transformBuffer,
+    uint32_t index, const ViewProjection& viewProjection, const ObjectColor* objectColor) {
+	PushModel(
+	    model, hierarchy.GetWorldMatrix(index), transformBuffer.GetGPUVirtualAddress(index),
+	    viewProjection, RenderQueue::kNoTexture, objectColor);
+}
+
+void ModelRenderQueue::DrawMesh(
+    const MeshView& mesh, const Material& material, const WorldTransform& worldTransform,
+    const ViewProjection& viewProjection, uint32_t textureHandle, const ObjectColor* objectColor) {
+	assert(commandList_);
+
+	uint32_t pipelineId = 0;
+	float depth = 0.0f;
+	RenderQueue::Packet packet = MakePacket(
+	    ModelCommon::GetInstance()->GetDefaultLightGroup(), worldTransform.matWorld_,
+	    worldTransform.GetConstBuffer()->GetGPUVirtualAddress(), viewProjection, objectColor,
+	    pipelineId, depth);
+	PushMesh(packet, pipelineId, depth, mesh, &material, textureHandle);
+}
+
+void ModelRenderQueue::PushModel(
+    Model& model, const Matrix4x4& matWorld, D3D12_GPU_VIRTUAL_ADDRESS worldTransformAddress,
+    const ViewProjection& viewProjection, uint32_t textureHandle,
+    const ObjectColor* objectColor) {
+	assert(commandList_);
+
+	const LightGroup* lightGroup = model.GetLightGroup();
+	if (!lightGroup) {
+		lightGroup = ModelCommon::GetInstance()->GetDefaultLightGroup();
+	}
+	uint32_t pipelineId = 0;
+	float depth = 0.0f;
+	RenderQueue::Packet packet = MakePacket(
+	    lightGroup, matWorld, worldTransformAddress, viewProjection, objectColor, pipelineId,
+	    depth);
+
+	for (const std::unique_ptr<Mesh>& mesh : model.GetMeshes()) {
+		const D3D12_VERTEX_BUFFER_VIEW& vbView = mesh->GetVBView();
+		const D3D12_INDEX_BUFFER_VIEW& ibView = mesh->GetIBView();
+		MeshView view;
+		view.vertexBuffer.gpuAddress = vbView.BufferLocation;
+		view.vertexBuffer.sizeInBytes = vbView.SizeInBytes;
+		view.vertexBuffer.strideInBytes = vbView.StrideInBytes;
+		view.indexBuffer.gpuAddress = ibView.BufferLocation;
+		view.indexBuffer.sizeInBytes = ibView.SizeInBytes;
+		view.indexBuffer.is32Bit = ibView.Format == DXGI_FORMAT_R32_UINT;
+		view.indexCount = uint32_t(mesh->GetIndices().size());
+		PushMesh(packet, pipelineId, depth, view, mesh->GetMaterial(), textureHandle);
+	}
+}
+
+RenderQueue::Packet ModelRenderQueue::MakePacket(
+    const LightGroup* lightGroup, const Matrix4x4& matWorld,
+    D3D12_GPU_VIRTUAL_ADDRESS worldTransformAddress, const ViewProjection& viewProjection,
+    const ObjectColor* objectColor, uint32_t& pipelineId, float& depth) {
+	ModelCommon* modelCommon = ModelCommon::GetInstance();
+	if (!objectColor) {
+		objectColor = modelCommon->GetObjectColor();
+	}
+
+	// 手前から奥へ描くための深度（ワールド座標の原点をビュー空間へ）
+	Vector3 position = {matWorld.m[3][0], matWorld.m[3][1], matWorld.m[3][2]};
+	depth = MultiplyMatrixVector(viewProjection.matView, position).z;
+
+	// メッシュごとに変わらない部分
+	RenderQueue::Packet packet;
+	packet.rootSignature = modelCommon->GetRootSignature();
+	packet.pipelineState = modelCommon->GetPipelineState();
+	packet.topology = RenderCommandList::PrimitiveTopology::kTriangleList;
+	packet.constantBuffers[uint32_t(Model::RoomParameter::kWorldTransform)] =
+	    worldTransformAddress;
+	packet.constantBuffers[uint32_t(Model::RoomParameter::kViewProjection)] =
+	    viewProjection.GetConstBuffer()->GetGPUVirtualAddress();
+	packet.constantBuffers[uint32_t(Model::RoomParameter::kLight)] =
+	    lightGroup->GetConstBuffer()->GetGPUVirtualAddress();
+	packet.constantBuffers[uint32_t(Model::RoomParameter::kObjectColor)] =
+	    objectColor->GetConstBuffer()->GetGPUVirtualAddress();
+	packet.textureRootParameterIndex = uint32_t(Model::RoomParameter::kTexture);
+
+	// 点光源の割り当てがあるフレームはクラスタ化ライティングのパイプラインで描く
+	pipelineId = 0;
+	ClusteredLighting* clusteredLighting = ClusteredLighting::GetInstance();
+	if (clusteredLighting->IsReady()) {
+		clusteredLighting->SetRootParameters(packet);
+		pipelineId = 1;
+	}
+	return packet;
+}
+
+void ModelRenderQueue::PushMesh(
+    RenderQueue::Packet& packet, uint32_t pipelineId, float depth, const MeshView& mesh,
+    const Material* material, uint32_t textureHandle) {
+	assert(material);
+
+	packet.vertexBuffer = mesh.vertexBuffer;
+	packet.indexBuffer = mesh.indexBuffer;
+	packet.indexCount = mesh.indexCount;
+
+	packet.constantBuffers[uint32_t(Model::RoomParameter::kMaterial)] =
+	    material->GetConstantBuffer()->GetGPUVirtualAddress();
+	packet.textureHandle =
+	    textureHandle != RenderQueue::kNoTexture ? textureHandle : material->GetTextureHadle();
+
+	packet.sortKey = RenderQueue::MakeSortKey(
+	    pipelineId, packet.textureHandle, GetMaterialId(material), depth);
+	queue_.Push(packet);
+}
+
+uint32_t ModelRenderQueue::GetMaterialId(const Material* material) {
+	auto it = materialIds_.find(material);
+	if (it != materialIds_.end()) {
+		return it->second;
+	}
+	uint32_t id = uint32_t(materialIds_.size());
+	materialIds_.emplace(material, id);
+	return id;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Model.h"
+#include "RenderQueue.h"
+#include "TransformBuffer.h"
+#include "TransformHierarchy.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <unordered_map>
+
+/// <summary>
+/// モデル描画キュー（Model::Drawの代わりに要求を溜めて、並べ替えてからまとめて描画する）
+/// </summary>
+/// <remarks>
+/// Model::Drawと同じルートパラメータ、同じ順序のコマンドをRenderCommandList経由で積む。
+/// ライブラリ内部で積まれるコマンドには手を出せないので、並べ替えるのはこのキューに積んだ分だけ。
+/// </remarks>
+class ModelRenderQueue {
+public:
+	using Statistics = RenderQueue::Statistics;
+
+	/// <summary>
+	/// Model以外のメッシュ（頂点はMesh::VertexPosNormalUvと同じ並び）
+	/// </summary>
+	struct MeshView {
+		// 頂点バッファ
+		RenderCommandList::VertexBufferView vertexBuffer;
+		// インデックスバッファ
+		RenderCommandList::IndexBufferView indexBuffer;
+		// インデックス数
+		uint32_t indexCount = 0;
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static ModelRenderQueue* GetInstance();
+
+	/// <summary>
+	/// フレーム開始（統計情報とマテリアル番号をリセット）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 描画前処理（Model::PreDrawの後に呼ぶ）
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト（DirectXCommonのもの）</param>
+	void Begin(ID3D12GraphicsCommandList* commandList);
+
+	/// <summary>
+	/// 描画前処理（Model::PreDrawの後に呼ぶ）
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト</param>
+	void Begin(RenderCommandList* commandList);
+
+	/// <summary>
+	/// 描画後処理（溜めた要求を並べ替えて描画する。Model::PostDrawの前に呼ぶ）
+	/// </summary>
+	void End();
+
+	/// <summary>
+	/// 描画要求を積む
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void Draw(
+	    Model& model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// 描画要求を積む（テクスチャ差し替え）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void Draw(
+	    Model& model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHandle, const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// 描画要求を積む（トランスフォーム階層のノード。行列はTransformBufferのものを使う）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="hierarchy">トランスフォーム階層（Update済み）</param>
+	/// <param name="transformBuffer">このフレームの分をUpload済みの定数バッファ</param>
+	/// <param name="index">ノード番号</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void Draw(
+	    Model& model, const TransformHierarchy& hierarchy, const TransformBuffer& transformBuffer,
+	    uint32_t index, const ViewProjection& viewProjection,
+	    const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// 描画要求を積む（Model以外のメッシュ。ライトは既定のLightGroup）
+	/// </summary>
+	/// <param name="mesh">メッシュ</param>
+	/// <param name="material">マテリアル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHandle">テクスチャハンドル。RenderQueue::kNoTextureならマテリアルのもの</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void DrawMesh(
+	    const MeshView& mesh, const Material& material, const WorldTransform& worldTransform,
+	    const ViewProjection& viewProjection, uint32_t textureHandle = RenderQueue::kNoTexture,
+	    const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// 直前のフレームの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return lastStatistics_; }
+
+private:
+	ModelRenderQueue() = default;
+	~ModelRenderQueue() = default;
+	ModelRenderQueue(const ModelRenderQueue&) = delete;
+	ModelRenderQueue& operator=(const ModelRenderQueue&) = delete;
+
+	/// <summary>
+	/// メッシュごとに描画要求を積む
+	/// </summary>
+	/// <param name="textureHandle">差し替えるテクスチャ。RenderQueue::kNoTextureならマテリアルのもの</param>
+	/// <param name="matWorld">ワールド行列（ソートキー用）</param>
+	/// <param name="worldTransformAddress">ワールド行列の定数バッファのGPUアドレス</param>
+	void PushModel(
+	    Model& model, const Matrix4x4& matWorld, D3D12_GPU_VIRTUAL_ADDRESS worldTransformAddress,
+	    const ViewProjection& viewProjection, uint32_t textureHandle,
+	    const ObjectColor* objectColor);
+
+	/// <summary>
+	/// メッシュごとに変わらない部分の描画要求を作る
+	/// </summary>
+	/// <param name="pipelineId">ソートキー用のパイプライン番号</param>
+	/// <param name="depth">ソートキー用の深度</param>
+	RenderQueue::Packet MakePacket(
+	    const LightGroup* lightGroup, const Matrix4x4& matWorld,
+	    D3D12_GPU_VIRTUAL_ADDRESS worldTransformAddress, const ViewProjection& viewProjection,
+	    const ObjectColor* objectColor, uint32_t& pipelineId, float& depth);
+
+	/// <summary>
+	/// メッシュ1つ分の描画要求を積む
+	/// </summary>
+	void PushMesh(
+	    RenderQueue::Packet& packet, uint32_t pipelineId, float depth, const MeshView& mesh,
+	    const Material* material, uint32_t textureHandle);
+
+	/// <summary>
+	/// ソートキー用のマテリアル番号の取得（フレーム内で最初に現れた順に振る）
+	/// </summary>
+	uint32_t GetMaterialId(const Material* material);
+
+	// コマンドリスト
+	RenderCommandList* commandList_ = nullptr;
+	// 描画キュー
+	RenderQueue queue_;
+	// マテリアル番号
+	std::unordered_map<const Material*, uint32_t> materialIds_;
+	// 直前のフレームの統計情報
+	Statistics lastStatistics_;
+};
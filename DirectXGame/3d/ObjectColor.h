@@ -32,6 +32,7 @@ public:
 	/// アクセッサ
 	/// </summary>
 	void SetColor(const Vector4& color) { color_ = color; }
+	ID3D12Resource* GetConstBuffer() const { return constBuffer_.Get(); }
 
 private:
 	Vector4 color_ = {1, 1, 1, 1};
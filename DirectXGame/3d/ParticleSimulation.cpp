@@ -0,0 +1,235 @@
+#include "ParticleSimulation.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PARTICLE_SIMULATION_USE_SSE
+#endif
+
+namespace {
+
+// SIMD幅
+const uint32_t kSimdWidth = 4;
+// 積分を1ジョブで受け持つ数（SIMD幅の倍数）
+const uint32_t kIntegrateGrainSize = 4096;
+static_assert(kIntegrateGrainSize % kSimdWidth == 0);
+
+} // namespace
+
+void ParticleSimulation::Initialize(uint32_t maxParticles, uint32_t maxEmitters) {
+	assert(maxParticles > 0);
+
+	// SIMDで端数を気にせず回せるように切り上げておく
+	capacity_ = (maxParticles + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+	aliveCount_ = 0;
+
+	for (std::vector<float>* stream :
+	     {&positionX_, &positionY_, &positionZ_, &velocityX_, &velocityY_, &velocityZ_, &life_,
+	      &inverseLifetime_, &size_, &colorR_, &colorG_, &colorB_, &colorA_}) {
+		stream->assign(capacity_, 0.0f);
+	}
+
+	emitters_.assign(maxEmitters, Emitter{});
+	freeEmitters_.clear();
+	for (uint32_t i = maxEmitters; i > 0; i--) {
+		freeEmitters_.push_back(i - 1);
+	}
+
+	randomEngine_.seed(std::random_device()());
+}
+
+void ParticleSimulation::Emit(const EmitterDesc& desc, uint32_t count) {
+	count = std::min(count, capacity_ - aliveCount_);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	for (uint32_t k = 0; k < count; k++) {
+		// 放出方向
+		Vector3 direction;
+		if (desc.shape == Shape::kRingZ) {
+			float angle = 2.0f * std::numbers::pi_v<float> * float(k) / float(count);
+			direction = {std::cos(angle), std::sin(angle), 0.0f};
+		} else {
+			float z = distribution(randomEngine_);
+			float angle = std::numbers::pi_v<float> * distribution(randomEngine_);
+			float r = std::sqrt(1.0f - z * z);
+			direction = {r * std::cos(angle), r * std::sin(angle), z};
+		}
+		Spawn(desc, direction);
+	}
+
+	statistics_.emittedCount += count;
+}
+
+void ParticleSimulation::Emit(const EmitterDesc& desc, const Vector3* directions, uint32_t count) {
+	count = std::min(count, capacity_ - aliveCount_);
+	for (uint32_t k = 0; k < count; k++) {
+		Spawn(desc, directions[k]);
+	}
+
+	statistics_.emittedCount += count;
+}
+
+void ParticleSimulation::Spawn(const EmitterDesc& desc, const Vector3& direction) {
+	uint32_t i = aliveCount_++;
+	positionX_[i] = desc.position.x;
+	positionY_[i] = desc.position.y;
+	positionZ_[i] = desc.position.z;
+	velocityX_[i] = direction.x * desc.speed;
+	velocityY_[i] = direction.y * desc.speed;
+	velocityZ_[i] = direction.z * desc.speed;
+	life_[i] = desc.lifetime;
+	inverseLifetime_[i] = 1.0f / desc.lifetime;
+	size_[i] = desc.size;
+	colorR_[i] = desc.color.x;
+	colorG_[i] = desc.color.y;
+	colorB_[i] = desc.color.z;
+	colorA_[i] = desc.color.w;
+}
+
+uint32_t ParticleSimulation::CreateEmitter(const EmitterDesc& desc) {
+	if (freeEmitters_.empty()) {
+		return kInvalidEmitter;
+	}
+
+	uint32_t emitter = freeEmitters_.back();
+	freeEmitters_.pop_back();
+	emitters_[emitter] = {desc, 0.0f, 0.0f, true};
+	return emitter;
+}
+
+void ParticleSimulation::DestroyEmitter(uint32_t emitter) {
+	assert(emitter < emitters_.size());
+	if (!emitters_[emitter].isActive) {
+		return;
+	}
+	emitters_[emitter].isActive = false;
+	freeEmitters_.push_back(emitter);
+}
+
+void ParticleSimulation::SetEmitterPosition(uint32_t emitter, const Vector3& position) {
+	assert(emitter < emitters_.size());
+	emitters_[emitter].desc.position = position;
+}
+
+void ParticleSimulation::Clear() {
+	aliveCount_ = 0;
+	for (uint32_t i = 0; i < emitters_.size(); i++) {
+		DestroyEmitter(i);
+	}
+	statistics_ = {};
+}
+
+void ParticleSimulation::Update(float deltaTime) {
+	auto start = std::chrono::steady_clock::now();
+	statistics_.emittedCount = 0;
+	statistics_.killedCount = 0;
+
+	// エミッタからの放出
+	for (uint32_t i = 0; i < emitters_.size(); i++) {
+		Emitter& emitter = emitters_[i];
+		if (!emitter.isActive) {
+			continue;
+		}
+		emitter.elapsed += deltaTime;
+		emitter.accumulator += emitter.desc.rate * deltaTime;
+		uint32_t count = uint32_t(emitter.accumulator);
+		emitter.accumulator -= float(count);
+		Emit(emitter.desc, count);
+
+		// 時間切れで自動的にプールへ返す
+		if (emitter.desc.duration > 0.0f && emitter.elapsed >= emitter.desc.duration) {
+			DestroyEmitter(i);
+		}
+	}
+
+	Integrate(deltaTime);
+	Compact();
+
+	statistics_.aliveCount = aliveCount_;
+	statistics_.updateMilliseconds =
+	    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ParticleSimulation::Integrate(float deltaTime) {
+	// 容量はSIMD幅の倍数なので、生存数を切り上げた所まで回して良い
+	uint32_t count = (aliveCount_ + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+
+#ifdef PARTICLE_SIMULATION_USE_SSE
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 accelerationX = _mm_set1_ps(acceleration_.x * deltaTime);
+	const __m128 accelerationY = _mm_set1_ps(acceleration_.y * deltaTime);
+	const __m128 accelerationZ = _mm_set1_ps(acceleration_.z * deltaTime);
+
+	auto integrateRange = [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i += kSimdWidth) {
+			__m128 velocityX = _mm_add_ps(_mm_loadu_ps(&velocityX_[i]), accelerationX);
+			__m128 velocityY = _mm_add_ps(_mm_loadu_ps(&velocityY_[i]), accelerationY);
+			__m128 velocityZ = _mm_add_ps(_mm_loadu_ps(&velocityZ_[i]), accelerationZ);
+			_mm_storeu_ps(&velocityX_[i], velocityX);
+			_mm_storeu_ps(&velocityY_[i], velocityY);
+			_mm_storeu_ps(&velocityZ_[i], velocityZ);
+
+			_mm_storeu_ps(
+			    &positionX_[i],
+			    _mm_add_ps(_mm_loadu_ps(&positionX_[i]), _mm_mul_ps(velocityX, dt)));
+			_mm_storeu_ps(
+			    &positionY_[i],
+			    _mm_add_ps(_mm_loadu_ps(&positionY_[i]), _mm_mul_ps(velocityY, dt)));
+			_mm_storeu_ps(
+			    &positionZ_[i],
+			    _mm_add_ps(_mm_loadu_ps(&positionZ_[i]), _mm_mul_ps(velocityZ, dt)));
+
+			_mm_storeu_ps(&life_[i], _mm_sub_ps(_mm_loadu_ps(&life_[i]), dt));
+		}
+	};
+#else
+	auto integrateRange = [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++) {
+			velocityX_[i] += acceleration_.x * deltaTime;
+			velocityY_[i] += acceleration_.y * deltaTime;
+			velocityZ_[i] += acceleration_.z * deltaTime;
+			positionX_[i] += velocityX_[i] * deltaTime;
+			positionY_[i] += velocityY_[i] * deltaTime;
+			positionZ_[i] += velocityZ_[i] * deltaTime;
+			life_[i] -= deltaTime;
+		}
+	};
+#endif
+
+	// 要素ごとに独立なので、SIMD幅の倍数のかたまりでジョブへ分ける
+	JobSystem::GetInstance()->ParallelFor(count, kIntegrateGrainSize, integrateRange);
+}
+
+void ParticleSimulation::Compact() {
+	for (uint32_t i = 0; i < aliveCount_;) {
+		if (life_[i] > 0.0f) {
+			i++;
+			continue;
+		}
+
+		// 末尾の生存分で埋める（順序は保たない）
+		uint32_t last = --aliveCount_;
+		for (std::vector<float>* stream :
+		     {&positionX_, &positionY_, &positionZ_, &velocityX_, &velocityY_, &velocityZ_,
+		      &life_, &inverseLifetime_, &size_, &colorR_, &colorG_, &colorB_, &colorA_}) {
+			(*stream)[i] = (*stream)[last];
+		}
+		statistics_.killedCount++;
+	}
+}
+
+void ParticleSimulation::WriteInstances(Instance* instances) const {
+	for (uint32_t i = 0; i < aliveCount_; i++) {
+		Instance& instance = instances[i];
+		instance.position = {positionX_[i], positionY_[i], positionZ_[i]};
+		instance.size = size_[i];
+		// 寿命に合わせてフェードアウト
+		float fade = std::clamp(life_[i] * inverseLifetime_[i], 0.0f, 1.0f);
+		instance.color = {colorR_[i], colorG_[i], colorB_[i], colorA_[i] * fade};
+	}
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/// <summary>
+/// パーティクルの更新（SoA配置、SIMD更新）。GPUに触れないので単体でテストや計測ができる
+/// </summary>
+class ParticleSimulation {
+public:
+	// 無効なエミッタ
+	static constexpr uint32_t kInvalidEmitter = UINT32_MAX;
+
+	/// <summary>
+	/// 放出形状
+	/// </summary>
+	enum class Shape {
+		kRingZ,  //!< XY平面上に等間隔
+		kSphere, //!< 全方向ランダム
+	};
+
+	/// <summary>
+	/// 放出設定
+	/// </summary>
+	struct EmitterDesc {
+		// 放出位置
+		Vector3 position = {0.0f, 0.0f, 0.0f};
+		// 放出形状
+		Shape shape = Shape::kSphere;
+		// 初速[単位/秒]
+		float speed = 1.0f;
+		// 寿命[秒]
+		float lifetime = 1.0f;
+		// 大きさ（半径）
+		float size = 0.25f;
+		// 色
+		Vector4 color = {1, 1, 1, 1};
+		// 毎秒の放出数（エミッタのみ）
+		float rate = 0.0f;
+		// 放出を続ける時間[秒]。0以下なら破棄するまで続ける（エミッタのみ）
+		float duration = 0.0f;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 生存数
+		uint32_t aliveCount = 0;
+		// 直前の更新で生まれた数
+		uint32_t emittedCount = 0;
+		// 直前の更新で消えた数
+		uint32_t killedCount = 0;
+		// 直前の更新に掛かった時間[ms]
+		double updateMilliseconds = 0.0;
+
+		/// <summary>
+		/// 1ミリ秒あたりに更新したパーティクル数
+		/// </summary>
+		double GetParticlesPerMillisecond() const {
+			return updateMilliseconds > 0.0 ? double(aliveCount) / updateMilliseconds : 0.0;
+		}
+	};
+
+	/// <summary>
+	/// 描画に渡す1インスタンス分のデータ（シェーダーの構造化バッファと同じ並び）
+	/// </summary>
+	struct Instance {
+		Vector3 position;
+		float size;
+		Vector4 color;
+	};
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="maxParticles">最大パーティクル数</param>
+	/// <param name="maxEmitters">最大エミッタ数</param>
+	void Initialize(uint32_t maxParticles, uint32_t maxEmitters = 16);
+
+	/// <summary>
+	/// 一度にまとめて放出する
+	/// </summary>
+	/// <param name="desc">放出設定</param>
+	/// <param name="count">放出数</param>
+	void Emit(const EmitterDesc& desc, uint32_t count);
+
+	/// <summary>
+	/// 各粒の方向を指定してまとめて放出する（desc.shapeは使わない）
+	/// </summary>
+	/// <param name="desc">放出設定</param>
+	/// <param name="directions">各粒の方向（単位ベクトル）</param>
+	/// <param name="count">放出数</param>
+	void Emit(const EmitterDesc& desc, const Vector3* directions, uint32_t count);
+
+	/// <summary>
+	/// エミッタをプールから確保する
+	/// </summary>
+	/// <param name="desc">放出設定</param>
+	/// <returns>エミッタ番号。空きが無ければkInvalidEmitter</returns>
+	uint32_t CreateEmitter(const EmitterDesc& desc);
+
+	/// <summary>
+	/// エミッタをプールに返す
+	/// </summary>
+	/// <param name="emitter">エミッタ番号</param>
+	void DestroyEmitter(uint32_t emitter);
+
+	/// <summary>
+	/// エミッタの位置を変更する
+	/// </summary>
+	/// <param name="emitter">エミッタ番号</param>
+	/// <param name="position">放出位置</param>
+	void SetEmitterPosition(uint32_t emitter, const Vector3& position);
+
+	/// <summary>
+	/// 全パーティクルとエミッタの破棄
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 更新
+	/// </summary>
+	/// <param name="deltaTime">経過時間[秒]</param>
+	void Update(float deltaTime);
+
+	/// <summary>
+	/// 生存している全パーティクルのインスタンスデータを書き出す（寿命に合わせてαを下げる）
+	/// </summary>
+	/// <param name="instances">書き込み先（生存数分）</param>
+	void WriteInstances(Instance* instances) const;
+
+	/// <summary>
+	/// 全パーティクルに掛かる加速度の設定
+	/// </summary>
+	/// <param name="acceleration">加速度</param>
+	void SetAcceleration(const Vector3& acceleration) { acceleration_ = acceleration; }
+
+	/// <summary>
+	/// 最大数の取得（未初期化なら0）
+	/// </summary>
+	uint32_t GetCapacity() const { return capacity_; }
+
+	/// <summary>
+	/// 生存数の取得
+	/// </summary>
+	uint32_t GetAliveCount() const { return aliveCount_; }
+
+	/// <summary>
+	/// 統計情報の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+protected:
+	/// <summary>
+	/// エミッタ
+	/// </summary>
+	struct Emitter {
+		EmitterDesc desc;
+		// 経過時間[秒]
+		float elapsed = 0.0f;
+		// 放出数の端数
+		float accumulator = 0.0f;
+		// 使用中
+		bool isActive = false;
+	};
+
+	/// <summary>
+	/// 1粒を末尾に追加する（空きがあること）
+	/// </summary>
+	/// <param name="desc">放出設定</param>
+	/// <param name="direction">方向</param>
+	void Spawn(const EmitterDesc& desc, const Vector3& direction);
+
+	/// <summary>
+	/// 位置、速度、寿命をまとめて進める
+	/// </summary>
+	/// <param name="deltaTime">経過時間[秒]</param>
+	void Integrate(float deltaTime);
+
+	/// <summary>
+	/// 寿命が尽きたものを末尾と入れ替えて詰める
+	/// </summary>
+	void Compact();
+
+	// 位置
+	std::vector<float> positionX_;
+	std::vector<float> positionY_;
+	std::vector<float> positionZ_;
+	// 速度
+	std::vector<float> velocityX_;
+	std::vector<float> velocityY_;
+	std::vector<float> velocityZ_;
+	// 残り寿命[秒]
+	std::vector<float> life_;
+	// 寿命の逆数（フェード用）
+	std::vector<float> inverseLifetime_;
+	// 大きさ
+	std::vector<float> size_;
+	// 色
+	std::vector<float> colorR_;
+	std::vector<float> colorG_;
+	std::vector<float> colorB_;
+	std::vector<float> colorA_;
+	// 最大数（SIMD幅に切り上げ済み）
+	uint32_t capacity_ = 0;
+	// 生存数（先頭から詰めて並ぶ）
+	uint32_t aliveCount_ = 0;
+	// 全体に掛かる加速度
+	Vector3 acceleration_ = {0.0f, 0.0f, 0.0f};
+
+	// エミッタプール
+	std::vector<Emitter> emitters_;
+	// 空きエミッタ番号
+	std::vector<uint32_t> freeEmitters_;
+
+	// 乱数
+	std::mt19937 randomEngine_;
+
+	// 統計情報
+	Statistics statistics_;
+};
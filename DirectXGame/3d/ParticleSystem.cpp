@@ -0,0 +1,137 @@
+#include "ParticleSystem.h"
+#include "DirectXCommon.h"
+#include "ShaderUtility.h"
+#include <cassert>
+#include <d3dx12.h>
+
+using namespace Microsoft::WRL;
+
+ID3D12Device* ParticleSystem::sDevice_ = nullptr;
+RenderCommandList* ParticleSystem::sCommandList_ = nullptr;
+ComPtr<ID3D12RootSignature> ParticleSystem::sRootSignature_;
+ComPtr<ID3D12PipelineState> ParticleSystem::sPipelineState_;
+
+void ParticleSystem::StaticInitialize(ID3D12Device* device, const std::wstring& directoryPath) {
+	assert(device);
+
+	HRESULT result = S_FALSE;
+	sDevice_ = device;
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(directoryPath + L"shaders/ParticleVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(directoryPath + L"shaders/ParticlePS.hlsl", "ps_5_0");
+
+	// ルートパラメータ（ビュープロジェクション、インスタンス配列）
+	CD3DX12_ROOT_PARAMETER rootparams[2];
+	rootparams[0].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[1].InitAsShaderResourceView(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+
+	// 頂点は頂点番号から作るので入力レイアウトなし
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = sDevice_->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&sRootSignature_));
+	assert(SUCCEEDED(result));
+
+	// グラフィックスパイプライン
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	// 深度テストはするが、半透明なので書き込まない
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	gpipeline.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+
+	// 通常αブレンド
+	D3D12_RENDER_TARGET_BLEND_DESC& blenddesc = gpipeline.BlendState.RenderTarget[0];
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	gpipeline.SampleDesc.Count = 1;
+	gpipeline.pRootSignature = sRootSignature_.Get();
+
+	result = sDevice_->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&sPipelineState_));
+	assert(SUCCEEDED(result));
+}
+
+void ParticleSystem::PreDraw(ID3D12GraphicsCommandList* commandList) {
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	assert(commandList == dxCommon->GetCommandList());
+	(void)commandList;
+	PreDraw(dxCommon->GetRenderCommandList());
+}
+
+void ParticleSystem::PreDraw(RenderCommandList* commandList) {
+	// PreDrawとPostDrawがペアで呼ばれていなければエラー
+	assert(ParticleSystem::sCommandList_ == nullptr);
+
+	sCommandList_ = commandList;
+
+	sCommandList_->SetPipelineState(sPipelineState_.Get());
+	sCommandList_->SetRootSignature(sRootSignature_.Get());
+	sCommandList_->SetPrimitiveTopology(RenderCommandList::PrimitiveTopology::kTriangleStrip);
+}
+
+void ParticleSystem::PostDraw() { sCommandList_ = nullptr; }
+
+void ParticleSystem::Initialize(uint32_t maxParticles, uint32_t maxEmitters) {
+	assert(sDevice_);
+	ParticleSimulation::Initialize(maxParticles, maxEmitters);
+
+	// 全数を描けるだけの領域をフレーム数分確保する（共有の定数バッファアロケータは容量が足りない）
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	frameCount_ = dxCommon->GetFrameCount();
+	instanceCountPerFrame_ = capacity_;
+	instanceBuffer_ = dxCommon->GetRenderDevice()->CreateUploadBuffer(
+	    uint64_t(sizeof(Instance)) * instanceCountPerFrame_ * frameCount_);
+	assert(instanceBuffer_.cpuAddress);
+	lastDrawFenceValue_ = 0;
+}
+
+void ParticleSystem::Draw(const ViewProjection& viewProjection) {
+	assert(sCommandList_);
+	if (aliveCount_ == 0) {
+		return;
+	}
+
+	// 領域はフレームごとに1つなので、同じフレームに2回描くと1回目の内容を上書きしてしまう
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	uint64_t fenceValue = dxCommon->GetNextFenceValue();
+	assert(fenceValue != lastDrawFenceValue_ && "ParticleSystem::Draw called twice in a frame");
+	if (fenceValue == lastDrawFenceValue_) {
+		droppedDrawCount_++;
+		return;
+	}
+	lastDrawFenceValue_ = fenceValue;
+
+	// DirectXCommonが完了を待ったフレーム番号の領域に書き込む
+	uint32_t frameIndex = dxCommon->GetFrameIndex();
+	assert(frameIndex < frameCount_);
+	uint64_t offset = uint64_t(sizeof(Instance)) * instanceCountPerFrame_ * frameIndex;
+	WriteInstances(reinterpret_cast<Instance*>(instanceBuffer_.cpuAddress + offset));
+	sCommandList_->AddUploadBytes(sizeof(Instance) * aliveCount_);
+
+	// 全パーティクルを1回で描画
+	sCommandList_->SetConstantBuffer(0, viewProjection.GetConstBuffer()->GetGPUVirtualAddress());
+	sCommandList_->SetShaderResource(1, instanceBuffer_.gpuAddress + offset);
+	sCommandList_->Draw(4, aliveCount_, 0, 0);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ParticleSimulation.h"
+#include "RenderBackend.h"
+#include "ViewProjection.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <string>
+#include <wrl.h>
+
+/// <summary>
+/// パーティクルシステム（ParticleSimulationの更新結果をインスタンシングで描画する）
+/// </summary>
+class ParticleSystem : public ParticleSimulation {
+public:
+	/// <summary>
+	/// 静的初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	static void
+	    StaticInitialize(ID3D12Device* device, const std::wstring& directoryPath = L"Resources/");
+
+	/// <summary>
+	/// 描画前処理
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト（DirectXCommonのもの）</param>
+	static void PreDraw(ID3D12GraphicsCommandList* commandList);
+
+	/// <summary>
+	/// 描画前処理
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト</param>
+	static void PreDraw(RenderCommandList* commandList);
+
+	/// <summary>
+	/// 描画後処理
+	/// </summary>
+	static void PostDraw();
+
+	/// <summary>
+	/// 初期化（インスタンスバッファも最大数から確保する）
+	/// </summary>
+	/// <param name="maxParticles">最大パーティクル数</param>
+	/// <param name="maxEmitters">最大エミッタ数</param>
+	void Initialize(uint32_t maxParticles, uint32_t maxEmitters = 16);
+
+	/// <summary>
+	/// 描画（PreDraw～PostDrawの間で、1フレームに1回呼ぶ）
+	/// </summary>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	void Draw(const ViewProjection& viewProjection);
+
+	/// <summary>
+	/// 描けなかった回数の取得（同じフレームに2回以上描こうとした）
+	/// </summary>
+	uint32_t GetDroppedDrawCount() const { return droppedDrawCount_; }
+
+private:
+	// デバイス
+	static ID3D12Device* sDevice_;
+	// コマンドリスト
+	static RenderCommandList* sCommandList_;
+	// ルートシグネチャ
+	static Microsoft::WRL::ComPtr<ID3D12RootSignature> sRootSignature_;
+	// パイプラインステートオブジェクト
+	static Microsoft::WRL::ComPtr<ID3D12PipelineState> sPipelineState_;
+
+	// インスタンスバッファ（同時に処理中になりうるフレーム数分のリング。デバイスが保持する）
+	RenderDevice::UploadBuffer instanceBuffer_;
+	// リング内の1フレーム分のインスタンス数
+	uint32_t instanceCountPerFrame_ = 0;
+	// リング内の領域数
+	uint32_t frameCount_ = 0;
+	// 最後に描画したフレームのフェンス値
+	uint64_t lastDrawFenceValue_ = 0;
+	// 描けなかった回数
+	uint32_t droppedDrawCount_ = 0;
+};
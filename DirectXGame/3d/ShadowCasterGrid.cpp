@@ -0,0 +1,223 @@
+#include "ShadowCasterGrid.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void ShadowCasterGrid::Initialize(float cellSize) {
+	assert(cellSize > 0.0f);
+	cellSize_ = cellSize;
+	Clear();
+}
+
+uint32_t ShadowCasterGrid::Add(const Vector3& position) {
+	uint32_t handle = 0;
+	if (!freeHandles_.empty()) {
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+	} else {
+		handle = uint32_t(casters_.size());
+		casters_.emplace_back();
+	}
+	Caster& caster = casters_[handle];
+	caster.position = position;
+	caster.alive = true;
+	casterCount_++;
+	Insert(handle);
+	return handle;
+}
+
+void ShadowCasterGrid::Remove(uint32_t handle) {
+	assert(handle < casters_.size() && casters_[handle].alive);
+	Erase(handle);
+	casters_[handle].alive = false;
+	casterCount_--;
+	freeHandles_.push_back(handle);
+}
+
+void ShadowCasterGrid::SetPosition(uint32_t handle, const Vector3& position) {
+	assert(handle < casters_.size() && casters_[handle].alive);
+	Caster& caster = casters_[handle];
+	caster.position = position;
+	// 同じ格子の中で動いただけなら登録し直さない
+	if (ToKey(ToCell(position)) != caster.cellKey) {
+		Erase(handle);
+		Insert(handle);
+	}
+}
+
+const Vector3& ShadowCasterGrid::GetPosition(uint32_t handle) const {
+	assert(handle < casters_.size() && casters_[handle].alive);
+	return casters_[handle].position;
+}
+
+void ShadowCasterGrid::Clear() {
+	cells_.clear();
+	casters_.clear();
+	freeHandles_.clear();
+	casterCount_ = 0;
+	minCell_ = {0, 0, 0};
+	maxCell_ = {0, 0, 0};
+	candidates_.clear();
+	selected_.clear();
+	statistics_ = {};
+}
+
+const std::vector<uint32_t>& ShadowCasterGrid::Select(const Vector3& center, uint32_t maxCount) {
+	selected_.clear();
+	candidates_.clear();
+	statistics_ = {};
+	statistics_.casterCount = casterCount_;
+	if (maxCount == 0 || casterCount_ == 0) {
+		return selected_;
+	}
+
+	// 登録範囲の箱に一番近い点から探す。箱の中の点pについて
+	// |p - center|^2 >= |p - clamped|^2 + |clamped - center|^2 が成り立つ
+	Vector3 boxMin = {
+	    float(minCell_.x) * cellSize_, float(minCell_.y) * cellSize_,
+	    float(minCell_.z) * cellSize_};
+	Vector3 boxMax = {
+	    float(maxCell_.x + 1) * cellSize_, float(maxCell_.y + 1) * cellSize_,
+	    float(maxCell_.z + 1) * cellSize_};
+	Vector3 clamped = {
+	    std::clamp(center.x, boxMin.x, boxMax.x), std::clamp(center.y, boxMin.y, boxMax.y),
+	    std::clamp(center.z, boxMin.z, boxMax.z)};
+	Vector3 offset = center - clamped;
+	float offsetSquared = offset.x * offset.x + offset.y * offset.y + offset.z * offset.z;
+
+	Cell origin = ToCell(clamped);
+	origin.x = std::clamp(origin.x, minCell_.x, maxCell_.x);
+	origin.y = std::clamp(origin.y, minCell_.y, maxCell_.y);
+	origin.z = std::clamp(origin.z, minCell_.z, maxCell_.z);
+	int32_t maxRing = std::max(
+	    {origin.x - minCell_.x, maxCell_.x - origin.x, origin.y - minCell_.y,
+	     maxCell_.y - origin.y, origin.z - minCell_.z, maxCell_.z - origin.z});
+
+	for (int32_t ring = 0; ring <= maxRing; ring++) {
+		int32_t x0 = std::max(origin.x - ring, minCell_.x);
+		int32_t x1 = std::min(origin.x + ring, maxCell_.x);
+		int32_t y0 = std::max(origin.y - ring, minCell_.y);
+		int32_t y1 = std::min(origin.y + ring, maxCell_.y);
+		int32_t z0 = std::max(origin.z - ring, minCell_.z);
+		int32_t z1 = std::min(origin.z + ring, maxCell_.z);
+		bool nearZFace = origin.z - ring >= minCell_.z;
+		bool farZFace = ring > 0 && origin.z + ring <= maxCell_.z;
+
+		// 原点からのチェビシェフ距離がちょうどringの格子（箱の外は飛ばす）
+		for (int32_t y = y0; y <= y1; y++) {
+			bool yFace = std::abs(y - origin.y) == ring;
+			for (int32_t x = x0; x <= x1; x++) {
+				if (yFace || std::abs(x - origin.x) == ring) {
+					for (int32_t z = z0; z <= z1; z++) {
+						VisitCell(x, y, z, center);
+					}
+					continue;
+				}
+				if (!nearZFace && !farZFace) {
+					// 奥行きの面が箱の外なら、この行の内側は調べる格子が無い
+					x = std::max(x, x1 - 1);
+					continue;
+				}
+				if (nearZFace) {
+					VisitCell(x, y, origin.z - ring, center);
+				}
+				if (farZFace) {
+					VisitCell(x, y, origin.z + ring, center);
+				}
+			}
+		}
+
+		// 次の周より外の格子は少なくともringマス分離れている
+		if (candidates_.size() >= maxCount) {
+			auto nth = candidates_.begin() + (maxCount - 1);
+			std::nth_element(
+			    candidates_.begin(), nth, candidates_.end(),
+			    [](const Candidate& a, const Candidate& b) {
+				    return a.distanceSquared < b.distanceSquared;
+			    });
+			float reach = float(ring) * cellSize_;
+			if (nth->distanceSquared <= reach * reach + offsetSquared) {
+				break;
+			}
+		}
+	}
+
+	// 近い順に必要な数だけ並べる（同じ距離はハンドル順）
+	uint32_t count = std::min(maxCount, uint32_t(candidates_.size()));
+	std::partial_sort(
+	    candidates_.begin(), candidates_.begin() + count, candidates_.end(),
+	    [](const Candidate& a, const Candidate& b) {
+		    if (a.distanceSquared != b.distanceSquared) {
+			    return a.distanceSquared < b.distanceSquared;
+		    }
+		    return a.handle < b.handle;
+	    });
+	selected_.reserve(count);
+	for (uint32_t i = 0; i < count; i++) {
+		selected_.push_back(candidates_[i].handle);
+	}
+	statistics_.candidateCount = uint32_t(candidates_.size());
+	statistics_.selectedCount = count;
+	return selected_;
+}
+
+ShadowCasterGrid::Cell ShadowCasterGrid::ToCell(const Vector3& position) const {
+	return {
+	    int32_t(std::floor(position.x / cellSize_)), int32_t(std::floor(position.y / cellSize_)),
+	    int32_t(std::floor(position.z / cellSize_))};
+}
+
+uint64_t ShadowCasterGrid::ToKey(const Cell& cell) {
+	const int32_t kBias = 1 << 20;
+	const uint64_t kMask = (uint64_t(1) << 21) - 1;
+	return (uint64_t(cell.x + kBias) & kMask) | ((uint64_t(cell.y + kBias) & kMask) << 21) |
+	       ((uint64_t(cell.z + kBias) & kMask) << 42);
+}
+
+void ShadowCasterGrid::Insert(uint32_t handle) {
+	Caster& caster = casters_[handle];
+	Cell cell = ToCell(caster.position);
+	caster.cellKey = ToKey(cell);
+	std::vector<uint32_t>& handles = cells_[caster.cellKey];
+	caster.slot = uint32_t(handles.size());
+	handles.push_back(handle);
+
+	if (casterCount_ == 1) {
+		minCell_ = cell;
+		maxCell_ = cell;
+	} else {
+		minCell_ = {
+		    std::min(minCell_.x, cell.x), std::min(minCell_.y, cell.y),
+		    std::min(minCell_.z, cell.z)};
+		maxCell_ = {
+		    std::max(maxCell_.x, cell.x), std::max(maxCell_.y, cell.y),
+		    std::max(maxCell_.z, cell.z)};
+	}
+}
+
+void ShadowCasterGrid::Erase(uint32_t handle) {
+	Caster& caster = casters_[handle];
+	auto it = cells_.find(caster.cellKey);
+	assert(it != cells_.end());
+	std::vector<uint32_t>& handles = it->second;
+	// 末尾と入れ替えて外す
+	uint32_t last = handles.back();
+	handles[caster.slot] = last;
+	casters_[last].slot = caster.slot;
+	handles.pop_back();
+	if (handles.empty()) {
+		cells_.erase(it);
+	}
+}
+
+void ShadowCasterGrid::VisitCell(int32_t x, int32_t y, int32_t z, const Vector3& center) {
+	statistics_.visitedCellCount++;
+	auto it = cells_.find(ToKey({x, y, z}));
+	if (it == cells_.end()) {
+		return;
+	}
+	for (uint32_t handle : it->second) {
+		Vector3 d = casters_[handle].position - center;
+		candidates_.push_back({d.x * d.x + d.y * d.y + d.z * d.z, handle});
+	}
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Vector3.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 丸影を落とすキャスターの空間格子（カメラに近い順にN個を選ぶ）
+/// </summary>
+/// <remarks>
+/// キャスターは一辺cellSizeの立方体の格子に登録しておき、選ぶときは
+/// 登録範囲の中でカメラに一番近い格子から外側へ1周ずつ広げて調べる。
+/// 未探索の格子がどれもN番目の候補より遠いと分かった時点で打ち切るので、
+/// キャスターが多くても調べるのはカメラの近くだけで済む。GPUやファイルに触れない。
+/// </remarks>
+class ShadowCasterGrid {
+public:
+	// 無効なハンドル
+	static const uint32_t kInvalidHandle = UINT32_MAX;
+	// 既定の格子の一辺
+	static constexpr float kDefaultCellSize = 4.0f;
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 登録されているキャスター数
+		uint32_t casterCount = 0;
+		// 調べた格子数（空の格子を含む）
+		uint32_t visitedCellCount = 0;
+		// 距離を計算したキャスター数
+		uint32_t candidateCount = 0;
+		// 選んだキャスター数
+		uint32_t selectedCount = 0;
+	};
+
+	/// <summary>
+	/// 初期化（登録済みのキャスターは消える）
+	/// </summary>
+	/// <param name="cellSize">格子の一辺</param>
+	void Initialize(float cellSize = kDefaultCellSize);
+
+	/// <summary>
+	/// キャスターを登録する
+	/// </summary>
+	/// <param name="position">ワールド座標</param>
+	/// <returns>ハンドル</returns>
+	uint32_t Add(const Vector3& position);
+
+	/// <summary>
+	/// キャスターを取り除く
+	/// </summary>
+	/// <param name="handle">Addで受け取ったハンドル</param>
+	void Remove(uint32_t handle);
+
+	/// <summary>
+	/// キャスターを動かす
+	/// </summary>
+	/// <param name="handle">Addで受け取ったハンドル</param>
+	/// <param name="position">ワールド座標</param>
+	void SetPosition(uint32_t handle, const Vector3& position);
+
+	/// <summary>
+	/// キャスターの座標
+	/// </summary>
+	const Vector3& GetPosition(uint32_t handle) const;
+
+	/// <summary>
+	/// 全てのキャスターを取り除く
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 指定位置に近い順にキャスターを選ぶ
+	/// </summary>
+	/// <param name="center">カメラ座標</param>
+	/// <param name="maxCount">選ぶ最大数</param>
+	/// <returns>近い順に並んだハンドル（次の呼び出しまで有効）</returns>
+	const std::vector<uint32_t>& Select(const Vector3& center, uint32_t maxCount);
+
+	uint32_t GetCasterCount() const { return casterCount_; }
+	float GetCellSize() const { return cellSize_; }
+
+	/// <summary>
+	/// 直前のSelectの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	/// <summary>
+	/// 格子の座標
+	/// </summary>
+	struct Cell {
+		int32_t x;
+		int32_t y;
+		int32_t z;
+	};
+
+	/// <summary>
+	/// 登録されたキャスター
+	/// </summary>
+	struct Caster {
+		// ワールド座標
+		Vector3 position;
+		// 入っている格子のキー
+		uint64_t cellKey = 0;
+		// 格子内での位置
+		uint32_t slot = 0;
+		// 使用中
+		bool alive = false;
+	};
+
+	/// <summary>
+	/// 距離を計算した候補
+	/// </summary>
+	struct Candidate {
+		float distanceSquared;
+		uint32_t handle;
+	};
+
+	/// <summary>
+	/// ワールド座標が入る格子
+	/// </summary>
+	Cell ToCell(const Vector3& position) const;
+
+	/// <summary>
+	/// 格子のキー（各軸21bitに詰める）
+	/// </summary>
+	static uint64_t ToKey(const Cell& cell);
+
+	/// <summary>
+	/// 格子に登録する
+	/// </summary>
+	void Insert(uint32_t handle);
+
+	/// <summary>
+	/// 格子から外す
+	/// </summary>
+	void Erase(uint32_t handle);
+
+	/// <summary>
+	/// 1つの格子のキャスターを候補に加える
+	/// </summary>
+	void VisitCell(int32_t x, int32_t y, int32_t z, const Vector3& center);
+
+	// 格子の一辺
+	float cellSize_ = kDefaultCellSize;
+	// 格子ごとのキャスター
+	std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+	// キャスター（ハンドルが添字）
+	std::vector<Caster> casters_;
+	// 空いているハンドル
+	std::vector<uint32_t> freeHandles_;
+	// 登録されているキャスター数
+	uint32_t casterCount_ = 0;
+	// 登録したことのある格子の範囲（広がるだけで縮まない）
+	Cell minCell_ = {0, 0, 0};
+	Cell maxCell_ = {0, 0, 0};
+	// 候補（作業用）
+	std::vector<Candidate> candidates_;
+	// 選んだハンドル
+	std::vector<uint32_t> selected_;
+	// 統計情報
+	Statistics statistics_;
+};
@@ -0,0 +1,65 @@
+#include "ShadowCasterSystem.h"
+#include "ConstantBufferAllocator.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+ShadowCasterSystem* ShadowCasterSystem::GetInstance() {
+	static ShadowCasterSystem instance;
+	return &instance;
+}
+
+void ShadowCasterSystem::Initialize() {
+	grid_.Initialize();
+	packed_.reserve(kMaxShadowCasters);
+
+	// キャスターの真上にライトを置いて真下に落とす
+	shape_.SetDir({0.0f, 1.0f, 0.0f});
+	shape_.SetDistanceCasterLight(3.0f);
+	shape_.SetAtten({0.5f, 0.6f, 0.0f});
+	shape_.SetFactorAngle({0.0f, 0.5f});
+	isReady_ = false;
+}
+
+void ShadowCasterSystem::Update(const ViewProjection& viewProjection) {
+	isReady_ = false;
+
+	const std::vector<uint32_t>& selected =
+	    grid_.Select(viewProjection.translation_, kMaxShadowCasters);
+
+	// 選んだキャスターを丸影の並びに詰める
+	packed_.clear();
+	for (uint32_t handle : selected) {
+		CircleShadow::ConstBufferData data{};
+		data.dir = shape_.GetDir();
+		data.casterPos = grid_.GetPosition(handle);
+		data.distanceCasterLight = shape_.GetDistanceCasterLight();
+		data.atten = shape_.GetAtten();
+		data.factorAngleCos = shape_.GetFactorAngleCos();
+		data.active = 1;
+		packed_.push_back(data);
+	}
+
+	// 空のバッファはバインドできないので最低1要素分は確保する
+	ConstantBufferAllocator* allocator = ConstantBufferAllocator::GetInstance();
+	size_t size = sizeof(CircleShadow::ConstBufferData) * packed_.size();
+	ConstantBufferAllocator::Allocation allocation =
+	    allocator->Allocate(std::max<size_t>(size, sizeof(CircleShadow::ConstBufferData)));
+	if (allocation.cpuAddress && size > 0) {
+		std::memcpy(allocation.cpuAddress, packed_.data(), size);
+	}
+	castersAddress_ = allocation.gpuAddress;
+
+	ConstBufferDataShadowParameters parameters{};
+	parameters.shadowCasterCount = uint32_t(packed_.size());
+	parametersAddress_ = allocator->Upload(parameters);
+
+	isReady_ = castersAddress_ != 0 && parametersAddress_ != 0;
+}
+
+void ShadowCasterSystem::SetRootParameters(
+    RenderQueue::Packet& packet, uint32_t parametersIndex, uint32_t castersIndex) const {
+	assert(isReady_);
+	packet.constantBuffers[parametersIndex] = parametersAddress_;
+	packet.shaderResources[castersIndex] = castersAddress_;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CircleShadow.h"
+#include "RenderQueue.h"
+#include "ShadowCasterGrid.h"
+#include "ViewProjection.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <vector>
+
+/// <summary>
+/// 丸影のキャスター管理（多数のキャスターからカメラに近いものを選んでシェーダに渡す）
+/// </summary>
+/// <remarks>
+/// LightGroupの丸影は1つ分しか転送できないので、選んだキャスターは
+/// CircleShadow::ConstBufferDataの並びでStructuredBufferに詰め、クラスタ化ライティングの
+/// パイプラインで落とす。影の向きや減衰は全キャスター共通でSetShapeで変える。
+/// </remarks>
+class ShadowCasterSystem {
+public:
+	using Statistics = ShadowCasterGrid::Statistics;
+
+	// 1フレームでシェーダに渡す最大キャスター数
+	static const uint32_t kMaxShadowCasters = 32;
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static ShadowCasterSystem* GetInstance();
+
+	/// <summary>
+	/// 初期化（真下に落ちる影の形にする）
+	/// </summary>
+	void Initialize();
+
+	/// <summary>
+	/// フレーム開始（前のフレームの転送を無効にする）
+	/// </summary>
+	void BeginFrame() { isReady_ = false; }
+
+	/// <summary>
+	/// キャスターを登録する
+	/// </summary>
+	/// <param name="position">ワールド座標</param>
+	/// <returns>ハンドル</returns>
+	uint32_t AddCaster(const Vector3& position) { return grid_.Add(position); }
+
+	/// <summary>
+	/// キャスターを取り除く
+	/// </summary>
+	/// <param name="handle">AddCasterで受け取ったハンドル</param>
+	void RemoveCaster(uint32_t handle) { grid_.Remove(handle); }
+
+	/// <summary>
+	/// キャスターを動かす
+	/// </summary>
+	/// <param name="handle">AddCasterで受け取ったハンドル</param>
+	/// <param name="position">ワールド座標</param>
+	void SetCasterPosition(uint32_t handle, const Vector3& position) {
+		grid_.SetPosition(handle, position);
+	}
+
+	/// <summary>
+	/// 影の形をセット（向きは投影方向の逆ベクトル。キャスター座標と有効フラグは使わない）
+	/// </summary>
+	void SetShape(const CircleShadow& shape) { shape_ = shape; }
+
+	/// <summary>
+	/// カメラに近いキャスターを選んで転送する（ConstantBufferAllocator::BeginFrameの後、描画の前に呼ぶ）
+	/// </summary>
+	/// <param name="viewProjection">描画に使うビュープロジェクション</param>
+	void Update(const ViewProjection& viewProjection);
+
+	/// <summary>
+	/// 今フレームの転送が済んでいるか
+	/// </summary>
+	bool IsReady() const { return isReady_; }
+
+	/// <summary>
+	/// 描画要求に丸影のルートパラメータを設定する（IsReadyのときだけ）
+	/// </summary>
+	/// <param name="packet">描画要求</param>
+	/// <param name="parametersIndex">キャスター数の定数バッファのルートパラメータ番号</param>
+	/// <param name="castersIndex">キャスターのStructuredBufferのルートパラメータ番号</param>
+	void SetRootParameters(
+	    RenderQueue::Packet& packet, uint32_t parametersIndex, uint32_t castersIndex) const;
+
+	/// <summary>
+	/// 直前のUpdateの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return grid_.GetStatistics(); }
+
+private:
+	/// <summary>
+	/// シェーダに渡すキャスター数
+	/// </summary>
+	struct ConstBufferDataShadowParameters {
+		uint32_t shadowCasterCount;
+		uint32_t pad[3];
+	};
+
+	ShadowCasterSystem() = default;
+	~ShadowCasterSystem() = default;
+	ShadowCasterSystem(const ShadowCasterSystem&) = delete;
+	ShadowCasterSystem& operator=(const ShadowCasterSystem&) = delete;
+
+	// キャスターの空間格子
+	ShadowCasterGrid grid_;
+	// 影の形
+	CircleShadow shape_;
+	// シェーダに渡すキャスター（作業用）
+	std::vector<CircleShadow::ConstBufferData> packed_;
+	// 今フレームの転送先
+	D3D12_GPU_VIRTUAL_ADDRESS parametersAddress_ = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS castersAddress_ = 0;
+	// 今フレームの転送が済んでいる
+	bool isReady_ = false;
+};
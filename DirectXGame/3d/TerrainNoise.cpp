@@ -0,0 +1,348 @@
+#include "TerrainNoise.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define TERRAIN_NOISE_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCCとClangは関数ごとにAVX2を許可する（MSVCは指定なしで組み込み関数が使える）
+#if defined(TERRAIN_NOISE_X64) && (defined(__GNUC__) || defined(__clang__))
+#define TERRAIN_NOISE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define TERRAIN_NOISE_AVX2_TARGET
+#endif
+
+namespace {
+
+// 2Dパーリンノイズの値域[-√2/2, √2/2]を[0,1]に写す係数
+const float kNormalizeScale = std::numbers::sqrt2_v<float> * 0.5f;
+
+/// <summary>
+/// 改良パーリンノイズのフェード関数（6t^5 - 15t^4 + 10t^3）
+/// </summary>
+float Fade(float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+/// <summary>
+/// 折り返して尾根にする
+/// </summary>
+float Ridge(float n) {
+	n = 1.0f - std::abs(n * 2.0f - 1.0f);
+	return n * n;
+}
+
+/// <summary>
+/// CPUとOSがAVX2を使えるか
+/// </summary>
+bool IsAvx2Supported() {
+#if defined(TERRAIN_NOISE_X64) && defined(_MSC_VER)
+	int info[4] = {};
+	__cpuid(info, 1);
+	// OSがYMMレジスタを保存するか
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(TERRAIN_NOISE_X64)
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+} // namespace
+
+void TerrainNoise::Initialize(uint32_t seed, bool useSimd) {
+	std::mt19937 randomEngine(seed);
+
+	// 0～255を並べ替えて2周分並べる
+	for (uint32_t i = 0; i < kSizePermutation; i++) {
+		permutation_[i] = int32_t(i);
+	}
+	std::shuffle(permutation_, permutation_ + kSizePermutation, randomEngine);
+	for (uint32_t i = 0; i < kSizePermutation; i++) {
+		permutation_[kSizePermutation + i] = permutation_[i];
+	}
+
+	// 勾配は円周上のランダムな向き
+	std::uniform_real_distribution<float> angleDistribution(
+	    0.0f, 2.0f * std::numbers::pi_v<float>);
+	for (uint32_t i = 0; i < kSizePermutation; i++) {
+		float angle = angleDistribution(randomEngine);
+		gradientX_[i] = std::cos(angle);
+		gradientY_[i] = std::sin(angle);
+	}
+
+	simdEnabled_ = useSimd && IsAvx2Supported();
+}
+
+float TerrainNoise::Perlin(float x, float y) const {
+	float fx = std::floor(x);
+	float fy = std::floor(y);
+	int32_t ix = int32_t(fx) & int32_t(kSizePermutation - 1);
+	int32_t iy = int32_t(fy) & int32_t(kSizePermutation - 1);
+	float tx = x - fx;
+	float ty = y - fy;
+
+	// 格子の四隅の勾配番号
+	int32_t p0 = permutation_[ix];
+	int32_t p1 = permutation_[ix + 1];
+	int32_t h00 = permutation_[p0 + iy];
+	int32_t h10 = permutation_[p1 + iy];
+	int32_t h01 = permutation_[p0 + iy + 1];
+	int32_t h11 = permutation_[p1 + iy + 1];
+
+	// 四隅からの距離ベクトルと勾配の内積
+	float d00 = gradientX_[h00] * tx + gradientY_[h00] * ty;
+	float d10 = gradientX_[h10] * (tx - 1.0f) + gradientY_[h10] * ty;
+	float d01 = gradientX_[h01] * tx + gradientY_[h01] * (ty - 1.0f);
+	float d11 = gradientX_[h11] * (tx - 1.0f) + gradientY_[h11] * (ty - 1.0f);
+
+	float u = Fade(tx);
+	float v = Fade(ty);
+	float a = d00 + u * (d10 - d00);
+	float b = d01 + u * (d11 - d01);
+	float n = a + v * (b - a);
+	return n * kNormalizeScale + 0.5f;
+}
+
+void TerrainNoise::Perlin8(const float* x, const float* y, float* result) const {
+	if (simdEnabled_) {
+		Perlin8Avx2(x, y, result);
+	} else {
+		Perlin8Scalar(x, y, result);
+	}
+}
+
+float TerrainNoise::Fractal(float x, float y, const FractalDesc& desc) const {
+	float sum = 0.0f;
+	float amplitude = 1.0f;
+	float amplitudeSum = 0.0f;
+	float frequency = desc.frequency;
+	for (uint32_t octave = 0; octave < desc.octaveCount; octave++) {
+		float n = Perlin(x * frequency, y * frequency);
+		if (desc.type == Type::kRidged) {
+			n = Ridge(n);
+		}
+		sum += n * amplitude;
+		amplitudeSum += amplitude;
+		amplitude *= desc.gain;
+		frequency *= desc.lacunarity;
+	}
+	return amplitudeSum > 0.0f ? sum / amplitudeSum : 0.0f;
+}
+
+void TerrainNoise::FractalRow(
+    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const {
+	if (simdEnabled_) {
+		FractalRowAvx2(x0, dx, y, count, desc, result);
+	} else {
+		FractalRowScalar(x0, dx, y, count, desc, result);
+	}
+}
+
+void TerrainNoise::FractalRowScalar(
+    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const {
+	alignas(32) float xs[kBatchSize];
+	alignas(32) float ys[kBatchSize];
+	alignas(32) float sums[kBatchSize];
+	alignas(32) float noise[kBatchSize];
+
+	for (uint32_t begin = 0; begin < count; begin += kBatchSize) {
+		uint32_t batchCount = std::min(kBatchSize, count - begin);
+		for (uint32_t i = 0; i < kBatchSize; i++) {
+			sums[i] = 0.0f;
+		}
+
+		float amplitude = 1.0f;
+		float amplitudeSum = 0.0f;
+		float frequency = desc.frequency;
+		for (uint32_t octave = 0; octave < desc.octaveCount; octave++) {
+			// 端数のバッチは最後のサンプルで埋める
+			for (uint32_t i = 0; i < kBatchSize; i++) {
+				float x = x0 + dx * float(begin + std::min(i, batchCount - 1));
+				xs[i] = x * frequency;
+				ys[i] = y * frequency;
+			}
+			Perlin8Scalar(xs, ys, noise);
+			for (uint32_t i = 0; i < kBatchSize; i++) {
+				float n = desc.type == Type::kRidged ? Ridge(noise[i]) : noise[i];
+				sums[i] += n * amplitude;
+			}
+			amplitudeSum += amplitude;
+			amplitude *= desc.gain;
+			frequency *= desc.lacunarity;
+		}
+
+		for (uint32_t i = 0; i < batchCount; i++) {
+			result[begin + i] = amplitudeSum > 0.0f ? sums[i] / amplitudeSum : 0.0f;
+		}
+	}
+}
+
+void TerrainNoise::FractalGrid(
+    float x0, float y0, float step, uint32_t width, uint32_t height, const FractalDesc& desc,
+    float* result, JobSystem* jobSystem) const {
+	if (!jobSystem) {
+		jobSystem = JobSystem::GetInstance();
+	}
+
+	// 行の長さに関わらず1ジョブがおよそkRowJobSamples個になるよう行をまとめる
+	static constexpr uint32_t kRowJobSamples = 16384;
+	uint32_t rowsPerJob = std::max(1u, kRowJobSamples / std::max(1u, width));
+	jobSystem->ParallelFor(height, rowsPerJob, [&](uint32_t rowBegin, uint32_t rowEnd) {
+		for (uint32_t row = rowBegin; row < rowEnd; row++) {
+			FractalRow(
+			    x0, step, y0 + step * float(row), width, desc, result + size_t(row) * width);
+		}
+	});
+}
+
+void TerrainNoise::Perlin8Scalar(const float* x, const float* y, float* result) const {
+	for (uint32_t i = 0; i < kBatchSize; i++) {
+		result[i] = Perlin(x[i], y[i]);
+	}
+}
+
+#if defined(TERRAIN_NOISE_X64)
+
+namespace {
+
+/// <summary>
+/// 勾配番号の勾配と距離ベクトルの内積（8サンプル分）
+/// </summary>
+TERRAIN_NOISE_AVX2_TARGET __m256 GradientDot(
+    const float* gradientX, const float* gradientY, __m256i h, __m256 dx, __m256 dy) {
+	__m256 gx = _mm256_i32gather_ps(gradientX, h, 4);
+	__m256 gy = _mm256_i32gather_ps(gradientY, h, 4);
+	return _mm256_add_ps(_mm256_mul_ps(gx, dx), _mm256_mul_ps(gy, dy));
+}
+
+/// <summary>
+/// フェード関数（8サンプル分。スカラー版と同じ順で計算する）
+/// </summary>
+TERRAIN_NOISE_AVX2_TARGET __m256 Fade8(__m256 t) {
+	__m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+	inner = _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10.0f));
+	return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+}
+
+/// <summary>
+/// パーリンノイズ（8サンプル分。[0,1]の値）
+/// </summary>
+TERRAIN_NOISE_AVX2_TARGET __m256 Perlin8Kernel(
+    const int32_t* permutation, const float* gradientX, const float* gradientY, __m256 vx,
+    __m256 vy) {
+	__m256 fx = _mm256_floor_ps(vx);
+	__m256 fy = _mm256_floor_ps(vy);
+	__m256i mask = _mm256_set1_epi32(int32_t(TerrainNoise::kSizePermutation - 1));
+	__m256i ix = _mm256_and_si256(_mm256_cvttps_epi32(fx), mask);
+	__m256i iy = _mm256_and_si256(_mm256_cvttps_epi32(fy), mask);
+	__m256 tx = _mm256_sub_ps(vx, fx);
+	__m256 ty = _mm256_sub_ps(vy, fy);
+
+	// 格子の四隅の勾配番号
+	__m256i one = _mm256_set1_epi32(1);
+	__m256i p0 = _mm256_i32gather_epi32(permutation, ix, 4);
+	__m256i p1 = _mm256_i32gather_epi32(permutation, _mm256_add_epi32(ix, one), 4);
+	__m256i p0y = _mm256_add_epi32(p0, iy);
+	__m256i p1y = _mm256_add_epi32(p1, iy);
+	__m256i h00 = _mm256_i32gather_epi32(permutation, p0y, 4);
+	__m256i h10 = _mm256_i32gather_epi32(permutation, p1y, 4);
+	__m256i h01 = _mm256_i32gather_epi32(permutation, _mm256_add_epi32(p0y, one), 4);
+	__m256i h11 = _mm256_i32gather_epi32(permutation, _mm256_add_epi32(p1y, one), 4);
+
+	// 四隅からの距離ベクトルと勾配の内積
+	__m256 oneF = _mm256_set1_ps(1.0f);
+	__m256 tx1 = _mm256_sub_ps(tx, oneF);
+	__m256 ty1 = _mm256_sub_ps(ty, oneF);
+	__m256 d00 = GradientDot(gradientX, gradientY, h00, tx, ty);
+	__m256 d10 = GradientDot(gradientX, gradientY, h10, tx1, ty);
+	__m256 d01 = GradientDot(gradientX, gradientY, h01, tx, ty1);
+	__m256 d11 = GradientDot(gradientX, gradientY, h11, tx1, ty1);
+
+	__m256 u = Fade8(tx);
+	__m256 v = Fade8(ty);
+	__m256 a = _mm256_add_ps(d00, _mm256_mul_ps(u, _mm256_sub_ps(d10, d00)));
+	__m256 b = _mm256_add_ps(d01, _mm256_mul_ps(u, _mm256_sub_ps(d11, d01)));
+	__m256 n = _mm256_add_ps(a, _mm256_mul_ps(v, _mm256_sub_ps(b, a)));
+	return _mm256_add_ps(_mm256_mul_ps(n, _mm256_set1_ps(kNormalizeScale)), _mm256_set1_ps(0.5f));
+}
+
+} // namespace
+
+TERRAIN_NOISE_AVX2_TARGET void
+    TerrainNoise::Perlin8Avx2(const float* x, const float* y, float* result) const {
+	__m256 n = Perlin8Kernel(
+	    permutation_, gradientX_, gradientY_, _mm256_loadu_ps(x), _mm256_loadu_ps(y));
+	_mm256_storeu_ps(result, n);
+}
+
+TERRAIN_NOISE_AVX2_TARGET void TerrainNoise::FractalRowAvx2(
+    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const {
+	__m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256 signMask = _mm256_set1_ps(-0.0f);
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 two = _mm256_set1_ps(2.0f);
+	bool ridged = desc.type == Type::kRidged;
+
+	for (uint32_t begin = 0; begin < count; begin += kBatchSize) {
+		uint32_t batchCount = std::min(kBatchSize, count - begin);
+		// 端数のバッチは最後のサンプルで埋める
+		__m256i index = _mm256_min_epi32(lane, _mm256_set1_epi32(int32_t(batchCount - 1)));
+		index = _mm256_add_epi32(index, _mm256_set1_epi32(int32_t(begin)));
+		__m256 vx = _mm256_add_ps(
+		    _mm256_set1_ps(x0), _mm256_mul_ps(_mm256_set1_ps(dx), _mm256_cvtepi32_ps(index)));
+
+		__m256 sum = _mm256_setzero_ps();
+		float amplitude = 1.0f;
+		float amplitudeSum = 0.0f;
+		float frequency = desc.frequency;
+		for (uint32_t octave = 0; octave < desc.octaveCount; octave++) {
+			__m256 vf = _mm256_set1_ps(frequency);
+			__m256 n = Perlin8Kernel(
+			    permutation_, gradientX_, gradientY_, _mm256_mul_ps(vx, vf),
+			    _mm256_set1_ps(y * frequency));
+			if (ridged) {
+				__m256 centered = _mm256_sub_ps(_mm256_mul_ps(n, two), one);
+				n = _mm256_sub_ps(one, _mm256_andnot_ps(signMask, centered));
+				n = _mm256_mul_ps(n, n);
+			}
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(n, _mm256_set1_ps(amplitude)));
+			amplitudeSum += amplitude;
+			amplitude *= desc.gain;
+			frequency *= desc.lacunarity;
+		}
+
+		alignas(32) float sums[kBatchSize];
+		_mm256_store_ps(sums, sum);
+		for (uint32_t i = 0; i < batchCount; i++) {
+			result[begin + i] = amplitudeSum > 0.0f ? sums[i] / amplitudeSum : 0.0f;
+		}
+	}
+}
+
+
+#else
+
+void TerrainNoise::Perlin8Avx2(const float* x, const float* y, float* result) const {
+	Perlin8Scalar(x, y, result);
+}
+
+void TerrainNoise::FractalRowAvx2(
+    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const {
+	FractalRowScalar(x0, dx, y, count, desc, result);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+
+class JobSystem;
+
+/// <summary>
+/// 地形用の2Dパーリンノイズ（8サンプルずつまとめて求める）
+/// </summary>
+/// <remarks>
+/// 勾配と並べ替え表は平らな配列に持ち、AVX2が使えるCPUではgatherで8サンプルを1度に求める。
+/// 使えない場合は同じ式のスカラー版で求める。値はどちらも[0,1]。
+/// 格子の塗りつぶしは行ごとにジョブへ分ける。GPUやファイルに触れない。
+/// </remarks>
+class TerrainNoise {
+public:
+	// 並べ替え表の大きさ（ノイズはこの周期で繰り返す）
+	static const uint32_t kSizePermutation = 256;
+	// 1度に求めるサンプル数
+	static const uint32_t kBatchSize = 8;
+
+	/// <summary>
+	/// オクターブの重ね方
+	/// </summary>
+	enum class Type {
+		kFbm,    // 普通に重ねる（なだらかな起伏）
+		kRidged, // 0付近を折り返して重ねる（尾根）
+	};
+
+	/// <summary>
+	/// オクターブの設定
+	/// </summary>
+	struct FractalDesc {
+		// 重ね方
+		Type type = Type::kFbm;
+		// オクターブ数
+		uint32_t octaveCount = 4;
+		// 最初のオクターブの周波数
+		float frequency = 1.0f;
+		// オクターブごとの周波数の倍率
+		float lacunarity = 2.0f;
+		// オクターブごとの振幅の倍率
+		float gain = 0.5f;
+	};
+
+	/// <summary>
+	/// 初期化（勾配と並べ替え表を作る）
+	/// </summary>
+	/// <param name="seed">乱数の種</param>
+	/// <param name="useSimd">AVX2が使えるCPUならAVX2で求める</param>
+	void Initialize(uint32_t seed = 0, bool useSimd = true);
+
+	/// <summary>
+	/// パーリンノイズ
+	/// </summary>
+	/// <returns>[0,1]の値</returns>
+	float Perlin(float x, float y) const;
+
+	/// <summary>
+	/// パーリンノイズをkBatchSize個まとめて求める
+	/// </summary>
+	/// <param name="x">X座標（kBatchSize個）</param>
+	/// <param name="y">Y座標（kBatchSize個）</param>
+	/// <param name="result">[0,1]の値（kBatchSize個）</param>
+	void Perlin8(const float* x, const float* y, float* result) const;
+
+	/// <summary>
+	/// オクターブを重ねたノイズ
+	/// </summary>
+	/// <returns>[0,1]の値</returns>
+	float Fractal(float x, float y, const FractalDesc& desc) const;
+
+	/// <summary>
+	/// 横一列のオクターブを重ねたノイズ（x0, x0 + dx, ...）
+	/// </summary>
+	/// <param name="x0">先頭のX座標</param>
+	/// <param name="dx">X座標の間隔</param>
+	/// <param name="y">Y座標</param>
+	/// <param name="count">サンプル数</param>
+	/// <param name="desc">オクターブの設定</param>
+	/// <param name="result">[0,1]の値（count個）</param>
+	void FractalRow(
+	    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const;
+
+	/// <summary>
+	/// 格子状にオクターブを重ねたノイズを求める（行ごとにジョブへ分ける）
+	/// </summary>
+	/// <param name="x0">左上のX座標</param>
+	/// <param name="y0">左上のY座標</param>
+	/// <param name="step">サンプルの間隔</param>
+	/// <param name="width">横のサンプル数</param>
+	/// <param name="height">縦のサンプル数</param>
+	/// <param name="desc">オクターブの設定</param>
+	/// <param name="result">[0,1]の値（width * height個、行優先）</param>
+	/// <param name="jobSystem">ジョブシステム（nullptrなら共有インスタンス）</param>
+	void FractalGrid(
+	    float x0, float y0, float step, uint32_t width, uint32_t height, const FractalDesc& desc,
+	    float* result, JobSystem* jobSystem = nullptr) const;
+
+	/// <summary>
+	/// AVX2で求めているか
+	/// </summary>
+	bool IsSimdEnabled() const { return simdEnabled_; }
+
+private:
+	/// <summary>
+	/// スカラー版（Perlin8でAVX2が使えないとき）
+	/// </summary>
+	void Perlin8Scalar(const float* x, const float* y, float* result) const;
+
+	/// <summary>
+	/// AVX2版
+	/// </summary>
+	void Perlin8Avx2(const float* x, const float* y, float* result) const;
+
+	/// <summary>
+	/// FractalRowのスカラー版
+	/// </summary>
+	void FractalRowScalar(
+	    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const;
+
+	/// <summary>
+	/// FractalRowのAVX2版（オクターブの重ね合わせもまとめて求める）
+	/// </summary>
+	void FractalRowAvx2(
+	    float x0, float dx, float y, uint32_t count, const FractalDesc& desc, float* result) const;
+
+	// 並べ替え表（添字の繰り上がりを避けるため2周分）
+	alignas(32) int32_t permutation_[kSizePermutation * 2] = {};
+	// 勾配ベクトル（単位ベクトル）
+	alignas(32) float gradientX_[kSizePermutation] = {};
+	alignas(32) float gradientY_[kSizePermutation] = {};
+	// AVX2で求める
+	bool simdEnabled_ = false;
+};
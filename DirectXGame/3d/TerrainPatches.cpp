@@ -0,0 +1,252 @@
+#include "TerrainPatches.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void TerrainPatches::Initialize(
+    uint32_t quadCountX, uint32_t quadCountZ, float cellSize, uint32_t patchQuadCount,
+    uint32_t lodCount, float skirtDepth) {
+	assert(lodCount > 0 && lodCount <= kMaxLodCount);
+	assert(patchQuadCount % (1u << (lodCount - 1)) == 0);
+	assert(quadCountX % patchQuadCount == 0 && quadCountZ % patchQuadCount == 0);
+	assert(cellSize > 0.0f);
+
+	quadCountX_ = quadCountX;
+	quadCountZ_ = quadCountZ;
+	cellSize_ = cellSize;
+	patchQuadCount_ = patchQuadCount;
+	patchCountX_ = quadCountX / patchQuadCount;
+	patchCountZ_ = quadCountZ / patchQuadCount;
+	skirtDepth_ = skirtDepth;
+
+	// 格子点(n+1)^2個の後ろに外周のスカート頂点4n個
+	patchVertexCount_ = (patchQuadCount + 1) * (patchQuadCount + 1) + patchQuadCount * 4;
+	assert(patchVertexCount_ <= UINT16_MAX);
+
+	heights_.assign(size_t(GetVertexCountX()) * GetVertexCountZ(), 0.0f);
+	vertices_.assign(size_t(GetPatchCount()) * patchVertexCount_, Vertex{});
+	patchMinHeights_.assign(GetPatchCount(), 0.0f);
+	patchMaxHeights_.assign(GetPatchCount(), 0.0f);
+	dirtyPatches_.assign(GetPatchCount(), true);
+	rebuiltPatches_.clear();
+	patchLods_.assign(GetPatchCount(), 0);
+	lods_.resize(lodCount);
+	BuildIndices();
+
+	statistics_ = {};
+	statistics_.patchCount = GetPatchCount();
+}
+
+void TerrainPatches::SetHeight(uint32_t x, uint32_t z, float height) {
+	assert(x < GetVertexCountX() && z < GetVertexCountZ());
+	heights_[z * GetVertexCountX() + x] = height;
+	MarkDirty(x, z, x, z);
+}
+
+void TerrainPatches::SetHeights(const float* heights) {
+	std::copy(heights, heights + heights_.size(), heights_.begin());
+	std::fill(dirtyPatches_.begin(), dirtyPatches_.end(), true);
+}
+
+void TerrainPatches::Raise(const Vector2& center, float radius, float amount) {
+	assert(radius > 0.0f);
+	// 円に外接する格子点の範囲
+	float minX = std::floor((center.x - radius) / cellSize_);
+	float maxX = std::ceil((center.x + radius) / cellSize_);
+	float minZ = std::floor((center.y - radius) / cellSize_);
+	float maxZ = std::ceil((center.y + radius) / cellSize_);
+	if (maxX < 0.0f || maxZ < 0.0f || minX > float(quadCountX_) || minZ > float(quadCountZ_)) {
+		return;
+	}
+	uint32_t x0 = uint32_t(std::max(minX, 0.0f));
+	uint32_t x1 = uint32_t(std::min(maxX, float(quadCountX_)));
+	uint32_t z0 = uint32_t(std::max(minZ, 0.0f));
+	uint32_t z1 = uint32_t(std::min(maxZ, float(quadCountZ_)));
+
+	for (uint32_t z = z0; z <= z1; z++) {
+		for (uint32_t x = x0; x <= x1; x++) {
+			float dx = float(x) * cellSize_ - center.x;
+			float dz = float(z) * cellSize_ - center.y;
+			float t = (dx * dx + dz * dz) / (radius * radius);
+			if (t < 1.0f) {
+				heights_[z * GetVertexCountX() + x] += amount * (1.0f - t) * (1.0f - t);
+			}
+		}
+	}
+	MarkDirty(x0, z0, x1, z1);
+}
+
+const std::vector<uint32_t>& TerrainPatches::Rebuild() {
+	rebuiltPatches_.clear();
+	for (uint32_t patch = 0; patch < GetPatchCount(); patch++) {
+		if (dirtyPatches_[patch]) {
+			dirtyPatches_[patch] = false;
+			rebuiltPatches_.push_back(patch);
+		}
+	}
+	// 区画ごとに自分の頂点と高さの範囲だけを書くので、区画ごとにジョブへ分ける
+	JobSystem::GetInstance()->ParallelFor(
+	    uint32_t(rebuiltPatches_.size()), 1, [this](uint32_t begin, uint32_t end) {
+		    for (uint32_t i = begin; i < end; i++) {
+			    BuildPatch(rebuiltPatches_[i]);
+		    }
+	    });
+	statistics_.rebuiltPatchCount = uint32_t(rebuiltPatches_.size());
+	return rebuiltPatches_;
+}
+
+const std::vector<uint32_t>& TerrainPatches::SelectLods(
+    const Vector3& cameraPosition, float lodDistance) {
+	assert(lodDistance > 0.0f);
+	statistics_.triangleCount = 0;
+	statistics_.fullDetailTriangleCount = 0;
+	std::fill(std::begin(statistics_.lodPatchCounts), std::end(statistics_.lodPatchCounts), 0);
+
+	float patchSize = float(patchQuadCount_) * cellSize_;
+	for (uint32_t pz = 0; pz < patchCountZ_; pz++) {
+		for (uint32_t px = 0; px < patchCountX_; px++) {
+			uint32_t patch = pz * patchCountX_ + px;
+
+			// 区画の箱からカメラまでの距離
+			float minX = float(px) * patchSize;
+			float minZ = float(pz) * patchSize;
+			float dx = std::max(
+			    {minX - cameraPosition.x, 0.0f, cameraPosition.x - (minX + patchSize)});
+			float dz = std::max(
+			    {minZ - cameraPosition.z, 0.0f, cameraPosition.z - (minZ + patchSize)});
+			float dy = std::max(
+			    {patchMinHeights_[patch] - cameraPosition.y, 0.0f,
+			     cameraPosition.y - patchMaxHeights_[patch]});
+			float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+			// 距離が2倍になるごとに詳細度を1つ下げる
+			uint32_t lod = 0;
+			float limit = lodDistance;
+			while (lod + 1 < GetLodCount() && distance >= limit) {
+				lod++;
+				limit *= 2.0f;
+			}
+			patchLods_[patch] = lod;
+
+			statistics_.triangleCount += lods_[lod].indexCount / 3;
+			statistics_.fullDetailTriangleCount += lods_[0].indexCount / 3;
+			statistics_.lodPatchCounts[lod]++;
+		}
+	}
+	return patchLods_;
+}
+
+void TerrainPatches::MarkDirty(uint32_t minX, uint32_t minZ, uint32_t maxX, uint32_t maxZ) {
+	// 法線は隣の格子点の高さから求めるので1つ外側まで
+	minX = minX > 0 ? minX - 1 : 0;
+	minZ = minZ > 0 ? minZ - 1 : 0;
+	maxX = std::min(maxX + 1, quadCountX_);
+	maxZ = std::min(maxZ + 1, quadCountZ_);
+
+	// 区画の境目の格子点は両側の区画に含まれる
+	uint32_t px0 = minX > 0 ? (minX - 1) / patchQuadCount_ : 0;
+	uint32_t pz0 = minZ > 0 ? (minZ - 1) / patchQuadCount_ : 0;
+	uint32_t px1 = std::min(maxX / patchQuadCount_, patchCountX_ - 1);
+	uint32_t pz1 = std::min(maxZ / patchQuadCount_, patchCountZ_ - 1);
+	for (uint32_t pz = pz0; pz <= pz1; pz++) {
+		for (uint32_t px = px0; px <= px1; px++) {
+			dirtyPatches_[pz * patchCountX_ + px] = true;
+		}
+	}
+}
+
+void TerrainPatches::BuildPatch(uint32_t patch) {
+	uint32_t n = patchQuadCount_;
+	uint32_t originX = (patch % patchCountX_) * n;
+	uint32_t originZ = (patch / patchCountX_) * n;
+	uint32_t vertexCountX = GetVertexCountX();
+	Vertex* vertices = vertices_.data() + size_t(patch) * patchVertexCount_;
+
+	float minHeight = heights_[originZ * vertexCountX + originX];
+	float maxHeight = minHeight;
+	for (uint32_t z = 0; z <= n; z++) {
+		for (uint32_t x = 0; x <= n; x++) {
+			uint32_t gx = originX + x;
+			uint32_t gz = originZ + z;
+			float height = heights_[gz * vertexCountX + gx];
+			minHeight = std::min(minHeight, height);
+			maxHeight = std::max(maxHeight, height);
+
+			// 隣の格子点との差分で法線を求める（地形の端は片側）
+			uint32_t left = gx > 0 ? gx - 1 : gx;
+			uint32_t right = std::min(gx + 1, quadCountX_);
+			uint32_t back = gz > 0 ? gz - 1 : gz;
+			uint32_t front = std::min(gz + 1, quadCountZ_);
+			float slopeX =
+			    (heights_[gz * vertexCountX + right] - heights_[gz * vertexCountX + left]) /
+			    (float(right - left) * cellSize_);
+			float slopeZ =
+			    (heights_[front * vertexCountX + gx] - heights_[back * vertexCountX + gx]) /
+			    (float(front - back) * cellSize_);
+			Vector3 normal = {-slopeX, 1.0f, -slopeZ};
+			float length =
+			    std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+
+			Vertex& vertex = vertices[GridIndex(x, z)];
+			vertex.pos = {float(gx) * cellSize_, height, float(gz) * cellSize_};
+			vertex.normal = {normal.x / length, normal.y / length, normal.z / length};
+			vertex.uv = {float(gx) / float(quadCountX_), 1.0f - float(gz) / float(quadCountZ_)};
+		}
+	}
+
+	// 外周を南→東→北→西の順に1周して、同じ頂点を真下にずらしたものをスカートにする
+	uint32_t skirtBase = (n + 1) * (n + 1);
+	for (uint32_t k = 0; k < n * 4; k++) {
+		Vertex skirt = vertices[BorderIndex(k)];
+		skirt.pos.y -= skirtDepth_;
+		vertices[skirtBase + k] = skirt;
+	}
+
+	patchMinHeights_[patch] = minHeight - skirtDepth_;
+	patchMaxHeights_[patch] = maxHeight;
+}
+
+uint16_t TerrainPatches::BorderIndex(uint32_t k) const {
+	uint32_t n = patchQuadCount_;
+	uint32_t side = k / n;
+	uint32_t t = k % n;
+	uint32_t x = side == 0 ? t : side == 1 ? n : side == 2 ? n - t : 0;
+	uint32_t z = side == 0 ? 0 : side == 1 ? t : side == 2 ? n : n - t;
+	return GridIndex(x, z);
+}
+
+void TerrainPatches::BuildIndices() {
+	uint32_t n = patchQuadCount_;
+	uint32_t skirtBase = (n + 1) * (n + 1);
+	uint32_t borderCount = n * 4;
+
+	indices_.clear();
+	for (uint32_t lod = 0; lod < GetLodCount(); lod++) {
+		uint32_t step = 1u << lod;
+		lods_[lod].indexOffset = uint32_t(indices_.size());
+
+		// 格子（上から見て時計回り）
+		for (uint32_t z = 0; z < n; z += step) {
+			for (uint32_t x = 0; x < n; x += step) {
+				uint16_t v00 = GridIndex(x, z);
+				uint16_t v01 = GridIndex(x, z + step);
+				uint16_t v10 = GridIndex(x + step, z);
+				uint16_t v11 = GridIndex(x + step, z + step);
+				indices_.insert(indices_.end(), {v00, v01, v10, v10, v01, v11});
+			}
+		}
+
+		// スカート（外から見て時計回り）
+		for (uint32_t k = 0; k < borderCount; k += step) {
+			uint32_t next = (k + step) % borderCount;
+			uint16_t top0 = BorderIndex(k);
+			uint16_t top1 = BorderIndex(next);
+			uint16_t bottom0 = uint16_t(skirtBase + k);
+			uint16_t bottom1 = uint16_t(skirtBase + next);
+			indices_.insert(indices_.end(), {top0, top1, bottom0, bottom0, top1, bottom1});
+		}
+
+		lods_[lod].indexCount = uint32_t(indices_.size()) - lods_[lod].indexOffset;
+	}
+}
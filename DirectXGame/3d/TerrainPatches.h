@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 区画分けした地形（区画ごとの頂点、詳細度ごとのインデックス、詳細度の選択）
+/// </summary>
+/// <remarks>
+/// 高さは地形全体で1枚の配列に持ち、頂点は区画ごとに(n+1)^2個の格子点と
+/// 外周に沿ったスカート頂点4n個を並べる。詳細度lは格子点を2^l個おきに使うだけなので、
+/// インデックスは全区画で共通になる。詳細度の違う区画の境目にできる隙間は、
+/// 外周から真下に垂らしたスカートで隠す。GPUやファイルに触れない。
+/// </remarks>
+class TerrainPatches {
+public:
+	// 既定の区画の一辺のマス数
+	static const uint32_t kDefaultPatchQuadCount = 32;
+	// 最大詳細度数
+	static const uint32_t kMaxLodCount = 6;
+
+	/// <summary>
+	/// 頂点（Mesh::VertexPosNormalUvと同じ並び）
+	/// </summary>
+	struct Vertex {
+		Vector3 pos;    // xyz座標
+		Vector3 normal; // 法線ベクトル
+		Vector2 uv;     // uv座標
+	};
+
+	/// <summary>
+	/// 詳細度ごとのインデックスの範囲
+	/// </summary>
+	struct Lod {
+		// 先頭
+		uint32_t indexOffset = 0;
+		// インデックス数
+		uint32_t indexCount = 0;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 区画数
+		uint32_t patchCount = 0;
+		// 直前のRebuildで作り直した区画数
+		uint32_t rebuiltPatchCount = 0;
+		// 直前のSelectLodsで描く三角形数
+		uint32_t triangleCount = 0;
+		// 直前のSelectLodsで全区画を最高詳細度で描いた場合の三角形数
+		uint32_t fullDetailTriangleCount = 0;
+		// 詳細度ごとの区画数
+		uint32_t lodPatchCounts[kMaxLodCount] = {};
+	};
+
+	/// <summary>
+	/// 初期化（高さは全て0、全区画を作り直し待ちにする）
+	/// </summary>
+	/// <param name="quadCountX">横のマス数（patchQuadCountの倍数）</param>
+	/// <param name="quadCountZ">奥行のマス数（patchQuadCountの倍数）</param>
+	/// <param name="cellSize">1マスの大きさ</param>
+	/// <param name="patchQuadCount">区画の一辺のマス数（2^(lodCount-1)の倍数）</param>
+	/// <param name="lodCount">詳細度数</param>
+	/// <param name="skirtDepth">スカートを垂らす深さ</param>
+	void Initialize(
+	    uint32_t quadCountX, uint32_t quadCountZ, float cellSize,
+	    uint32_t patchQuadCount = kDefaultPatchQuadCount, uint32_t lodCount = 4,
+	    float skirtDepth = 1.0f);
+
+	/// <summary>
+	/// 格子点の高さの取得
+	/// </summary>
+	float GetHeight(uint32_t x, uint32_t z) const { return heights_[z * GetVertexCountX() + x]; }
+
+	/// <summary>
+	/// 格子点の高さをセット（影響する区画を作り直し待ちにする）
+	/// </summary>
+	void SetHeight(uint32_t x, uint32_t z, float height);
+
+	/// <summary>
+	/// 全ての高さをセット（全区画を作り直し待ちにする）
+	/// </summary>
+	/// <param name="heights">GetVertexCountX() * GetVertexCountZ()個、行優先</param>
+	void SetHeights(const float* heights);
+
+	/// <summary>
+	/// 円の範囲を盛り上げる（中心ほど高く、縁で0）
+	/// </summary>
+	/// <param name="center">中心（ローカル座標のxz）</param>
+	/// <param name="radius">半径</param>
+	/// <param name="amount">中心の高さの増分（負なら掘る）</param>
+	void Raise(const Vector2& center, float radius, float amount);
+
+	/// <summary>
+	/// 作り直し待ちの区画の頂点を作り直す
+	/// </summary>
+	/// <returns>作り直した区画番号（昇順。次の呼び出しまで有効）</returns>
+	const std::vector<uint32_t>& Rebuild();
+
+	/// <summary>
+	/// カメラからの距離で区画ごとの詳細度を選ぶ
+	/// </summary>
+	/// <param name="cameraPosition">カメラ座標（ローカル座標）</param>
+	/// <param name="lodDistance">詳細度0で描く距離（詳細度が1上がるごとに2倍）</param>
+	/// <returns>区画ごとの詳細度（次の呼び出しまで有効）</returns>
+	const std::vector<uint32_t>& SelectLods(const Vector3& cameraPosition, float lodDistance);
+
+	uint32_t GetVertexCountX() const { return quadCountX_ + 1; }
+	uint32_t GetVertexCountZ() const { return quadCountZ_ + 1; }
+	uint32_t GetPatchCountX() const { return patchCountX_; }
+	uint32_t GetPatchCountZ() const { return patchCountZ_; }
+	uint32_t GetPatchCount() const { return patchCountX_ * patchCountZ_; }
+	uint32_t GetLodCount() const { return uint32_t(lods_.size()); }
+
+	/// <summary>
+	/// 1区画の頂点数（格子点とスカート）
+	/// </summary>
+	uint32_t GetPatchVertexCount() const { return patchVertexCount_; }
+
+	/// <summary>
+	/// 全区画の頂点（区画pの頂点はp * GetPatchVertexCount()から）
+	/// </summary>
+	const std::vector<Vertex>& GetVertices() const { return vertices_; }
+
+	/// <summary>
+	/// 全詳細度のインデックス（区画内の頂点番号。全区画共通）
+	/// </summary>
+	const std::vector<uint16_t>& GetIndices() const { return indices_; }
+
+	/// <summary>
+	/// 詳細度のインデックスの範囲
+	/// </summary>
+	const Lod& GetLod(uint32_t lod) const { return lods_[lod]; }
+
+	/// <summary>
+	/// 直前のSelectLodsで選んだ区画の詳細度
+	/// </summary>
+	uint32_t GetPatchLod(uint32_t patch) const { return patchLods_[patch]; }
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	/// <summary>
+	/// 格子点の範囲に掛かる区画を作り直し待ちにする（法線が変わる隣の格子点も含める）
+	/// </summary>
+	void MarkDirty(uint32_t minX, uint32_t minZ, uint32_t maxX, uint32_t maxZ);
+
+	/// <summary>
+	/// 1区画の頂点を作る
+	/// </summary>
+	void BuildPatch(uint32_t patch);
+
+	/// <summary>
+	/// 全詳細度のインデックスを作る
+	/// </summary>
+	void BuildIndices();
+
+	/// <summary>
+	/// 区画内の格子点番号
+	/// </summary>
+	uint16_t GridIndex(uint32_t x, uint32_t z) const {
+		return uint16_t(z * (patchQuadCount_ + 1) + x);
+	}
+
+	/// <summary>
+	/// 外周を南→東→北→西の順に1周したk番目の格子点番号
+	/// </summary>
+	uint16_t BorderIndex(uint32_t k) const;
+
+	// 横と奥行のマス数
+	uint32_t quadCountX_ = 0;
+	uint32_t quadCountZ_ = 0;
+	// 1マスの大きさ
+	float cellSize_ = 1.0f;
+	// 区画の一辺のマス数
+	uint32_t patchQuadCount_ = kDefaultPatchQuadCount;
+	// 横と奥行の区画数
+	uint32_t patchCountX_ = 0;
+	uint32_t patchCountZ_ = 0;
+	// 1区画の頂点数
+	uint32_t patchVertexCount_ = 0;
+	// スカートを垂らす深さ
+	float skirtDepth_ = 1.0f;
+
+	// 格子点の高さ
+	std::vector<float> heights_;
+	// 全区画の頂点
+	std::vector<Vertex> vertices_;
+	// 全詳細度のインデックス
+	std::vector<uint16_t> indices_;
+	// 詳細度ごとのインデックスの範囲
+	std::vector<Lod> lods_;
+	// 区画ごとの高さの範囲（詳細度の選択用）
+	std::vector<float> patchMinHeights_;
+	std::vector<float> patchMaxHeights_;
+	// 作り直し待ちの区画
+	std::vector<bool> dirtyPatches_;
+	// 作り直した区画番号
+	std::vector<uint32_t> rebuiltPatches_;
+	// 区画ごとの詳細度
+	std::vector<uint32_t> patchLods_;
+	// 統計情報
+	Statistics statistics_;
+};
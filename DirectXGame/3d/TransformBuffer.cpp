@@ -0,0 +1,69 @@
+#include "TransformBuffer.h"
+#include "DirectXCommon.h"
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+void TransformBuffer::Initialize(ID3D12Device* device, uint32_t capacity) {
+	assert(device);
+	assert(capacity > 0);
+	capacity_ = capacity;
+	boundTransforms_.assign(capacity_, nullptr);
+	uint32_t frameCount = DirectXCommon::GetInstance()->GetFrameCount();
+	staleIndices_.assign(frameCount, {});
+	frameIndex_ = 0;
+
+	// 定数バッファ生成（フレーム数分の領域）
+	HRESULT result = S_FALSE;
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc =
+	    CD3DX12_RESOURCE_DESC::Buffer(uint64_t(kStride) * capacity_ * frameCount);
+	result = device->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&constBuffer_));
+	assert(SUCCEEDED(result));
+
+	// 永続マップ
+	result = constBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&constMap_));
+	assert(SUCCEEDED(result));
+}
+
+void TransformBuffer::Bind(uint32_t index, WorldTransform* worldTransform) {
+	assert(index < capacity_);
+	boundTransforms_[index] = worldTransform;
+}
+
+void TransformBuffer::Upload(const TransformHierarchy& hierarchy) {
+	assert(constMap_);
+	assert(hierarchy.GetCount() <= capacity_);
+
+	frameIndex_ = DirectXCommon::GetInstance()->GetFrameIndex();
+	uint8_t* regionMap = constMap_ + size_t(kStride) * capacity_ * frameIndex_;
+
+	// 他の領域に書いた変更をこの領域にも反映する
+	std::vector<uint32_t>& staleIndices = staleIndices_[frameIndex_];
+	for (uint32_t index : staleIndices) {
+		const Matrix4x4& matWorld = hierarchy.GetWorldMatrix(index);
+		std::memcpy(regionMap + size_t(kStride) * index, &matWorld, sizeof(Matrix4x4));
+	}
+	staleIndices.clear();
+
+	const std::vector<uint32_t>& changedIndices = hierarchy.GetChangedIndices();
+	for (uint32_t index : changedIndices) {
+		const Matrix4x4& matWorld = hierarchy.GetWorldMatrix(index);
+		std::memcpy(regionMap + size_t(kStride) * index, &matWorld, sizeof(Matrix4x4));
+
+		if (WorldTransform* worldTransform = boundTransforms_[index]) {
+			worldTransform->matWorld_ = matWorld;
+			worldTransform->TransferMatrix();
+		}
+	}
+
+	// 他の領域は次にその領域を使うときに書く
+	for (uint32_t i = 0; i < uint32_t(staleIndices_.size()); i++) {
+		if (i != frameIndex_) {
+			staleIndices_[i].insert(
+			    staleIndices_[i].end(), changedIndices.begin(), changedIndices.end());
+		}
+	}
+}
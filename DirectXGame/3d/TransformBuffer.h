@@ -0,0 +1,63 @@
+#pragma once
+
+#include "TransformHierarchy.h"
+#include "WorldTransform.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// トランスフォーム階層のワールド行列を1本のアップロードバッファにまとめて置く定数バッファ
+/// </summary>
+/// <remarks>
+/// GPUが処理中のフレームの行列を書き換えないように、同時に処理中になりうるフレーム数分の領域を持つ。
+/// </remarks>
+class TransformBuffer {
+public:
+	// 1ノード分の定数バッファの大きさ（CBVの配置単位）
+	static const uint32_t kStride = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="capacity">最大ノード数</param>
+	void Initialize(ID3D12Device* device, uint32_t capacity);
+
+	/// <summary>
+	/// ノードにWorldTransformを結び付ける（Model::Draw用に行列を書き写す）
+	/// </summary>
+	/// <param name="index">ノード番号</param>
+	/// <param name="worldTransform">書き写し先。nullptrなら解除</param>
+	void Bind(uint32_t index, WorldTransform* worldTransform);
+
+	/// <summary>
+	/// 今のフレームの領域に、前回その領域へ書いてから変わったワールド行列だけ転送する
+	/// </summary>
+	/// <param name="hierarchy">トランスフォーム階層（Update済み）</param>
+	void Upload(const TransformHierarchy& hierarchy);
+
+	/// <summary>
+	/// 直前にUploadした領域でのノードの定数バッファのGPUアドレス（ConstBufferDataWorldTransform）
+	/// </summary>
+	/// <param name="index">ノード番号</param>
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress(uint32_t index) const {
+		return constBuffer_->GetGPUVirtualAddress() +
+		       uint64_t(kStride) * (uint64_t(capacity_) * frameIndex_ + index);
+	}
+
+private:
+	// 定数バッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
+	// マッピング済みアドレス
+	uint8_t* constMap_ = nullptr;
+	// 最大ノード数
+	uint32_t capacity_ = 0;
+	// 直前にUploadした領域の番号
+	uint32_t frameIndex_ = 0;
+	// 領域ごとの、他の領域で転送済みだがこの領域にはまだ書いていないノード番号
+	std::vector<std::vector<uint32_t>> staleIndices_;
+	// 書き写し先
+	std::vector<WorldTransform*> boundTransforms_;
+};
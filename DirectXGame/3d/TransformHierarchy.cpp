@@ -0,0 +1,139 @@
+#include "TransformHierarchy.h"
+#include <cassert>
+
+uint32_t TransformHierarchy::Add(
+    uint32_t parent, const Vector3& scale, const Vector3& rotation, const Vector3& translation) {
+	uint32_t index = GetCount();
+	// 親が先に並んでいることが一度の走査の前提
+	assert(parent == kNoParent || parent < index);
+
+	scaleX_.push_back(scale.x);
+	scaleY_.push_back(scale.y);
+	scaleZ_.push_back(scale.z);
+	rotationX_.push_back(rotation.x);
+	rotationY_.push_back(rotation.y);
+	rotationZ_.push_back(rotation.z);
+	translationX_.push_back(translation.x);
+	translationY_.push_back(translation.y);
+	translationZ_.push_back(translation.z);
+	parents_.push_back(parent);
+	localMatrices_.push_back(MakeIdentity4x4());
+	worldMatrices_.push_back(MakeIdentity4x4());
+	localDirty_.push_back(1);
+	worldDirty_.push_back(0);
+	hasDirty_ = true;
+
+	return index;
+}
+
+void TransformHierarchy::Clear() {
+	for (std::vector<float>* stream :
+	     {&scaleX_, &scaleY_, &scaleZ_, &rotationX_, &rotationY_, &rotationZ_, &translationX_,
+	      &translationY_, &translationZ_}) {
+		stream->clear();
+	}
+	parents_.clear();
+	localMatrices_.clear();
+	worldMatrices_.clear();
+	localDirty_.clear();
+	worldDirty_.clear();
+	changedIndices_.clear();
+	hasDirty_ = false;
+}
+
+void TransformHierarchy::Reserve(uint32_t capacity) {
+	for (std::vector<float>* stream :
+	     {&scaleX_, &scaleY_, &scaleZ_, &rotationX_, &rotationY_, &rotationZ_, &translationX_,
+	      &translationY_, &translationZ_}) {
+		stream->reserve(capacity);
+	}
+	parents_.reserve(capacity);
+	localMatrices_.reserve(capacity);
+	worldMatrices_.reserve(capacity);
+	localDirty_.reserve(capacity);
+	worldDirty_.reserve(capacity);
+	changedIndices_.reserve(capacity);
+}
+
+void TransformHierarchy::SetScale(uint32_t index, const Vector3& scale) {
+	scaleX_[index] = scale.x;
+	scaleY_[index] = scale.y;
+	scaleZ_[index] = scale.z;
+	localDirty_[index] = 1;
+	hasDirty_ = true;
+}
+
+void TransformHierarchy::SetRotation(uint32_t index, const Vector3& rotation) {
+	rotationX_[index] = rotation.x;
+	rotationY_[index] = rotation.y;
+	rotationZ_[index] = rotation.z;
+	localDirty_[index] = 1;
+	hasDirty_ = true;
+}
+
+void TransformHierarchy::SetTranslation(uint32_t index, const Vector3& translation) {
+	translationX_[index] = translation.x;
+	translationY_[index] = translation.y;
+	translationZ_[index] = translation.z;
+	localDirty_[index] = 1;
+	hasDirty_ = true;
+}
+
+Vector3 TransformHierarchy::GetScale(uint32_t index) const {
+	return {scaleX_[index], scaleY_[index], scaleZ_[index]};
+}
+
+Vector3 TransformHierarchy::GetRotation(uint32_t index) const {
+	return {rotationX_[index], rotationY_[index], rotationZ_[index]};
+}
+
+Vector3 TransformHierarchy::GetTranslation(uint32_t index) const {
+	return {translationX_[index], translationY_[index], translationZ_[index]};
+}
+
+void TransformHierarchy::Update() {
+	changedIndices_.clear();
+	if (!hasDirty_) {
+		return;
+	}
+	hasDirty_ = false;
+
+	uint32_t count = GetCount();
+
+	// ローカル行列は変更のあった連続区間ごとにまとめて作る
+	for (uint32_t start = 0; start < count;) {
+		if (!localDirty_[start]) {
+			start++;
+			continue;
+		}
+		uint32_t end = start + 1;
+		while (end < count && localDirty_[end]) {
+			end++;
+		}
+		TransformArrays arrays = {
+		    {&scaleX_[start], &scaleY_[start], &scaleZ_[start]},
+		    {&rotationX_[start], &rotationY_[start], &rotationZ_[start]},
+		    {&translationX_[start], &translationY_[start], &translationZ_[start]},
+		};
+		MakeAffineMatrices(arrays, end - start, &localMatrices_[start]);
+		start = end;
+	}
+
+	// 親が先に並んでいるので、先頭から一度走査すれば変更が子孫まで伝わる
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t parent = parents_[i];
+		bool isDirty = localDirty_[i] || (parent != kNoParent && worldDirty_[parent]);
+		worldDirty_[i] = isDirty;
+		localDirty_[i] = 0;
+		if (!isDirty) {
+			continue;
+		}
+
+		if (parent == kNoParent) {
+			worldMatrices_[i] = localMatrices_[i];
+		} else {
+			worldMatrices_[i] = Multiply(localMatrices_[i], worldMatrices_[parent]);
+		}
+		changedIndices_.push_back(i);
+	}
+}
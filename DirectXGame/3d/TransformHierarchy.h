@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "MyMath.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// トランスフォーム階層（ローカルSRTをSoAで持ち、親子順に並べて一度の走査でワールド行列を求める）
+/// </summary>
+/// <remarks>
+/// 親は必ず子より前に追加するので、先頭から順に処理すれば親のワールド行列は計算済みになる。
+/// GPUやファイルに触れない。
+/// </remarks>
+class TransformHierarchy {
+public:
+	// 親なし
+	static constexpr uint32_t kNoParent = UINT32_MAX;
+
+	/// <summary>
+	/// ノードの追加
+	/// </summary>
+	/// <param name="parent">親のノード番号（追加済みであること）。親なしならkNoParent</param>
+	/// <param name="scale">ローカルスケール</param>
+	/// <param name="rotation">X,Y,Z軸回りのローカル回転角</param>
+	/// <param name="translation">ローカル座標</param>
+	/// <returns>ノード番号</returns>
+	uint32_t Add(
+	    uint32_t parent, const Vector3& scale = {1, 1, 1}, const Vector3& rotation = {0, 0, 0},
+	    const Vector3& translation = {0, 0, 0});
+
+	/// <summary>
+	/// 全ノードの破棄
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 容量の予約
+	/// </summary>
+	/// <param name="capacity">ノード数</param>
+	void Reserve(uint32_t capacity);
+
+	void SetScale(uint32_t index, const Vector3& scale);
+	void SetRotation(uint32_t index, const Vector3& rotation);
+	void SetTranslation(uint32_t index, const Vector3& translation);
+
+	Vector3 GetScale(uint32_t index) const;
+	Vector3 GetRotation(uint32_t index) const;
+	Vector3 GetTranslation(uint32_t index) const;
+	uint32_t GetParent(uint32_t index) const { return parents_[index]; }
+
+	/// <summary>
+	/// 変更のあったノードとその子孫だけ行列を更新する
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// ワールド行列の取得（Update後に有効）
+	/// </summary>
+	const Matrix4x4& GetWorldMatrix(uint32_t index) const { return worldMatrices_[index]; }
+
+	/// <summary>
+	/// 直前のUpdateでワールド行列が変わったノード番号（昇順）
+	/// </summary>
+	const std::vector<uint32_t>& GetChangedIndices() const { return changedIndices_; }
+
+	/// <summary>
+	/// ノード数の取得
+	/// </summary>
+	uint32_t GetCount() const { return uint32_t(parents_.size()); }
+
+private:
+	// ローカルスケール
+	std::vector<float> scaleX_;
+	std::vector<float> scaleY_;
+	std::vector<float> scaleZ_;
+	// ローカル回転角
+	std::vector<float> rotationX_;
+	std::vector<float> rotationY_;
+	std::vector<float> rotationZ_;
+	// ローカル座標
+	std::vector<float> translationX_;
+	std::vector<float> translationY_;
+	std::vector<float> translationZ_;
+	// 親のノード番号（自分より小さい）
+	std::vector<uint32_t> parents_;
+	// ローカル行列
+	std::vector<Matrix4x4> localMatrices_;
+	// ワールド行列
+	std::vector<Matrix4x4> worldMatrices_;
+	// ローカルSRTが変わった
+	std::vector<uint8_t> localDirty_;
+	// ワールド行列の再計算が必要（Update内で使う）
+	std::vector<uint8_t> worldDirty_;
+	// 直前のUpdateで変わったノード番号
+	std::vector<uint32_t> changedIndices_;
+	// 変更のあったノードがあるか
+	bool hasDirty_ = false;
+};
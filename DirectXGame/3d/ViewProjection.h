@@ -3,6 +3,7 @@
 #include "Matrix4x4.h"
 #include "Vector3.h"
 #include "Mymath.h"
+#include "Quaternion.h"
 #include <d3d12.h>
 #include <type_traits>
 #include <wrl.h>
@@ -65,11 +66,21 @@ public:
 	void UpdateViewMatrixZFree() {
 		// 拡大率を1に固定し、回転と平行移動を適用
 		matView = MakeAffineMatrix({ 1, 1, 1 }, rotation_, translation_);
-		matView = Inverse(matView); // 行列の逆行列を求める
+		matView = InverseRigid(matView); // 回転と平行移動だけなので転置で逆行列を求める
 		UpdateProjectionMatrix();   // 射影行列の更新
 		TransferMatrix();           // 定数バッファに転送
 	}
 
+	/// <summary>
+	/// クォータニオンの回転でビュー行列を更新する（rotation_は使わない）
+	/// </summary>
+	/// <param name="rotation">回転</param>
+	void UpdateViewMatrixZFree(const Quaternion& rotation) {
+		matView = MakeViewMatrix(rotation, translation_);
+		UpdateProjectionMatrix();
+		TransferMatrix();
+	}
+
 	/// <summary>
 	/// 行列を転送する
 	/// </summary>
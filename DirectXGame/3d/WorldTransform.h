@@ -7,6 +7,8 @@
 #include <wrl.h>
 #include "MyMath.h"
 
+struct Quaternion;
+
 
 // 定数バッファ用データ構造体
 struct ConstBufferDataWorldTransform {
@@ -42,6 +44,11 @@ public:
 	/// </summary>
 	void UpdateMatrix();
 	/// <summary>
+	/// クォータニオンの回転で行列を更新する（rotation_は使わない）
+	/// </summary>
+	/// <param name="rotation">回転</param>
+	void UpdateMatrix(const Quaternion& rotation);
+	/// <summary>
 	/// 定数バッファ生成
 	/// </summary>
 	void CreateConstBuffer();
@@ -1,8 +1,16 @@
 #include "WorldTransform.h"
+#include "Quaternion.h"
 
 void WorldTransform::UpdateMatrix() {
 
 	matWorld_ = MakeAffineMatrix(scale_, rotation_, translation_);
 	TransferMatrix();
 
-}
\ No newline at end of file
+}
+
+void WorldTransform::UpdateMatrix(const Quaternion& rotation) {
+
+	matWorld_ = MakeAffineMatrix(scale_, rotation, translation_);
+	TransferMatrix();
+
+}
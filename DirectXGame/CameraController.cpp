@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "CameraController.h"
+#include "CameraRoll.h"
 #include "Player.h"
 #include <format>
 #include <cmath> // fmod関数を使用
@@ -19,7 +20,7 @@ void CameraController::Update() {
 #ifdef DEBUG
 	// ImGuiでカメラの回転状態を表示
 	ImGui::Begin("CameraRotate");
-	ImGui::Text("viewprojection.Z: %0.1f", viewProjection_.rotation_.z);  // Z軸回転角度を表示
+	ImGui::Text("rotationTimer: %0.2f", rotationTimer_);  // 回転の経過時間を表示
 	ImGui::End();
 #endif
 
@@ -67,10 +68,10 @@ void CameraController::Update() {
 		// 移動範囲制限（X軸）
 		viewProjection_.translation_.y = std::clamp(viewProjection_.translation_.y, 
 			movableArea_.bottom, movableArea_.top);
-	}
 
-	// ビュープロジェクション行列の更新
-	viewProjection_.UpdateViewMatrixZFree();
+		// ビュープロジェクション行列の更新（回転中はUpdateRotationがクォータニオンで更新する）
+		viewProjection_.UpdateViewMatrixZFree();
+	}
 }
 
 void CameraController::Reset() {
@@ -85,22 +86,15 @@ void CameraController::UpdateRotation() {
 			isRotating_ = false;
 			t = 1.0f;
 		}
-		// 回転のための定数
-		const float PI = 3.1415927f;
 		// プレイヤーの位置を取得
 		Vector3 playerPos = target_->GetWorldPosition();
 		viewProjection_.translation_.y = playerPos.y + 5.0f; // カメラの高さ調整
 
-		// 反転時は180度回転
-		if (t < 1.5f) {
-			viewProjection_.rotation_.z = PI * (2.0f * t);
-		}
-		else {
-			viewProjection_.rotation_.z = PI * (2.0f * (1.0f - t));
-		}
+		// Z軸回りに0度→180度→360度と回す（rotation_は使わない）
+		Quaternion rotation = MakeCameraRollRotation(t);
 
-		// 新しく作った UpdateViewMatrixZFree を呼び出してカメラの行列を更新
-		viewProjection_.UpdateViewMatrixZFree();
+		// クォータニオンの回転でカメラの行列を更新
+		viewProjection_.UpdateViewMatrixZFree(rotation);
 	}
 }
 
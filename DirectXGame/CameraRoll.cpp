@@ -0,0 +1,17 @@
+#include "CameraRoll.h"
+#include <algorithm>
+#include <cstdint>
+
+Quaternion MakeCameraRollRotation(float t) {
+	t = std::clamp(t, 0.0f, 1.0f);
+
+	// Z軸回りの0度、180度、360度
+	static const Quaternion kKeyRotations[] = {
+	    Quaternion::Identity(),
+	    Quaternion(0.0f, 0.0f, 0.0f, 1.0f),
+	    -Quaternion::Identity(),
+	};
+	uint32_t section = t < 0.5f ? 0 : 1;
+	float sectionT = t * 2.0f - float(section);
+	return Slerp(kKeyRotations[section], kKeyRotations[section + 1], sectionT);
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include "Quaternion.h"
+
+// 重力反転の演出でカメラをZ軸回りに一回転させる回転（tが0で0度、0.5で180度、1で360度）。
+// 180度ずつの2区間をSlerpでつなぐので、最短経路でも逆回りせずに一周する
+Quaternion MakeCameraRollRotation(float t);
@@ -1,8 +1,8 @@
 #pragma once
-#include "Model.h"
+#include "ParticleSystem.h"
+#include "ViewProjection.h"
 #include "assert.h"
 #include <array>
-#include "WorldTransform.h"
 #include <numbers>
 #include "MyMath.h"
 
@@ -11,32 +11,41 @@
 class DeathParticles {
 
 public:
-	void Initialize(Vector3 position, Model* model, ViewProjection* viewProjection );
+	void Initialize(Vector3 position, ViewProjection* viewProjection);
 
 	void Update();
 
+	/// <summary>
+	/// 描画（ParticleSystem::PreDraw～PostDrawの間で呼ぶ）
+	/// </summary>
 	void Draw();
 
 	bool GetIsFinished() const { return isFinished_; }
 
 private:
 
-	Model* model_ = nullptr;
 	ViewProjection* viewProjection_ = nullptr;
 
-	static inline const uint32_t kNumParticles = 8;
-	std::array<WorldTransform, kNumParticles> worldTransforms_;
+	static inline constexpr uint32_t kNumParticles = 8;
+	// XY平面上に等間隔に並んだ飛び散る方向（コンパイル時に計算）
+	static constexpr std::array<Vector3, kNumParticles> kDirections = [] {
+		std::array<Vector3, kNumParticles> directions;
+		for (uint32_t i = 0; i < kNumParticles; i++) {
+			float angle = 2.0f * std::numbers::pi_v<float> * float(i) / float(kNumParticles);
+			directions[i] = {ConstexprCos(angle), ConstexprSin(angle), 0.0f};
+		}
+		return directions;
+	}();
+	ParticleSystem particleSystem_;
 
 	// 存在時間
 	static inline const float kDuration = 2.0f;
-	// 移動の速さ
-	static inline const float kSpeed = 0.05f;
-	// 分割した１個分の角度
-	static inline const float kAngleUnit = 2 * std::numbers::pi_v<float> / kNumParticles;
+	// 移動の速さ[単位/秒]
+	static inline const float kSpeed = 0.05f * 60.0f;
+	// 粒の半径
+	static inline const float kSize = 0.25f;
 	//終了フラグ
 	bool isFinished_ = false;
 	//経過時間カウント
 	float counter_ = 0.0f;
-	ObjectColor objectColor_;
-	Vector4 color_;
 };
@@ -1,4 +1,5 @@
 #include "Door.h"
+#include "ModelRenderQueue.h"
 
 Door::Door() {}
 
@@ -23,5 +24,5 @@ void Door::Update() {
 }
 
 void Door::Draw() {
-	model_->Draw(worldTransform_, *viewProjection_);
+	ModelRenderQueue::GetInstance()->Draw(*model_, worldTransform_, *viewProjection_);
 }
\ No newline at end of file
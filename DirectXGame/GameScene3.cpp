@@ -1,4 +1,9 @@
 #include "GameScene3.h"
+#include "MemoryTracker.h"
+#include "ModelRenderQueue.h"
+#include "Profiler.h"
+#include "ClusteredLighting.h"
+#include "SpriteBatch.h"
 #include "TextureManager.h"
 #include <cassert>
 
@@ -12,15 +17,6 @@ GameScene3::~GameScene3() {
 	delete skydome_;
 	delete mapChipField_;
 	delete deathParticles_;
-	delete deathParticlesModel_;
-
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-			delete worldTransformBlock;
-		}
-	}
-	worldTransformBlocks_.clear();
 }
 
 void GameScene3::Initialize() {
@@ -29,21 +25,29 @@ void GameScene3::Initialize() {
 	input_ = Input::GetInstance();
 	audio_ = Audio::GetInstance();
 
-	// テクスチャ読み込み
-	texturHandle_ = TextureManager::Load("pralyer.png");
+	// テクスチャ読み込み（デコードはワーカースレッドで並列に行い、転送まではプレースホルダーを描く）
+	texturHandle_ = TextureManager::LoadAsync("pralyer.png");
 
 	//キーボードテクスチャ
-	keyHandle_ = TextureManager::Load("images/key.png");
-	keySprite_ = Sprite::Create(keyHandle_, { -20,-50 });
+	// UI画像はアトラスから（未ベイクなら単体のテクスチャ）
+	uiAtlas_.Load("atlas/ui.atlas");
+	uiAtlas_.LoadMissingAsync({"images/key.png", "images/invert.png"});
+	// スプライトの大きさとUVは画像の大きさから決まるので、生成前に読み込みを待つ
+	TextureManager::GetInstance()->WaitPending();
+	keySprite_ = uiAtlas_.CreateSprite("images/key.png", { -20,-50 });
+	keyHandle_ = keySprite_->GetTextureHandle();
 
 	//反転テクスチャ
-	invertHandle_ = TextureManager::Load("images/invert.png");
-	invertSprite_ = Sprite::Create(invertHandle_, { 300,0 });
+	invertSprite_ = uiAtlas_.CreateSprite("images/invert.png", { 300,0 });
+	invertHandle_ = invertSprite_->GetTextureHandle();
 
 	//サウンドデータ読み込み
-	BGMHandle_ = audio_->LoadWave("sound/BGM.mp3");
-	JumpSEHandle_ = audio_->LoadWave("sound/jump.mp3");
-	InvertSEHandle_ = audio_->LoadWave("sound/invert.mp3");
+	{
+		MEMORY_TAG_SCOPE(MemoryTracker::Tag::kAudio);
+		BGMHandle_ = audio_->LoadWave("sound/BGM.mp3");
+		JumpSEHandle_ = audio_->LoadWave("sound/jump.mp3");
+		InvertSEHandle_ = audio_->LoadWave("sound/invert.mp3");
+	}
 
 	audio_->PlayWave(BGMHandle_);
 
@@ -54,17 +58,25 @@ void GameScene3::Initialize() {
 	// ビュープロジェクションの初期化
 	viewProjection_.Initialize();
 
-	// SkyDome
-	skydome_ = new Skydome();
-	modelSkydome_ = Model::CreateFromOBJ("skydome", true);
-	skydome_->Initialize(modelSkydome_, &viewProjection_);
+	// 3Dモデルの読み込み
+	{
+		MEMORY_TAG_SCOPE(MemoryTracker::Tag::kModel);
 
-	// Block
-	blockModel_ = Model::CreateFromOBJ("block", true);
-	blockModel2_ = Model::CreateFromOBJ("block2", true);
+		// SkyDome
+		skydome_ = new Skydome();
+		modelSkydome_ = Model::CreateFromOBJ("skydome", true);
+		skydome_->Initialize(modelSkydome_, &viewProjection_);
 
-	// Door
-	doorModel_ = Model::CreateFromOBJ("door", true);
+		// Block
+		blockModel_ = Model::CreateFromOBJ("block", true);
+		blockModel2_ = Model::CreateFromOBJ("block2", true);
+
+		// Door
+		doorModel_ = Model::CreateFromOBJ("door", true);
+
+		// Player
+		model_ = Model::CreateFromOBJ("player", true); // 3Dモデルの生成
+	}
 
 	// DebugCamera
 	debugCamera_ = new DebugCamera(1280, 720);
@@ -76,7 +88,6 @@ void GameScene3::Initialize() {
 
 	// Player
 	player_ = new Player();
-	model_ = Model::CreateFromOBJ("player", true); // 3Dモデルの生成
 	Vector3 playerPostion = mapChipField_->GetMapChipPostionByIndex(3, 3);
 	player_->SetMapChipField(mapChipField_);
 	player_->Initialize(model_, &viewProjection_, playerPostion);
@@ -91,8 +102,7 @@ void GameScene3::Initialize() {
 
 	// DeathParticles
 	deathParticles_ = new DeathParticles;
-	deathParticlesModel_ = Model::CreateFromOBJ("deathParticle", true); // 3Dモデルの生成
-	deathParticles_->Initialize(playerPostion, deathParticlesModel_, &viewProjection_);
+	deathParticles_->Initialize(playerPostion, &viewProjection_);
 
 	// phase
 	phase_ = Phase::kplay;
@@ -133,16 +143,9 @@ void GameScene3::Update() {
 		cameraController_->Update();
 	}
 
-	// Block
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-			if (!worldTransformBlock)
-				continue;
-			worldTransformBlock->matWorld_ = MakeAffineMatrix(worldTransformBlock->scale_, worldTransformBlock->rotation_, worldTransformBlock->translation_);
-			// 定数バッファに転送する
-			worldTransformBlock->TransferMatrix();
-		}
-	}
+	// Block（変更のあったマスだけ行列を求め、このフレームの領域へ転送する）
+	blockTransforms_.Update();
+	blockTransformBuffer_.Upload(blockTransforms_);
 
 #ifdef _DEBUG
 	if (input_->TriggerKey(DIK_C)) {
@@ -188,62 +191,44 @@ void GameScene3::Update() {
 }
 
 void GameScene3::GenerateBlokcs() {
-
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kMap);
 	// 要素数
 	uint32_t numBlokVirtical = mapChipField_->GetNumBlockVirtical();     // 縦
 	uint32_t numBlokHorizontal = mapChipField_->GetNumBlockHorizontal(); // 横
 
-	// 要素数を変更する
-	// 列数を設定
-	worldTransformBlocks_.resize(numBlokVirtical);
+	// マスの位置は反転しても変わらないので、全マスのノードをマップ全体の子として作っておき、
+	// 描くかどうかはマップチップの種類で決める
+	blockTransforms_.Clear();
+	blockTransforms_.Reserve(numBlokVirtical * numBlokHorizontal + 1);
+	uint32_t mapNode = blockTransforms_.Add(TransformHierarchy::kNoParent);
+	blockNodes_.assign(numBlokVirtical, std::vector<uint32_t>(numBlokHorizontal));
 	for (uint32_t i = 0; i < numBlokVirtical; ++i) {
-		worldTransformBlocks_[i].resize(numBlokHorizontal);
+		for (uint32_t j = 0; j < numBlokHorizontal; ++j) {
+			blockNodes_[i][j] = blockTransforms_.Add(
+			    mapNode, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f},
+			    mapChipField_->GetMapChipPostionByIndex(j, i));
+		}
 	}
+	blockTransformBuffer_.Initialize(dxCommon_->GetDevice(), blockTransforms_.GetCount());
+}
 
-	// キューブ生成
-	for (uint32_t i = 0; i < numBlokVirtical; ++i) {
-		for (uint32_t j = 0; j < numBlokHorizontal; ++j) {
-			// マップチップの種類を取得
-			MapChipType mapChipType = mapChipField_->GetMapChipTypeByIndex(j, i);
-
-			// 1（ブロック）の場合のみ描画
-			if (mapChipType == MapChipType::kBlock || mapChipType == MapChipType::kBlock2) {
-				// 既存のワールドトランスフォームがない場合は新たに生成
-				if (!worldTransformBlocks_[i][j]) {
-					WorldTransform* worldTransform = new WorldTransform();
-					worldTransform->Initialize();
-					worldTransformBlocks_[i][j] = worldTransform;
-				}
-				// ブロックの位置を設定
-				worldTransformBlocks_[i][j]->translation_ = mapChipField_->GetMapChipPostionByIndex(j, i);
-				worldTransformBlocks_[i][j]->matWorld_ = MakeAffineMatrix(
-					worldTransformBlocks_[i][j]->scale_,
-					worldTransformBlocks_[i][j]->rotation_,
-					worldTransformBlocks_[i][j]->translation_);
-				worldTransformBlocks_[i][j]->TransferMatrix();
-			}
-			else if (mapChipType == MapChipType::kDoor) {
-				if (!worldTransformBlocks_[i][j]) {
-					WorldTransform* worldTransform = new WorldTransform();
-					worldTransform->Initialize();
-					worldTransformBlocks_[i][j] = worldTransform;
-				}
-				worldTransformBlocks_[i][j]->translation_ = mapChipField_->GetMapChipPostionByIndex(j, i);
-				worldTransformBlocks_[i][j]->matWorld_ = MakeAffineMatrix(
-					worldTransformBlocks_[i][j]->scale_,
-					worldTransformBlocks_[i][j]->rotation_,
-					worldTransformBlocks_[i][j]->translation_);
-				worldTransformBlocks_[i][j]->TransferMatrix();
-			}
-			else {
-				// 0（空白）の場合、ワールドトランスフォームを削除（描画しない）
-				if (worldTransformBlocks_[i][j]) {
-					delete worldTransformBlocks_[i][j];
-					worldTransformBlocks_[i][j] = nullptr;
-				}
+void GameScene3::UpdatePointLights() {
+	pointLights_.clear();
+	for (size_t i = 0; i < blockNodes_.size(); ++i) {
+		for (size_t j = 0; j < blockNodes_[i].size(); ++j) {
+			if (mapChipField_->GetMapChipTypeByIndex(uint32_t(j), uint32_t(i)) != MapChipType::kDoor) {
+				continue;
 			}
+			// ドアの少し手前を照らす
+			const Matrix4x4& matWorld = blockTransforms_.GetWorldMatrix(blockNodes_[i][j]);
+			LightCluster::PointLight light;
+			light.position = {matWorld.m[3][0], matWorld.m[3][1], matWorld.m[3][2] - 1.5f};
+			light.radius = 6.0f;
+			light.color = {1.0f, 0.8f, 0.5f};
+			pointLights_.push_back(light);
 		}
 	}
+	ClusteredLighting::GetInstance()->Update(viewProjection_, pointLights_);
 }
 
 void GameScene3::Draw() {
@@ -269,8 +254,13 @@ void GameScene3::Draw() {
 #pragma endregion
 
 #pragma region 3Dオブジェクト描画
+	// 点光源を格子に割り当てる
+	UpdatePointLights();
 	// 3Dオブジェクト描画前処理
 	Model::PreDraw(commandList);
+	// モデルは描画キューに溜めて並べ替えてから描く
+	ModelRenderQueue* modelRenderQueue = ModelRenderQueue::GetInstance();
+	modelRenderQueue->Begin(commandList);
 
 	/// <summary>
 	/// ここに3Dオブジェクトの描画処理を追加できる
@@ -280,56 +270,64 @@ void GameScene3::Draw() {
 		player_->Draw();
 	}
 
-	if (player_->GetIsDead_() == true) {
-		deathParticles_->Draw();
-	}
-
 	skydome_->Draw();
 
 	// ブロックとドアの描画
-	for (size_t i = 0; i < worldTransformBlocks_.size(); ++i) {
-		for (size_t j = 0; j < worldTransformBlocks_[i].size(); ++j) {
-			WorldTransform* worldTransformBlock = worldTransformBlocks_[i][j];
-			if (!worldTransformBlock) continue;
-
+	for (size_t i = 0; i < blockNodes_.size(); ++i) {
+		for (size_t j = 0; j < blockNodes_[i].size(); ++j) {
 			MapChipType mapChipType = mapChipField_->GetMapChipTypeByIndex(uint32_t(j), uint32_t(i));
 
 			if (mapChipType == MapChipType::kBlock) {
 				// ブロックの描画
-				blockModel_->Draw(*worldTransformBlock, viewProjection_);
+				modelRenderQueue->Draw(
+				    *blockModel_, blockTransforms_, blockTransformBuffer_, blockNodes_[i][j],
+				    viewProjection_);
 			}
 			else if (mapChipType == MapChipType::kDoor) {
 				// ドアの描画
-				doorModel_->Draw(*worldTransformBlock, viewProjection_);
+				modelRenderQueue->Draw(
+				    *doorModel_, blockTransforms_, blockTransformBuffer_, blockNodes_[i][j],
+				    viewProjection_);
 			}
 		}
 	}
 
+	modelRenderQueue->End();
 	// 3Dオブジェクト描画後処理
 	Model::PostDraw();
+
+	// パーティクル描画
+	ParticleSystem::PreDraw(commandList);
+
+	if (player_->GetIsDead_() == true) {
+		deathParticles_->Draw();
+	}
+
+	ParticleSystem::PostDraw();
 #pragma endregion
 
 #pragma region 前景スプライト描画
-	// 前景スプライト描画前処理
-	Sprite::PreDraw(commandList);
+	// 前景スプライト描画前処理（UIはバッチにまとめて描く）
+	SpriteBatch* spriteBatch = SpriteBatch::GetInstance();
+	spriteBatch->Begin(commandList);
 
 	/// <summary>
 	/// ここに前景スプライトの描画処理を追加できる
 	/// </summary>
 
 	if (playerPosition.x >= 0.0f && playerPosition.x <= 15.0f && invertFlg) {
-		keySprite_->Draw();
+		uiAtlas_.Draw(spriteBatch, *keySprite_, "images/key.png");
 	}
 
 	///
 	///反転してみようを描画
 	/// 
 	if (playerPosition.x >= 15.0f && playerPosition.x <= 19.0f && invertFlg) {
-		invertSprite_->Draw();
+		uiAtlas_.Draw(spriteBatch, *invertSprite_, "images/invert.png");
 	}
 
 	// スプライト描画後処理
-	Sprite::PostDraw();
+	spriteBatch->End();
 
 #pragma endregion
 }
@@ -345,7 +343,7 @@ void GameScene3::ChangePhase() {
 			phase_ = Phase::kDeath;
 			// 自キャラの座標を取得
 			const Vector3& deathParticlesPosition = player_->GetWorldPosition();
-			deathParticles_->Initialize(deathParticlesPosition, deathParticlesModel_, &viewProjection_);
+			deathParticles_->Initialize(deathParticlesPosition, &viewProjection_);
 		}
 		/*Clear();*/
 		break;
@@ -361,6 +359,8 @@ void GameScene3::ChangePhase() {
 #pragma region 反転
 
 void GameScene3::InvertBlockPositionsWithCentering() {
+	PROFILE_SCOPE("GameScene3::InvertBlockPositionsWithCentering");
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kMap);
 	// マップの縦横のブロック数を取得
 	uint32_t numBlockVertical = mapChipField_->GetNumBlockVirtical();     // 縦
 	uint32_t numBlockHorizontal = mapChipField_->GetNumBlockHorizontal(); // 横
@@ -405,32 +405,9 @@ void GameScene3::InvertBlockPositionsWithCentering() {
 				invertedChip = MapChipType::kBlank; // その他の種類は空白にする
 			}
 
-			// マップチップを更新（位置を反転させて）
+			// マップチップを更新（位置を反転させて）。マスのノードの位置は変わらないので、
+			// 描画はマップチップの種類を見て切り替わる
 			mapChipField_->SetMapChipTypeByIndex(invertedJ, invertedI, invertedChip);
-
-			if (invertedChip == MapChipType::kBlock || invertedChip == MapChipType::kDoor) {
-				// ブロックまたはドアが存在しなければ新しいワールドトランスフォームを作成
-				if (!worldTransformBlocks_[invertedI][invertedJ]) {
-					WorldTransform* worldTransform = new WorldTransform();
-					worldTransform->Initialize();
-					worldTransformBlocks_[invertedI][invertedJ] = worldTransform;
-				}
-				// ブロックまたはドアの位置を設定
-				Vector3 newPosition = mapChipField_->GetMapChipPostionByIndex(invertedJ, invertedI);
-				worldTransformBlocks_[invertedI][invertedJ]->translation_ = newPosition;
-				worldTransformBlocks_[invertedI][invertedJ]->matWorld_ = MakeAffineMatrix(
-					worldTransformBlocks_[invertedI][invertedJ]->scale_,
-					worldTransformBlocks_[invertedI][invertedJ]->rotation_,
-					worldTransformBlocks_[invertedI][invertedJ]->translation_);
-				worldTransformBlocks_[invertedI][invertedJ]->TransferMatrix();
-			}
-			else {
-				// ブロックまたはドアが空白になる場合は、メモリを解放して削除
-				if (worldTransformBlocks_[invertedI][invertedJ]) {
-					delete worldTransformBlocks_[invertedI][invertedJ];
-					worldTransformBlocks_[invertedI][invertedJ] = nullptr;
-				}
-			}
 		}
 	}
 
@@ -4,6 +4,7 @@
 #include "CameraController.h"
 #include "DebugCamera.h"
 #include "DirectXCommon.h"
+#include "LightCluster.h"
 #include "Input.h"
 #include "MapChipField.h"
 #include "Model.h"
@@ -11,6 +12,9 @@
 #include "Player.h" 
 #include "Skydome.h"
 #include "Sprite.h"
+#include "TextureAtlas.h"
+#include "TransformBuffer.h"
+#include "TransformHierarchy.h"
 #include "ViewProjection.h"
 #include "WorldTransform.h"
 #include "DeathParticles.h"
@@ -49,6 +53,11 @@ public: // メンバ関数
 	/// </summary>
 	void GenerateBlokcs();
 
+	/// <summary>
+	/// 点光源の更新（ドアの位置に置いてクラスタに割り当てる）
+	/// </summary>
+	void UpdatePointLights();
+
 	/// <summary>
 	/// 描画
 	/// </summary>
@@ -78,6 +87,9 @@ private: // メンバ変数
 	// テクスチャハンドル
 	uint32_t texturHandle_ = 0;
 
+	// UIアトラス
+	TextureAtlas uiAtlas_;
+
 	//キーボードテクスチャ
 	uint32_t keyHandle_ = 0;
 	Sprite* keySprite_ = nullptr;
@@ -108,10 +120,18 @@ private: // メンバ変数
 	// SkyDome
 	Skydome* skydome_ = nullptr;
 	Model* modelSkydome_ = nullptr;
-	std::vector<std::vector<WorldTransform*>> worldTransformBlocks_;
+
+	// ブロックとドアのトランスフォーム（マップ全体のノードを親に、全マスに1つずつ）
+	TransformHierarchy blockTransforms_;
+	// ブロックとドアのワールド行列の定数バッファ
+	TransformBuffer blockTransformBuffer_;
+	// マスのノード番号（[縦][横]）
+	std::vector<std::vector<uint32_t>> blockNodes_;
 
 	// Door
 	Model* doorModel_ = nullptr;
+	// ドアに置く点光源
+	std::vector<LightCluster::PointLight> pointLights_;
 
 	// MapChipField
 	MapChipField* mapChipField_;
@@ -123,7 +143,6 @@ private: // メンバ変数
 
 	//死エフェクト
 	DeathParticles* deathParticles_ = nullptr;
-	Model* deathParticlesModel_ = nullptr;
 
 	//フェーズ
 	Phase phase_;
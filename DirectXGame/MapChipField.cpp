@@ -1,4 +1,6 @@
 #include "MapChipField.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include <fstream>
 #include <map>
 #include <sstream>
@@ -24,6 +26,7 @@ void MapChipField::ResetMapChipData() {
 }
 
 void MapChipField::LoadMapChipCsv(const std::string& filePath) {
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kMap);
 	// マップチップデータをリセット
 	ResetMapChipData();
 
@@ -99,6 +102,8 @@ void MapChipField::SetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex, MapCh
 }
 
 void MapChipField::InvertMap() {
+	PROFILE_SCOPE("MapChipField::InvertMap");
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kMap);
 	// 新しいデータ構造を作成し、サイズを既存のマップチップデータと同じにする
 	std::vector<std::vector<MapChipType>> invertedData(kNumBlockVirtical, std::vector<MapChipType>(kNumBlockHorizontal));
 
@@ -1,71 +1,90 @@
 #include "MyMath.h"
 
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
-	Matrix4x4 ans;
-
-	ans.m[0][0] = 1;
-	ans.m[0][1] = 0;
-	ans.m[0][2] = 0;
-	ans.m[0][3] = 0;
-
-	ans.m[1][0] = 0;
-	ans.m[1][1] = 1;
-	ans.m[1][2] = 0;
-	ans.m[1][3] = 0;
-
-	ans.m[2][0] = 0;
-	ans.m[2][1] = 0;
-	ans.m[2][2] = 1;
-	ans.m[2][3] = 0;
-
-	ans.m[3][0] = translate.x;
-	ans.m[3][1] = translate.y;
-	ans.m[3][2] = translate.z;
-	ans.m[3][3] = 1;
-
-	return ans;
+// SIMDを使わない場合はMYMATH_NO_SIMDを定義する
+#if !defined(MYMATH_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#include <emmintrin.h>
+#define MYMATH_USE_SSE
+#elif !defined(MYMATH_NO_SIMD) && (defined(_M_ARM64) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define MYMATH_USE_NEON
+#endif
+
+namespace {
+
+#if defined(MYMATH_USE_SSE)
+
+// 4要素の並び替え（_MM_SHUFFLEの逆順指定）
+#define MYMATH_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+/// <summary>
+/// 2x2行列の積 a * b（各__m128は行優先の2x2行列）
+/// </summary>
+inline __m128 Mat2Multiply(__m128 a, __m128 b) {
+	return _mm_add_ps(
+	    _mm_mul_ps(a, MYMATH_SHUFFLE(b, b, 0, 3, 0, 3)),
+	    _mm_mul_ps(MYMATH_SHUFFLE(a, a, 1, 0, 3, 2), MYMATH_SHUFFLE(b, b, 2, 1, 2, 1)));
 }
 
-Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
-	Matrix4x4 ans;
-
-	ans.m[0][0] = scale.x;
-	ans.m[0][1] = 0;
-	ans.m[0][2] = 0;
-	ans.m[0][3] = 0;
-
-	ans.m[1][0] = 0;
-	ans.m[1][1] = scale.y;
-	ans.m[1][2] = 0;
-	ans.m[1][3] = 0;
-
-	ans.m[2][0] = 0;
-	ans.m[2][1] = 0;
-	ans.m[2][2] = scale.z;
-	ans.m[2][3] = 0;
-
-	ans.m[3][0] = 0;
-	ans.m[3][1] = 0;
-	ans.m[3][2] = 0;
-	ans.m[3][3] = 1;
-	return ans;
+/// <summary>
+/// 2x2行列の積 adj(a) * b
+/// </summary>
+inline __m128 Mat2AdjointMultiply(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+	    _mm_mul_ps(MYMATH_SHUFFLE(a, a, 3, 3, 0, 0), b),
+	    _mm_mul_ps(MYMATH_SHUFFLE(a, a, 1, 1, 2, 2), MYMATH_SHUFFLE(b, b, 2, 3, 0, 1)));
 }
 
-Vector3 TransformVector3(const Vector3& vector, const Matrix4x4& matrix) {
+/// <summary>
+/// 2x2行列の積 a * adj(b)
+/// </summary>
+inline __m128 Mat2MultiplyAdjoint(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+	    _mm_mul_ps(a, MYMATH_SHUFFLE(b, b, 3, 0, 3, 0)),
+	    _mm_mul_ps(MYMATH_SHUFFLE(a, a, 1, 0, 3, 2), MYMATH_SHUFFLE(b, b, 2, 1, 2, 1)));
+}
 
-	Vector3 ans;
+/// <summary>
+/// 4要素まとめてsinとcosを求める（最小最大近似多項式）
+/// </summary>
+inline void SinCos(__m128 radian, __m128& sin, __m128& cos) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 pi = _mm_set1_ps(3.14159265f);
+	const __m128 halfPi = _mm_set1_ps(1.57079633f);
+
+	// [-π, π]に収める。2πを上位(下位ビットが0で積が丸まらない)と下位に分けて引くと、
+	// 角度が大きくても2πの丸め誤差が周回数倍にならない
+	__m128 quotient = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(radian, _mm_set1_ps(0.159154943f))));
+	__m128 x = _mm_sub_ps(radian, _mm_mul_ps(quotient, _mm_set1_ps(6.28125f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(quotient, _mm_set1_ps(1.93530717e-3f)));
+
+	// [-π/2, π/2]に折り返す（cosは符号が反転する）
+	__m128 sign = _mm_and_ps(x, signMask);
+	__m128 reflected = _mm_sub_ps(_mm_or_ps(pi, sign), x);
+	__m128 isReflected = _mm_cmpgt_ps(_mm_andnot_ps(signMask, x), halfPi);
+	x = _mm_or_ps(_mm_and_ps(isReflected, reflected), _mm_andnot_ps(isReflected, x));
+	__m128 cosSign = _mm_and_ps(isReflected, signMask);
+
+	__m128 x2 = _mm_mul_ps(x, x);
+	__m128 s = _mm_set1_ps(-2.3889859e-08f);
+	s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(2.7525562e-06f));
+	s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(-0.00019840874f));
+	s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(0.0083333310f));
+	s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(-0.16666667f));
+	s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(1.0f));
+	sin = _mm_mul_ps(s, x);
+
+	__m128 c = _mm_set1_ps(-2.6051615e-07f);
+	c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(2.4760495e-05f));
+	c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(-0.0013888378f));
+	c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(0.041666638f));
+	c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(-0.5f));
+	c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(1.0f));
+	cos = _mm_xor_ps(c, cosSign);
+}
 
-	ans.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
-	ans.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
-	ans.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2];
-	float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+#endif
 
-	assert(w != 0.0f);
-	ans.x /= w;
-	ans.y /= w;
-	ans.z /= w;
-	return ans;
-}
+} // namespace
 
 Matrix4x4 MakeRotateXMatrix(float radian) {
 
@@ -152,8 +171,86 @@ Matrix4x4 MakeRotateZMatrix(float radian) {
 
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
 
-	Matrix4x4 rotateXYZ = Multiply(Multiply(MakeRotateXMatrix(rotate.x), MakeRotateYMatrix(rotate.y)), MakeRotateZMatrix(rotate.z));
-	return Multiply(Multiply(MakeScaleMatrix(scale), rotateXYZ), MakeTranslateMatrix(translate));
+	// S * Rx * Ry * Rz * T を展開した式で直接求める
+	float sinX = std::sin(rotate.x);
+	float cosX = std::cos(rotate.x);
+	float sinY = std::sin(rotate.y);
+	float cosY = std::cos(rotate.y);
+	float sinZ = std::sin(rotate.z);
+	float cosZ = std::cos(rotate.z);
+
+	Matrix4x4 ans;
+	ans.m[0][0] = scale.x * (cosY * cosZ);
+	ans.m[0][1] = scale.x * (cosY * sinZ);
+	ans.m[0][2] = scale.x * (-sinY);
+	ans.m[0][3] = 0;
+
+	ans.m[1][0] = scale.y * (sinX * sinY * cosZ - cosX * sinZ);
+	ans.m[1][1] = scale.y * (sinX * sinY * sinZ + cosX * cosZ);
+	ans.m[1][2] = scale.y * (sinX * cosY);
+	ans.m[1][3] = 0;
+
+	ans.m[2][0] = scale.z * (cosX * sinY * cosZ + sinX * sinZ);
+	ans.m[2][1] = scale.z * (cosX * sinY * sinZ - sinX * cosZ);
+	ans.m[2][2] = scale.z * (cosX * cosY);
+	ans.m[2][3] = 0;
+
+	ans.m[3][0] = translate.x;
+	ans.m[3][1] = translate.y;
+	ans.m[3][2] = translate.z;
+	ans.m[3][3] = 1;
+
+	return ans;
+}
+
+void MakeAffineMatrices(const TransformArrays& transforms, size_t count, Matrix4x4* matrices) {
+
+	size_t i = 0;
+
+#if defined(MYMATH_USE_SSE)
+	// 4行列ずつ、各要素を4レーンで求めてから転置して書き出す
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4) {
+		__m128 sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos(_mm_loadu_ps(transforms.rotate[0] + i), sinX, cosX);
+		SinCos(_mm_loadu_ps(transforms.rotate[1] + i), sinY, cosY);
+		SinCos(_mm_loadu_ps(transforms.rotate[2] + i), sinZ, cosZ);
+		__m128 scaleX = _mm_loadu_ps(transforms.scale[0] + i);
+		__m128 scaleY = _mm_loadu_ps(transforms.scale[1] + i);
+		__m128 scaleZ = _mm_loadu_ps(transforms.scale[2] + i);
+		__m128 sinXsinY = _mm_mul_ps(sinX, sinY);
+		__m128 cosXsinY = _mm_mul_ps(cosX, sinY);
+
+		__m128 rows[4][4] = {
+		    {_mm_mul_ps(scaleX, _mm_mul_ps(cosY, cosZ)), _mm_mul_ps(scaleX, _mm_mul_ps(cosY, sinZ)),
+		     _mm_sub_ps(zero, _mm_mul_ps(scaleX, sinY)), zero},
+		    {_mm_mul_ps(scaleY, _mm_sub_ps(_mm_mul_ps(sinXsinY, cosZ), _mm_mul_ps(cosX, sinZ))),
+		     _mm_mul_ps(scaleY, _mm_add_ps(_mm_mul_ps(sinXsinY, sinZ), _mm_mul_ps(cosX, cosZ))),
+		     _mm_mul_ps(scaleY, _mm_mul_ps(sinX, cosY)), zero},
+		    {_mm_mul_ps(scaleZ, _mm_add_ps(_mm_mul_ps(cosXsinY, cosZ), _mm_mul_ps(sinX, sinZ))),
+		     _mm_mul_ps(scaleZ, _mm_sub_ps(_mm_mul_ps(cosXsinY, sinZ), _mm_mul_ps(sinX, cosZ))),
+		     _mm_mul_ps(scaleZ, _mm_mul_ps(cosX, cosY)), zero},
+		    {_mm_loadu_ps(transforms.translate[0] + i), _mm_loadu_ps(transforms.translate[1] + i),
+		     _mm_loadu_ps(transforms.translate[2] + i), one},
+		};
+
+		for (int row = 0; row < 4; row++) {
+			_MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+			for (int lane = 0; lane < 4; lane++) {
+				_mm_storeu_ps(matrices[i + lane].m[row], rows[row][lane]);
+			}
+		}
+	}
+#endif
+
+	// 端数（SIMDが無ければ全部）
+	for (; i < count; i++) {
+		matrices[i] = MakeAffineMatrix(
+		    {transforms.scale[0][i], transforms.scale[1][i], transforms.scale[2][i]},
+		    {transforms.rotate[0][i], transforms.rotate[1][i], transforms.rotate[2][i]},
+		    {transforms.translate[0][i], transforms.translate[1][i], transforms.translate[2][i]});
+	}
 }
 
 #pragma region Add
@@ -161,6 +258,15 @@ Matrix4x4 Add(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 
 	Matrix4x4 ans;
 
+#if defined(MYMATH_USE_SSE)
+	for (int i = 0; i < 4; i++) {
+		_mm_storeu_ps(ans.m[i], _mm_add_ps(_mm_loadu_ps(mt1.m[i]), _mm_loadu_ps(mt2.m[i])));
+	}
+#elif defined(MYMATH_USE_NEON)
+	for (int i = 0; i < 4; i++) {
+		vst1q_f32(ans.m[i], vaddq_f32(vld1q_f32(mt1.m[i]), vld1q_f32(mt2.m[i])));
+	}
+#else
 	ans.m[0][0] = mt1.m[0][0] + mt2.m[0][0];
 	ans.m[0][1] = mt1.m[0][1] + mt2.m[0][1];
 	ans.m[0][2] = mt1.m[0][2] + mt2.m[0][2];
@@ -180,6 +286,7 @@ Matrix4x4 Add(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 	ans.m[3][1] = mt1.m[3][1] + mt2.m[3][1];
 	ans.m[3][2] = mt1.m[3][2] + mt2.m[3][2];
 	ans.m[3][3] = mt1.m[3][3] + mt2.m[3][3];
+#endif
 
 	return ans;
 }
@@ -190,6 +297,15 @@ Matrix4x4 Subtract(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 
 	Matrix4x4 ans;
 
+#if defined(MYMATH_USE_SSE)
+	for (int i = 0; i < 4; i++) {
+		_mm_storeu_ps(ans.m[i], _mm_sub_ps(_mm_loadu_ps(mt1.m[i]), _mm_loadu_ps(mt2.m[i])));
+	}
+#elif defined(MYMATH_USE_NEON)
+	for (int i = 0; i < 4; i++) {
+		vst1q_f32(ans.m[i], vsubq_f32(vld1q_f32(mt1.m[i]), vld1q_f32(mt2.m[i])));
+	}
+#else
 	ans.m[0][0] = mt1.m[0][0] - mt2.m[0][0];
 	ans.m[0][1] = mt1.m[0][1] - mt2.m[0][1];
 	ans.m[0][2] = mt1.m[0][2] - mt2.m[0][2];
@@ -209,6 +325,7 @@ Matrix4x4 Subtract(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 	ans.m[3][1] = mt1.m[3][1] - mt2.m[3][1];
 	ans.m[3][2] = mt1.m[3][2] - mt2.m[3][2];
 	ans.m[3][3] = mt1.m[3][3] - mt2.m[3][3];
+#endif
 
 	return ans;
 }
@@ -217,6 +334,36 @@ Matrix4x4 Subtract(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 #pragma region Multiply
 Matrix4x4 Multiply(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 
+#if defined(MYMATH_USE_SSE)
+	// 結果のi行目 = Σ mt1[i][k] * (mt2のk行目)
+	Matrix4x4 ans;
+	const __m128 row0 = _mm_loadu_ps(mt2.m[0]);
+	const __m128 row1 = _mm_loadu_ps(mt2.m[1]);
+	const __m128 row2 = _mm_loadu_ps(mt2.m[2]);
+	const __m128 row3 = _mm_loadu_ps(mt2.m[3]);
+	for (int i = 0; i < 4; i++) {
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(mt1.m[i][0]), row0);
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(mt1.m[i][1]), row1));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(mt1.m[i][2]), row2));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(mt1.m[i][3]), row3));
+		_mm_storeu_ps(ans.m[i], sum);
+	}
+	return ans;
+#elif defined(MYMATH_USE_NEON)
+	Matrix4x4 ans;
+	const float32x4_t row0 = vld1q_f32(mt2.m[0]);
+	const float32x4_t row1 = vld1q_f32(mt2.m[1]);
+	const float32x4_t row2 = vld1q_f32(mt2.m[2]);
+	const float32x4_t row3 = vld1q_f32(mt2.m[3]);
+	for (int i = 0; i < 4; i++) {
+		float32x4_t sum = vmulq_n_f32(row0, mt1.m[i][0]);
+		sum = vmlaq_n_f32(sum, row1, mt1.m[i][1]);
+		sum = vmlaq_n_f32(sum, row2, mt1.m[i][2]);
+		sum = vmlaq_n_f32(sum, row3, mt1.m[i][3]);
+		vst1q_f32(ans.m[i], sum);
+	}
+	return ans;
+#else
 	Matrix4x4 ans = {};
 	for (int i = 0; i < 4; i++) {
 		for (int j = 0; j < 4; j++) {
@@ -227,11 +374,63 @@ Matrix4x4 Multiply(const Matrix4x4& mt1, const Matrix4x4& mt2) {
 		}
 	}
 	return ans;
+#endif
 }
 #pragma endregion
 
 #pragma region Inverse
 Matrix4x4 Inverse(const Matrix4x4& m) {
+#if defined(MYMATH_USE_SSE)
+	// 2x2のブロックに分けて余因子を求める
+	//     | A B |
+	// m = | C D |
+	const __m128 row0 = _mm_loadu_ps(m.m[0]);
+	const __m128 row1 = _mm_loadu_ps(m.m[1]);
+	const __m128 row2 = _mm_loadu_ps(m.m[2]);
+	const __m128 row3 = _mm_loadu_ps(m.m[3]);
+	__m128 a = _mm_movelh_ps(row0, row1);
+	__m128 b = _mm_movehl_ps(row1, row0);
+	__m128 c = _mm_movelh_ps(row2, row3);
+	__m128 d = _mm_movehl_ps(row3, row2);
+
+	// (|A|, |B|, |C|, |D|)
+	__m128 detSub = _mm_sub_ps(
+	    _mm_mul_ps(MYMATH_SHUFFLE(row0, row2, 0, 2, 0, 2), MYMATH_SHUFFLE(row1, row3, 1, 3, 1, 3)),
+	    _mm_mul_ps(MYMATH_SHUFFLE(row0, row2, 1, 3, 1, 3), MYMATH_SHUFFLE(row1, row3, 0, 2, 0, 2)));
+	__m128 detA = MYMATH_SHUFFLE(detSub, detSub, 0, 0, 0, 0);
+	__m128 detB = MYMATH_SHUFFLE(detSub, detSub, 1, 1, 1, 1);
+	__m128 detC = MYMATH_SHUFFLE(detSub, detSub, 2, 2, 2, 2);
+	__m128 detD = MYMATH_SHUFFLE(detSub, detSub, 3, 3, 3, 3);
+
+	__m128 adjDC = Mat2AdjointMultiply(d, c);
+	__m128 adjAB = Mat2AdjointMultiply(a, b);
+	// 逆行列の各ブロック（の随伴）
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Multiply(b, adjDC));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Multiply(c, adjAB));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MultiplyAdjoint(d, adjAB));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MultiplyAdjoint(a, adjDC));
+
+	// |m| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	__m128 determinant = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+	__m128 trace = _mm_mul_ps(adjAB, MYMATH_SHUFFLE(adjDC, adjDC, 0, 2, 1, 3));
+	trace = _mm_add_ps(trace, MYMATH_SHUFFLE(trace, trace, 2, 3, 0, 1));
+	trace = _mm_add_ps(trace, MYMATH_SHUFFLE(trace, trace, 1, 0, 3, 2));
+	determinant = _mm_sub_ps(determinant, trace);
+
+	const __m128 recpDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+	x = _mm_mul_ps(x, recpDeterminant);
+	y = _mm_mul_ps(y, recpDeterminant);
+	z = _mm_mul_ps(z, recpDeterminant);
+	w = _mm_mul_ps(w, recpDeterminant);
+
+	// 随伴を取りながら行に並べ直す
+	Matrix4x4 result;
+	_mm_storeu_ps(result.m[0], MYMATH_SHUFFLE(x, y, 3, 1, 3, 1));
+	_mm_storeu_ps(result.m[1], MYMATH_SHUFFLE(x, y, 2, 0, 2, 0));
+	_mm_storeu_ps(result.m[2], MYMATH_SHUFFLE(z, w, 3, 1, 3, 1));
+	_mm_storeu_ps(result.m[3], MYMATH_SHUFFLE(z, w, 2, 0, 2, 0));
+	return result;
+#else
 	float determinant = +m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2]
 
 	                    - m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2]
@@ -302,6 +501,65 @@ Matrix4x4 Inverse(const Matrix4x4& m) {
 	                  m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1]) *
 	                 recpDeterminant;
 
+	return result;
+#endif
+}
+#pragma endregion
+
+#pragma region InverseAffine
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	// 3x3部分の余因子
+	float cofactor00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+	float cofactor01 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+	float cofactor02 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+	float determinant = m.m[0][0] * cofactor00 + m.m[0][1] * cofactor01 + m.m[0][2] * cofactor02;
+	assert(determinant != 0.0f);
+	float recpDeterminant = 1.0f / determinant;
+
+	Matrix4x4 result;
+	result.m[0][0] = cofactor00 * recpDeterminant;
+	result.m[0][1] = (m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2]) * recpDeterminant;
+	result.m[0][2] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) * recpDeterminant;
+	result.m[0][3] = 0.0f;
+
+	result.m[1][0] = cofactor01 * recpDeterminant;
+	result.m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) * recpDeterminant;
+	result.m[1][2] = (m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2]) * recpDeterminant;
+	result.m[1][3] = 0.0f;
+
+	result.m[2][0] = cofactor02 * recpDeterminant;
+	result.m[2][1] = (m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1]) * recpDeterminant;
+	result.m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) * recpDeterminant;
+	result.m[2][3] = 0.0f;
+
+	// 平行移動は -t * (3x3の逆行列)
+	for (int j = 0; j < 3; j++) {
+		result.m[3][j] = -(m.m[3][0] * result.m[0][j] + m.m[3][1] * result.m[1][j] + m.m[3][2] * result.m[2][j]);
+	}
+	result.m[3][3] = 1.0f;
+
+	return result;
+}
+#pragma endregion
+
+#pragma region InverseRigid
+Matrix4x4 InverseRigid(const Matrix4x4& m) {
+
+	Matrix4x4 result;
+	// 回転行列の逆行列は転置
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			result.m[i][j] = m.m[j][i];
+		}
+		result.m[i][3] = 0.0f;
+	}
+
+	// 平行移動は -t * R^T
+	for (int j = 0; j < 3; j++) {
+		result.m[3][j] = -(m.m[3][0] * m.m[j][0] + m.m[3][1] * m.m[j][1] + m.m[3][2] * m.m[j][2]);
+	}
+	result.m[3][3] = 1.0f;
+
 	return result;
 }
 #pragma endregion
@@ -311,6 +569,24 @@ Matrix4x4 Transpose(const Matrix4x4& mt1) {
 
 	Matrix4x4 ans;
 
+#if defined(MYMATH_USE_SSE)
+	__m128 row0 = _mm_loadu_ps(mt1.m[0]);
+	__m128 row1 = _mm_loadu_ps(mt1.m[1]);
+	__m128 row2 = _mm_loadu_ps(mt1.m[2]);
+	__m128 row3 = _mm_loadu_ps(mt1.m[3]);
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+	_mm_storeu_ps(ans.m[0], row0);
+	_mm_storeu_ps(ans.m[1], row1);
+	_mm_storeu_ps(ans.m[2], row2);
+	_mm_storeu_ps(ans.m[3], row3);
+#elif defined(MYMATH_USE_NEON)
+	// 4要素おきに読み込むと列が並ぶ
+	float32x4x4_t columns = vld4q_f32(&mt1.m[0][0]);
+	vst1q_f32(ans.m[0], columns.val[0]);
+	vst1q_f32(ans.m[1], columns.val[1]);
+	vst1q_f32(ans.m[2], columns.val[2]);
+	vst1q_f32(ans.m[3], columns.val[3]);
+#else
 	ans.m[0][0] = mt1.m[0][0];
 	ans.m[0][1] = mt1.m[1][0];
 	ans.m[0][2] = mt1.m[2][0];
@@ -330,122 +606,8 @@ Matrix4x4 Transpose(const Matrix4x4& mt1) {
 	ans.m[3][1] = mt1.m[1][3];
 	ans.m[3][2] = mt1.m[2][3];
 	ans.m[3][3] = mt1.m[3][3];
+#endif
 
 	return ans;
 }
 #pragma endregion
-
-Matrix4x4 MekeIdentity4x4() {
-
-	Matrix4x4 ans;
-
-	ans.m[0][0] = 1;
-	ans.m[0][1] = 0;
-	ans.m[0][2] = 0;
-	ans.m[0][3] = 0;
-
-	ans.m[1][0] = 0;
-	ans.m[1][1] = 1;
-	ans.m[1][2] = 0;
-	ans.m[1][3] = 0;
-
-	ans.m[2][0] = 0;
-	ans.m[2][1] = 0;
-	ans.m[2][2] = 1;
-	ans.m[2][3] = 0;
-
-	ans.m[3][0] = 0;
-	ans.m[3][1] = 0;
-	ans.m[3][2] = 0;
-	ans.m[3][3] = 1;
-
-	return ans;
-}
-
-const Vector3 operator+(const Vector3& v1, const Vector3& v2) {
-
-	Vector3 temp = v1;
-	Vector3 resurut = {temp.x + v2.x, temp.y + v2.y, temp.z + v2.z};
-
-	return resurut;
-};
-
-const Vector3 operator*(const Vector3& v1, const Vector3& v2) {
-
-	Vector3 temp = v1;
-	Vector3 resurut = {temp.x * v2.x, temp.y * v2.y, temp.z * v2.z};
-
-	return resurut;
-};
-const Vector3 operator*(const Vector3& v1, const float& v2) {
-	Vector3 temp = v1;
-	Vector3 resurut = {temp.x * v2, temp.y * v2, temp.z * v2};
-
-	return resurut;
-}
-
-//float Dot(float v1, float v2) { return 0.0f; }
-
-Vector3 Cross(const Vector3& v1, const Vector3& v2) {
-	Vector3 ans;
-
-	ans.x = v1.y * v2.z - v1.z * v2.y;
-	ans.y = v1.z * v2.x - v1.x * v2.z;
-	ans.z = v1.x * v2.y - v1.y * v2.x;
-
-	return ans;
-}
-
-Matrix4x4 MakeIdentity4x4() {
-
-	Matrix4x4 ans;
-
-	ans.m[0][0] = 1;
-	ans.m[0][1] = 0;
-	ans.m[0][2] = 0;
-	ans.m[0][3] = 0;
-
-	ans.m[1][0] = 0;
-	ans.m[1][1] = 1;
-	ans.m[1][2] = 0;
-	ans.m[1][3] = 0;
-
-	ans.m[2][0] = 0;
-	ans.m[2][1] = 0;
-	ans.m[2][2] = 1;
-	ans.m[2][3] = 0;
-
-	ans.m[3][0] = 0;
-	ans.m[3][1] = 0;
-	ans.m[3][2] = 0;
-	ans.m[3][3] = 1;
-
-	return ans;
-}
-
-Vector3 Lerp(const Vector3& a, const Vector3& b, float t) {
-
-	Vector3 ans;
-
-	ans.x = t * a.x + (1.0f - t) * b.x;
-	ans.y = t * a.y + (1.0f - t) * b.y;
-	ans.z = t * a.z + (1.0f - t) * b.z;
-
-	return ans;
-}
-
-float fLerp(float a, float b, float t) { 
-	float  ans;
-
-	ans = t * a + (1.0f - t) * b;
-	return ans;
-}
-
-bool IsCollision(const AABB& aabb1, const AABB& aabb2) {
-	if ((aabb1.min.x <= aabb2.max.x && aabb1.max.x >= aabb2.min.x) && (aabb1.min.y <= aabb2.max.y && aabb1.max.y >= aabb2.min.y) && (aabb1.min.z <= aabb2.max.z && aabb1.max.z >= aabb2.min.z)) {
-
-		return true;
-	}
-
-	return false;
-}
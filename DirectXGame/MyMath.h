@@ -4,6 +4,8 @@
 #pragma once
 #include <assert.h>
 #include <cmath>
+#include <cstddef>
+#include <type_traits>
 #include <stdio.h>
 #include "Vector4.h"
 #include "Vector2.h"
@@ -29,12 +31,47 @@ struct AABB {
 	Vector3 max;
 };
 
+// 拡大縮小、回転、平行移動をSoAで並べた配列（[0]がX、[1]がY、[2]がZ）
+struct TransformArrays {
+	const float* scale[3];
+	const float* rotate[3];
+	const float* translate[3];
+};
+
 //回転
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) noexcept {
+	return {{
+	    {1, 0, 0, 0},
+	    {0, 1, 0, 0},
+	    {0, 0, 1, 0},
+	    {translate.x, translate.y, translate.z, 1},
+	}};
+}
 //拡大
-Matrix4x4 MakeScaleMatrix(const Vector3& scale);
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) noexcept {
+	return {{
+	    {scale.x, 0, 0, 0},
+	    {0, scale.y, 0, 0},
+	    {0, 0, scale.z, 0},
+	    {0, 0, 0, 1},
+	}};
+}
 //同時座標変換
-Vector3 TransformVector3(const Vector3& vector, const Matrix4x4& matrix);
+constexpr Vector3 TransformVector3(const Vector3& vector, const Matrix4x4& matrix) noexcept {
+
+	Vector3 ans;
+
+	ans.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
+	ans.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
+	ans.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2];
+	float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+
+	assert(w != 0.0f);
+	ans.x /= w;
+	ans.y /= w;
+	ans.z /= w;
+	return ans;
+}
 
 //回転X
 Matrix4x4 MakeRotateXMatrix(float radian);
@@ -44,6 +81,8 @@ Matrix4x4 MakeRotateYMatrix(float radian);
 Matrix4x4 MakeRotateZMatrix(float radian);
 
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+//アフィン行列をまとめて作る
+void MakeAffineMatrices(const TransformArrays& transforms, size_t count, Matrix4x4* matrices);
 
 
 
@@ -56,29 +95,80 @@ Matrix4x4 Subtract(const Matrix4x4& mt1, const Matrix4x4& mt2);
 
 //掛け算
 Matrix4x4 Multiply(const Matrix4x4& mt1, const Matrix4x4& mt2);
+//掛け算（定数式ならその場で計算し、実行時はSIMD版のMultiplyを呼ぶ）
+constexpr Matrix4x4 operator*(const Matrix4x4& mt1, const Matrix4x4& mt2) noexcept {
+	if (!std::is_constant_evaluated()) {
+		return Multiply(mt1, mt2);
+	}
+	Matrix4x4 ans = {};
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			for (int k = 0; k < 4; k++) {
+				ans.m[i][j] += mt1.m[i][k] * mt2.m[k][j];
+			}
+		}
+	}
+	return ans;
+}
 
 //逆行列
 Matrix4x4 Inverse(const Matrix4x4& m);
+//逆行列（アフィン変換用。4列目が(0,0,0,1)であること）
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+//逆行列（回転と平行移動のみの剛体変換用。3x3部分を転置するだけ）
+Matrix4x4 InverseRigid(const Matrix4x4& m);
 
 
 
 Matrix4x4 Transpose(const Matrix4x4& mt1);
-//0行列
-Matrix4x4 MekeIdentity4x4();
-
-//クロス積
-Vector3 Cross(const Vector3& v1, const Vector3& v2);
-
-const Vector3 operator+(const Vector3& v1, const Vector3& v2);
-const Vector3 operator*(const Vector3& v1, const Vector3& v2);
-const Vector3 operator*(const Vector3& v1, const float& v2);
-float Dot(float v1, float v2);
-
-Matrix4x4 MakeIdentity4x4();
-
-Vector3 Lerp(const Vector3& a, const Vector3& b, float t);
-float fLerp(float a, float b, float t);
-bool IsCollision(const AABB& aabb1, const AABB& aabb2);
+//単位行列
+constexpr Matrix4x4 MakeIdentity4x4() noexcept { return MakeScaleMatrix({1, 1, 1}); }
+constexpr Matrix4x4 MekeIdentity4x4() noexcept { return MakeIdentity4x4(); }
+
+//Vector3の演算子、内積、クロス積、長さ、正規化はVector3.hにある
+
+// tが1でa、0でbになる
+constexpr Vector3 Lerp(const Vector3& a, const Vector3& b, float t) noexcept { return a * t + b * (1.0f - t); }
+constexpr float fLerp(float a, float b, float t) noexcept { return t * a + (1.0f - t) * b; }
+
+constexpr bool IsCollision(const AABB& aabb1, const AABB& aabb2) noexcept {
+	return (aabb1.min.x <= aabb2.max.x && aabb1.max.x >= aabb2.min.x) && (aabb1.min.y <= aabb2.max.y && aabb1.max.y >= aabb2.min.y) &&
+	       (aabb1.min.z <= aabb2.max.z && aabb1.max.z >= aabb2.min.z);
+}
+
+//定数式用の[-π, π]への正規化
+constexpr double ConstexprWrapPi(double radian) noexcept {
+	constexpr double kPi = 3.14159265358979323846;
+	while (radian > kPi) {
+		radian -= 2.0 * kPi;
+	}
+	while (radian < -kPi) {
+		radian += 2.0 * kPi;
+	}
+	return radian;
+}
+//定数式用のsin（テーブルをコンパイル時に作るため。実行時はstd::sinを使う）
+constexpr float ConstexprSin(float radian) noexcept {
+	double x = ConstexprWrapPi(radian);
+	double term = x;
+	double sum = x;
+	for (int n = 1; n < 12; n++) {
+		term *= -x * x / double((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return float(sum);
+}
+//定数式用のcos
+constexpr float ConstexprCos(float radian) noexcept {
+	double x = ConstexprWrapPi(radian);
+	double term = 1.0;
+	double sum = 1.0;
+	for (int n = 1; n < 12; n++) {
+		term *= -x * x / double((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+	return float(sum);
+}
 
 //void DrawGrid(const Matrix4x4& viewProjectionMatrix, const Matrix4x4& viewportMatrix) {
 //	const float kGridHalfWidth = 2.0f;
@@ -1,5 +1,6 @@
 #define NOMINMAX
 #include "Player.h"
+#include "ModelRenderQueue.h"
 #include "MapChipField.h"
 #include <DebugText.h>
 
@@ -43,7 +44,7 @@ void Player::Update() {
 }
 
 void Player::Draw() {
-	model_->Draw(worldTransform_, *viewProjection_);
+	ModelRenderQueue::GetInstance()->Draw(*model_, worldTransform_, *viewProjection_);
 }
 
 void Player::PrayerMove() {
@@ -145,15 +146,7 @@ void Player::MapCollision(CollisionMapInfo& info) {
 
 Vector3 Player::CornerPosition(const Vector3& center, Corner corner) {
 
-	Vector3 offseetTable[kNumCorner] = {
-
-		{+kWidth / 2.0f, -kHeight / 2.0f, 0},
-		{-kWidth / 2.0f, -kHeight / 2.0f, 0},
-		{+kWidth / 2.0f, +kHeight / 2.0f, 0},
-		{-kWidth / 2.0f, +kHeight / 2.0f, 0}
-	};
-
-	return center + offseetTable[static_cast<uint32_t>(corner)];
+	return PlayerShape::CornerPosition(center, corner);
 }
 
 void Player::PlayerCollisionMove(const CollisionMapInfo& info) {
@@ -513,12 +506,7 @@ Vector3 Player::GetWorldPosition() {
 }
 
 AABB Player::GetAABB() {
-	Vector3 worldPos = GetWorldPosition();
-	AABB aabb;
-	aabb.min = { worldPos.x - kWidth / 2.0f, worldPos.y - kHeight / 2.0f, worldPos.z - kWidth / 2.0f };
-	aabb.max = { worldPos.x + kWidth / 2.0f, worldPos.y + kHeight / 2.0f, worldPos.z + kWidth / 2.0f };
-
-	return aabb;
+	return PlayerShape::MakeAABB(GetWorldPosition());
 }
 
 void Player::SetWorldPosition(const Vector3& newPosition)
@@ -531,9 +519,10 @@ void Player::SetWorldPosition(const Vector3& newPosition)
 // プレイヤーの回転を設定するメソッド
 void Player::SetRotation(const Quaternion& rotation) {
 	rotation_ = rotation;
+	// 以降のUpdateはオイラー角で行列を作るので合わせておく
 	worldTransform_.rotation_ = QuaternionToEuler(rotation_); // クォータニオンからオイラー角に変換
-	worldTransform_.matWorld_ = MakeAffineMatrix(worldTransform_.scale_, worldTransform_.rotation_, worldTransform_.translation_);
-	worldTransform_.TransferMatrix();
+	// 行列はクォータニオンから直接作る
+	worldTransform_.UpdateMatrix(rotation_);
 }
 
 // プレイヤーの重力方向を設定するメソッド
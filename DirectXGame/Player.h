@@ -4,6 +4,7 @@
 #include "WorldTransform.h"
 #include "assert.h"
 #include "MyMath.h"
+#include "PlayerShape.h"
 #include "Quaternion.h"
 
 #include <numbers>
@@ -22,13 +23,6 @@ struct CollisionMapInfo {
 	Vector3 move;         // 移動量
 };
 
-enum Corner {
-	kRightBottom,
-	kLeftBottom,
-	kRightTop,
-	kLeftTop,
-	kNumCorner // 要素数
-};
 
 
 class Enemy;
@@ -135,8 +129,8 @@ private:
 	static inline const float kJampAcceleration = 1.3f;    // ジャンプ初速
 	// 当たり判定
 	MapChipField* mapChipFild_ = nullptr;
-	static inline const float kWidth = 0.8f;
-	static inline const float kHeight = 0.8f;
+	static inline constexpr float kWidth = PlayerShape::kWidth;
+	static inline constexpr float kHeight = PlayerShape::kHeight;
 	static inline const float kBlank = 1.0;
 	static inline const float kAttenuationLanding = 0.1f;
 	static inline const float kCollisionsmallnumber = 0.1f;
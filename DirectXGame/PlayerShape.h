@@ -0,0 +1,38 @@
+#pragma once
+#include "MyMath.h"
+#include "Vector3.h"
+#include <cstdint>
+
+enum Corner {
+	kRightBottom,
+	kLeftBottom,
+	kRightTop,
+	kLeftTop,
+	kNumCorner // 要素数
+};
+
+// 自機の当たり判定の形（Playerのマップ衝突と敵との衝突で使う。モデルや入力に依らない）
+struct PlayerShape {
+	static inline constexpr float kWidth = 0.8f;
+	static inline constexpr float kHeight = 0.8f;
+	// 中心から各角へのずれ（Corner順）
+	static inline constexpr Vector3 kCornerOffsets[kNumCorner] = {
+	    {+kWidth / 2.0f, -kHeight / 2.0f, 0},
+	    {-kWidth / 2.0f, -kHeight / 2.0f, 0},
+	    {+kWidth / 2.0f, +kHeight / 2.0f, 0},
+	    {-kWidth / 2.0f, +kHeight / 2.0f, 0},
+	};
+
+	// 中心から角の位置
+	static constexpr Vector3 CornerPosition(const Vector3& center, Corner corner) noexcept {
+		return center + kCornerOffsets[static_cast<uint32_t>(corner)];
+	}
+
+	// 中心からAABB（奥行きは幅と同じ）
+	static constexpr AABB MakeAABB(const Vector3& center) noexcept {
+		AABB aabb;
+		aabb.min = {center.x - kWidth / 2.0f, center.y - kHeight / 2.0f, center.z - kWidth / 2.0f};
+		aabb.max = {center.x + kWidth / 2.0f, center.y + kHeight / 2.0f, center.z + kWidth / 2.0f};
+		return aabb;
+	}
+};
@@ -1,4 +1,10 @@
 #include "Quaternion.h"
+#include "MyMath.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define QUATERNION_USE_SSE
+#endif
 
 Quaternion EulerToQuaternion(float pitch, float yaw, float roll) {
     // オイラー角をクォータニオンに変換
@@ -16,4 +22,82 @@ Quaternion EulerToQuaternion(float pitch, float yaw, float roll) {
     q.z = cr * cp * sy - sr * sp * cy;
 
     return q;
-}
\ No newline at end of file
+}
+
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+    // 回転行列の各行を拡大率倍して平行移動を入れる
+    Matrix4x4 mat = rotate.ToMatrix();
+    for (int j = 0; j < 3; j++) {
+        mat.m[0][j] *= scale.x;
+        mat.m[1][j] *= scale.y;
+        mat.m[2][j] *= scale.z;
+    }
+    mat.m[3][0] = translate.x;
+    mat.m[3][1] = translate.y;
+    mat.m[3][2] = translate.z;
+    return mat;
+}
+
+Matrix4x4 MakeViewMatrix(const Quaternion& rotate, const Vector3& translate) {
+    // 回転と平行移動だけなので転置で逆行列を求める
+    return InverseRigid(MakeAffineMatrix({1, 1, 1}, rotate, translate));
+}
+
+void MakeAffineMatrices(const Vector3* scales, const Quaternion* rotates, const Vector3* translates, size_t count, Matrix4x4* matrices) {
+    size_t i = 0;
+
+#ifdef QUATERNION_USE_SSE
+    // 4個ずつ(w,x,y,z)を転置して成分ごとに並べ、行列の要素を4レーンで求める
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 w = _mm_loadu_ps(&rotates[i + 0].w);
+        __m128 x = _mm_loadu_ps(&rotates[i + 1].w);
+        __m128 y = _mm_loadu_ps(&rotates[i + 2].w);
+        __m128 z = _mm_loadu_ps(&rotates[i + 3].w);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+
+        __m128 x2 = _mm_mul_ps(x, two);
+        __m128 y2 = _mm_mul_ps(y, two);
+        __m128 z2 = _mm_mul_ps(z, two);
+        __m128 xx = _mm_mul_ps(x, x2);
+        __m128 yy = _mm_mul_ps(y, y2);
+        __m128 zz = _mm_mul_ps(z, z2);
+        __m128 xy = _mm_mul_ps(x, y2);
+        __m128 xz = _mm_mul_ps(x, z2);
+        __m128 yz = _mm_mul_ps(y, z2);
+        __m128 wx = _mm_mul_ps(w, x2);
+        __m128 wy = _mm_mul_ps(w, y2);
+        __m128 wz = _mm_mul_ps(w, z2);
+
+        __m128 scaleX = _mm_setr_ps(scales[i].x, scales[i + 1].x, scales[i + 2].x, scales[i + 3].x);
+        __m128 scaleY = _mm_setr_ps(scales[i].y, scales[i + 1].y, scales[i + 2].y, scales[i + 3].y);
+        __m128 scaleZ = _mm_setr_ps(scales[i].z, scales[i + 1].z, scales[i + 2].z, scales[i + 3].z);
+
+        __m128 rows[4][4] = {
+            {_mm_mul_ps(scaleX, _mm_sub_ps(one, _mm_add_ps(yy, zz))), _mm_mul_ps(scaleX, _mm_add_ps(xy, wz)),
+             _mm_mul_ps(scaleX, _mm_sub_ps(xz, wy)), zero},
+            {_mm_mul_ps(scaleY, _mm_sub_ps(xy, wz)), _mm_mul_ps(scaleY, _mm_sub_ps(one, _mm_add_ps(xx, zz))),
+             _mm_mul_ps(scaleY, _mm_add_ps(yz, wx)), zero},
+            {_mm_mul_ps(scaleZ, _mm_add_ps(xz, wy)), _mm_mul_ps(scaleZ, _mm_sub_ps(yz, wx)),
+             _mm_mul_ps(scaleZ, _mm_sub_ps(one, _mm_add_ps(xx, yy))), zero},
+            {_mm_setr_ps(translates[i].x, translates[i + 1].x, translates[i + 2].x, translates[i + 3].x),
+             _mm_setr_ps(translates[i].y, translates[i + 1].y, translates[i + 2].y, translates[i + 3].y),
+             _mm_setr_ps(translates[i].z, translates[i + 1].z, translates[i + 2].z, translates[i + 3].z), one},
+        };
+
+        for (int row = 0; row < 4; row++) {
+            _MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+            for (int lane = 0; lane < 4; lane++) {
+                _mm_storeu_ps(matrices[i + lane].m[row], rows[row][lane]);
+            }
+        }
+    }
+#endif
+
+    // 端数（SIMDが無ければ全部）
+    for (; i < count; i++) {
+        matrices[i] = MakeAffineMatrix(scales[i], rotates[i], translates[i]);
+    }
+}
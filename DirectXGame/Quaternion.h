@@ -1,5 +1,6 @@
 #pragma once
 #include <cmath>
+#include <cstddef>
 #include "Vector3.h"
 
 // クォータニオンを表現する構造体
@@ -36,11 +37,24 @@ struct Quaternion {
 
     // クォータニオンとベクトルの積 (ベクトルを回転)
     Vector3 operator*(const Vector3& v) const {
-        // クォータニオンとベクトルを掛けて、ベクトルを回転させる
-        Quaternion qv(0, v.x, v.y, v.z);
-        Quaternion conj = this->Conjugate();
-        Quaternion result = (*this) * qv * conj;
-        return Vector3(result.x, result.y, result.z);
+        // q * v * q^-1 を展開した式（t = 2(u×v), v' = v + w t + u×t）
+        Vector3 u(x, y, z);
+        Vector3 t = Cross(u, v) * 2.0f;
+        return v + t * w + Cross(u, t);
+    }
+
+    // スカラー倍
+    Quaternion operator*(float s) const {
+        return Quaternion(w * s, x * s, y * s, z * s);
+    }
+
+    Quaternion operator+(const Quaternion& q) const {
+        return Quaternion(w + q.w, x + q.x, y + q.y, z + q.z);
+    }
+
+    // 符号反転（同じ回転を表す）
+    Quaternion operator-() const {
+        return Quaternion(-w, -x, -y, -z);
     }
 
     // クォータニオンの共役を返す（逆回転用）
@@ -49,17 +63,25 @@ struct Quaternion {
     }
 
     // クォータニオンを回転行列に変換
+    // （MakeRotateXMatrix等と同じ行ベクトル形式。単位クォータニオンであること）
     Matrix4x4 ToMatrix() const {
         Matrix4x4 mat;
         mat.m[0][0] = 1 - 2 * (y * y + z * z);
-        mat.m[0][1] = 2 * (x * y - z * w);
-        mat.m[0][2] = 2 * (x * z + y * w);
-        mat.m[1][0] = 2 * (x * y + z * w);
+        mat.m[0][1] = 2 * (x * y + z * w);
+        mat.m[0][2] = 2 * (x * z - y * w);
+        mat.m[0][3] = 0;
+        mat.m[1][0] = 2 * (x * y - z * w);
         mat.m[1][1] = 1 - 2 * (x * x + z * z);
-        mat.m[1][2] = 2 * (y * z - x * w);
-        mat.m[2][0] = 2 * (x * z - y * w);
-        mat.m[2][1] = 2 * (y * z + x * w);
+        mat.m[1][2] = 2 * (y * z + x * w);
+        mat.m[1][3] = 0;
+        mat.m[2][0] = 2 * (x * z + y * w);
+        mat.m[2][1] = 2 * (y * z - x * w);
         mat.m[2][2] = 1 - 2 * (x * x + y * y);
+        mat.m[2][3] = 0;
+        mat.m[3][0] = 0;
+        mat.m[3][1] = 0;
+        mat.m[3][2] = 0;
+        mat.m[3][3] = 1;
         return mat;
     }
 
@@ -113,4 +135,43 @@ Quaternion EulerToQuaternion(float pitch, float yaw, float roll);
 // クォータニオンをオイラー角に変換する関数
 inline Vector3 QuaternionToEuler(const Quaternion& q) {
     return Quaternion::ToEuler(q);
-}
\ No newline at end of file
+}
+
+// 内積
+inline float Dot(const Quaternion& q0, const Quaternion& q1) {
+    return q0.w * q1.w + q0.x * q1.x + q0.y * q1.y + q0.z * q1.z;
+}
+
+// 正規化線形補間（近い角度同士なら安価で十分）
+inline Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t) {
+    // 短い方の経路を通る
+    Quaternion end = Dot(q0, q1) < 0.0f ? -q1 : q1;
+    Quaternion result = q0 * (1.0f - t) + end * t;
+    result.Normalize();
+    return result;
+}
+
+// 球面線形補間（角速度一定）
+inline Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+    float dot = Dot(q0, q1);
+    // 短い方の経路を通る
+    Quaternion end = q1;
+    if (dot < 0.0f) {
+        end = -q1;
+        dot = -dot;
+    }
+    // ほぼ同じ向きならsinθで割れないのでNlerp
+    if (dot > 0.9995f) {
+        return Nlerp(q0, end, t);
+    }
+    float theta = std::acos(dot);
+    float recpSinTheta = 1.0f / std::sin(theta);
+    return q0 * (std::sin((1.0f - t) * theta) * recpSinTheta) + end * (std::sin(t * theta) * recpSinTheta);
+}
+
+// 拡大縮小、クォータニオン回転、平行移動からアフィン行列を作る
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+// カメラの回転と位置からビュー行列（カメラのワールド行列の逆）を作る
+Matrix4x4 MakeViewMatrix(const Quaternion& rotate, const Vector3& translate);
+// クォータニオン回転のアフィン行列をまとめて作る
+void MakeAffineMatrices(const Vector3* scales, const Quaternion* rotates, const Vector3* translates, size_t count, Matrix4x4* matrices);
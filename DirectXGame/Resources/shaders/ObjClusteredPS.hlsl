@@ -0,0 +1,103 @@
+#include "ObjLighting.hlsli"
+
+Texture2D<float4> tex : register(t0); // 0番スロットに設定されたテクスチャ
+SamplerState smp : register(s0);      // 0番スロットに設定されたサンプラー
+
+// 格子の設定（LightClusterと同じ分け方）
+cbuffer ClusterParameters : register(b5) {
+	uint tileCountX;
+	uint tileCountY;
+	uint sliceCount;
+	uint pointLightCount;
+	float sliceScale; // スライス番号 = floor(log(z) * sliceScale + sliceBias)
+	float sliceBias;
+	float2 tileSize;  // タイルの大きさ[px]
+};
+
+struct ClusteredPointLight {
+	float3 position; // ライト座標
+	float radius;    // 届く距離
+	float3 color;    // ライトの色(RGB)
+	float pad;
+};
+
+StructuredBuffer<ClusteredPointLight> clusteredPointLights : register(t1);
+StructuredBuffer<uint2> clusters : register(t2);             // x:先頭 y:ライト数
+StructuredBuffer<uint> clusterLightIndices : register(t3);
+
+// ShadowCasterSystemが選んだ丸影の数
+cbuffer ShadowParameters : register(b6) {
+	uint shadowCasterCount;
+};
+
+// 丸影（CircleShadow::ConstBufferDataと同じ並び）
+struct ClusteredCircleShadow {
+	float3 dir;                // 投影方向の逆ベクトル（単位ベクトル）
+	float pad1;
+	float3 casterPos;          // キャスター座標
+	float distanceCasterLight; // キャスターとライトの距離
+	float3 atten;              // 距離減衰係数
+	float pad2;
+	float2 factorAngleCos;     // 減衰角度のコサイン
+	uint active;
+	float pad3;
+};
+
+StructuredBuffer<ClusteredCircleShadow> shadowCasters : register(t4);
+
+float4 main(VSOutput input) : SV_TARGET {
+	// UV変換
+	float2 uv = float2(
+	    input.uv.x * m_uv_scale.x + m_uv_offset.x, input.uv.y * m_uv_scale.y + m_uv_offset.y);
+	// テクスチャマッピング
+	float4 texcolor = tex.Sample(smp, uv);
+
+	// LightGroupのライトによるシェーディング
+	float4 shadecolor = ShadeObject(input);
+
+	// 自分の格子を求める
+	float viewZ = mul(input.worldpos, view).z;
+	uint2 tile = min(uint2(input.svpos.xy / tileSize), uint2(tileCountX - 1, tileCountY - 1));
+	uint slice = (uint)clamp(floor(log(viewZ) * sliceScale + sliceBias), 0, sliceCount - 1);
+	uint2 cluster = clusters[tile.x + (tile.y + slice * tileCountY) * tileCountX];
+
+	// 頂点から視点への方向ベクトル
+	float3 eyedir = normalize(cameraPos - input.worldpos.xyz);
+
+	// 格子に届く点光源だけ
+	for (uint i = 0; i < cluster.y; i++) {
+		ClusteredPointLight light = clusteredPointLights[clusterLightIndices[cluster.x + i]];
+
+		// ライトへの方向ベクトル
+		float3 lightv = light.position - input.worldpos.xyz;
+		float d = length(lightv);
+		lightv = normalize(lightv);
+
+		// 届く距離で0になる距離減衰
+		float falloff = saturate(1.0f - (d * d) / (light.radius * light.radius));
+		float atten = falloff * falloff;
+
+		// ライトに向かうベクトルと法線の内積（数が多いので裏側からは照らさない）
+		float3 dotlightnormal = saturate(dot(lightv, input.normal));
+		// 反射光ベクトル
+		float3 reflect = normalize(-lightv + 2 * dotlightnormal * input.normal);
+		// 拡散反射光
+		float3 diffuse = dotlightnormal * m_diffuse;
+		// 鏡面反射光
+		float3 specular = pow(saturate(dot(reflect, eyedir)), shininess) * m_specular;
+
+		// 全て加算する
+		shadecolor.rgb += atten * (diffuse + specular) * light.color;
+	}
+
+	// 選ばれた丸影
+	for (i = 0; i < shadowCasterCount; i++) {
+		ClusteredCircleShadow shadow = shadowCasters[i];
+		shadecolor.rgb -= CircleShadowAtten(
+		    input.worldpos.xyz, shadow.dir, shadow.casterPos, shadow.distanceCasterLight,
+		    shadow.atten, shadow.factorAngleCos);
+	}
+
+	// シェーディングによる色で描画
+	return shadecolor * texcolor * color;
+}
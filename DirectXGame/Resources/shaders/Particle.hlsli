@@ -0,0 +1,21 @@
+#pragma pack_matrix(row_major)
+
+cbuffer ViewProjection : register(b0) {
+	matrix view;       // ビュー変換行列
+	matrix projection; // プロジェクション変換行列
+	float3 cameraPos;  // カメラ座標（ワールド座標）
+};
+
+// 1パーティクル分のデータ
+struct ParticleInstance {
+	float3 position; // ワールド座標
+	float size;      // 半径
+	float4 color;    // 色(RGBA)
+};
+
+// 頂点シェーダーからピクセルシェーダーへのやり取りに使用する構造体
+struct VSOutput {
+	float4 svpos : SV_POSITION; // システム用頂点座標
+	float2 local : TEXCOORD;    // 板ポリ内の座標(-1～1)
+	float4 color : COLOR;       // 色(RGBA)
+};
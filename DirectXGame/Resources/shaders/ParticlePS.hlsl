@@ -0,0 +1,12 @@
+#include "Particle.hlsli"
+
+float4 main(VSOutput input) : SV_TARGET {
+	// 円の外側は捨てる
+	float r2 = dot(input.local, input.local);
+	clip(1.0f - r2);
+
+	// 球に見えるよう、正面からの光で陰影を付ける
+	float3 normal = float3(input.local, sqrt(1.0f - r2));
+	float shade = 0.6f + 0.4f * normal.z;
+	return float4(input.color.rgb * shade, input.color.a);
+}
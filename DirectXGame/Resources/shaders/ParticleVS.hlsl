@@ -0,0 +1,22 @@
+#include "Particle.hlsli"
+
+StructuredBuffer<ParticleInstance> instances : register(t0);
+
+// 三角形ストリップの4頂点
+static const float2 kCorners[4] = {
+    float2(-1.0f, -1.0f), float2(-1.0f, 1.0f), float2(1.0f, -1.0f), float2(1.0f, 1.0f)};
+
+VSOutput main(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID) {
+	ParticleInstance instance = instances[instanceId];
+	float2 corner = kCorners[vertexId];
+
+	// ビュー空間で広げてカメラに向ける
+	float4 viewPos = mul(float4(instance.position, 1.0f), view);
+	viewPos.xy += corner * instance.size;
+
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(viewPos, projection);
+	output.local = corner;
+	output.color = instance.color;
+	return output;
+}
@@ -0,0 +1,10 @@
+#include "SpriteBatch.hlsli"
+
+// 座標はCPU側でクリップ空間に変換済み
+VSOutput main(float4 pos : POSITION, float2 uv : TEXCOORD, float4 color : COLOR) {
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = pos;
+	output.uv = uv;
+	output.color = color;
+	return output;
+}
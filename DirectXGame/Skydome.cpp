@@ -1,4 +1,5 @@
 #include "Skydome.h"
+#include "ModelRenderQueue.h"
 
 void Skydome::Initialize(Model* model, ViewProjection* viewProjection) {
 
@@ -11,4 +12,6 @@ void Skydome::Initialize(Model* model, ViewProjection* viewProjection) {
 
 void Skydome::Update() {}
 
-void Skydome::Draw() { model_->Draw(worldTransform_, *viewProjection_); }
+void Skydome::Draw() {
+	ModelRenderQueue::GetInstance()->Draw(*model_, worldTransform_, *viewProjection_);
+}
@@ -1,4 +1,6 @@
 #include "TitleScene.h"
+#include "MemoryTracker.h"
+#include "ModelRenderQueue.h"
 #include <numbers>
 
 TitleScene::TitleScene() {}
@@ -16,16 +18,20 @@ void TitleScene::Initialize() {
 	input_ = Input::GetInstance();
 	audio_ = Audio::GetInstance();
 
-	model_ = Model::CreateFromOBJ("title", true);
-	stage1model_ = Model::CreateFromOBJ("stage1", true);
-	stage2model_ = Model::CreateFromOBJ("stage2", true);
-	stage3model_ = Model::CreateFromOBJ("stage3", true);
+	// 3Dモデルの読み込み
+	{
+		MEMORY_TAG_SCOPE(MemoryTracker::Tag::kModel);
+		model_ = Model::CreateFromOBJ("title", true);
+		stage1model_ = Model::CreateFromOBJ("stage1", true);
+		stage2model_ = Model::CreateFromOBJ("stage2", true);
+		stage3model_ = Model::CreateFromOBJ("stage3", true);
+		modelSkydome_ = Model::CreateFromOBJ("skydomeTitle", true);
+	}
 	worldTransform_.Initialize();
 	viewProjection_.Initialize();
 
 	// SkyDome
 	skydome_ = new Skydome();
-	modelSkydome_ = Model::CreateFromOBJ("skydomeTitle", true);
 	skydome_->Initialize(modelSkydome_, &viewProjection_);
 
 	Timer_ = 0.0f;
@@ -123,12 +129,15 @@ void TitleScene::Draw() {
 #pragma region 3Dオブジェクト描画
 	// 3Dオブジェクト描画前処理
 	Model::PreDraw(commandList);
+	// モデルは描画キューに溜めて並べ替えてから描く
+	ModelRenderQueue* modelRenderQueue = ModelRenderQueue::GetInstance();
+	modelRenderQueue->Begin(commandList);
 
 
-	model_->Draw(worldTransform_, viewProjection_);
-	stage1model_->Draw(worldTransform_, viewProjection_);
-	stage2model_->Draw(worldTransform_, viewProjection_);
-	stage3model_->Draw(worldTransform_, viewProjection_);
+	modelRenderQueue->Draw(*model_, worldTransform_, viewProjection_);
+	modelRenderQueue->Draw(*stage1model_, worldTransform_, viewProjection_);
+	modelRenderQueue->Draw(*stage2model_, worldTransform_, viewProjection_);
+	modelRenderQueue->Draw(*stage3model_, worldTransform_, viewProjection_);
 
 	skydome_->Draw();
 
@@ -136,6 +145,7 @@ void TitleScene::Draw() {
 	/// ここに3Dオブジェクトの描画処理を追加できる
 	/// </summary>
 
+	modelRenderQueue->End();
 	// 3Dオブジェクト描画後処理
 	Model::PostDraw();
 #pragma endregion
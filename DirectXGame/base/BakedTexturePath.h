@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <system_error>
+
+/// <summary>
+/// ベイク済みテクスチャのパス（元画像の拡張子を.ddsに差し替え）
+/// </summary>
+/// <param name="sourcePath">元画像のパス</param>
+/// <returns>ベイク済みテクスチャのパス</returns>
+inline std::filesystem::path GetBakedTexturePath(const std::filesystem::path& sourcePath) {
+	std::filesystem::path bakedPath(sourcePath);
+	bakedPath.replace_extension(".dds");
+	return bakedPath;
+}
+
+/// <summary>
+/// ベイク済みテクスチャが使えるか（元画像より古ければ、編集前の内容なので使わない）
+/// </summary>
+/// <param name="sourcePath">元画像のパス</param>
+/// <param name="bakedPath">ベイク済みテクスチャのパス</param>
+/// <returns>ベイク済みテクスチャがあり、元画像以降に書き出されていればtrue</returns>
+inline bool IsBakedTextureUpToDate(
+    const std::filesystem::path& sourcePath, const std::filesystem::path& bakedPath) {
+	std::error_code error;
+	std::filesystem::file_time_type bakedTime = std::filesystem::last_write_time(bakedPath, error);
+	if (error) {
+		return false;
+	}
+	std::filesystem::file_time_type sourceTime =
+	    std::filesystem::last_write_time(sourcePath, error);
+	// 元画像を配布しない場合はベイク済みだけで読む
+	if (error) {
+		return true;
+	}
+	return sourceTime <= bakedTime;
+}
@@ -0,0 +1,62 @@
+#include "ConstantBufferAllocator.h"
+#include <cassert>
+
+ConstantBufferAllocator* ConstantBufferAllocator::GetInstance() {
+	static ConstantBufferAllocator instance;
+	return &instance;
+}
+
+void ConstantBufferAllocator::Initialize(
+    RenderDevice* device, FrameScheduler* frameScheduler, uint64_t sizePerFrame) {
+	assert(device);
+	assert(frameScheduler);
+	frameScheduler_ = frameScheduler;
+
+	// 256バイト単位で切り出すので容量も揃えておく
+	sizePerFrame = (sizePerFrame + kAlignment - 1) / kAlignment * kAlignment;
+	uint32_t frameCount = frameScheduler_->GetFrameCount();
+	allocator_.Initialize(frameCount, sizePerFrame);
+	buffers_.assign(frameCount, {});
+	statistics_ = {};
+
+	// 永続マップ済みのアップロードバッファ
+	for (uint32_t i = 0; i < frameCount; i++) {
+		buffers_[i] = device->CreateUploadBuffer(sizePerFrame);
+		assert(buffers_[i].cpuAddress);
+	}
+}
+
+void ConstantBufferAllocator::BeginFrame() {
+	if (!allocator_.BeginFrame(frameScheduler_->GetCompletedValue())) {
+		// 次のバッファがまだGPUで使用中なら待つ
+		frameScheduler_->WaitForValue(allocator_.GetNextRegionFenceValue());
+		bool isBegun = allocator_.BeginFrame(frameScheduler_->GetCompletedValue());
+		assert(isBegun);
+		(void)isBegun;
+	}
+}
+
+void ConstantBufferAllocator::EndFrame() {
+	allocator_.EndFrame(frameScheduler_->GetCurrentFenceValue());
+
+	const LinearAllocator::Statistics& statistics = allocator_.GetStatistics();
+	statistics_.allocationCount = statistics.allocationCount;
+	statistics_.requestedBytes = statistics.requestedBytes;
+	statistics_.usedBytes = statistics.usedBytes;
+	statistics_.capacityBytes = allocator_.GetRegionSize();
+	statistics_.failedCount = statistics.failedCount;
+}
+
+ConstantBufferAllocator::Allocation
+    ConstantBufferAllocator::Allocate(uint64_t size, uint64_t alignment) {
+	uint64_t offset = allocator_.Allocate(size, alignment);
+	if (offset == LinearAllocator::kInvalidOffset) {
+		return {};
+	}
+
+	uint32_t index = allocator_.GetRegionIndex();
+	Allocation allocation;
+	allocation.cpuAddress = buffers_[index].cpuAddress + offset;
+	allocation.gpuAddress = buffers_[index].gpuAddress + offset;
+	return allocation;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "FrameScheduler.h"
+#include "LinearAllocator.h"
+#include "RenderBackend.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// <summary>
+/// フレームごとの定数バッファ割り当て（大きなアップロードバッファから256バイト単位で切り出す）
+/// </summary>
+/// <remarks>
+/// 割り当てた領域はそのフレームの描画が終わるまで有効。毎フレーム書き換える小さなデータ
+/// （定数、インスタンスデータ）を個別のコミット済みリソースにしないために使う。
+/// </remarks>
+class ConstantBufferAllocator {
+public:
+	// 定数バッファの配置（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+	static constexpr uint64_t kAlignment = 256;
+
+	/// <summary>
+	/// 割り当て結果
+	/// </summary>
+	struct Allocation {
+		// 書き込み先
+		void* cpuAddress = nullptr;
+		// GPUアドレス
+		uint64_t gpuAddress = 0;
+	};
+
+	/// <summary>
+	/// 1フレーム分の統計情報
+	/// </summary>
+	struct Statistics {
+		// 割り当て回数
+		uint32_t allocationCount = 0;
+		// 要求されたバイト数
+		uint64_t requestedBytes = 0;
+		// 配置調整込みで使用したバイト数
+		uint64_t usedBytes = 0;
+		// 1フレームで使える最大バイト数
+		uint64_t capacityBytes = 0;
+		// 容量不足で失敗した回数
+		uint32_t failedCount = 0;
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static ConstantBufferAllocator* GetInstance();
+
+	/// <summary>
+	/// 初期化（アップロードバッファは同時に処理中になりうるフレーム数分）
+	/// </summary>
+	/// <param name="device">描画デバイス</param>
+	/// <param name="frameScheduler">フレーム管理（フレーム数とフェンス値を使う）</param>
+	/// <param name="sizePerFrame">1フレームで使える最大バイト数</param>
+	void Initialize(
+	    RenderDevice* device, FrameScheduler* frameScheduler, uint64_t sizePerFrame = 1024 * 1024);
+
+	/// <summary>
+	/// フレーム開始（GPUが使い終えたバッファに切り替える）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// フレーム終了（PostDrawの前に呼ぶ）
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// 割り当て
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">配置（2の累乗）</param>
+	/// <returns>割り当て結果。容量不足ならアドレスが0</returns>
+	Allocation Allocate(uint64_t size, uint64_t alignment = kAlignment);
+
+	/// <summary>
+	/// データを書き込んでGPUアドレスを返す
+	/// </summary>
+	/// <param name="data">データ</param>
+	/// <returns>GPUアドレス。容量不足なら0</returns>
+	template<class T> uint64_t Upload(const T& data) {
+		Allocation allocation = Allocate(sizeof(T));
+		if (allocation.cpuAddress) {
+			std::memcpy(allocation.cpuAddress, &data, sizeof(T));
+		}
+		return allocation.gpuAddress;
+	}
+
+	/// <summary>
+	/// 直前のフレームの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	ConstantBufferAllocator() = default;
+	~ConstantBufferAllocator() = default;
+	ConstantBufferAllocator(const ConstantBufferAllocator&) = delete;
+	ConstantBufferAllocator& operator=(const ConstantBufferAllocator&) = delete;
+
+	// フレーム管理
+	FrameScheduler* frameScheduler_ = nullptr;
+	// 割り当て位置の管理
+	LinearAllocator allocator_;
+	// アップロードバッファ（フレームごと。デバイスが保持する）
+	std::vector<RenderDevice::UploadBuffer> buffers_;
+	// 直前のフレームの統計情報
+	Statistics statistics_;
+};
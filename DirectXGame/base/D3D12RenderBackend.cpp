@@ -0,0 +1,92 @@
+#include "D3D12RenderBackend.h"
+#include "TextureManager.h"
+#include <cassert>
+#include <d3dx12.h>
+
+void D3D12RenderDevice::Initialize(ID3D12Device* device) {
+	assert(device);
+	device_ = device;
+}
+
+RenderDevice::UploadBuffer D3D12RenderDevice::CreateUploadBuffer(uint64_t size) {
+	HRESULT result = S_FALSE;
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	result = device_->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&resource));
+	if (FAILED(result)) {
+		return {};
+	}
+
+	// 永続マップ
+	UploadBuffer buffer;
+	result = resource->Map(0, nullptr, reinterpret_cast<void**>(&buffer.cpuAddress));
+	if (FAILED(result)) {
+		return {};
+	}
+	buffer.gpuAddress = resource->GetGPUVirtualAddress();
+	buffer.size = size;
+	resources_.push_back(std::move(resource));
+	return buffer;
+}
+
+void D3D12RenderCommandList::SetRootSignature(void* rootSignature) {
+	commandList_->SetGraphicsRootSignature(static_cast<ID3D12RootSignature*>(rootSignature));
+}
+
+void D3D12RenderCommandList::SetPipelineState(void* pipelineState) {
+	commandList_->SetPipelineState(static_cast<ID3D12PipelineState*>(pipelineState));
+}
+
+void D3D12RenderCommandList::SetPrimitiveTopology(PrimitiveTopology topology) {
+	static const D3D_PRIMITIVE_TOPOLOGY kTopologies[] = {
+	    D3D_PRIMITIVE_TOPOLOGY_POINTLIST,
+	    D3D_PRIMITIVE_TOPOLOGY_LINELIST,
+	    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+	    D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP,
+	};
+	commandList_->IASetPrimitiveTopology(kTopologies[size_t(topology)]);
+}
+
+void D3D12RenderCommandList::SetVertexBuffer(const VertexBufferView& view) {
+	D3D12_VERTEX_BUFFER_VIEW vbView{};
+	vbView.BufferLocation = view.gpuAddress;
+	vbView.SizeInBytes = view.sizeInBytes;
+	vbView.StrideInBytes = view.strideInBytes;
+	commandList_->IASetVertexBuffers(0, 1, &vbView);
+}
+
+void D3D12RenderCommandList::SetIndexBuffer(const IndexBufferView& view) {
+	D3D12_INDEX_BUFFER_VIEW ibView{};
+	ibView.BufferLocation = view.gpuAddress;
+	ibView.SizeInBytes = view.sizeInBytes;
+	ibView.Format = view.is32Bit ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+	commandList_->IASetIndexBuffer(&ibView);
+}
+
+void D3D12RenderCommandList::SetConstantBuffer(uint32_t rootParameterIndex, uint64_t gpuAddress) {
+	commandList_->SetGraphicsRootConstantBufferView(rootParameterIndex, gpuAddress);
+}
+
+void D3D12RenderCommandList::SetShaderResource(uint32_t rootParameterIndex, uint64_t gpuAddress) {
+	commandList_->SetGraphicsRootShaderResourceView(rootParameterIndex, gpuAddress);
+}
+
+void D3D12RenderCommandList::SetTexture(uint32_t rootParameterIndex, uint32_t textureHandle) {
+	TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(
+	    commandList_, rootParameterIndex, textureHandle);
+}
+
+void D3D12RenderCommandList::Draw(
+    uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) {
+	commandList_->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+}
+
+void D3D12RenderCommandList::DrawIndexed(
+    uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex,
+    uint32_t startInstance) {
+	commandList_->DrawIndexedInstanced(
+	    indexCount, instanceCount, startIndex, baseVertex, startInstance);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// D3D12の描画デバイス
+/// </summary>
+class D3D12RenderDevice : public RenderDevice {
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	void Initialize(ID3D12Device* device);
+
+	UploadBuffer CreateUploadBuffer(uint64_t size) override;
+
+private:
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// 生成したバッファ（デバイスと同じだけ生かしておく）
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> resources_;
+};
+
+/// <summary>
+/// ID3D12GraphicsCommandListへそのまま流すコマンドリスト
+/// </summary>
+class D3D12RenderCommandList : public RenderCommandList {
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="commandList">流し先</param>
+	void Initialize(ID3D12GraphicsCommandList* commandList) { commandList_ = commandList; }
+
+	/// <summary>
+	/// 流し先の取得
+	/// </summary>
+	ID3D12GraphicsCommandList* GetCommandList() const { return commandList_; }
+
+	void SetRootSignature(void* rootSignature) override;
+	void SetPipelineState(void* pipelineState) override;
+	void SetPrimitiveTopology(PrimitiveTopology topology) override;
+	void SetVertexBuffer(const VertexBufferView& view) override;
+	void SetIndexBuffer(const IndexBufferView& view) override;
+	void SetConstantBuffer(uint32_t rootParameterIndex, uint64_t gpuAddress) override;
+	void SetShaderResource(uint32_t rootParameterIndex, uint64_t gpuAddress) override;
+	void SetTexture(uint32_t rootParameterIndex, uint32_t textureHandle) override;
+	void Draw(
+	    uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+	    uint32_t startInstance) override;
+	void DrawIndexed(
+	    uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex,
+	    uint32_t startInstance) override;
+	void AddUploadBytes(uint64_t) override {}
+
+private:
+	// 流し先
+	ID3D12GraphicsCommandList* commandList_ = nullptr;
+};
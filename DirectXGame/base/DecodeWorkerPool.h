@@ -0,0 +1,265 @@
+#pragma once
+
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// デコードのワーカースレッド（要求は積んだ順に取り出し、結果は終わった順に返す）
+/// </summary>
+/// <remarks>
+/// 画像の型とデコード処理はSourceで与える。Sourceには次のものが要る。
+/// ・using Image（デコード結果）、using Status（成否）
+/// ・Status Decode(const std::wstring& filePath, Image& image)（複数のワーカーから同時に呼ばれる）
+/// ・static bool IsSucceeded(Status status)
+/// ・static uint64_t GetByteSize(const Image& image)（スループットに数えるバイト数）
+/// ・bool BeginWorker()、void EndWorker(bool begun)（ワーカースレッドの開始時と終了時）
+/// ・kThreadName（Profilerに出すスレッド名）、kScopeName（デコード区間の名前）
+/// ・kMemoryTag（ワーカーの確保の分類）
+/// グラフィックスAPIやWindowsに依存しない。
+/// </remarks>
+template<typename Source> class DecodeWorkerPool {
+public:
+	using Image = typename Source::Image;
+	using Status = typename Source::Status;
+
+	/// <summary>
+	/// デコード要求
+	/// </summary>
+	struct Request {
+		// テクスチャハンドル
+		uint32_t handle = 0;
+		// 名前
+		std::string name;
+		// フルパス
+		std::wstring filePath;
+	};
+
+	/// <summary>
+	/// デコード結果
+	/// </summary>
+	struct Result {
+		// テクスチャハンドル
+		uint32_t handle = 0;
+		// 名前
+		std::string name;
+		// 結果
+		Status result{};
+		// デコードしたイメージ
+		Image image;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// デコードしたテクスチャ数
+		uint64_t textureCount = 0;
+		// デコード後のバイト数（全ミップ合計）
+		uint64_t decodedBytes = 0;
+		// デコードに掛かった時間の合計[秒]
+		double seconds = 0.0;
+
+		/// <summary>
+		/// スループットの取得
+		/// </summary>
+		/// <returns>MB/s</returns>
+		double GetMegaBytesPerSecond() const {
+			return seconds > 0.0 ? double(decodedBytes) / (1024.0 * 1024.0) / seconds : 0.0;
+		}
+	};
+
+	DecodeWorkerPool() = default;
+	~DecodeWorkerPool() { Finalize(); }
+	DecodeWorkerPool(const DecodeWorkerPool&) = delete;
+	DecodeWorkerPool& operator=(const DecodeWorkerPool&) = delete;
+
+	/// <summary>
+	/// ワーカースレッド起動
+	/// </summary>
+	/// <param name="workerCount">スレッド数。0ならハードウェアスレッド数-1</param>
+	void Initialize(uint32_t workerCount = 0);
+
+	/// <summary>
+	/// ワーカースレッド停止（まだ取り出されていない要求は捨てる）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// デコード要求を積む
+	/// </summary>
+	/// <param name="request">デコード要求</param>
+	void Push(Request request);
+
+	/// <summary>
+	/// 完了した結果を取り出す
+	/// </summary>
+	/// <param name="results">結果の追加先</param>
+	void Collect(std::vector<Result>& results);
+
+	/// <summary>
+	/// 要求が全て完了するまで待つ
+	/// </summary>
+	void WaitIdle();
+
+	/// <summary>
+	/// 処理中の要求があるか
+	/// </summary>
+	bool IsBusy() const { return 0 < inFlightCount_.load(); }
+
+	/// <summary>
+	/// ワーカー数
+	/// </summary>
+	uint32_t GetWorkerCount() const { return uint32_t(workers_.size()); }
+
+	/// <summary>
+	/// 統計情報の取得
+	/// </summary>
+	Statistics GetStatistics() const;
+
+	/// <summary>
+	/// デコード処理の取得
+	/// </summary>
+	Source& GetSource() { return source_; }
+
+private:
+	/// <summary>
+	/// ワーカースレッドの処理
+	/// </summary>
+	void WorkerMain();
+
+	// デコード処理
+	Source source_;
+	// ワーカースレッド
+	std::vector<std::thread> workers_;
+	// 要求キュー
+	std::deque<Request> requests_;
+	// 結果キュー
+	std::vector<Result> results_;
+	// キュー用ミューテックス
+	mutable std::mutex mutex_;
+	// 要求の到着通知
+	std::condition_variable requestArrived_;
+	// 完了通知
+	std::condition_variable requestDone_;
+	// 処理中の要求数
+	std::atomic<uint32_t> inFlightCount_ = 0;
+	// 終了フラグ
+	bool quit_ = false;
+	// 統計情報
+	Statistics statistics_;
+};
+
+template<typename Source> void DecodeWorkerPool<Source>::Initialize(uint32_t workerCount) {
+	assert(workers_.empty());
+
+	if (workerCount == 0) {
+		// メインスレッドの分を残す（コア数が取れなければ0が返るので1にする）
+		uint32_t threadCount = std::thread::hardware_concurrency();
+		workerCount = threadCount > 1 ? threadCount - 1 : 1;
+	}
+
+	quit_ = false;
+	for (uint32_t i = 0; i < workerCount; i++) {
+		workers_.emplace_back(&DecodeWorkerPool::WorkerMain, this);
+	}
+}
+
+template<typename Source> void DecodeWorkerPool<Source>::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		quit_ = true;
+		requests_.clear();
+	}
+	requestArrived_.notify_all();
+
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+	results_.clear();
+	inFlightCount_ = 0;
+}
+
+template<typename Source> void DecodeWorkerPool<Source>::Push(Request request) {
+	assert(!workers_.empty());
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		requests_.push_back(std::move(request));
+		inFlightCount_++;
+	}
+	requestArrived_.notify_one();
+}
+
+template<typename Source> void DecodeWorkerPool<Source>::Collect(std::vector<Result>& results) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (Result& result : results_) {
+		results.push_back(std::move(result));
+	}
+	results_.clear();
+}
+
+template<typename Source> void DecodeWorkerPool<Source>::WaitIdle() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	requestDone_.wait(lock, [this] { return inFlightCount_.load() == 0; });
+}
+
+template<typename Source>
+typename DecodeWorkerPool<Source>::Statistics DecodeWorkerPool<Source>::GetStatistics() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return statistics_;
+}
+
+template<typename Source> void DecodeWorkerPool<Source>::WorkerMain() {
+	bool begun = source_.BeginWorker();
+	Profiler::GetInstance()->SetThreadName(Source::kThreadName);
+	// このスレッドの確保は全てデコードの分類に数える
+	MEMORY_TAG_SCOPE(Source::kMemoryTag);
+
+	while (true) {
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			requestArrived_.wait(lock, [this] { return quit_ || !requests_.empty(); });
+			if (quit_) {
+				break;
+			}
+			request = std::move(requests_.front());
+			requests_.pop_front();
+		}
+
+		Result result;
+		result.handle = request.handle;
+		result.name = std::move(request.name);
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			PROFILE_SCOPE(Source::kScopeName);
+			result.result = source_.Decode(request.filePath, result.image);
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (Source::IsSucceeded(result.result)) {
+				statistics_.textureCount++;
+				statistics_.decodedBytes += Source::GetByteSize(result.image);
+				statistics_.seconds += elapsed.count();
+			}
+			results_.push_back(std::move(result));
+			inFlightCount_--;
+		}
+		requestDone_.notify_all();
+	}
+
+	source_.EndWorker(begun);
+}
@@ -1,5 +1,6 @@
 #include "DirectXCommon.h"
 #include "DebugText.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <cassert>
 #include <thread>
@@ -16,6 +17,32 @@ using namespace Microsoft::WRL;
 namespace {
 const uint32_t kNumRTVDescriptor = 4;
 const uint32_t kLinearRTVStart = 2;
+
+/// <summary>
+/// コマンドキューとID3D12Fenceをフレーム管理のフェンスとして扱う
+/// </summary>
+class D3D12FrameFence : public FrameScheduler::Fence {
+public:
+	D3D12FrameFence(ID3D12CommandQueue* commandQueue, ID3D12Fence* fence)
+	    : commandQueue_(commandQueue), fence_(fence) {}
+
+	uint64_t GetCompletedValue() const override { return fence_->GetCompletedValue(); }
+
+	void Signal(uint64_t value) override { commandQueue_->Signal(fence_, value); }
+
+	void Wait(uint64_t value) override {
+		if (fence_->GetCompletedValue() < value) {
+			HANDLE event = CreateEvent(nullptr, false, false, nullptr);
+			fence_->SetEventOnCompletion(value, event);
+			WaitForSingleObject(event, INFINITE);
+			CloseHandle(event);
+		}
+	}
+
+private:
+	ID3D12CommandQueue* commandQueue_;
+	ID3D12Fence* fence_;
+};
 } // namespace
 
 DirectXCommon* DirectXCommon::GetInstance() {
@@ -24,11 +51,13 @@ DirectXCommon* DirectXCommon::GetInstance() {
 }
 
 void DirectXCommon::Initialize(
-    WinApp* winApp, int32_t backBufferWidth, int32_t backBufferHeight, bool enableDebugLayer) {
+    WinApp* winApp, int32_t backBufferWidth, int32_t backBufferHeight, bool enableDebugLayer,
+    uint32_t frameCount) {
 	// nullptrチェック
 	assert(winApp);
 	assert(4 <= backBufferWidth && backBufferWidth <= 4096);
 	assert(4 <= backBufferHeight && backBufferHeight <= 4096);
+	assert(1 <= frameCount);
 
 	// sleepの分解能をあげておく
 	timeBeginPeriod(1);
@@ -36,6 +65,7 @@ void DirectXCommon::Initialize(
 	winApp_ = winApp;
 	backBufferWidth_ = backBufferWidth;
 	backBufferHeight_ = backBufferHeight;
+	frameCount_ = std::min(frameCount, kMaxFrameCount);
 	reference_ = std::chrono::steady_clock::now();
 
 	// DXGIデバイス初期化
@@ -85,6 +115,7 @@ void DirectXCommon::PreDraw() {
 }
 
 void DirectXCommon::PostDraw() {
+	PROFILE_SCOPE("DirectXCommon::PostDraw");
 	HRESULT result;
 
 	// リソースバリアを変更（描画対象→表示状態）
@@ -118,14 +149,8 @@ void DirectXCommon::PostDraw() {
 	}
 #endif
 
-	// コマンドリストの実行完了を待つ
-	commandQueue_->Signal(fence_.Get(), ++fenceVal_);
-	if (fence_->GetCompletedValue() != fenceVal_) {
-		HANDLE event = CreateEvent(nullptr, false, false, nullptr);
-		fence_->SetEventOnCompletion(fenceVal_, event);
-		WaitForSingleObject(event, INFINITE);
-		CloseHandle(event);
-	}
+	// コマンドリストの完了時にシグナルさせる。完了は待たずに次のフレームの記録へ進む
+	fenceVal_ = frameScheduler_.EndFrame();
 
 	// ウィンドウ閉じるとframeLatencyWaitableObject_をインクリメントする対象がいなくなって0のままになるからInfiniteにしない
 	// 初期化時にframeLatencyWaitableObject_のカウンタを無理やり0にしたのでこの対応がいる。
@@ -155,8 +180,12 @@ void DirectXCommon::PostDraw() {
 	    std::chrono::steady_clock::now() - reference_);
 	reference_ = std::chrono::steady_clock::now();
 
-	commandAllocator_->Reset();
-	commandList_->Reset(commandAllocator_.Get(), nullptr);
+	// 次のフレーム番号を前回使ったフレームの完了を待ってから、そのアロケータを再利用する
+	frameScheduler_.BeginFrame();
+	ID3D12CommandAllocator* commandAllocator =
+	    commandAllocators_[frameScheduler_.GetFrameIndex()].Get();
+	commandAllocator->Reset();
+	commandList_->Reset(commandAllocator, nullptr);
 }
 
 void DirectXCommon::ClearRenderTarget() {
@@ -180,6 +209,10 @@ void DirectXCommon::ClearDepthBuffer() {
 	commandList_->ClearDepthStencilView(dsvH, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
 }
 
+void DirectXCommon::SetRenderCommandList(RenderCommandList* renderCommandList) {
+	activeRenderCommandList_ = renderCommandList ? renderCommandList : renderCommandList_.get();
+}
+
 int32_t DirectXCommon::GetBackBufferWidth() const { return backBufferWidth_; }
 
 int32_t DirectXCommon::GetBackBufferHeight() const { return backBufferHeight_; }
@@ -338,8 +371,8 @@ void DirectXCommon::CreateSwapChain() {
 	swapChain1->QueryInterface(IID_PPV_ARGS(&swapChain_));
 	assert(SUCCEEDED(result));
 
-	// VSync共存型fps固定のためにレイテンシ1
-	swapChain_->SetMaximumFrameLatency(1);
+	// VSync共存型fps固定のためにレイテンシ1（kMaxFrameCountが2なので常に1）
+	swapChain_->SetMaximumFrameLatency(std::max<UINT>(frameCount_ - 1, 1));
 
 	// 実際のflip用イベントを取得
 	frameLatencyWaitableObject_ = swapChain_->GetFrameLatencyWaitableObject();
@@ -355,17 +388,27 @@ void DirectXCommon::CreateSwapChain() {
 void DirectXCommon::InitializeCommand() {
 	HRESULT result = S_FALSE;
 
-	// コマンドアロケータを生成
-	result = device_->CreateCommandAllocator(
-	    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator_));
-	assert(SUCCEEDED(result));
+	// コマンドアロケータをフレームごとに生成
+	commandAllocators_.resize(frameCount_);
+	for (Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& commandAllocator : commandAllocators_) {
+		result = device_->CreateCommandAllocator(
+		    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
+		assert(SUCCEEDED(result));
+	}
 
-	// コマンドリストを生成
+	// コマンドリストを生成（フレーム0のアロケータで記録を始める）
 	result = device_->CreateCommandList(
-	    0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator_.Get(), nullptr,
+	    0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocators_[0].Get(), nullptr,
 	    IID_PPV_ARGS(&commandList_));
 	assert(SUCCEEDED(result));
 
+	// 描画バックエンドのインターフェース
+	renderDevice_ = std::make_unique<D3D12RenderDevice>();
+	renderDevice_->Initialize(device_.Get());
+	renderCommandList_ = std::make_unique<D3D12RenderCommandList>();
+	renderCommandList_->Initialize(commandList_.Get());
+	activeRenderCommandList_ = renderCommandList_.get();
+
 	// 標準設定でコマンドキューを生成
 	D3D12_COMMAND_QUEUE_DESC cmdQueueDesc{};
 	result = device_->CreateCommandQueue(&cmdQueueDesc, IID_PPV_ARGS(&commandQueue_));
@@ -446,10 +489,16 @@ void DirectXCommon::CreateDepthBuffer() {
 	    depthBuffer_.Get(), &dsvDesc, dsvHeap_->GetCPUDescriptorHandleForHeapStart());
 }
 
+void DirectXCommon::WaitForFenceValue(UINT64 value) { frameScheduler_.WaitForValue(value); }
+
 void DirectXCommon::CreateFence() {
 	HRESULT result = S_FALSE;
 
 	// フェンスの生成
 	result = device_->CreateFence(fenceVal_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
 	assert(SUCCEEDED(result));
+
+	// フレーム管理
+	frameFence_ = std::make_unique<D3D12FrameFence>(commandQueue_.Get(), fence_.Get());
+	frameScheduler_.Initialize(frameFence_.get(), frameCount_, fenceVal_);
 }
@@ -6,14 +6,29 @@
 #include <d3d12.h>
 #include <d3dx12.h>
 #include <dxgi1_6.h>
+#include <functional>
+#include <memory>
 #include <wrl.h>
 
+#include "D3D12RenderBackend.h"
+#include "FrameScheduler.h"
 #include "WinApp.h"
 
 /// <summary>
 /// DirectX汎用
 /// </summary>
 class DirectXCommon {
+public: // 定数
+	// 同時に処理中にできる最大フレーム数。
+	// ライブラリのWorldTransform、ViewProjection、ObjectColor、Material、LightGroup、Spriteは
+	// 定数バッファを1つしか持たずUpdateで直接書き換える。3フレーム以上にするとフレーム遅延が2になり、
+	// GPUが読んでいる途中の定数バッファを次のフレームのUpdateが書き換えてしまうので2までにする。
+	// 2ならフレーム遅延1の待機で前のフレームの表示を待ってから次のフレームを記録する
+	// （CPUとGPUはほぼ重ならない。コマンドアロケータやリングバッファはフレーム数分ある）
+	static const uint32_t kMaxFrameCount = 2;
+	// 同時に処理中にするフレーム数の既定値
+	static const uint32_t kDefaultFrameCount = 2;
+
 public: // メンバ関数
 	/// <summary>
 	/// シングルトンインスタンスの取得
@@ -24,9 +39,11 @@ public: // メンバ関数
 	/// <summary>
 	/// 初期化
 	/// </summary>
+	/// <param name="frameCount">同時に処理中にするフレーム数（1ならフレーム毎にGPUを待つ。kMaxFrameCountまでに丸める）</param>
 	void Initialize(
 	    WinApp* win, int32_t backBufferWidth = WinApp::kWindowWidth,
-	    int32_t backBufferHeight = WinApp::kWindowHeight, bool enableDebugLayer = true);
+	    int32_t backBufferHeight = WinApp::kWindowHeight, bool enableDebugLayer = true,
+	    uint32_t frameCount = kDefaultFrameCount);
 
 	/// <summary>
 	/// 描画前処理
@@ -60,6 +77,22 @@ public: // メンバ関数
 	/// <returns>描画コマンドリスト</returns>
 	ID3D12GraphicsCommandList* GetCommandList() const { return commandList_.Get(); }
 
+	/// <summary>
+	/// 描画デバイス（バックエンド共通インターフェース）の取得
+	/// </summary>
+	RenderDevice* GetRenderDevice() const { return renderDevice_.get(); }
+
+	/// <summary>
+	/// 描画コマンドリスト（バックエンド共通インターフェース）の取得
+	/// </summary>
+	RenderCommandList* GetRenderCommandList() const { return activeRenderCommandList_; }
+
+	/// <summary>
+	/// 描画コマンドリストの差し替え（計測用の記録コマンドリストを挟むなど）
+	/// </summary>
+	/// <param name="renderCommandList">差し替え先。nullptrならD3D12のコマンドリストに戻す</param>
+	void SetRenderCommandList(RenderCommandList* renderCommandList);
+
 	/// <summary>
 	/// バックバッファの幅取得
 	/// </summary>
@@ -75,6 +108,55 @@ public: // メンバ関数
 	// バックバッファの数を取得
 	size_t GetBackBufferCount() const { return backBuffers_.size(); }
 
+	/// <summary>
+	/// 同時に処理中にするフレーム数の取得
+	/// </summary>
+	uint32_t GetFrameCount() const { return frameScheduler_.GetFrameCount(); }
+
+	/// <summary>
+	/// 今記録中のフレーム番号の取得（0～GetFrameCount()-1）
+	/// </summary>
+	uint32_t GetFrameIndex() const { return frameScheduler_.GetFrameIndex(); }
+
+	/// <summary>
+	/// GPUが完了したフェンス値の取得
+	/// </summary>
+	UINT64 GetCompletedFenceValue() const { return frameScheduler_.GetCompletedValue(); }
+
+	/// <summary>
+	/// 今記録中のフレームの完了時にシグナルされるフェンス値の取得
+	/// </summary>
+	UINT64 GetNextFenceValue() const { return frameScheduler_.GetCurrentFenceValue(); }
+
+	/// <summary>
+	/// フェンス値に達するまで待つ
+	/// </summary>
+	/// <param name="value">フェンス値</param>
+	void WaitForFenceValue(UINT64 value);
+
+	/// <summary>
+	/// 今記録中のフレームをGPUが終えた後に実行する処理を登録する（使用中リソースの解放など）
+	/// </summary>
+	/// <param name="task">処理</param>
+	void ExecuteAfterFrame(std::function<void()> task) { frameScheduler_.Defer(std::move(task)); }
+
+	/// <summary>
+	/// 処理中のフレームを全て待つ（終了時やリソースの作り直し前に呼ぶ）
+	/// </summary>
+	void WaitForIdle() { frameScheduler_.WaitForIdle(); }
+
+	/// <summary>
+	/// フレーム管理の取得
+	/// </summary>
+	FrameScheduler* GetFrameScheduler() { return &frameScheduler_; }
+
+	/// <summary>
+	/// フレーム管理の統計情報の取得
+	/// </summary>
+	const FrameScheduler::Statistics& GetFrameStatistics() const {
+		return frameScheduler_.GetStatistics();
+	}
+
 	void SetRenderTargets(bool sRGB);
 
 private: // メンバ変数
@@ -85,7 +167,8 @@ private: // メンバ変数
 	Microsoft::WRL::ComPtr<IDXGIFactory7> dxgiFactory_;
 	Microsoft::WRL::ComPtr<ID3D12Device> device_;
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList_;
-	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator_;
+	// フレームごとのコマンドアロケータ
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> commandAllocators_;
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue_;
 	Microsoft::WRL::ComPtr<IDXGISwapChain4> swapChain_;
 	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> backBuffers_;
@@ -94,6 +177,14 @@ private: // メンバ変数
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> dsvHeap_;
 	Microsoft::WRL::ComPtr<ID3D12Fence> fence_;
 	UINT64 fenceVal_ = 0;
+	// フレーム管理
+	FrameScheduler frameScheduler_;
+	std::unique_ptr<FrameScheduler::Fence> frameFence_;
+	uint32_t frameCount_ = kDefaultFrameCount;
+	// 描画バックエンド
+	std::unique_ptr<D3D12RenderDevice> renderDevice_;
+	std::unique_ptr<D3D12RenderCommandList> renderCommandList_;
+	RenderCommandList* activeRenderCommandList_ = nullptr;
 	int32_t backBufferWidth_ = 0;
 	int32_t backBufferHeight_ = 0;
 	HANDLE frameLatencyWaitableObject_;
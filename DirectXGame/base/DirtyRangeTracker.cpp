@@ -0,0 +1,72 @@
+#include "DirtyRangeTracker.h"
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+void DirtyRangeTracker::Initialize(uint32_t elementCount, uint32_t copyCount) {
+	assert(copyCount > 0);
+	elementCount_ = elementCount;
+	dirtyBits_.assign(copyCount, std::vector<uint64_t>((elementCount + 63) / 64, 0));
+	ranges_.clear();
+	MarkAll();
+}
+
+void DirtyRangeTracker::Mark(uint32_t index) {
+	assert(index < elementCount_);
+	for (std::vector<uint64_t>& bits : dirtyBits_) {
+		bits[index / 64] |= uint64_t(1) << (index % 64);
+	}
+}
+
+void DirtyRangeTracker::Mark(uint32_t begin, uint32_t count) {
+	assert(begin + count <= elementCount_);
+	for (uint32_t i = begin; i < begin + count; i++) {
+		Mark(i);
+	}
+}
+
+const std::vector<DirtyRangeTracker::Range>&
+    DirtyRangeTracker::Collect(uint32_t copy, uint32_t mergeGap) {
+	assert(copy < dirtyBits_.size());
+	ranges_.clear();
+
+	std::vector<uint64_t>& bits = dirtyBits_[copy];
+	for (uint32_t w = 0; w < uint32_t(bits.size()); w++) {
+		uint64_t word = bits[w];
+		bits[w] = 0;
+		// 立っているビットの連続をまとめて取り出す
+		while (word != 0) {
+			uint32_t bit = uint32_t(std::countr_zero(word));
+			uint32_t run = uint32_t(std::countr_one(word >> bit));
+			uint32_t begin = w * 64 + bit;
+			if (bit + run >= 64) {
+				word = 0;
+			} else {
+				word &= ~(((uint64_t(1) << run) - 1) << bit);
+			}
+
+			// 前の区間と続いている（または隙間が小さい）ならつなげる
+			if (!ranges_.empty() &&
+			    begin <= ranges_.back().begin + ranges_.back().count + mergeGap) {
+				ranges_.back().count = begin + run - ranges_.back().begin;
+			} else {
+				ranges_.push_back({begin, run});
+			}
+		}
+	}
+	return ranges_;
+}
+
+uint64_t DirtyRangeTracker::Upload(
+    uint32_t copy, const void* source, void* destination, uint32_t stride, uint32_t mergeGap) {
+	const uint8_t* src = static_cast<const uint8_t*>(source);
+	uint8_t* dst = static_cast<uint8_t*>(destination);
+	uint64_t bytes = 0;
+	for (const Range& range : Collect(copy, mergeGap)) {
+		size_t offset = size_t(range.begin) * stride;
+		size_t size = size_t(range.count) * stride;
+		std::memcpy(dst + offset, src + offset, size);
+		bytes += size;
+	}
+	return bytes;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 変更された要素を記録し、書き込み先ごとに連続区間へまとめる（メモリそのものには触れない）
+/// </summary>
+/// <remarks>
+/// フレームごとに別のバッファへ書く場合、各バッファは自分が最後に書かれてからの変更を
+/// 全て受け取る必要があるので、印は書き込み先の数だけ持つ。
+/// </remarks>
+class DirtyRangeTracker {
+public:
+	/// <summary>
+	/// 連続区間
+	/// </summary>
+	struct Range {
+		// 先頭の要素番号
+		uint32_t begin = 0;
+		// 要素数
+		uint32_t count = 0;
+	};
+
+	/// <summary>
+	/// 初期化（全要素を変更ありにする）
+	/// </summary>
+	/// <param name="elementCount">要素数</param>
+	/// <param name="copyCount">書き込み先の数</param>
+	void Initialize(uint32_t elementCount, uint32_t copyCount);
+
+	/// <summary>
+	/// 1要素に変更の印を付ける
+	/// </summary>
+	void Mark(uint32_t index);
+
+	/// <summary>
+	/// 連続する要素に変更の印を付ける
+	/// </summary>
+	void Mark(uint32_t begin, uint32_t count);
+
+	/// <summary>
+	/// 全要素に変更の印を付ける
+	/// </summary>
+	void MarkAll() { Mark(0, elementCount_); }
+
+	/// <summary>
+	/// 書き込み先の変更を連続区間にまとめて取り出し、その書き込み先の印を消す
+	/// </summary>
+	/// <param name="copy">書き込み先の番号</param>
+	/// <param name="mergeGap">この数以下の隙間は埋めて1区間にする</param>
+	/// <returns>先頭から順に並んだ区間（次の呼び出しまで有効）</returns>
+	const std::vector<Range>& Collect(uint32_t copy, uint32_t mergeGap = 0);
+
+	/// <summary>
+	/// 変更をまとめて書き込む
+	/// </summary>
+	/// <param name="copy">書き込み先の番号</param>
+	/// <param name="source">全要素の元データ</param>
+	/// <param name="destination">書き込み先（マップ済みバッファなど）</param>
+	/// <param name="stride">1要素のバイト数</param>
+	/// <param name="mergeGap">この数以下の隙間は埋めて1区間にする</param>
+	/// <returns>書き込んだバイト数</returns>
+	uint64_t Upload(
+	    uint32_t copy, const void* source, void* destination, uint32_t stride,
+	    uint32_t mergeGap = 0);
+
+	uint32_t GetElementCount() const { return elementCount_; }
+	uint32_t GetCopyCount() const { return uint32_t(dirtyBits_.size()); }
+
+private:
+	// 要素数
+	uint32_t elementCount_ = 0;
+	// 書き込み先ごとの変更の印（1bitが1要素）
+	std::vector<std::vector<uint64_t>> dirtyBits_;
+	// 取り出した区間
+	std::vector<Range> ranges_;
+};
@@ -0,0 +1,59 @@
+#include "FrameScheduler.h"
+#include <cassert>
+
+void FrameScheduler::Initialize(Fence* fence, uint32_t frameCount, uint64_t initialFenceValue) {
+	assert(fence);
+	assert(frameCount > 0);
+	fence_ = fence;
+	frameFenceValues_.assign(frameCount, initialFenceValue);
+	frameIndex_ = 0;
+	signaledValue_ = initialFenceValue;
+	tasks_.clear();
+	statistics_ = {};
+}
+
+void FrameScheduler::BeginFrame() {
+	uint64_t value = frameFenceValues_[frameIndex_];
+	if (fence_->GetCompletedValue() < value) {
+		fence_->Wait(value);
+		statistics_.waitCount++;
+	}
+	RunCompletedTasks();
+}
+
+uint64_t FrameScheduler::EndFrame() {
+	fence_->Signal(++signaledValue_);
+	frameFenceValues_[frameIndex_] = signaledValue_;
+	frameIndex_ = (frameIndex_ + 1) % GetFrameCount();
+	statistics_.frameCount++;
+	return signaledValue_;
+}
+
+void FrameScheduler::Defer(std::function<void()> task) {
+	tasks_.push_back({GetCurrentFenceValue(), std::move(task)});
+	statistics_.pendingTaskCount = uint32_t(tasks_.size());
+}
+
+void FrameScheduler::WaitForIdle() {
+	if (fence_->GetCompletedValue() < signaledValue_) {
+		fence_->Wait(signaledValue_);
+	}
+	RunCompletedTasks();
+}
+
+void FrameScheduler::WaitForValue(uint64_t value) {
+	if (fence_->GetCompletedValue() < value) {
+		fence_->Wait(value);
+	}
+}
+
+void FrameScheduler::RunCompletedTasks() {
+	uint64_t completed = fence_->GetCompletedValue();
+	// 処理の中でDeferされても壊れないように1つずつ取り出す
+	while (!tasks_.empty() && tasks_.front().fenceValue <= completed) {
+		std::function<void()> function = std::move(tasks_.front().function);
+		tasks_.pop_front();
+		function();
+	}
+	statistics_.pendingTaskCount = uint32_t(tasks_.size());
+}
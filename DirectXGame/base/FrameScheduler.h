@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// 複数フレームを同時に処理させるためのフレーム番号とフェンス値の管理（グラフィックスAPIに依存しない）
+/// </summary>
+/// <remarks>
+/// 初期化直後はフレーム0を記録中として扱う。EndFrameでフェンスをシグナルして次のフレームに進み、
+/// BeginFrameでそのフレーム番号を前回使ったフレームの完了を待つ。
+/// Deferで登録した処理は、登録時に記録中だったフレームをGPUが終えた後に実行する。
+/// </remarks>
+class FrameScheduler {
+public:
+	/// <summary>
+	/// フェンス（D3D12ではコマンドキューとID3D12Fenceの組を包む）
+	/// </summary>
+	class Fence {
+	public:
+		virtual ~Fence() = default;
+
+		/// <summary>
+		/// GPUが完了したフェンス値の取得
+		/// </summary>
+		virtual uint64_t GetCompletedValue() const = 0;
+
+		/// <summary>
+		/// それまでに積んだコマンドの完了時にフェンス値をシグナルさせる
+		/// </summary>
+		/// <param name="value">フェンス値</param>
+		virtual void Signal(uint64_t value) = 0;
+
+		/// <summary>
+		/// フェンス値に達するまで待つ
+		/// </summary>
+		/// <param name="value">フェンス値</param>
+		virtual void Wait(uint64_t value) = 0;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 終えたフレーム数
+		uint64_t frameCount = 0;
+		// BeginFrameでGPUを待った回数
+		uint64_t waitCount = 0;
+		// 実行待ちの遅延処理の数
+		uint32_t pendingTaskCount = 0;
+	};
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="fence">フェンス</param>
+	/// <param name="frameCount">同時に処理中になりうるフレーム数</param>
+	/// <param name="initialFenceValue">フェンスの初期値</param>
+	void Initialize(Fence* fence, uint32_t frameCount, uint64_t initialFenceValue = 0);
+
+	/// <summary>
+	/// フレーム開始（今のフレーム番号を前回使ったフレームの完了を待つ）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// フレーム終了（コマンド実行後に呼ぶ）
+	/// </summary>
+	/// <returns>シグナルしたフェンス値</returns>
+	uint64_t EndFrame();
+
+	/// <summary>
+	/// 今記録中のフレームをGPUが終えた後に実行する処理を登録する
+	/// </summary>
+	/// <param name="task">処理（リソースの解放など）</param>
+	void Defer(std::function<void()> task);
+
+	/// <summary>
+	/// シグナル済みのフレームが全て終わるまで待ち、遅延処理を全て実行する
+	/// </summary>
+	void WaitForIdle();
+
+	/// <summary>
+	/// フェンス値に達するまで待つ
+	/// </summary>
+	/// <param name="value">フェンス値</param>
+	void WaitForValue(uint64_t value);
+
+	/// <summary>
+	/// 今のフレーム番号
+	/// </summary>
+	uint32_t GetFrameIndex() const { return frameIndex_; }
+
+	/// <summary>
+	/// 同時に処理中になりうるフレーム数
+	/// </summary>
+	uint32_t GetFrameCount() const { return uint32_t(frameFenceValues_.size()); }
+
+	/// <summary>
+	/// 今記録中のフレームの完了時にシグナルされるフェンス値
+	/// </summary>
+	uint64_t GetCurrentFenceValue() const { return signaledValue_ + 1; }
+
+	/// <summary>
+	/// 最後にシグナルしたフェンス値
+	/// </summary>
+	uint64_t GetSignaledValue() const { return signaledValue_; }
+
+	/// <summary>
+	/// GPUが完了したフェンス値
+	/// </summary>
+	uint64_t GetCompletedValue() const { return fence_->GetCompletedValue(); }
+
+	/// <summary>
+	/// 統計情報の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	/// <summary>
+	/// 遅延処理
+	/// </summary>
+	struct Task {
+		// このフェンス値に達したら実行する
+		uint64_t fenceValue;
+		std::function<void()> function;
+	};
+
+	/// <summary>
+	/// 完了したフレームの遅延処理を実行する
+	/// </summary>
+	void RunCompletedTasks();
+
+	// フェンス
+	Fence* fence_ = nullptr;
+	// 各フレーム番号を最後に使ったフレームのフェンス値
+	std::vector<uint64_t> frameFenceValues_;
+	// 今のフレーム番号
+	uint32_t frameIndex_ = 0;
+	// 最後にシグナルしたフェンス値
+	uint64_t signaledValue_ = 0;
+	// 遅延処理（フェンス値の昇順）
+	std::deque<Task> tasks_;
+	// 統計情報
+	Statistics statistics_;
+};
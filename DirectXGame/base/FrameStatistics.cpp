@@ -0,0 +1,153 @@
+#include "FrameStatistics.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+void FrameStatistics::Initialize(double budgetMilliseconds) {
+	assert(budgetMilliseconds > 0.0);
+	budgetMilliseconds_ = budgetMilliseconds;
+	histogram_.assign(kBinCount, 0);
+	frameCount_ = 0;
+	totalMilliseconds_ = 0.0;
+	minMilliseconds_ = 0.0;
+	maxMilliseconds_ = 0.0;
+	hitches_.assign(kMaxHitchCount, Hitch{});
+	hitchCount_ = 0;
+}
+
+void FrameStatistics::AddFrame(
+    double milliseconds, const std::vector<Profiler::ScopeStatistics>& scopes) {
+	assert(!histogram_.empty());
+	milliseconds = std::max(milliseconds, 0.0);
+
+	uint32_t bin = uint32_t(std::min(milliseconds / kBinMilliseconds, double(kBinCount - 1)));
+	histogram_[bin]++;
+	totalMilliseconds_ += milliseconds;
+	minMilliseconds_ = frameCount_ == 0 ? milliseconds : std::min(minMilliseconds_, milliseconds);
+	maxMilliseconds_ = std::max(maxMilliseconds_, milliseconds);
+
+	if (milliseconds > budgetMilliseconds_) {
+		Hitch& hitch = hitches_[hitchCount_ % kMaxHitchCount];
+		hitch = {};
+		hitch.frameIndex = frameCount_;
+		hitch.milliseconds = milliseconds;
+
+		// そのフレームに呼ばれた区間を長い順に残す
+		for (const Profiler::ScopeStatistics& scope : scopes) {
+			if (scope.callCount == 0) {
+				continue;
+			}
+			HitchScope candidate = {scope.name, scope.lastMilliseconds, scope.callCount};
+			uint32_t index = hitch.scopeCount;
+			while (index > 0 && hitch.scopes[index - 1].milliseconds < candidate.milliseconds) {
+				if (index < kMaxHitchScopeCount) {
+					hitch.scopes[index] = hitch.scopes[index - 1];
+				}
+				index--;
+			}
+			if (index < kMaxHitchScopeCount) {
+				hitch.scopes[index] = candidate;
+				hitch.scopeCount = std::min(hitch.scopeCount + 1, kMaxHitchScopeCount);
+			}
+		}
+		hitchCount_++;
+	}
+	frameCount_++;
+}
+
+FrameStatistics::Summary FrameStatistics::GetSummary() const {
+	Summary summary;
+	summary.frameCount = frameCount_;
+	summary.hitchCount = hitchCount_;
+	if (frameCount_ == 0) {
+		return summary;
+	}
+	summary.averageMilliseconds = totalMilliseconds_ / double(frameCount_);
+	summary.p50Milliseconds = GetPercentile(50.0);
+	summary.p95Milliseconds = GetPercentile(95.0);
+	summary.p99Milliseconds = GetPercentile(99.0);
+	summary.minMilliseconds = minMilliseconds_;
+	summary.maxMilliseconds = maxMilliseconds_;
+	return summary;
+}
+
+double FrameStatistics::GetPercentile(double percent) const {
+	if (frameCount_ == 0) {
+		return 0.0;
+	}
+
+	// percent%のフレームがそれ以下になる位置を含む区間を探して、区間内を補間する
+	double rank = std::clamp(percent, 0.0, 100.0) / 100.0 * double(frameCount_);
+	double cumulative = 0.0;
+	for (uint32_t bin = 0; bin < kBinCount; bin++) {
+		uint32_t count = histogram_[bin];
+		if (count > 0 && cumulative + double(count) >= rank) {
+			double lower = double(bin) * kBinMilliseconds;
+			double upper = bin + 1 < kBinCount ? lower + kBinMilliseconds : maxMilliseconds_;
+			double t = (rank - cumulative) / double(count);
+			// 実測の範囲からははみ出さない
+			return std::clamp(lower + (upper - lower) * t, minMilliseconds_, maxMilliseconds_);
+		}
+		cumulative += double(count);
+	}
+	return maxMilliseconds_;
+}
+
+std::vector<FrameStatistics::Hitch> FrameStatistics::GetHitches() const {
+	std::vector<Hitch> hitches;
+	uint64_t count = std::min<uint64_t>(hitchCount_, kMaxHitchCount);
+	for (uint64_t i = hitchCount_ - count; i < hitchCount_; i++) {
+		hitches.push_back(hitches_[i % kMaxHitchCount]);
+	}
+	return hitches;
+}
+
+std::string FrameStatistics::FormatReport() const {
+	Summary summary = GetSummary();
+
+	// Linuxでも組めるようstd::formatは使わない
+	std::string report;
+	char line[256];
+	std::snprintf(
+	    line, sizeof(line),
+	    "frames %llu, avg %.2f ms, p50 %.2f, p95 %.2f, p99 %.2f, min %.2f, max %.2f\n",
+	    (unsigned long long)summary.frameCount, summary.averageMilliseconds,
+	    summary.p50Milliseconds, summary.p95Milliseconds, summary.p99Milliseconds,
+	    summary.minMilliseconds, summary.maxMilliseconds);
+	report += line;
+	std::snprintf(
+	    line, sizeof(line), "hitches over %.2f ms: %llu (last %u kept)\n", budgetMilliseconds_,
+	    (unsigned long long)summary.hitchCount,
+	    uint32_t(std::min<uint64_t>(summary.hitchCount, kMaxHitchCount)));
+	report += line;
+
+	for (const Hitch& hitch : GetHitches()) {
+		std::snprintf(
+		    line, sizeof(line), "  frame %llu: %.2f ms", (unsigned long long)hitch.frameIndex,
+		    hitch.milliseconds);
+		report += line;
+		for (uint32_t i = 0; i < hitch.scopeCount; i++) {
+			const HitchScope& scope = hitch.scopes[i];
+			std::snprintf(
+			    line, sizeof(line), "%s%.*s %.2f", i == 0 ? " | " : ", ", int(scope.name.size()),
+			    scope.name.data(), scope.milliseconds);
+			report += line;
+			if (scope.callCount > 1) {
+				std::snprintf(line, sizeof(line), " x%u", scope.callCount);
+				report += line;
+			}
+		}
+		report += "\n";
+	}
+	return report;
+}
+
+bool FrameStatistics::WriteReport(const std::string& filePath) const {
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file << FormatReport();
+	return bool(file);
+}
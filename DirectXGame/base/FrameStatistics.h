@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Profiler.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// フレーム時間の統計と引っかかり（予算超過フレーム）の記録
+/// </summary>
+/// <remarks>
+/// フレーム時間は固定幅のヒストグラムに数え、百分位はヒストグラムから求めるので、
+/// 何フレーム積んでも記憶域は増えない。予算を超えたフレームは、そのフレームに
+/// Profilerが測った区間のうち長いものと一緒に直近kMaxHitchCount件を残す。
+/// グラフィックスAPIやWindowsに依存しない。
+/// </remarks>
+class FrameStatistics {
+public:
+	// ヒストグラムの1区間の幅[ms]
+	static constexpr double kBinMilliseconds = 0.1;
+	// ヒストグラムの区間数（これを超えるフレームは最後の区間に数える）
+	static constexpr uint32_t kBinCount = 2000;
+	// 残す引っかかりの件数
+	static constexpr uint32_t kMaxHitchCount = 32;
+	// 引っかかり1件に残す区間数
+	static constexpr uint32_t kMaxHitchScopeCount = 6;
+
+	/// <summary>
+	/// 引っかかりのフレームで測った区間
+	/// </summary>
+	struct HitchScope {
+		// 区間名
+		std::string_view name;
+		// フレーム内の合計時間[ms]
+		double milliseconds = 0.0;
+		// 呼び出し回数
+		uint32_t callCount = 0;
+	};
+
+	/// <summary>
+	/// 引っかかり
+	/// </summary>
+	struct Hitch {
+		// フレーム番号（AddFrameの呼び出し順）
+		uint64_t frameIndex = 0;
+		// フレーム時間[ms]
+		double milliseconds = 0.0;
+		// 長かった区間（長い順）
+		HitchScope scopes[kMaxHitchScopeCount];
+		// 区間数
+		uint32_t scopeCount = 0;
+	};
+
+	/// <summary>
+	/// 集計
+	/// </summary>
+	struct Summary {
+		// フレーム数
+		uint64_t frameCount = 0;
+		// 平均[ms]
+		double averageMilliseconds = 0.0;
+		// 中央値[ms]
+		double p50Milliseconds = 0.0;
+		// 95パーセンタイル[ms]
+		double p95Milliseconds = 0.0;
+		// 99パーセンタイル[ms]
+		double p99Milliseconds = 0.0;
+		// 最小[ms]
+		double minMilliseconds = 0.0;
+		// 最大[ms]
+		double maxMilliseconds = 0.0;
+		// 引っかかりの累計
+		uint64_t hitchCount = 0;
+	};
+
+	/// <summary>
+	/// 初期化（それまでの統計は捨てる）
+	/// </summary>
+	/// <param name="budgetMilliseconds">これを超えたフレームを引っかかりとする[ms]</param>
+	void Initialize(double budgetMilliseconds = 1000.0 / 60.0);
+
+	/// <summary>
+	/// 1フレーム分を積む
+	/// </summary>
+	/// <param name="milliseconds">フレーム時間[ms]</param>
+	/// <param name="scopes">そのフレームの区間の集計（Profiler::GetScopeStatistics）</param>
+	void AddFrame(double milliseconds, const std::vector<Profiler::ScopeStatistics>& scopes = {});
+
+	/// <summary>
+	/// 集計を求める
+	/// </summary>
+	Summary GetSummary() const;
+
+	/// <summary>
+	/// 百分位[ms]（ヒストグラムの区間内は一様とみなして補間する）
+	/// </summary>
+	/// <param name="percent">0～100</param>
+	double GetPercentile(double percent) const;
+
+	/// <summary>
+	/// 残っている引っかかり（古い順）
+	/// </summary>
+	std::vector<Hitch> GetHitches() const;
+
+	/// <summary>
+	/// ヒストグラム（kBinCount個。i番目は[i * kBinMilliseconds, (i + 1) * kBinMilliseconds)）
+	/// </summary>
+	const std::vector<uint32_t>& GetHistogram() const { return histogram_; }
+
+	/// <summary>
+	/// 予算[ms]
+	/// </summary>
+	double GetBudgetMilliseconds() const { return budgetMilliseconds_; }
+
+	/// <summary>
+	/// 集計と直近の引っかかりを短いテキストにする
+	/// </summary>
+	std::string FormatReport() const;
+
+	/// <summary>
+	/// FormatReportの内容を書き出す
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <returns>書き出せたか</returns>
+	bool WriteReport(const std::string& filePath) const;
+
+private:
+	// 予算[ms]
+	double budgetMilliseconds_ = 1000.0 / 60.0;
+	// ヒストグラム
+	std::vector<uint32_t> histogram_;
+	// フレーム数
+	uint64_t frameCount_ = 0;
+	// 合計[ms]
+	double totalMilliseconds_ = 0.0;
+	// 最小、最大[ms]
+	double minMilliseconds_ = 0.0;
+	double maxMilliseconds_ = 0.0;
+	// 直近の引っかかり（リング）
+	std::vector<Hitch> hitches_;
+	// 引っかかりの累計
+	uint64_t hitchCount_ = 0;
+};
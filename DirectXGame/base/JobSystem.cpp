@@ -0,0 +1,278 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <string>
+
+thread_local JobSystem* JobSystem::tOwner_ = nullptr;
+thread_local uint32_t JobSystem::tQueueIndex_ = 0;
+
+namespace {
+
+// 寝る前にキューを見直す回数
+const uint32_t kSpinCount = 64;
+
+} // namespace
+
+JobSystem* JobSystem::GetInstance() {
+	// ワーカーが使うプロファイラを先に作り、終了時にこちらより後で破棄されるようにする
+	Profiler::GetInstance();
+	static JobSystem instance;
+	return &instance;
+}
+
+JobSystem::~JobSystem() { Finalize(); }
+
+void JobSystem::Initialize(uint32_t workerCount) {
+	assert(workers_.empty());
+	quit_ = false;
+	queueCount_ = workerCount + 1;
+	queues_ = std::make_unique<WorkQueue[]>(queueCount_);
+	workers_.reserve(workerCount);
+	for (uint32_t i = 1; i <= workerCount; i++) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+void JobSystem::Finalize() {
+	if (workers_.empty()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		quit_ = true;
+	}
+	taskArrived_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+	assert(queuedTaskCount_.load() == 0);
+}
+
+uint32_t JobSystem::GetDefaultWorkerCount() {
+	uint32_t threadCount = std::thread::hardware_concurrency();
+	return threadCount > 1 ? threadCount - 1 : 0;
+}
+
+void JobSystem::Run(const Job& job, Counter* counter) { Run(&job, 1, counter); }
+
+void JobSystem::Run(const Job* jobs, uint32_t count, Counter* counter) {
+	if (count == 0) {
+		return;
+	}
+	if (counter) {
+		counter->value_.fetch_add(count, std::memory_order_relaxed);
+	}
+	// ワーカーがいなければ待つスレッドが実行するので、ここでは積むだけ
+	std::vector<Task> tasks(count);
+	for (uint32_t i = 0; i < count; i++) {
+		tasks[i].job = jobs[i];
+		tasks[i].counter = counter;
+	}
+	Push(tasks.data(), count);
+}
+
+void JobSystem::RunAfter(Counter& dependency, const Job& job, Counter* counter) {
+	if (counter) {
+		counter->value_.fetch_add(1, std::memory_order_relaxed);
+	}
+	{
+		// 依存先の最後のジョブは残り数を0にしてからこのロックを取って待ちを回収するので、
+		// ロック中に残りがあれば回収に間に合い、なければもう積んでよい
+		std::lock_guard<std::mutex> lock(dependency.mutex_);
+		if (!dependency.IsDone()) {
+			dependency.waitingJobs_.push_back(job);
+			dependency.waitingCounters_.push_back(counter);
+			return;
+		}
+	}
+	Task task = {job, counter};
+	Push(&task, 1);
+}
+
+void JobSystem::Wait(Counter& counter) {
+	// 後片付け中のスレッドがいなくなるまで待つ（戻った後にカウンタを破棄してよい）
+	uint32_t queueIndex = GetQueueIndex();
+	while (counter.value_.load(std::memory_order_acquire) != 0) {
+		if (!TryRunTask(queueIndex)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+JobSystem::Statistics JobSystem::GetStatistics() const {
+	Statistics statistics;
+	statistics.executedJobCount = executedJobCount_.load(std::memory_order_relaxed);
+	statistics.stolenJobCount = stolenJobCount_.load(std::memory_order_relaxed);
+	return statistics;
+}
+
+void JobSystem::WorkerMain(uint32_t queueIndex) {
+	tOwner_ = this;
+	tQueueIndex_ = queueIndex;
+	Profiler::GetInstance()->SetThreadName("JobWorker " + std::to_string(queueIndex));
+
+	while (true) {
+		if (TryRunTask(queueIndex)) {
+			continue;
+		}
+		// すぐ次が来ることが多いので、少し見直してから寝る
+		bool found = false;
+		for (uint32_t i = 0; i < kSpinCount && !found; i++) {
+			std::this_thread::yield();
+			found = queuedTaskCount_.load(std::memory_order_relaxed) > 0;
+		}
+		if (found) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		sleepingWorkerCount_.fetch_add(1);
+		taskArrived_.wait(lock, [this] { return quit_ || queuedTaskCount_.load() > 0; });
+		sleepingWorkerCount_.fetch_sub(1);
+		if (quit_) {
+			break;
+		}
+	}
+	tOwner_ = nullptr;
+}
+
+uint32_t JobSystem::GetQueueIndex() const { return tOwner_ == this ? tQueueIndex_ : 0; }
+
+void JobSystem::Push(const Task* tasks, uint32_t count) {
+	assert(queues_);
+	// 取り出しより先に数が減らないよう、積む前に増やす
+	queuedTaskCount_.fetch_add(count);
+	WorkQueue& queue = queues_[GetQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.insert(queue.tasks.end(), tasks, tasks + count);
+	}
+	WakeWorkers(count);
+}
+
+void JobSystem::PushChunks(
+    JobFunction function, void* data, uint32_t count, uint32_t grainSize, uint32_t firstChunk,
+    Counter* counter) {
+	assert(queues_);
+	uint32_t chunkCount = count / grainSize + (count % grainSize != 0 ? 1 : 0);
+	if (firstChunk >= chunkCount) {
+		return;
+	}
+	uint32_t pushCount = chunkCount - firstChunk;
+	if (counter) {
+		counter->value_.fetch_add(pushCount, std::memory_order_relaxed);
+	}
+	queuedTaskCount_.fetch_add(pushCount);
+
+	// 持ち主は後ろから取るので、先頭に近いかたまりほど後に積んで呼び出し元の実行順をそろえる
+	WorkQueue& queue = queues_[GetQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		for (uint32_t chunk = chunkCount; chunk-- > firstChunk;) {
+			Task task;
+			task.job.function = function;
+			task.job.data = data;
+			task.job.begin = chunk * grainSize;
+			task.job.end = std::min(count, task.job.begin + grainSize);
+			task.counter = counter;
+			queue.tasks.push_back(task);
+		}
+	}
+	WakeWorkers(pushCount);
+}
+
+void JobSystem::WakeWorkers(uint32_t count) {
+	// 寝るワーカーは寝ている数を増やしてからジョブ数を見るので、
+	// ジョブ数を増やしてから寝ている数を見れば起こし損ねない
+	if (sleepingWorkerCount_.load() == 0) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+	}
+	if (count == 1) {
+		taskArrived_.notify_one();
+	} else {
+		taskArrived_.notify_all();
+	}
+}
+
+bool JobSystem::TryRunTask(uint32_t queueIndex) {
+	if (queuedTaskCount_.load(std::memory_order_relaxed) == 0) {
+		return false;
+	}
+
+	// 自分のキューの後ろ（新しい方）から
+	Task task;
+	bool found = false;
+	{
+		WorkQueue& queue = queues_[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+			found = true;
+		}
+	}
+	// なければ隣から順に他のキューの前（古い方）を横取りする
+	for (uint32_t i = 1; i < queueCount_ && !found; i++) {
+		WorkQueue& queue = queues_[(queueIndex + i) % queueCount_];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			found = true;
+			stolenJobCount_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	if (!found) {
+		return false;
+	}
+	queuedTaskCount_.fetch_sub(1, std::memory_order_relaxed);
+
+	{
+		PROFILE_SCOPE("JobSystem::Job");
+		task.job.function(task.job.data, task.job.begin, task.job.end);
+	}
+	executedJobCount_.fetch_add(1, std::memory_order_relaxed);
+	if (task.counter) {
+		Complete(task.counter);
+	}
+	return true;
+}
+
+void JobSystem::Complete(Counter* counter) {
+	// 最後の1つは残り数を0にするのと同時に後片付け中の数を増やし、Waitを後片付けの後まで待たせる
+	uint64_t value = counter->value_.load(std::memory_order_relaxed);
+	bool isLast = false;
+	while (true) {
+		assert((value & Counter::kCountMask) > 0);
+		isLast = (value & Counter::kCountMask) == 1;
+		uint64_t next = value - 1 + (isLast ? Counter::kFinisherOne : 0);
+		if (counter->value_.compare_exchange_weak(value, next, std::memory_order_acq_rel)) {
+			break;
+		}
+	}
+	if (!isLast) {
+		return;
+	}
+
+	// 待っていたジョブを回収してから後片付けを終える（以降はカウンタに触れない）
+	std::vector<Job> waitingJobs;
+	std::vector<Counter*> waitingCounters;
+	{
+		std::lock_guard<std::mutex> lock(counter->mutex_);
+		waitingJobs.swap(counter->waitingJobs_);
+		waitingCounters.swap(counter->waitingCounters_);
+	}
+	counter->value_.fetch_sub(Counter::kFinisherOne, std::memory_order_release);
+
+	if (!waitingJobs.empty()) {
+		std::vector<Task> tasks(waitingJobs.size());
+		for (size_t i = 0; i < waitingJobs.size(); i++) {
+			tasks[i] = {waitingJobs[i], waitingCounters[i]};
+		}
+		Push(tasks.data(), uint32_t(tasks.size()));
+	}
+}
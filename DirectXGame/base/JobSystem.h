@@ -0,0 +1,287 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// ワークスティーリングのジョブシステム（ワーカーごとの両端キューと、手の空いたワーカーの横取り）
+/// </summary>
+/// <remarks>
+/// 積んだジョブは積んだワーカーのキューの後ろに入り、持ち主は後ろ（新しい方）から、
+/// 手の空いたワーカーは他のキューの前（古い方）から取る。ワーカー以外のスレッドが積んだジョブは
+/// 共有のキューに入る。完了はカウンタで待ち、待っている間は待っているスレッドもジョブを実行する。
+/// 依存先のカウンタを指定したジョブは、依存先のジョブが全て終わってから積まれる。
+/// キューは個別のミューテックスで守る（持ち主と横取りが同じキューでぶつかる時だけ待つ）。
+/// グラフィックスAPIやWindowsに依存しない。
+/// </remarks>
+class JobSystem {
+public:
+	/// <summary>
+	/// ジョブの関数
+	/// </summary>
+	/// <param name="data">ジョブのデータ（ジョブが終わるまで有効なこと）</param>
+	/// <param name="begin">範囲の先頭</param>
+	/// <param name="end">範囲の終端</param>
+	using JobFunction = void (*)(void* data, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// ジョブ
+	/// </summary>
+	struct Job {
+		// 関数
+		JobFunction function = nullptr;
+		// データ
+		void* data = nullptr;
+		// 範囲
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	/// <summary>
+	/// ジョブの完了を数えるカウンタ（積んだジョブが全て終わると0になる）
+	/// </summary>
+	class Counter {
+	public:
+		Counter() = default;
+		~Counter() { assert(value_.load() == 0 && waitingJobs_.empty()); }
+		Counter(const Counter&) = delete;
+		Counter& operator=(const Counter&) = delete;
+
+		/// <summary>
+		/// 積んだジョブが全て終わったか
+		/// </summary>
+		bool IsDone() const { return (value_.load(std::memory_order_acquire) & kCountMask) == 0; }
+
+	private:
+		friend class JobSystem;
+
+		// 下位32ビットが残りのジョブ数、上位32ビットが後片付け中のスレッド数
+		static constexpr uint64_t kCountMask = 0xffffffffull;
+		static constexpr uint64_t kFinisherOne = 1ull << 32;
+
+		// 残りのジョブ数と後片付け中のスレッド数
+		std::atomic<uint64_t> value_ = 0;
+		// waitingJobs_の排他
+		std::mutex mutex_;
+		// 完了を待っているジョブと、そのジョブのカウンタ
+		std::vector<Job> waitingJobs_;
+		std::vector<Counter*> waitingCounters_;
+	};
+
+	/// <summary>
+	/// 統計（累計）
+	/// </summary>
+	struct Statistics {
+		// 実行したジョブ数
+		uint64_t executedJobCount = 0;
+		// 他のキューから横取りしたジョブ数
+		uint64_t stolenJobCount = 0;
+	};
+
+	/// <summary>
+	/// エンジンで共有するインスタンスの取得（テストなどでは個別に作ってよい）
+	/// </summary>
+	/// <returns>共有インスタンス</returns>
+	static JobSystem* GetInstance();
+
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// 初期化（ワーカーを起動する）
+	/// </summary>
+	/// <param name="workerCount">ワーカー数（0なら全て待っているスレッドで実行する）</param>
+	void Initialize(uint32_t workerCount);
+
+	/// <summary>
+	/// 終了（ワーカーを止める。積んだジョブは全て待ってから呼ぶこと）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// ハードウェアのスレッド数から、呼び出し元のスレッドの分を除いたワーカー数
+	/// </summary>
+	static uint32_t GetDefaultWorkerCount();
+
+	/// <summary>
+	/// ワーカー数
+	/// </summary>
+	uint32_t GetWorkerCount() const { return uint32_t(workers_.size()); }
+
+	/// <summary>
+	/// ジョブを積む
+	/// </summary>
+	/// <param name="job">ジョブ</param>
+	/// <param name="counter">完了を数えるカウンタ（nullptrなら数えない）</param>
+	void Run(const Job& job, Counter* counter = nullptr);
+
+	/// <summary>
+	/// ジョブをまとめて積む
+	/// </summary>
+	/// <param name="jobs">ジョブ</param>
+	/// <param name="count">ジョブ数</param>
+	/// <param name="counter">完了を数えるカウンタ（nullptrなら数えない）</param>
+	void Run(const Job* jobs, uint32_t count, Counter* counter = nullptr);
+
+	/// <summary>
+	/// 依存先のジョブが全て終わってからジョブを積む
+	/// </summary>
+	/// <param name="dependency">依存先のカウンタ（ジョブを積み終えてから呼ぶこと）</param>
+	/// <param name="job">ジョブ</param>
+	/// <param name="counter">完了を数えるカウンタ（nullptrなら数えない）</param>
+	void RunAfter(Counter& dependency, const Job& job, Counter* counter = nullptr);
+
+	/// <summary>
+	/// カウンタが0になるまで、ジョブを実行しながら待つ
+	/// </summary>
+	void Wait(Counter& counter);
+
+	/// <summary>
+	/// [0, count)をgrainSizeずつに分けて並列に実行し、全て終わるまで待つ
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1ジョブの要素数</param>
+	/// <param name="function">function(begin, end)。複数のスレッドから同時に呼ばれる</param>
+	template<typename Function>
+	void ParallelFor(uint32_t count, uint32_t grainSize, Function&& function);
+
+	/// <summary>
+	/// 呼び出し可能なオブジェクトからジョブを作る（オブジェクトはジョブが終わるまで有効なこと）
+	/// </summary>
+	/// <param name="function">function(begin, end)</param>
+	/// <param name="begin">範囲の先頭</param>
+	/// <param name="end">範囲の終端</param>
+	template<typename Function>
+	static Job MakeJob(Function& function, uint32_t begin = 0, uint32_t end = 0);
+
+	/// <summary>
+	/// 統計の取得
+	/// </summary>
+	Statistics GetStatistics() const;
+
+private:
+	/// <summary>
+	/// キューに積んだジョブ
+	/// </summary>
+	struct Task {
+		// ジョブ
+		Job job;
+		// 完了を数えるカウンタ
+		Counter* counter = nullptr;
+	};
+
+	/// <summary>
+	/// ワーカーごとの両端キュー（0番はワーカー以外のスレッドの共有）
+	/// </summary>
+	struct alignas(64) WorkQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	/// <summary>
+	/// ワーカーのメイン関数
+	/// </summary>
+	/// <param name="queueIndex">自分のキュー番号</param>
+	void WorkerMain(uint32_t queueIndex);
+
+	/// <summary>
+	/// 今のスレッドのキュー番号（このシステムのワーカーでなければ0）
+	/// </summary>
+	uint32_t GetQueueIndex() const;
+
+	/// <summary>
+	/// 今のスレッドのキューに積んで、寝ているワーカーを起こす
+	/// </summary>
+	/// <param name="tasks">ジョブ</param>
+	/// <param name="count">ジョブ数</param>
+	void Push(const Task* tasks, uint32_t count);
+
+	/// <summary>
+	/// [0, count)をgrainSizeずつに分けたうち、firstChunk番目以降を積む
+	/// </summary>
+	void PushChunks(
+	    JobFunction function, void* data, uint32_t count, uint32_t grainSize, uint32_t firstChunk,
+	    Counter* counter);
+
+	/// <summary>
+	/// 寝ているワーカーを起こす（queuedTaskCount_を増やしてから呼ぶ）
+	/// </summary>
+	/// <param name="count">積んだジョブ数</param>
+	void WakeWorkers(uint32_t count);
+
+	/// <summary>
+	/// 自分のキューの後ろか、他のキューの前から1つ取って実行する
+	/// </summary>
+	/// <param name="queueIndex">自分のキュー番号</param>
+	/// <returns>実行したか</returns>
+	bool TryRunTask(uint32_t queueIndex);
+
+	/// <summary>
+	/// カウンタを1つ減らし、0になったら待っていたジョブを積む
+	/// </summary>
+	void Complete(Counter* counter);
+
+	// 今のスレッドがワーカーとして属するシステムとキュー番号
+	static thread_local JobSystem* tOwner_;
+	static thread_local uint32_t tQueueIndex_;
+
+	// ワーカー
+	std::vector<std::thread> workers_;
+	// キュー（ワーカー数+1）
+	std::unique_ptr<WorkQueue[]> queues_;
+	uint32_t queueCount_ = 0;
+	// 全キューのジョブ数
+	std::atomic<uint32_t> queuedTaskCount_ = 0;
+	// 寝ているワーカー数
+	std::atomic<uint32_t> sleepingWorkerCount_ = 0;
+	// 寝ているワーカーを起こす
+	std::mutex sleepMutex_;
+	std::condition_variable taskArrived_;
+	// 終了要求（sleepMutex_で守る）
+	bool quit_ = false;
+	// 統計
+	std::atomic<uint64_t> executedJobCount_ = 0;
+	std::atomic<uint64_t> stolenJobCount_ = 0;
+};
+
+template<typename Function>
+void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, Function&& function) {
+	assert(grainSize > 0);
+	uint32_t chunkCount = count / grainSize + (count % grainSize != 0 ? 1 : 0);
+	if (chunkCount <= 1 || workers_.empty()) {
+		if (count > 0) {
+			function(0u, count);
+		}
+		return;
+	}
+
+	// 2つ目以降のかたまりを積み、最初のかたまりは呼び出し元で実行してから残りを手伝う
+	Job job = MakeJob(function);
+	Counter counter;
+	PushChunks(job.function, job.data, count, grainSize, 1, &counter);
+	function(0u, grainSize);
+	Wait(counter);
+}
+
+template<typename Function>
+JobSystem::Job JobSystem::MakeJob(Function& function, uint32_t begin, uint32_t end) {
+	using FunctionType = std::remove_reference_t<Function>;
+	Job job;
+	job.function = [](void* data, uint32_t rangeBegin, uint32_t rangeEnd) {
+		(*static_cast<FunctionType*>(data))(rangeBegin, rangeEnd);
+	};
+	job.data = const_cast<std::remove_const_t<FunctionType>*>(std::addressof(function));
+	job.begin = begin;
+	job.end = end;
+	return job;
+}
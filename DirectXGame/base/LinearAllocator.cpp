@@ -0,0 +1,57 @@
+#include "LinearAllocator.h"
+#include <cassert>
+
+void LinearAllocator::Initialize(uint32_t regionCount, uint64_t regionSize) {
+	assert(regionCount > 0);
+	assert(regionSize > 0);
+	regionSize_ = regionSize;
+	regionFenceValues_.assign(regionCount, 0);
+	// 最初のBeginFrameで0番に進むように末尾から始める
+	regionIndex_ = regionCount - 1;
+	cursor_ = 0;
+	isInFrame_ = false;
+	statistics_ = {};
+	lastStatistics_ = {};
+}
+
+bool LinearAllocator::BeginFrame(uint64_t completedFenceValue) {
+	assert(!isInFrame_);
+	uint32_t next = (regionIndex_ + 1) % GetRegionCount();
+	if (regionFenceValues_[next] > completedFenceValue) {
+		return false;
+	}
+
+	regionIndex_ = next;
+	cursor_ = 0;
+	isInFrame_ = true;
+	statistics_ = {};
+	return true;
+}
+
+uint64_t LinearAllocator::Allocate(uint64_t size, uint64_t alignment) {
+	assert(isInFrame_);
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	uint64_t offset = (cursor_ + alignment - 1) & ~(alignment - 1);
+	if (offset + size > regionSize_) {
+		statistics_.failedCount++;
+		return kInvalidOffset;
+	}
+
+	cursor_ = offset + size;
+	statistics_.allocationCount++;
+	statistics_.requestedBytes += size;
+	statistics_.usedBytes = cursor_;
+	return offset;
+}
+
+void LinearAllocator::EndFrame(uint64_t fenceValue) {
+	assert(isInFrame_);
+	regionFenceValues_[regionIndex_] = fenceValue;
+	isInFrame_ = false;
+	lastStatistics_ = statistics_;
+}
+
+uint64_t LinearAllocator::GetNextRegionFenceValue() const {
+	return regionFenceValues_[(regionIndex_ + 1) % GetRegionCount()];
+}
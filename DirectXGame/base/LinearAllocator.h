@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// フレームごとの線形割り当て（領域をフェンス値で使い回す。メモリそのものには触れない）
+/// </summary>
+/// <remarks>
+/// 領域を1フレームに1つ使い、割り当ては先頭から詰めるだけ。
+/// フレーム終了時にそのフレームのフェンス値を記録し、GPUがそこまで終えた領域だけを再利用する。
+/// </remarks>
+class LinearAllocator {
+public:
+	// 割り当て失敗
+	static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+
+	/// <summary>
+	/// 1フレーム分の統計情報
+	/// </summary>
+	struct Statistics {
+		// 割り当て回数
+		uint32_t allocationCount = 0;
+		// 要求されたバイト数
+		uint64_t requestedBytes = 0;
+		// 配置調整込みで使用したバイト数
+		uint64_t usedBytes = 0;
+		// 容量不足で失敗した回数
+		uint32_t failedCount = 0;
+	};
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="regionCount">領域数（同時に処理中になりうるフレーム数）</param>
+	/// <param name="regionSize">1領域のバイト数</param>
+	void Initialize(uint32_t regionCount, uint64_t regionSize);
+
+	/// <summary>
+	/// フレーム開始（次の領域に進む）
+	/// </summary>
+	/// <param name="completedFenceValue">GPUが完了したフェンス値</param>
+	/// <returns>次の領域がまだGPUで使用中ならfalse（待ってから呼び直す）</returns>
+	bool BeginFrame(uint64_t completedFenceValue);
+
+	/// <summary>
+	/// 割り当て
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">配置（2の累乗）</param>
+	/// <returns>今の領域の先頭からのオフセット。入らなければkInvalidOffset</returns>
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+	/// <summary>
+	/// フレーム終了
+	/// </summary>
+	/// <param name="fenceValue">このフレームのコマンド完了時にシグナルされるフェンス値</param>
+	void EndFrame(uint64_t fenceValue);
+
+	/// <summary>
+	/// 今の領域番号
+	/// </summary>
+	uint32_t GetRegionIndex() const { return regionIndex_; }
+
+	/// <summary>
+	/// 次の領域を再利用するために待つべきフェンス値
+	/// </summary>
+	uint64_t GetNextRegionFenceValue() const;
+
+	uint32_t GetRegionCount() const { return uint32_t(regionFenceValues_.size()); }
+	uint64_t GetRegionSize() const { return regionSize_; }
+
+	/// <summary>
+	/// 直前のフレームの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return lastStatistics_; }
+
+private:
+	// 1領域のバイト数
+	uint64_t regionSize_ = 0;
+	// 各領域を最後に使ったフレームのフェンス値
+	std::vector<uint64_t> regionFenceValues_;
+	// 今の領域番号
+	uint32_t regionIndex_ = 0;
+	// 今の領域の使用済みバイト数
+	uint64_t cursor_ = 0;
+	// フレーム中か
+	bool isInFrame_ = false;
+	// 今のフレームの統計情報
+	Statistics statistics_;
+	// 直前のフレームの統計情報
+	Statistics lastStatistics_;
+};
@@ -0,0 +1,297 @@
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+
+MemoryTracker::Counter MemoryTracker::sCounters_[size_t(Tag::kCountOfTag)];
+MemoryTracker::ThreadCounters MemoryTracker::sThreadCounters_[kMaxThreadCount + 1];
+std::atomic<uint32_t> MemoryTracker::sThreadCount_ = 0;
+MemoryTracker::FrameCounter MemoryTracker::sFrameCounters_[size_t(Tag::kCountOfTag)];
+thread_local MemoryTracker::TagStack MemoryTracker::tTagStack_ = {};
+
+namespace {
+
+/// <summary>
+/// 確保した領域の直前に置く見出し
+/// </summary>
+struct AllocationHeader {
+	// 要求されたバイト数
+	uint64_t size;
+	// mallocで得た先頭から返した領域までのバイト数
+	uint32_t offset;
+	// 確保時の分類
+	MemoryTracker::Tag tag;
+};
+// 見出しの大きさ（mallocの既定のアラインメントを崩さない）
+constexpr size_t kHeaderSize = 16;
+static_assert(sizeof(AllocationHeader) <= kHeaderSize);
+
+// 分類名
+const char* const kTagNames[] = {"Other", "Map", "Model", "Texture", "Audio", "UI"};
+static_assert(std::size(kTagNames) == size_t(MemoryTracker::Tag::kCountOfTag));
+
+} // namespace
+
+bool MemoryTracker::IsEnabled() {
+#ifdef MEMORY_TRACKER_DISABLED
+	return false;
+#else
+	return true;
+#endif
+}
+
+const char* MemoryTracker::GetTagName(Tag tag) {
+	assert(tag < Tag::kCountOfTag);
+	return kTagNames[size_t(tag)];
+}
+
+void MemoryTracker::PushTag(Tag tag) {
+	assert(tag < Tag::kCountOfTag);
+	assert(tTagStack_.depth < kMaxTagDepth);
+	tTagStack_.tags[tTagStack_.depth++] = tag;
+}
+
+void MemoryTracker::PopTag() {
+	assert(tTagStack_.depth > 0);
+	tTagStack_.depth--;
+}
+
+MemoryTracker::Tag MemoryTracker::GetCurrentTag() {
+	return tTagStack_.depth > 0 ? tTagStack_.tags[tTagStack_.depth - 1] : Tag::kOther;
+}
+
+void* MemoryTracker::Allocate(size_t size, size_t alignment) {
+	// 既定のアラインメントなら見出しの直後を返し、それより大きければ余分に取って揃える
+	size_t padding = alignment > kHeaderSize ? alignment - 1 : 0;
+	if (size > SIZE_MAX - kHeaderSize - padding) {
+		return nullptr;
+	}
+	uint8_t* base = static_cast<uint8_t*>(std::malloc(size + kHeaderSize + padding));
+	if (!base) {
+		return nullptr;
+	}
+	uintptr_t address = reinterpret_cast<uintptr_t>(base) + kHeaderSize;
+	if (padding > 0) {
+		address = (address + padding) & ~uintptr_t(alignment - 1);
+	}
+	uint8_t* pointer = reinterpret_cast<uint8_t*>(address);
+
+	Tag tag = GetCurrentTag();
+	AllocationHeader* header = reinterpret_cast<AllocationHeader*>(pointer - kHeaderSize);
+	header->size = size;
+	header->offset = uint32_t(pointer - base);
+	header->tag = tag;
+
+	// 最大は取り合いに負けたら読み直して、超えている間だけ書き直す
+	Counter& counter = sCounters_[size_t(tag)];
+	int64_t liveBytes =
+	    counter.liveBytes.fetch_add(int64_t(size), std::memory_order_relaxed) + int64_t(size);
+	int64_t peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+	while (liveBytes > peakBytes &&
+	       !counter.peakBytes.compare_exchange_weak(
+	           peakBytes, liveBytes, std::memory_order_relaxed)) {
+	}
+	ThreadCounter& threadCounter = GetThreadCounters()->tags[size_t(tag)];
+	Add<int64_t>(threadCounter.liveCount, 1);
+	Add<uint64_t>(threadCounter.allocationCount, 1);
+	Add<uint64_t>(threadCounter.allocatedBytes, size);
+	return pointer;
+}
+
+void MemoryTracker::Free(void* pointer) {
+	if (!pointer) {
+		return;
+	}
+	uint8_t* bytes = static_cast<uint8_t*>(pointer);
+	const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(bytes - kHeaderSize);
+	assert(header->tag < Tag::kCountOfTag);
+
+	sCounters_[size_t(header->tag)].liveBytes.fetch_sub(
+	    int64_t(header->size), std::memory_order_relaxed);
+	Add<int64_t>(GetThreadCounters()->tags[size_t(header->tag)].liveCount, -1);
+	std::free(bytes - header->offset);
+}
+
+MemoryTracker::ThreadCounters* MemoryTracker::GetThreadCounters() {
+	if (!tTagStack_.counters) {
+		uint32_t index = sThreadCount_.fetch_add(1, std::memory_order_acq_rel);
+		tTagStack_.shared = index >= kMaxThreadCount;
+		tTagStack_.counters = &sThreadCounters_[std::min(index, kMaxThreadCount)];
+	}
+	return tTagStack_.counters;
+}
+
+MemoryTracker::TagStatistics MemoryTracker::GetStatistics(Tag tag) {
+	assert(tag < Tag::kCountOfTag);
+	const Counter& counter = sCounters_[size_t(tag)];
+	const FrameCounter& frameCounter = sFrameCounters_[size_t(tag)];
+
+	TagStatistics statistics;
+	statistics.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+	statistics.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+	// 割り当て済みのスレッドごとの数と共有分を足す
+	uint32_t threadCount = std::min(sThreadCount_.load(std::memory_order_acquire), kMaxThreadCount);
+	for (uint32_t i = 0; i <= threadCount; i++) {
+		const ThreadCounter& threadCounter =
+		    sThreadCounters_[i < threadCount ? i : kMaxThreadCount].tags[size_t(tag)];
+		statistics.liveCount += threadCounter.liveCount.load(std::memory_order_relaxed);
+		statistics.allocationCount += threadCounter.allocationCount.load(std::memory_order_relaxed);
+		statistics.allocatedBytes += threadCounter.allocatedBytes.load(std::memory_order_relaxed);
+	}
+	statistics.frameAllocationCount = frameCounter.frameAllocationCount;
+	statistics.frameAllocatedBytes = frameCounter.frameAllocatedBytes;
+	statistics.maxFrameAllocationCount = frameCounter.maxFrameAllocationCount;
+	return statistics;
+}
+
+MemoryTracker::TagStatistics MemoryTracker::GetTotalStatistics() {
+	// 最大は分類ごとの最大の和（同時に最大だったとは限らないので上限の目安）
+	TagStatistics total;
+	for (size_t i = 0; i < size_t(Tag::kCountOfTag); i++) {
+		TagStatistics statistics = GetStatistics(Tag(i));
+		total.liveBytes += statistics.liveBytes;
+		total.peakBytes += statistics.peakBytes;
+		total.liveCount += statistics.liveCount;
+		total.allocationCount += statistics.allocationCount;
+		total.allocatedBytes += statistics.allocatedBytes;
+		total.frameAllocationCount += statistics.frameAllocationCount;
+		total.frameAllocatedBytes += statistics.frameAllocatedBytes;
+		total.maxFrameAllocationCount += statistics.maxFrameAllocationCount;
+	}
+	return total;
+}
+
+void MemoryTracker::EndFrame() {
+	for (size_t i = 0; i < size_t(Tag::kCountOfTag); i++) {
+		FrameCounter& frameCounter = sFrameCounters_[i];
+		TagStatistics statistics = GetStatistics(Tag(i));
+		uint64_t allocationCount = statistics.allocationCount;
+		uint64_t allocatedBytes = statistics.allocatedBytes;
+		frameCounter.frameAllocationCount = allocationCount - frameCounter.allocationCount;
+		frameCounter.frameAllocatedBytes = allocatedBytes - frameCounter.allocatedBytes;
+		frameCounter.allocationCount = allocationCount;
+		frameCounter.allocatedBytes = allocatedBytes;
+		if (frameCounter.frameAllocationCount > frameCounter.maxFrameAllocationCount) {
+			frameCounter.maxFrameAllocationCount = frameCounter.frameAllocationCount;
+		}
+	}
+}
+
+std::string MemoryTracker::FormatReport() {
+	// 集計を先に読んでおき、文字列の確保が結果に混ざらないようにする
+	TagStatistics statistics[size_t(Tag::kCountOfTag) + 1];
+	for (size_t i = 0; i < size_t(Tag::kCountOfTag); i++) {
+		statistics[i] = GetStatistics(Tag(i));
+	}
+	statistics[size_t(Tag::kCountOfTag)] = GetTotalStatistics();
+
+	// Linuxでも組めるようstd::formatは使わない
+	std::string report;
+	char line[256];
+	std::snprintf(
+	    line, sizeof(line), "%-8s %12s %12s %9s %12s %12s %10s\n", "tag", "live[KiB]", "peak[KiB]",
+	    "live", "allocs", "frame", "max frame");
+	report += line;
+	for (size_t i = 0; i <= size_t(Tag::kCountOfTag); i++) {
+		const TagStatistics& tag = statistics[i];
+		std::snprintf(
+		    line, sizeof(line), "%-8s %12.1f %12.1f %9lld %12llu %12llu %10llu\n",
+		    i < size_t(Tag::kCountOfTag) ? kTagNames[i] : "Total", double(tag.liveBytes) / 1024.0,
+		    double(tag.peakBytes) / 1024.0, (long long)tag.liveCount,
+		    (unsigned long long)tag.allocationCount, (unsigned long long)tag.frameAllocationCount,
+		    (unsigned long long)tag.maxFrameAllocationCount);
+		report += line;
+	}
+	return report;
+}
+
+bool MemoryTracker::WriteReport(const std::string& filePath) {
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file << FormatReport();
+	return bool(file);
+}
+
+#ifndef MEMORY_TRACKER_DISABLED
+
+namespace {
+
+// 確保できるまでnew_handlerを呼び、なければstd::bad_allocを投げる
+void* AllocateOrThrow(size_t size, size_t alignment) {
+	while (true) {
+		if (void* pointer = MemoryTracker::Allocate(size, alignment)) {
+			return pointer;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+// 確保できなければnullptrを返す
+void* AllocateOrNull(size_t size, size_t alignment) noexcept {
+	try {
+		return AllocateOrThrow(size, alignment);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+} // namespace
+
+// グローバルなoperator new/deleteの差し替え（配列版や大きさ付きの解放も全て同じ経路を通す）
+void* operator new(size_t size) { return AllocateOrThrow(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return AllocateOrThrow(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return AllocateOrNull(size, alignof(std::max_align_t));
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return AllocateOrNull(size, alignof(std::max_align_t));
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+	return AllocateOrThrow(size, size_t(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+	return AllocateOrThrow(size, size_t(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return AllocateOrNull(size, size_t(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return AllocateOrNull(size, size_t(alignment));
+}
+
+void operator delete(void* pointer) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+	MemoryTracker::Free(pointer);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+	MemoryTracker::Free(pointer);
+}
+void operator delete(void* pointer, std::align_val_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+	MemoryTracker::Free(pointer);
+}
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+	MemoryTracker::Free(pointer);
+}
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+	MemoryTracker::Free(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+	MemoryTracker::Free(pointer);
+}
+
+#endif
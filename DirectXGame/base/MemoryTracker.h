@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// ヒープ確保の分類ごとの集計（グローバルなoperator new/deleteを差し替えて数える）
+/// </summary>
+/// <remarks>
+/// 確保はその時点でスレッドの分類スタックの一番上の分類に数える。分類はMEMORY_TAG_SCOPEで積む。
+/// 各確保の前に16バイトの見出しを付けて大きさと分類を覚えておき、解放時にそこから引く。
+/// 数えるのはoperator newを通るヒープだけで、D3D12のリソースやDLL内の確保は含まれない。
+/// MEMORY_TRACKER_DISABLEDを定義すると差し替えず、分類も積まない。
+/// グラフィックスAPIやWindowsに依存しない。
+/// </remarks>
+class MemoryTracker {
+public:
+	/// <summary>
+	/// 確保の分類
+	/// </summary>
+	enum class Tag : uint8_t {
+		kOther,   // 分類なし
+		kMap,     // マップチップとブロック
+		kModel,   // モデル
+		kTexture, // テクスチャ
+		kAudio,   // 音声
+		kUI,      // スプライトなどのUI
+
+		kCountOfTag, // 使用禁止
+	};
+
+	// 分類スタックの深さの上限
+	static constexpr uint32_t kMaxTagDepth = 32;
+	// スレッドごとに数を持つスレッド数（超えた分は不可分な加算の共有分で数える）
+	static constexpr uint32_t kMaxThreadCount = 64;
+
+	/// <summary>
+	/// 分類ごとの集計
+	/// </summary>
+	struct TagStatistics {
+		// 確保中のバイト数
+		int64_t liveBytes = 0;
+		// 確保中のバイト数の最大
+		int64_t peakBytes = 0;
+		// 確保中の個数
+		int64_t liveCount = 0;
+		// 確保回数の累計
+		uint64_t allocationCount = 0;
+		// 確保したバイト数の累計
+		uint64_t allocatedBytes = 0;
+		// 直前のフレームの確保回数
+		uint64_t frameAllocationCount = 0;
+		// 直前のフレームに確保したバイト数
+		uint64_t frameAllocatedBytes = 0;
+		// 1フレームの確保回数の最大
+		uint64_t maxFrameAllocationCount = 0;
+	};
+
+	/// <summary>
+	/// スコープを抜けるまで分類を積む
+	/// </summary>
+	class ScopedTag {
+	public:
+		explicit ScopedTag(Tag tag) { MemoryTracker::PushTag(tag); }
+		~ScopedTag() { MemoryTracker::PopTag(); }
+		ScopedTag(const ScopedTag&) = delete;
+		ScopedTag& operator=(const ScopedTag&) = delete;
+	};
+
+	/// <summary>
+	/// operator new/deleteを差し替えているか
+	/// </summary>
+	static bool IsEnabled();
+
+	/// <summary>
+	/// 分類名
+	/// </summary>
+	static const char* GetTagName(Tag tag);
+
+	/// <summary>
+	/// 今のスレッドの分類を積む
+	/// </summary>
+	static void PushTag(Tag tag);
+
+	/// <summary>
+	/// 今のスレッドの分類を降ろす
+	/// </summary>
+	static void PopTag();
+
+	/// <summary>
+	/// 今のスレッドの分類（積んでいなければkOther）
+	/// </summary>
+	static Tag GetCurrentTag();
+
+	/// <summary>
+	/// 見出しを付けて確保し、今の分類に数える（operator newから呼ぶ）
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">アラインメント（2の累乗）</param>
+	/// <returns>確保した領域（失敗したらnullptr）</returns>
+	static void* Allocate(size_t size, size_t alignment);
+
+	/// <summary>
+	/// Allocateで確保した領域を解放し、確保時の分類から引く（operator deleteから呼ぶ）
+	/// </summary>
+	static void Free(void* pointer);
+
+	/// <summary>
+	/// 分類ごとの集計
+	/// </summary>
+	static TagStatistics GetStatistics(Tag tag);
+
+	/// <summary>
+	/// 全分類の合計
+	/// </summary>
+	static TagStatistics GetTotalStatistics();
+
+	/// <summary>
+	/// フレーム終了（直前のフレームの確保回数を求める。メインスレッドで1フレーム1回）
+	/// </summary>
+	static void EndFrame();
+
+	/// <summary>
+	/// 分類ごとの集計を短いテキストにする
+	/// </summary>
+	static std::string FormatReport();
+
+	/// <summary>
+	/// FormatReportの内容を書き出す
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <returns>書き出せたか</returns>
+	static bool WriteReport(const std::string& filePath);
+
+private:
+	/// <summary>
+	/// 分類ごとの確保中のバイト数（最大を正しく取るため全スレッドで共有する。
+	/// 取り合いを減らすよう1本ずつキャッシュラインを分ける）
+	/// </summary>
+	struct alignas(64) Counter {
+		std::atomic<int64_t> liveBytes = 0;
+		std::atomic<int64_t> peakBytes = 0;
+	};
+
+	/// <summary>
+	/// スレッドごとの分類ごとの数（持ち主のスレッドだけが書くので不可分な加算を使わない。
+	/// 別スレッドでの解放は解放したスレッドの数から引くので、全スレッドの和が正しい値になる）
+	/// </summary>
+	struct ThreadCounter {
+		std::atomic<int64_t> liveCount = 0;
+		std::atomic<uint64_t> allocationCount = 0;
+		std::atomic<uint64_t> allocatedBytes = 0;
+	};
+
+	/// <summary>
+	/// スレッドごとの数
+	/// </summary>
+	struct alignas(64) ThreadCounters {
+		ThreadCounter tags[size_t(Tag::kCountOfTag)];
+	};
+
+	/// <summary>
+	/// フレームごとの数（EndFrameだけが触る）
+	/// </summary>
+	struct FrameCounter {
+		// 前回のEndFrameでの累計
+		uint64_t allocationCount = 0;
+		uint64_t allocatedBytes = 0;
+		// 直前のフレームの分
+		uint64_t frameAllocationCount = 0;
+		uint64_t frameAllocatedBytes = 0;
+		// 1フレームの確保回数の最大
+		uint64_t maxFrameAllocationCount = 0;
+	};
+
+	/// <summary>
+	/// スレッドごとの分類スタック
+	/// </summary>
+	struct TagStack {
+		Tag tags[kMaxTagDepth];
+		uint32_t depth;
+		// 今のスレッドの数（初回の確保で割り当てる）
+		ThreadCounters* counters;
+		// 共有の数を使う（スレッド数がkMaxThreadCountを超えた）
+		bool shared;
+	};
+
+	/// <summary>
+	/// 今のスレッドの数（初回に割り当てる）
+	/// </summary>
+	static ThreadCounters* GetThreadCounters();
+
+	/// <summary>
+	/// スレッドごとの数に加える
+	/// </summary>
+	template<typename T> static void Add(std::atomic<T>& value, T amount) {
+		if (tTagStack_.shared) {
+			value.fetch_add(amount, std::memory_order_relaxed);
+		} else {
+			value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+	}
+
+	// 分類ごとの確保中のバイト数
+	static Counter sCounters_[size_t(Tag::kCountOfTag)];
+	// スレッドごとの数（最後の1つはスレッド数が上限を超えたときの共有分）
+	static ThreadCounters sThreadCounters_[kMaxThreadCount + 1];
+	// 割り当てたスレッドごとの数の個数
+	static std::atomic<uint32_t> sThreadCount_;
+	// 分類ごとのフレームの数
+	static FrameCounter sFrameCounters_[size_t(Tag::kCountOfTag)];
+	// 今のスレッドの分類スタック
+	static thread_local TagStack tTagStack_;
+};
+
+// スコープを抜けるまでの確保を分類tagに数える（MEMORY_TRACKER_DISABLEDを定義すると何もしない）
+#ifdef MEMORY_TRACKER_DISABLED
+#define MEMORY_TAG_SCOPE(tag) ((void)0)
+#else
+#define MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT_INNER(a, b)
+#define MEMORY_TAG_SCOPE(tag) MemoryTracker::ScopedTag MEMORY_TAG_CONCAT(memoryTag_, __LINE__)(tag)
+#endif
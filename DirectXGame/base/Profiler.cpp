@@ -0,0 +1,265 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PROFILER_USE_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_USE_TSC
+#endif
+
+std::atomic<bool> Profiler::sEnabled_ = false;
+thread_local Profiler::ThreadBuffer* Profiler::tThreadBuffer_ = nullptr;
+
+namespace {
+
+// 直近フレームの合計時間の百分位[tick]
+uint64_t Percentile(const std::vector<uint64_t>& sortedTotals, double percent) {
+	size_t index = size_t(percent / 100.0 * double(sortedTotals.size() - 1) + 0.5);
+	return sortedTotals[index];
+}
+
+// JSONの文字列に入れられない文字をエスケープする
+std::string EscapeJson(std::string_view text) {
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+			escaped += c;
+		} else if (uint8_t(c) < 0x20) {
+			char code[8];
+			std::snprintf(code, sizeof(code), "\\u%04x", uint32_t(c));
+			escaped += code;
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+} // namespace
+
+Profiler* Profiler::GetInstance() {
+	static Profiler instance;
+	return &instance;
+}
+
+Profiler::Profiler() {
+	// 最初の比は短い時間で求め、あとはEndFrameごとに初期化からの経過時間で求め直す
+	calibrationTick_ = Now();
+	calibrationTime_ = std::chrono::steady_clock::now();
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	Calibrate();
+}
+
+uint64_t Profiler::Now() {
+#ifdef PROFILER_USE_TSC
+	// steady_clockより1桁軽い（不変TSCを前提にする）
+	return __rdtsc();
+#else
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                    std::chrono::steady_clock::now().time_since_epoch())
+	                    .count());
+#endif
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(threadMutex_);
+	buffer->name = name;
+}
+
+uint64_t Profiler::BeginScope() {
+	GetThreadBuffer()->depth++;
+	return Now();
+}
+
+void Profiler::EndScope(const char* name, uint64_t begin) {
+	uint64_t end = Now();
+	ThreadBuffer* buffer = GetThreadBuffer();
+	assert(buffer->depth > 0);
+	buffer->depth--;
+
+	// 持ち主のスレッドだけが書くので、読み出し位置を見て空きがあれば書いて進める
+	uint64_t head = buffer->head.load(std::memory_order_relaxed);
+	if (head - buffer->tail.load(std::memory_order_acquire) >= kRingCapacity) {
+		buffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	Event& event = buffer->events[head & (kRingCapacity - 1)];
+	event.name = name;
+	event.begin = begin;
+	event.end = end;
+	event.depth = buffer->depth;
+	event.threadId = buffer->threadId;
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::EndFrame() {
+	// 全スレッドのリングから書き終わった分を回収する
+	frameEvents_.clear();
+	{
+		std::lock_guard<std::mutex> lock(threadMutex_);
+		uint64_t droppedEventCount = 0;
+		for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers_) {
+			uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+			uint64_t head = buffer->head.load(std::memory_order_acquire);
+			for (; tail != head; tail++) {
+				frameEvents_.push_back(buffer->events[tail & (kRingCapacity - 1)]);
+			}
+			buffer->tail.store(tail, std::memory_order_release);
+			droppedEventCount += buffer->droppedCount.load(std::memory_order_relaxed);
+		}
+		droppedEventCount_ = droppedEventCount;
+	}
+
+	// 区間名ごとにフレーム内の合計時間を積む
+	// 同じ名前でも翻訳単位ごとにポインタが違いうるので、ポインタで引けなければ文字列で引く
+	for (const Event& event : frameEvents_) {
+		ScopeHistory*& cached = historiesByPointer_[event.name];
+		if (!cached) {
+			ScopeHistory& history = scopeHistories_[event.name];
+			if (history.frameTotals.empty()) {
+				history.frameTotals.assign(kHistoryFrameCount, 0);
+				history.statisticsIndex = scopeStatistics_.size();
+				scopeStatistics_.push_back({});
+				scopeStatistics_.back().name = event.name;
+			}
+			cached = &history;
+		}
+		cached->currentTotal += event.end - event.begin;
+		cached->currentCallCount++;
+	}
+	Calibrate();
+	UpdateScopeStatistics();
+	frameCount_++;
+
+	// キャプチャ
+	if (captureFrameCount_ > 0) {
+		capturedEvents_.insert(capturedEvents_.end(), frameEvents_.begin(), frameEvents_.end());
+		captureFrameCount_--;
+	}
+}
+
+void Profiler::BeginCapture(uint32_t frameCount) {
+	capturedEvents_.clear();
+	captureFrameCount_ = frameCount;
+}
+
+std::string Profiler::ToChromeTrace() const {
+	// 時刻はキャプチャの最初の区間からの[us]
+	double microsecondsPerTick = nanosecondsPerTick_ * 1.0e-3;
+	uint64_t origin = UINT64_MAX;
+	for (const Event& event : capturedEvents_) {
+		origin = std::min(origin, event.begin);
+	}
+
+	// Linuxでも組めるようstd::formatは使わない
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	char line[256];
+	const char* separator = "";
+	{
+		std::lock_guard<std::mutex> lock(threadMutex_);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers_) {
+			std::string name = buffer->name.empty() ? "Thread " + std::to_string(buffer->threadId)
+			                                        : buffer->name;
+			std::snprintf(
+			    line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,",
+			    separator, buffer->threadId);
+			json += line;
+			json += "\"args\":{\"name\":\"" + EscapeJson(name) + "\"}}";
+			separator = ",\n";
+		}
+	}
+	for (const Event& event : capturedEvents_) {
+		json += separator;
+		json += "{\"name\":\"" + EscapeJson(event.name) + "\",";
+		std::snprintf(
+		    line, sizeof(line),
+		    "\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+		    event.threadId, double(event.begin - origin) * microsecondsPerTick,
+		    double(event.end - event.begin) * microsecondsPerTick);
+		json += line;
+		separator = ",\n";
+	}
+	json += "\n]}\n";
+	return json;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filePath) const {
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file << ToChromeTrace();
+	return bool(file);
+}
+
+void Profiler::Reset() {
+	frameEvents_.clear();
+	scopeHistories_.clear();
+	historiesByPointer_.clear();
+	scopeStatistics_.clear();
+	frameCount_ = 0;
+	captureFrameCount_ = 0;
+	capturedEvents_.clear();
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+	if (!tThreadBuffer_) {
+		std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+		buffer->events = std::make_unique<Event[]>(kRingCapacity);
+
+		std::lock_guard<std::mutex> lock(threadMutex_);
+		buffer->threadId = uint32_t(threadBuffers_.size());
+		tThreadBuffer_ = buffer.get();
+		threadBuffers_.push_back(std::move(buffer));
+	}
+	return tThreadBuffer_;
+}
+
+void Profiler::Calibrate() {
+#ifdef PROFILER_USE_TSC
+	uint64_t ticks = Now() - calibrationTick_;
+	std::chrono::duration<double, std::nano> elapsed =
+	    std::chrono::steady_clock::now() - calibrationTime_;
+	if (ticks > 0) {
+		nanosecondsPerTick_ = elapsed.count() / double(ticks);
+	}
+#endif
+}
+
+void Profiler::UpdateScopeStatistics() {
+	// 直近kHistoryFrameCountフレーム（まだ少なければ終えたフレーム数）で求める
+	size_t frameIndex = size_t(frameCount_ % kHistoryFrameCount);
+	size_t historyCount = size_t(std::min<uint64_t>(frameCount_ + 1, kHistoryFrameCount));
+	double millisecondsPerTick = nanosecondsPerTick_ * 1.0e-6;
+
+	for (auto& [name, history] : scopeHistories_) {
+		history.frameTotals[frameIndex] = history.currentTotal;
+
+		ScopeStatistics& statistics = scopeStatistics_[history.statisticsIndex];
+		statistics.callCount = history.currentCallCount;
+		statistics.lastMilliseconds = double(history.currentTotal) * millisecondsPerTick;
+		history.currentTotal = 0;
+		history.currentCallCount = 0;
+
+		sortedTotals_.assign(history.frameTotals.begin(), history.frameTotals.begin() + historyCount);
+		std::sort(sortedTotals_.begin(), sortedTotals_.end());
+		uint64_t sum = 0;
+		for (uint64_t total : sortedTotals_) {
+			sum += total;
+		}
+		statistics.averageMilliseconds = double(sum) * millisecondsPerTick / double(historyCount);
+		statistics.p50Milliseconds = double(Percentile(sortedTotals_, 50.0)) * millisecondsPerTick;
+		statistics.p95Milliseconds = double(Percentile(sortedTotals_, 95.0)) * millisecondsPerTick;
+		statistics.p99Milliseconds = double(Percentile(sortedTotals_, 99.0)) * millisecondsPerTick;
+		statistics.maxMilliseconds = double(sortedTotals_.back()) * millisecondsPerTick;
+	}
+}
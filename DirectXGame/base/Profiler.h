@@ -0,0 +1,299 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// CPU区間の計測（スコープで測り、スレッドごとのリングバッファに溜めてフレーム終わりに集計する）
+/// </summary>
+/// <remarks>
+/// 計測区間はPROFILE_SCOPEで囲む。区間名は文字列リテラルなど、プログラム終了まで有効なものに限る。
+/// 書き込みは各スレッド専用のリングバッファへのロックなしの追記だけで、
+/// 無効にしている間は有効フラグを1回読むだけになる。EndFrameで全スレッドのリングを回収し、
+/// 区間名ごとに直近のフレームの合計時間から平均と百分位を求める。
+/// キャプチャ中の区間はChrome trace形式（chrome://tracing、Perfetto）で書き出せる。
+/// グラフィックスAPIやWindowsに依存しない。
+/// </remarks>
+class Profiler {
+public:
+	// スレッドごとのリングバッファの区間数（2の累乗）
+	static constexpr uint32_t kRingCapacity = 16384;
+	// 平均と百分位を求めるフレーム数
+	static constexpr uint32_t kHistoryFrameCount = 120;
+
+	/// <summary>
+	/// 計測した区間
+	/// </summary>
+	struct Event {
+		// 区間名
+		const char* name = nullptr;
+		// 開始時刻[tick]
+		uint64_t begin = 0;
+		// 終了時刻[tick]
+		uint64_t end = 0;
+		// 呼び出しの深さ（0が一番外側）
+		uint32_t depth = 0;
+		// スレッド番号（登録順）
+		uint32_t threadId = 0;
+	};
+
+	/// <summary>
+	/// 区間名ごとの集計（直近kHistoryFrameCountフレームの、1フレーム内の合計時間）
+	/// </summary>
+	struct ScopeStatistics {
+		// 区間名
+		std::string_view name;
+		// 直前のフレームの呼び出し回数
+		uint32_t callCount = 0;
+		// 直前のフレームの合計時間[ms]
+		double lastMilliseconds = 0.0;
+		// 平均[ms]
+		double averageMilliseconds = 0.0;
+		// 中央値[ms]
+		double p50Milliseconds = 0.0;
+		// 95パーセンタイル[ms]
+		double p95Milliseconds = 0.0;
+		// 99パーセンタイル[ms]
+		double p99Milliseconds = 0.0;
+		// 最大[ms]
+		double maxMilliseconds = 0.0;
+	};
+
+	/// <summary>
+	/// スコープを抜けるまでを1区間として記録する
+	/// </summary>
+	class ScopedMarker {
+	public:
+		explicit ScopedMarker(const char* name) {
+			if (Profiler::IsEnabled()) {
+				name_ = name;
+				begin_ = Profiler::GetInstance()->BeginScope();
+			}
+		}
+		~ScopedMarker() {
+			if (name_) {
+				Profiler::GetInstance()->EndScope(name_, begin_);
+			}
+		}
+		ScopedMarker(const ScopedMarker&) = delete;
+		ScopedMarker& operator=(const ScopedMarker&) = delete;
+
+	private:
+		// 区間名（無効のときnullptr）
+		const char* name_ = nullptr;
+		// 開始時刻[tick]
+		uint64_t begin_ = 0;
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static Profiler* GetInstance();
+
+	/// <summary>
+	/// 計測が有効か（PROFILER_DISABLEDを定義したビルドでは常に無効）
+	/// </summary>
+	static bool IsEnabled() {
+#ifdef PROFILER_DISABLED
+		return false;
+#else
+		return sEnabled_.load(std::memory_order_relaxed);
+#endif
+	}
+
+	/// <summary>
+	/// 計測の有効、無効の切り替え（途中のスコープは開始時の状態で記録される）
+	/// </summary>
+	static void SetEnabled(bool enabled) {
+#ifdef PROFILER_DISABLED
+		(void)enabled;
+#else
+		sEnabled_.store(enabled, std::memory_order_relaxed);
+#endif
+	}
+
+	/// <summary>
+	/// 今のスレッドの名前をセット（Chrome traceの表示名）
+	/// </summary>
+	void SetThreadName(const std::string& name);
+
+	/// <summary>
+	/// 今の時刻[tick]（x86ではタイムスタンプカウンタ、それ以外はsteady_clockの[ns]）
+	/// </summary>
+	static uint64_t Now();
+
+	/// <summary>
+	/// 1tickのナノ秒数（steady_clockとの比較で求め、EndFrameごとに精度を上げる）
+	/// </summary>
+	double GetNanosecondsPerTick() const { return nanosecondsPerTick_; }
+
+	/// <summary>
+	/// 区間の開始（ScopedMarkerから呼ぶ）
+	/// </summary>
+	/// <returns>開始時刻[tick]</returns>
+	uint64_t BeginScope();
+
+	/// <summary>
+	/// 区間の終了（ScopedMarkerから呼ぶ。リングが一杯なら捨てる）
+	/// </summary>
+	void EndScope(const char* name, uint64_t begin);
+
+	/// <summary>
+	/// フレーム終了（全スレッドのリングを回収して集計する。メインスレッドで1フレーム1回）
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// キャプチャ開始（それまでのキャプチャは捨てる）
+	/// </summary>
+	/// <param name="frameCount">キャプチャするフレーム数</param>
+	void BeginCapture(uint32_t frameCount);
+
+	/// <summary>
+	/// キャプチャ中か
+	/// </summary>
+	bool IsCapturing() const { return captureFrameCount_ > 0; }
+
+	/// <summary>
+	/// キャプチャした区間（開始時刻順とは限らない）
+	/// </summary>
+	const std::vector<Event>& GetCapturedEvents() const { return capturedEvents_; }
+
+	/// <summary>
+	/// キャプチャした区間をChrome trace形式のJSONにする
+	/// </summary>
+	std::string ToChromeTrace() const;
+
+	/// <summary>
+	/// キャプチャした区間をChrome trace形式で書き出す
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <returns>書き出せたか</returns>
+	bool WriteChromeTrace(const std::string& filePath) const;
+
+	/// <summary>
+	/// 区間名ごとの集計（直前のEndFrameまで。最初に現れた順）
+	/// </summary>
+	const std::vector<ScopeStatistics>& GetScopeStatistics() const { return scopeStatistics_; }
+
+	/// <summary>
+	/// リングが一杯で捨てた区間数の累計
+	/// </summary>
+	uint64_t GetDroppedEventCount() const { return droppedEventCount_; }
+
+	/// <summary>
+	/// 直前のフレームの区間（次のEndFrameまで有効）
+	/// </summary>
+	const std::vector<Event>& GetFrameEvents() const { return frameEvents_; }
+
+	/// <summary>
+	/// 集計とキャプチャを捨てる（登録済みのスレッドはそのまま）
+	/// </summary>
+	void Reset();
+
+private:
+	/// <summary>
+	/// スレッドごとのリングバッファ（書き込みは持ち主のスレッド、読み出しはEndFrameのみ）
+	/// </summary>
+	struct ThreadBuffer {
+		// 区間
+		std::unique_ptr<Event[]> events;
+		// 書き込み位置（持ち主のスレッドだけが進める）
+		std::atomic<uint64_t> head = 0;
+		// 読み出し位置（EndFrameだけが進める）
+		std::atomic<uint64_t> tail = 0;
+		// リングが一杯で捨てた区間数
+		std::atomic<uint64_t> droppedCount = 0;
+		// 今の呼び出しの深さ
+		uint32_t depth = 0;
+		// スレッド番号（登録順）
+		uint32_t threadId = 0;
+		// スレッド名
+		std::string name;
+	};
+
+	/// <summary>
+	/// 区間名ごとの直近フレームの合計時間
+	/// </summary>
+	struct ScopeHistory {
+		// 直近フレームの合計時間[tick]（リング）
+		std::vector<uint64_t> frameTotals;
+		// 今のフレームの合計時間[tick]
+		uint64_t currentTotal = 0;
+		// 今のフレームの呼び出し回数
+		uint32_t currentCallCount = 0;
+		// 集計の位置
+		size_t statisticsIndex = 0;
+	};
+
+	Profiler();
+	~Profiler() = default;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	/// <summary>
+	/// 今のスレッドのリングバッファ（初回に登録する）
+	/// </summary>
+	ThreadBuffer* GetThreadBuffer();
+
+	/// <summary>
+	/// 直近フレームの合計時間から集計を求める
+	/// </summary>
+	void UpdateScopeStatistics();
+
+	/// <summary>
+	/// 初期化からの経過時間でtickとナノ秒の比を求め直す
+	/// </summary>
+	void Calibrate();
+
+	// 計測が有効（既定は無効）
+	static std::atomic<bool> sEnabled_;
+	// 今のスレッドのリングバッファ（初回の計測で登録する）
+	static thread_local ThreadBuffer* tThreadBuffer_;
+
+	// 登録済みのスレッドのリングバッファ（プログラム終了まで手放さない）
+	std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers_;
+	// threadBuffers_の追加と読み出しの排他
+	mutable std::mutex threadMutex_;
+	// 直前のフレームの区間
+	std::vector<Event> frameEvents_;
+	// 区間名ごとの直近フレームの合計時間
+	std::unordered_map<std::string_view, ScopeHistory> scopeHistories_;
+	// 区間名のポインタからの引き直しの省略
+	std::unordered_map<const char*, ScopeHistory*> historiesByPointer_;
+	// 区間名ごとの集計
+	std::vector<ScopeStatistics> scopeStatistics_;
+	// 終えたフレーム数
+	uint64_t frameCount_ = 0;
+	// キャプチャの残りフレーム数
+	uint32_t captureFrameCount_ = 0;
+	// キャプチャした区間
+	std::vector<Event> capturedEvents_;
+	// リングが一杯で捨てた区間数の累計
+	uint64_t droppedEventCount_ = 0;
+	// 作業用
+	std::vector<uint64_t> sortedTotals_;
+	// 比を求める基準のtickとsteady_clockの時刻
+	uint64_t calibrationTick_ = 0;
+	std::chrono::steady_clock::time_point calibrationTime_;
+	// 1tickのナノ秒数
+	double nanosecondsPerTick_ = 1.0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// スコープを抜けるまでを区間nameとして計測する（PROFILER_DISABLEDを定義すると何もしない）
+#ifdef PROFILER_DISABLED
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) Profiler::ScopedMarker PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#endif
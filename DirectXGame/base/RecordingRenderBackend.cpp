@@ -0,0 +1,183 @@
+#include "RecordingRenderBackend.h"
+#include <cassert>
+
+RenderDevice::UploadBuffer RecordingRenderDevice::CreateUploadBuffer(uint64_t size) {
+	buffers_.push_back(std::make_unique<uint8_t[]>(size_t(size)));
+
+	UploadBuffer buffer;
+	buffer.cpuAddress = buffers_.back().get();
+	buffer.gpuAddress = nextGpuAddress_;
+	buffer.size = size;
+	// 実機と同じく64KB単位で並べる
+	nextGpuAddress_ += (size + 0xFFFF) & ~uint64_t(0xFFFF);
+	return buffer;
+}
+
+void RecordingRenderCommandList::Reset() {
+	commands_.clear();
+	statistics_ = {};
+	rootSignature_ = kUnset;
+	pipelineState_ = kUnset;
+	primitiveTopology_ = kUnset;
+	vertexBuffer_ = kUnset;
+	indexBuffer_ = kUnset;
+	rootParameters_.fill(kUnset);
+}
+
+void RecordingRenderCommandList::SetRootSignature(void* rootSignature) {
+	Command command;
+	command.type = Command::Type::kSetRootSignature;
+	command.value = uint64_t(reinterpret_cast<uintptr_t>(rootSignature));
+	// ルートシグネチャが変わるとルートパラメータは全て無効になる
+	if (RecordState(command, rootSignature_)) {
+		rootParameters_.fill(kUnset);
+	}
+	if (forward_) {
+		forward_->SetRootSignature(rootSignature);
+	}
+}
+
+void RecordingRenderCommandList::SetPipelineState(void* pipelineState) {
+	Command command;
+	command.type = Command::Type::kSetPipelineState;
+	command.value = uint64_t(reinterpret_cast<uintptr_t>(pipelineState));
+	if (RecordState(command, pipelineState_)) {
+		statistics_.pipelineChangeCount++;
+	}
+	if (forward_) {
+		forward_->SetPipelineState(pipelineState);
+	}
+}
+
+void RecordingRenderCommandList::SetPrimitiveTopology(PrimitiveTopology topology) {
+	Command command;
+	command.type = Command::Type::kSetPrimitiveTopology;
+	command.value = uint64_t(topology);
+	RecordState(command, primitiveTopology_);
+	if (forward_) {
+		forward_->SetPrimitiveTopology(topology);
+	}
+}
+
+void RecordingRenderCommandList::SetVertexBuffer(const VertexBufferView& view) {
+	Command command;
+	command.type = Command::Type::kSetVertexBuffer;
+	command.value = view.gpuAddress;
+	command.count = view.sizeInBytes;
+	RecordState(command, vertexBuffer_);
+	if (forward_) {
+		forward_->SetVertexBuffer(view);
+	}
+}
+
+void RecordingRenderCommandList::SetIndexBuffer(const IndexBufferView& view) {
+	Command command;
+	command.type = Command::Type::kSetIndexBuffer;
+	command.value = view.gpuAddress;
+	command.count = view.sizeInBytes;
+	RecordState(command, indexBuffer_);
+	if (forward_) {
+		forward_->SetIndexBuffer(view);
+	}
+}
+
+void RecordingRenderCommandList::SetConstantBuffer(
+    uint32_t rootParameterIndex, uint64_t gpuAddress) {
+	Command command;
+	command.type = Command::Type::kSetConstantBuffer;
+	command.rootParameterIndex = rootParameterIndex;
+	command.value = gpuAddress;
+	RecordState(command, GetRootParameter(rootParameterIndex));
+	if (forward_) {
+		forward_->SetConstantBuffer(rootParameterIndex, gpuAddress);
+	}
+}
+
+void RecordingRenderCommandList::SetShaderResource(
+    uint32_t rootParameterIndex, uint64_t gpuAddress) {
+	Command command;
+	command.type = Command::Type::kSetShaderResource;
+	command.rootParameterIndex = rootParameterIndex;
+	command.value = gpuAddress;
+	RecordState(command, GetRootParameter(rootParameterIndex));
+	if (forward_) {
+		forward_->SetShaderResource(rootParameterIndex, gpuAddress);
+	}
+}
+
+void RecordingRenderCommandList::SetTexture(uint32_t rootParameterIndex, uint32_t textureHandle) {
+	Command command;
+	command.type = Command::Type::kSetTexture;
+	command.rootParameterIndex = rootParameterIndex;
+	command.value = textureHandle;
+	if (RecordState(command, GetRootParameter(rootParameterIndex))) {
+		statistics_.textureChangeCount++;
+	}
+	if (forward_) {
+		forward_->SetTexture(rootParameterIndex, textureHandle);
+	}
+}
+
+void RecordingRenderCommandList::Draw(
+    uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) {
+	Command command;
+	command.type = Command::Type::kDraw;
+	command.count = vertexCount;
+	command.instanceCount = instanceCount;
+	command.start = startVertex;
+	command.startInstance = startInstance;
+	if (recordsCommands_) {
+		commands_.push_back(command);
+	}
+	statistics_.drawCallCount++;
+	statistics_.instanceCount += instanceCount;
+	if (forward_) {
+		forward_->Draw(vertexCount, instanceCount, startVertex, startInstance);
+	}
+}
+
+void RecordingRenderCommandList::DrawIndexed(
+    uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex,
+    uint32_t startInstance) {
+	Command command;
+	command.type = Command::Type::kDrawIndexed;
+	command.count = indexCount;
+	command.instanceCount = instanceCount;
+	command.start = startIndex;
+	command.baseVertex = baseVertex;
+	command.startInstance = startInstance;
+	if (recordsCommands_) {
+		commands_.push_back(command);
+	}
+	statistics_.drawCallCount++;
+	statistics_.instanceCount += instanceCount;
+	if (forward_) {
+		forward_->DrawIndexed(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+	}
+}
+
+void RecordingRenderCommandList::AddUploadBytes(uint64_t bytes) {
+	statistics_.uploadBytes += bytes;
+	if (forward_) {
+		forward_->AddUploadBytes(bytes);
+	}
+}
+
+bool RecordingRenderCommandList::RecordState(Command command, uint64_t& current) {
+	command.isRedundant = (current == command.value);
+	current = command.value;
+	if (command.isRedundant) {
+		statistics_.redundantStateCount++;
+	} else {
+		statistics_.stateChangeCount++;
+	}
+	if (recordsCommands_) {
+		commands_.push_back(command);
+	}
+	return !command.isRedundant;
+}
+
+uint64_t& RecordingRenderCommandList::GetRootParameter(uint32_t rootParameterIndex) {
+	assert(rootParameterIndex < kMaxRootParameters);
+	return rootParameters_[rootParameterIndex];
+}
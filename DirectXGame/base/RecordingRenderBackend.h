@@ -0,0 +1,168 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// GPUを使わない描画デバイス（アップロードバッファをホストメモリで確保する）
+/// </summary>
+class RecordingRenderDevice : public RenderDevice {
+public:
+	// 仮のGPUアドレスの始まり（0を無効値として使えるように）
+	static constexpr uint64_t kBaseGpuAddress = 0x10000;
+
+	UploadBuffer CreateUploadBuffer(uint64_t size) override;
+
+	/// <summary>
+	/// 確保したバイト数の合計
+	/// </summary>
+	uint64_t GetAllocatedBytes() const { return nextGpuAddress_ - kBaseGpuAddress; }
+
+private:
+	// 確保したメモリ
+	std::vector<std::unique_ptr<uint8_t[]>> buffers_;
+	// 次に割り当てる仮のGPUアドレス
+	uint64_t nextGpuAddress_ = kBaseGpuAddress;
+};
+
+/// <summary>
+/// コマンドを記録して後から調べられるコマンドリスト
+/// </summary>
+/// <remarks>
+/// 流し先を指定すると記録しつつそのまま転送するので、実機の描画の計測にも使える。
+/// </remarks>
+class RecordingRenderCommandList : public RenderCommandList {
+public:
+	// 記録するルートパラメータの最大数
+	static constexpr uint32_t kMaxRootParameters = 16;
+
+	/// <summary>
+	/// 記録したコマンド
+	/// </summary>
+	struct Command {
+		enum class Type {
+			kSetRootSignature,
+			kSetPipelineState,
+			kSetPrimitiveTopology,
+			kSetVertexBuffer,
+			kSetIndexBuffer,
+			kSetConstantBuffer,
+			kSetShaderResource,
+			kSetTexture,
+			kDraw,
+			kDrawIndexed,
+		};
+		Type type = Type::kDraw;
+		// ルートパラメータ番号
+		uint32_t rootParameterIndex = 0;
+		// オブジェクトのアドレス、GPUアドレス、テクスチャハンドル、プリミティブ形状のいずれか
+		uint64_t value = 0;
+		// 頂点数またはインデックス数
+		uint32_t count = 0;
+		uint32_t instanceCount = 0;
+		// 開始頂点または開始インデックス
+		uint32_t start = 0;
+		int32_t baseVertex = 0;
+		uint32_t startInstance = 0;
+		// 直前と同じ状態を設定し直した
+		bool isRedundant = false;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// ドローコール数
+		uint32_t drawCallCount = 0;
+		// 描画したインスタンス数の合計
+		uint32_t instanceCount = 0;
+		// 状態を変えたコマンド数
+		uint32_t stateChangeCount = 0;
+		// 同じ状態を設定し直したコマンド数
+		uint32_t redundantStateCount = 0;
+		// パイプラインステートの切り替え数
+		uint32_t pipelineChangeCount = 0;
+		// テクスチャの切り替え数
+		uint32_t textureChangeCount = 0;
+		// 報告されたアップロードバイト数
+		uint64_t uploadBytes = 0;
+	};
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="forward">記録と同時に流す先。nullptrなら記録のみ</param>
+	explicit RecordingRenderCommandList(RenderCommandList* forward = nullptr) : forward_(forward) {
+		Reset();
+	}
+
+	/// <summary>
+	/// 記録と状態をリセット（フレームの始めに呼ぶ）
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 記録を残すか（falseなら統計だけ取る）
+	/// </summary>
+	void SetRecordsCommands(bool recordsCommands) { recordsCommands_ = recordsCommands; }
+
+	/// <summary>
+	/// 流し先の設定
+	/// </summary>
+	void SetForward(RenderCommandList* forward) { forward_ = forward; }
+
+	const std::vector<Command>& GetCommands() const { return commands_; }
+	const Statistics& GetStatistics() const { return statistics_; }
+
+	void SetRootSignature(void* rootSignature) override;
+	void SetPipelineState(void* pipelineState) override;
+	void SetPrimitiveTopology(PrimitiveTopology topology) override;
+	void SetVertexBuffer(const VertexBufferView& view) override;
+	void SetIndexBuffer(const IndexBufferView& view) override;
+	void SetConstantBuffer(uint32_t rootParameterIndex, uint64_t gpuAddress) override;
+	void SetShaderResource(uint32_t rootParameterIndex, uint64_t gpuAddress) override;
+	void SetTexture(uint32_t rootParameterIndex, uint32_t textureHandle) override;
+	void Draw(
+	    uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+	    uint32_t startInstance) override;
+	void DrawIndexed(
+	    uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex,
+	    uint32_t startInstance) override;
+	void AddUploadBytes(uint64_t bytes) override;
+
+private:
+	// 未設定
+	static constexpr uint64_t kUnset = UINT64_MAX;
+
+	/// <summary>
+	/// 状態設定コマンドの記録
+	/// </summary>
+	/// <param name="command">コマンド</param>
+	/// <param name="current">今の状態（更新される）</param>
+	/// <returns>状態が変わったか</returns>
+	bool RecordState(Command command, uint64_t& current);
+
+	/// <summary>
+	/// ルートパラメータの状態の参照
+	/// </summary>
+	uint64_t& GetRootParameter(uint32_t rootParameterIndex);
+
+	// 流し先
+	RenderCommandList* forward_ = nullptr;
+	// 記録を残すか
+	bool recordsCommands_ = true;
+	// 記録
+	std::vector<Command> commands_;
+	// 統計情報
+	Statistics statistics_;
+
+	// 今の状態（冗長な設定を数えるため）
+	uint64_t rootSignature_ = kUnset;
+	uint64_t pipelineState_ = kUnset;
+	uint64_t primitiveTopology_ = kUnset;
+	uint64_t vertexBuffer_ = kUnset;
+	uint64_t indexBuffer_ = kUnset;
+	std::array<uint64_t, kMaxRootParameters> rootParameters_;
+};
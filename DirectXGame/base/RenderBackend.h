@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+
+// 描画バックエンドの共通インターフェース（グラフィックスAPIのヘッダーに依存しない）
+// D3D12の実装（D3D12RenderBackend）と、GPUなしでコマンドを記録する実装（RecordingRenderBackend）がある。
+// ルートシグネチャとパイプラインステートはバックエンドのオブジェクトを指す不透明なポインタで渡す。
+
+/// <summary>
+/// 描画デバイス（リソース生成）
+/// </summary>
+class RenderDevice {
+public:
+	/// <summary>
+	/// 永続マップ済みのアップロードバッファ（デバイスが破棄されるまで有効）
+	/// </summary>
+	struct UploadBuffer {
+		uint8_t* cpuAddress = nullptr;
+		uint64_t gpuAddress = 0;
+		uint64_t size = 0;
+	};
+
+	virtual ~RenderDevice() = default;
+
+	/// <summary>
+	/// アップロードバッファの生成
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <returns>生成したバッファ。失敗したらcpuAddressがnullptr</returns>
+	virtual UploadBuffer CreateUploadBuffer(uint64_t size) = 0;
+};
+
+/// <summary>
+/// 描画コマンドの記録先
+/// </summary>
+class RenderCommandList {
+public:
+	/// <summary>
+	/// プリミティブ形状
+	/// </summary>
+	enum class PrimitiveTopology {
+		kPointList,
+		kLineList,
+		kTriangleList,
+		kTriangleStrip,
+	};
+
+	/// <summary>
+	/// 頂点バッファビュー
+	/// </summary>
+	struct VertexBufferView {
+		uint64_t gpuAddress = 0;
+		uint32_t sizeInBytes = 0;
+		uint32_t strideInBytes = 0;
+	};
+
+	/// <summary>
+	/// インデックスバッファビュー
+	/// </summary>
+	struct IndexBufferView {
+		uint64_t gpuAddress = 0;
+		uint32_t sizeInBytes = 0;
+		// 32bitインデックスか（falseなら16bit）
+		bool is32Bit = false;
+	};
+
+	virtual ~RenderCommandList() = default;
+
+	virtual void SetRootSignature(void* rootSignature) = 0;
+	virtual void SetPipelineState(void* pipelineState) = 0;
+	virtual void SetPrimitiveTopology(PrimitiveTopology topology) = 0;
+	virtual void SetVertexBuffer(const VertexBufferView& view) = 0;
+	virtual void SetIndexBuffer(const IndexBufferView& view) = 0;
+
+	/// <summary>
+	/// ルートパラメータに定数バッファを直接セット
+	/// </summary>
+	virtual void SetConstantBuffer(uint32_t rootParameterIndex, uint64_t gpuAddress) = 0;
+
+	/// <summary>
+	/// ルートパラメータにバッファのシェーダリソースを直接セット
+	/// </summary>
+	virtual void SetShaderResource(uint32_t rootParameterIndex, uint64_t gpuAddress) = 0;
+
+	/// <summary>
+	/// ルートパラメータにTextureManagerのテクスチャをセット
+	/// </summary>
+	virtual void SetTexture(uint32_t rootParameterIndex, uint32_t textureHandle) = 0;
+
+	virtual void Draw(
+	    uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex,
+	    uint32_t startInstance) = 0;
+	virtual void DrawIndexed(
+	    uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex,
+	    uint32_t startInstance) = 0;
+
+	/// <summary>
+	/// CPUからGPUに見えるメモリへ書き込んだバイト数の報告（計測用）
+	/// </summary>
+	virtual void AddUploadBytes(uint64_t bytes) = 0;
+};
@@ -0,0 +1,112 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+uint64_t RenderQueue::MakeSortKey(
+    uint32_t pipelineId, uint32_t textureHandle, uint32_t materialId, float depth) {
+	// 正の浮動小数点数はビット列のまま比べても大小が変わらない
+	uint32_t depthBits = 0;
+	if (depth > 0.0f) {
+		std::memcpy(&depthBits, &depth, sizeof(depthBits));
+	}
+	return (uint64_t(pipelineId & 0xF) << 60) | (uint64_t(textureHandle & 0xFFF) << 48) |
+	       (uint64_t(materialId & 0xFFFF) << 32) | uint64_t(depthBits);
+}
+
+void RenderQueue::Flush(RenderCommandList* commandList) {
+	assert(commandList);
+
+	uint32_t packetCount = uint32_t(packets_.size());
+	statistics_.packetCount += packetCount;
+
+	// キーが同じものは積んだ順を保つ
+	order_.resize(packetCount);
+	for (uint32_t i = 0; i < packetCount; i++) {
+		order_[i] = i;
+	}
+	std::stable_sort(order_.begin(), order_.end(), [this](uint32_t lhs, uint32_t rhs) {
+		return packets_[lhs].sortKey < packets_[rhs].sortKey;
+	});
+
+	// 直前に設定した状態（Flushの外で何が設定されたかは分からないので空から始める）
+	Packet state;
+	bool hasState = false;
+	uint32_t naiveStateCount = 0;
+	uint32_t emittedStateCount = 0;
+
+	for (uint32_t index : order_) {
+		const Packet& packet = packets_[index];
+
+		naiveStateCount += 5;
+		for (uint32_t i = 0; i < kMaxRootParameters; i++) {
+			naiveStateCount += packet.constantBuffers[i] != 0 ? 1 : 0;
+			naiveStateCount += packet.shaderResources[i] != 0 ? 1 : 0;
+		}
+		naiveStateCount += packet.textureHandle != kNoTexture ? 1 : 0;
+
+		if (!hasState || state.rootSignature != packet.rootSignature) {
+			commandList->SetRootSignature(packet.rootSignature);
+			emittedStateCount++;
+			// ルートシグネチャが変わるとルートパラメータは全て無効になる
+			state.rootSignature = packet.rootSignature;
+			state.constantBuffers.fill(0);
+			state.shaderResources.fill(0);
+			state.textureHandle = kNoTexture;
+		}
+		if (!hasState || state.pipelineState != packet.pipelineState) {
+			commandList->SetPipelineState(packet.pipelineState);
+			emittedStateCount++;
+			state.pipelineState = packet.pipelineState;
+		}
+		if (!hasState || state.topology != packet.topology) {
+			commandList->SetPrimitiveTopology(packet.topology);
+			emittedStateCount++;
+			state.topology = packet.topology;
+		}
+		if (!hasState || state.vertexBuffer.gpuAddress != packet.vertexBuffer.gpuAddress ||
+		    state.vertexBuffer.sizeInBytes != packet.vertexBuffer.sizeInBytes ||
+		    state.vertexBuffer.strideInBytes != packet.vertexBuffer.strideInBytes) {
+			commandList->SetVertexBuffer(packet.vertexBuffer);
+			emittedStateCount++;
+			state.vertexBuffer = packet.vertexBuffer;
+		}
+		if (!hasState || state.indexBuffer.gpuAddress != packet.indexBuffer.gpuAddress ||
+		    state.indexBuffer.sizeInBytes != packet.indexBuffer.sizeInBytes ||
+		    state.indexBuffer.is32Bit != packet.indexBuffer.is32Bit) {
+			commandList->SetIndexBuffer(packet.indexBuffer);
+			emittedStateCount++;
+			state.indexBuffer = packet.indexBuffer;
+		}
+		for (uint32_t i = 0; i < kMaxRootParameters; i++) {
+			uint64_t gpuAddress = packet.constantBuffers[i];
+			if (gpuAddress != 0 && state.constantBuffers[i] != gpuAddress) {
+				commandList->SetConstantBuffer(i, gpuAddress);
+				emittedStateCount++;
+				state.constantBuffers[i] = gpuAddress;
+			}
+			gpuAddress = packet.shaderResources[i];
+			if (gpuAddress != 0 && state.shaderResources[i] != gpuAddress) {
+				commandList->SetShaderResource(i, gpuAddress);
+				emittedStateCount++;
+				state.shaderResources[i] = gpuAddress;
+			}
+		}
+		if (packet.textureHandle != kNoTexture &&
+		    (state.textureHandle != packet.textureHandle ||
+		     state.textureRootParameterIndex != packet.textureRootParameterIndex)) {
+			commandList->SetTexture(packet.textureRootParameterIndex, packet.textureHandle);
+			emittedStateCount++;
+			state.textureRootParameterIndex = packet.textureRootParameterIndex;
+			state.textureHandle = packet.textureHandle;
+		}
+		hasState = true;
+
+		commandList->DrawIndexed(packet.indexCount, packet.instanceCount, 0, 0, 0);
+		statistics_.drawCallCount++;
+	}
+
+	statistics_.emittedStateCount += emittedStateCount;
+	statistics_.skippedStateCount += naiveStateCount - emittedStateCount;
+	packets_.clear();
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 描画キュー（描画要求をソートキー順に並べ替えて、変わった状態だけ設定しながら流す）
+/// </summary>
+/// <remarks>
+/// ソートキーは上位からパイプライン、テクスチャ、マテリアル、深度（手前から奥）の順。
+/// 状態の比較はFlushの中だけで行い、Flushの始めは何も設定されていないものとして扱う。
+/// </remarks>
+class RenderQueue {
+public:
+	// 定数バッファやシェーダリソースを直接設定できるルートパラメータ数
+	static constexpr uint32_t kMaxRootParameters = 12;
+	// テクスチャなし
+	static constexpr uint32_t kNoTexture = UINT32_MAX;
+
+	/// <summary>
+	/// 描画要求（ドローコール1回分の状態）
+	/// </summary>
+	struct Packet {
+		// ソートキー（MakeSortKeyで作る）
+		uint64_t sortKey = 0;
+		// ルートシグネチャ
+		void* rootSignature = nullptr;
+		// パイプラインステート
+		void* pipelineState = nullptr;
+		// プリミティブ形状
+		RenderCommandList::PrimitiveTopology topology =
+		    RenderCommandList::PrimitiveTopology::kTriangleList;
+		// 頂点バッファビュー
+		RenderCommandList::VertexBufferView vertexBuffer;
+		// インデックスバッファビュー
+		RenderCommandList::IndexBufferView indexBuffer;
+		// ルートパラメータ番号ごとの定数バッファのGPUアドレス（0なら設定しない）
+		std::array<uint64_t, kMaxRootParameters> constantBuffers = {};
+		// ルートパラメータ番号ごとのシェーダリソースのGPUアドレス（0なら設定しない）
+		std::array<uint64_t, kMaxRootParameters> shaderResources = {};
+		// テクスチャのルートパラメータ番号
+		uint32_t textureRootParameterIndex = 0;
+		// テクスチャハンドル（kNoTextureなら設定しない）
+		uint32_t textureHandle = kNoTexture;
+		// インデックス数
+		uint32_t indexCount = 0;
+		// インスタンス数
+		uint32_t instanceCount = 1;
+	};
+
+	/// <summary>
+	/// 統計情報
+	/// </summary>
+	struct Statistics {
+		// 積まれた描画要求数
+		uint32_t packetCount = 0;
+		// ドローコール数
+		uint32_t drawCallCount = 0;
+		// 実際に設定した状態の数
+		uint32_t emittedStateCount = 0;
+		// 要求ごとに全状態を設定した場合と比べて省いた数
+		uint32_t skippedStateCount = 0;
+	};
+
+	/// <summary>
+	/// ソートキーの生成
+	/// </summary>
+	/// <param name="pipelineId">パイプライン番号（下位4bitを使う）</param>
+	/// <param name="textureHandle">テクスチャハンドル（下位12bitを使う）</param>
+	/// <param name="materialId">マテリアル番号（下位16bitを使う）</param>
+	/// <param name="depth">カメラからの距離（負なら0とみなす）</param>
+	/// <returns>ソートキー</returns>
+	static uint64_t
+	    MakeSortKey(uint32_t pipelineId, uint32_t textureHandle, uint32_t materialId, float depth);
+
+	/// <summary>
+	/// 描画要求を積む
+	/// </summary>
+	/// <param name="packet">描画要求</param>
+	void Push(const Packet& packet) { packets_.push_back(packet); }
+
+	/// <summary>
+	/// 積んだ要求を並べ替えて流し、キューを空にする
+	/// </summary>
+	/// <param name="commandList">流し先</param>
+	void Flush(RenderCommandList* commandList);
+
+	/// <summary>
+	/// 積んだ要求を流さずに捨てる
+	/// </summary>
+	void Clear() { packets_.clear(); }
+
+	/// <summary>
+	/// 統計情報のリセット
+	/// </summary>
+	void ResetStatistics() { statistics_ = {}; }
+
+	/// <summary>
+	/// 積まれている要求数
+	/// </summary>
+	uint32_t GetPacketCount() const { return uint32_t(packets_.size()); }
+
+	/// <summary>
+	/// 前回のResetStatisticsからの統計情報
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	// 描画要求
+	std::vector<Packet> packets_;
+	// 並べ替えた要求番号
+	std::vector<uint32_t> order_;
+	// 統計情報
+	Statistics statistics_;
+};
@@ -0,0 +1,33 @@
+#include "ShaderUtility.h"
+#include <Windows.h>
+#include <algorithm>
+#include <cassert>
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const std::wstring& filePath, const char* target) {
+	Microsoft::WRL::ComPtr<ID3DBlob> blob;
+	Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+	UINT flags = 0;
+#ifdef _DEBUG
+	flags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+	HRESULT result = D3DCompileFromFile(
+	    filePath.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, flags, 0,
+	    &blob, &errorBlob);
+	if (FAILED(result)) {
+		// errorBlobからエラー内容をstring型にコピー
+		std::string errstr;
+		if (errorBlob) {
+			errstr.resize(errorBlob->GetBufferSize());
+			std::copy_n(
+			    (char*)errorBlob->GetBufferPointer(), errorBlob->GetBufferSize(), errstr.begin());
+		}
+		errstr += "\n";
+		// エラー内容を出力ウィンドウに表示
+		OutputDebugStringA(errstr.c_str());
+		assert(0);
+	}
+	return blob;
+}
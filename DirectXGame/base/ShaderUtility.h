@@ -0,0 +1,13 @@
+#pragma once
+
+#include <d3dcommon.h>
+#include <string>
+#include <wrl.h>
+
+/// <summary>
+/// シェーダファイルを読み込んでコンパイルする（エントリーポイントはmain）
+/// </summary>
+/// <param name="filePath">シェーダファイルのパス</param>
+/// <param name="target">シェーダモデル（"vs_5_0"など）</param>
+/// <returns>コンパイル済みシェーダ</returns>
+Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const std::wstring& filePath, const char* target);
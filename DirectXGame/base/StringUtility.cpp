@@ -16,4 +16,21 @@ std::wstring ConvertStringMultiByteToWide(const std::string& str) {
 	    CP_UTF8, 0, reinterpret_cast<const char*>(&str[0]), static_cast<int>(str.size()),
 	    &result[0], sizeNeeded);
 	return result;
+}
+
+std::string ConvertStringWideToMultiByte(const std::wstring& str) {
+	if (str.empty()) {
+		return std::string();
+	}
+
+	auto sizeNeeded = WideCharToMultiByte(
+	    CP_UTF8, 0, str.data(), static_cast<int>(str.size()), NULL, 0, NULL, NULL);
+	if (sizeNeeded == 0) {
+		return std::string();
+	}
+	std::string result(sizeNeeded, 0);
+	WideCharToMultiByte(
+	    CP_UTF8, 0, str.data(), static_cast<int>(str.size()), &result[0], sizeNeeded, NULL,
+	    NULL);
+	return result;
 }
\ No newline at end of file
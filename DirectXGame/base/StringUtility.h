@@ -7,4 +7,11 @@
 /// </summary>
 /// <param name="str">マルチバイト文字列</param>
 /// <returns>ワイド文字列</returns>
-std::wstring ConvertStringMultiByteToWide(const std::string& str);
\ No newline at end of file
+std::wstring ConvertStringMultiByteToWide(const std::string& str);
+
+/// <summary>
+/// ワイド文字列をマルチバイト文字列に変換する
+/// </summary>
+/// <param name="str">ワイド文字列</param>
+/// <returns>マルチバイト文字列</returns>
+std::string ConvertStringWideToMultiByte(const std::wstring& str);
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "TextureDecoder.h"
+#include "BakedTexturePath.h"
+#include <algorithm>
+
+using namespace DirectX;
+
+HRESULT TextureDecodeSource::Decode(const std::wstring& filePath, ScratchImage& image) {
+	return TextureDecoder::Decode(filePath, image);
+}
+
+HRESULT TextureDecoder::Decode(const std::wstring& filePath, ScratchImage& image) {
+	// 元のPNGより新しいベイク済みDDSがあれば、デコードもミップ生成もせずに読み込む
+	std::filesystem::path bakedPath = GetBakedTexturePath(filePath);
+	if (IsBakedTextureUpToDate(filePath, bakedPath)) {
+		HRESULT result = LoadBaked(bakedPath.wstring(), image);
+		if (SUCCEEDED(result)) {
+			return result;
+		}
+	}
+
+	return DecodeSource(filePath, image);
+}
+
+HRESULT TextureDecoder::LoadBaked(const std::wstring& filePath, ScratchImage& image) {
+	HRESULT result;
+
+	ScratchImage scratchImg{};
+	result = LoadFromDDSFile(filePath.c_str(), DDS_FLAGS_NONE, nullptr, scratchImg);
+	if (FAILED(result)) {
+		return result;
+	}
+
+	// ベイク時にSRGBで出力しているが、念のため揃えておく
+	scratchImg.OverrideFormat(MakeSRGB(scratchImg.GetMetadata().format));
+
+	image = std::move(scratchImg);
+	return S_OK;
+}
+
+HRESULT TextureDecoder::DecodeSource(const std::wstring& filePath, ScratchImage& image) {
+	HRESULT result;
+
+	// WICテクスチャのロード
+	ScratchImage scratchImg{};
+	result = LoadFromWICFile(filePath.c_str(), WIC_FLAGS_NONE, nullptr, scratchImg);
+	if (FAILED(result)) {
+		return result;
+	}
+
+	ScratchImage mipChain{};
+	// ミップマップ生成
+	result = GenerateMipMaps(
+	    scratchImg.GetImages(), scratchImg.GetImageCount(), scratchImg.GetMetadata(),
+	    TEX_FILTER_DEFAULT, 0, mipChain);
+	if (SUCCEEDED(result)) {
+		scratchImg = std::move(mipChain);
+	}
+
+	// 読み込んだディフューズテクスチャをSRGBとして扱う
+	scratchImg.OverrideFormat(MakeSRGB(scratchImg.GetMetadata().format));
+
+	image = std::move(scratchImg);
+	return S_OK;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "DecodeWorkerPool.h"
+#include <DirectXTex.h>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// WICとDirectXTexによるテクスチャのデコード処理（DecodeWorkerPoolのSource）
+/// </summary>
+struct TextureDecodeSource {
+	using Image = DirectX::ScratchImage;
+	using Status = HRESULT;
+
+	// Profilerに出すスレッド名
+	static constexpr const char* kThreadName = "TextureDecoder";
+	// デコード区間の名前
+	static constexpr const char* kScopeName = "TextureDecoder::Decode";
+	// ワーカーの確保の分類
+	static constexpr MemoryTracker::Tag kMemoryTag = MemoryTracker::Tag::kTexture;
+
+	/// <summary>
+	/// デコード（TextureDecoder::Decodeと同じ）
+	/// </summary>
+	HRESULT Decode(const std::wstring& filePath, DirectX::ScratchImage& image);
+
+	static bool IsSucceeded(HRESULT result) { return SUCCEEDED(result); }
+	static uint64_t GetByteSize(const DirectX::ScratchImage& image) { return image.GetPixelsSize(); }
+
+	/// <summary>
+	/// ワーカースレッド開始（WICはスレッド毎にCOMの初期化が必要）
+	/// </summary>
+	bool BeginWorker() { return SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED)); }
+
+	/// <summary>
+	/// ワーカースレッド終了
+	/// </summary>
+	void EndWorker(bool begun) {
+		if (begun) {
+			CoUninitialize();
+		}
+	}
+};
+
+/// <summary>
+/// テクスチャデコーダ（CPU処理のみ。デバイス不要）
+/// </summary>
+class TextureDecoder : public DecodeWorkerPool<TextureDecodeSource> {
+public:
+	/// <summary>
+	/// 画像ファイルの読み込み（呼び出したスレッドで実行）。
+	/// 同名のベイク済みDDSが元の画像より新しければそちらを使う
+	/// </summary>
+	/// <param name="filePath">フルパス</param>
+	/// <param name="image">出力イメージ（SRGBフォーマット）</param>
+	/// <returns>結果</returns>
+	static HRESULT Decode(const std::wstring& filePath, DirectX::ScratchImage& image);
+
+	/// <summary>
+	/// 画像ファイルのデコードとミップマップ生成
+	/// </summary>
+	/// <param name="filePath">フルパス</param>
+	/// <param name="image">出力イメージ（SRGBフォーマット）</param>
+	/// <returns>結果</returns>
+	static HRESULT DecodeSource(const std::wstring& filePath, DirectX::ScratchImage& image);
+
+	/// <summary>
+	/// ベイク済みDDSの読み込み（デコード、ミップ生成なし）
+	/// </summary>
+	/// <param name="filePath">フルパス</param>
+	/// <param name="image">出力イメージ（SRGBフォーマット）</param>
+	/// <returns>結果</returns>
+	static HRESULT LoadBaked(const std::wstring& filePath, DirectX::ScratchImage& image);
+};
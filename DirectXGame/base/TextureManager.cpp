@@ -1,4 +1,7 @@
 #include "TextureManager.h"
+#include "DirectXCommon.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "StringUtility.h"
 #include <DirectXTex.h>
 #include <cassert>
@@ -7,9 +10,15 @@
 using namespace DirectX;
 
 uint32_t TextureManager::Load(const std::string& fileName) {
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kTexture);
 	return TextureManager::GetInstance()->LoadInternal(fileName);
 }
 
+uint32_t TextureManager::LoadAsync(const std::string& fileName) {
+	MEMORY_TAG_SCOPE(MemoryTracker::Tag::kTexture);
+	return TextureManager::GetInstance()->LoadAsyncInternal(fileName);
+}
+
 bool TextureManager::Unload(uint32_t textureHandle) {
 	return TextureManager::GetInstance()->UnloadInternal(textureHandle);
 }
@@ -31,6 +40,14 @@ void TextureManager::Initialize(ID3D12Device* device, std::string directoryPath)
 
 	// 全テクスチャリセット
 	ResetAll();
+
+	// デコード用ワーカースレッド起動
+	decoder_.Initialize();
+}
+
+void TextureManager::Finalize() {
+	// デコード用ワーカースレッド停止
+	decoder_.Finalize();
 }
 
 void TextureManager::ResetAll() {
@@ -50,6 +67,7 @@ void TextureManager::ResetAll() {
 		textures_[i].cpuDescHandleSRV.ptr = 0;
 		textures_[i].gpuDescHandleSRV.ptr = 0;
 		textures_[i].name.clear();
+		textures_[i].isPending = false;
 	}
 	useTable_.Reset();
 }
@@ -58,6 +76,10 @@ const D3D12_RESOURCE_DESC TextureManager::GetResoureDesc(uint32_t textureHandle)
 
 	assert(textureHandle < textures_.size());
 	Texture& texture = textures_.at(textureHandle);
+	// 読み込み中はプレースホルダーの情報を返す
+	if (texture.isPending) {
+		return textures_.at(placeholderHandle_).resource->GetDesc();
+	}
 	return texture.resource->GetDesc();
 }
 
@@ -91,47 +113,26 @@ uint32_t TextureManager::LoadInternal(const std::string& fileName) {
 	Texture& texture = textures_.at(handle);
 	texture.name = fileName;
 
-	// ディレクトリパスとファイル名を連結してフルパスを得る
-	bool currentRelative = false;
-	if (2 < fileName.size()) {
-		currentRelative = (fileName[0] == '.') && (fileName[1] == '/');
+	// デコードとミップマップ生成
+	ScratchImage scratchImg{};
+	HRESULT result = TextureDecoder::Decode(ConvertFullPath(fileName), scratchImg);
+	if (FAILED(result)) {
+		NotFoundTexture(fileName);
 	}
-	std::string fullPath = currentRelative ? fileName : directoryPath_ + fileName;
 
-	// ユニコード文字列に変換
-	wchar_t wfilePath[256];
-	MultiByteToWideChar(CP_ACP, 0, fullPath.c_str(), -1, wfilePath, _countof(wfilePath));
-
-	HRESULT result;
+	// GPUリソース生成と転送
+	CreateTextureResource(handle, scratchImg);
 
-	TexMetadata metadata{};
-	ScratchImage scratchImg{};
+	useTable_.Set(handle);
 
-	// WICテクスチャのロード
-	result = LoadFromWICFile(wfilePath, WIC_FLAGS_NONE, &metadata, scratchImg);
-	if (FAILED(result)) {
-		auto message = std::format(
-		    L"テクスチャ「{0}」"
-		    "の読み込みに失敗しました。\n指定したパスが正しいか、必須リソースのコピー"
-		    "を忘れていないか確認してください。",
-		    ConvertStringMultiByteToWide(fileName));
-		MessageBoxW(nullptr, message.c_str(), L"Not found texture", 0);
-		assert(false);
-		exit(1);
-	}
+	return handle;
+}
 
-	ScratchImage mipChain{};
-	// ミップマップ生成
-	result = GenerateMipMaps(
-	    scratchImg.GetImages(), scratchImg.GetImageCount(), scratchImg.GetMetadata(),
-	    TEX_FILTER_DEFAULT, 0, mipChain);
-	if (SUCCEEDED(result)) {
-		scratchImg = std::move(mipChain);
-		metadata = scratchImg.GetMetadata();
-	}
+void TextureManager::CreateTextureResource(uint32_t handle, const ScratchImage& scratchImg) {
+	HRESULT result;
 
-	// 読み込んだディフューズテクスチャをSRGBとして扱う
-	metadata.format = MakeSRGB(metadata.format);
+	Texture& texture = textures_.at(handle);
+	const TexMetadata& metadata = scratchImg.GetMetadata();
 
 	// リソース設定
 	CD3DX12_RESOURCE_DESC texresDesc = CD3DX12_RESOURCE_DESC::Tex2D(
@@ -182,12 +183,109 @@ uint32_t TextureManager::LoadInternal(const std::string& fileName) {
 	    texture.resource.Get(), // ビューと関連付けるバッファ
 	    &srvDesc,               // テクスチャ設定情報
 	    texture.cpuDescHandleSRV);
+	texture.isPending = false;
+}
+
+void TextureManager::CreatePlaceholderView(uint32_t handle) {
+	Texture& texture = textures_.at(handle);
+	const Texture& placeholder = textures_.at(placeholderHandle_);
+	assert(placeholder.resource);
+
+	// 読み込み完了まではプレースホルダーのビューをそのまま使う。
+	// 自分の番号のデスクリプタは描画に使われないので、完了時に処理中のフレームを待たずに書き込める
+	texture.cpuDescHandleSRV = placeholder.cpuDescHandleSRV;
+	texture.gpuDescHandleSRV = placeholder.gpuDescHandleSRV;
+}
+
+std::wstring TextureManager::ConvertFullPath(const std::string& fileName) const {
+	// ディレクトリパスとファイル名を連結してフルパスを得る
+	bool currentRelative = false;
+	if (2 < fileName.size()) {
+		currentRelative = (fileName[0] == '.') && (fileName[1] == '/');
+	}
+	std::string fullPath = currentRelative ? fileName : directoryPath_ + fileName;
+
+	// ユニコード文字列に変換
+	wchar_t wfilePath[256];
+	MultiByteToWideChar(CP_ACP, 0, fullPath.c_str(), -1, wfilePath, _countof(wfilePath));
+	return wfilePath;
+}
+
+void TextureManager::NotFoundTexture(const std::string& fileName) {
+	auto message = std::format(
+	    L"テクスチャ「{0}」"
+	    "の読み込みに失敗しました。\n指定したパスが正しいか、必須リソースのコピー"
+	    "を忘れていないか確認してください。",
+	    ConvertStringMultiByteToWide(fileName));
+	MessageBoxW(nullptr, message.c_str(), L"Not found texture", 0);
+	assert(false);
+	exit(1);
+}
+
+uint32_t TextureManager::LoadAsyncInternal(const std::string& fileName) {
+
+	// 読み込み済み（読み込み中含む）テクスチャを検索
+	auto it = std::find_if(textures_.begin(), textures_.end(), [&](const auto& texture) {
+		return texture.name == fileName;
+	});
+	if (it != textures_.end()) {
+		return static_cast<uint32_t>(std::distance(textures_.begin(), it));
+	}
+
+	// 書き込むテクスチャの参照
+	uint32_t handle = uint32_t(useTable_.FindFirst());
+	assert(handle < kNumDescriptors);
+
+	Texture& texture = textures_.at(handle);
+	texture.name = fileName;
+	texture.isPending = true;
+
+	// 完了までプレースホルダーを描画させる
+	CreatePlaceholderView(handle);
+
+	// デコードとミップマップ生成はワーカースレッドで行う
+	TextureDecoder::Request request;
+	request.handle = handle;
+	request.name = fileName;
+	request.filePath = ConvertFullPath(fileName);
+	decoder_.Push(std::move(request));
 
 	useTable_.Set(handle);
 
 	return handle;
 }
 
+void TextureManager::UploadPending() {
+	PROFILE_SCOPE("TextureManager::UploadPending");
+	decoder_.Collect(decodedResults_);
+
+	for (TextureDecoder::Result& decoded : decodedResults_) {
+		Texture& texture = textures_.at(decoded.handle);
+		// 完了前に解放、または別のテクスチャで再利用された
+		if (!texture.isPending || texture.name != decoded.name) {
+			continue;
+		}
+
+		if (FAILED(decoded.result)) {
+			NotFoundTexture(decoded.name);
+		}
+
+		// GPUリソース生成と転送。ビューもここで差し替わる
+		CreateTextureResource(decoded.handle, decoded.image);
+	}
+	decodedResults_.clear();
+}
+
+void TextureManager::WaitPending() {
+	decoder_.WaitIdle();
+	UploadPending();
+}
+
+bool TextureManager::IsReady(uint32_t textureHandle) const {
+	assert(textureHandle < textures_.size());
+	return !textures_[textureHandle].isPending;
+}
+
 bool TextureManager::UnloadInternal(uint32_t textureHandle) {
 	// 範囲外
 	if (textures_.size() <= textureHandle) {
@@ -199,11 +297,17 @@ bool TextureManager::UnloadInternal(uint32_t textureHandle) {
 	assert(!texture.name.empty());
 
 	// テクスチャ設定を解除
-	texture.resource.Reset();
 	texture.cpuDescHandleSRV.ptr = 0;
 	texture.gpuDescHandleSRV.ptr = 0;
 	texture.name.clear();
-	useTable_.Reset(textureHandle);
+	texture.isPending = false;
+
+	// 処理中のフレームが使っているかもしれないので、リソースとデスクリプタは完了後に手放す
+	DirectXCommon::GetInstance()->ExecuteAfterFrame(
+	    [this, textureHandle, resource = std::move(texture.resource)]() mutable {
+		    resource.Reset();
+		    useTable_.Reset(textureHandle);
+	    });
 	return true;
 }
 
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "TextureDecoder.h"
 #include <array>
 #include <d3dx12.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <wrl.h>
 
 /// <summary>
@@ -26,6 +28,8 @@ public:
 		CD3DX12_GPU_DESCRIPTOR_HANDLE gpuDescHandleSRV;
 		// 名前
 		std::string name;
+		// 非同期読み込み中フラグ
+		bool isPending = false;
 	};
 
 	/// <summary>
@@ -35,6 +39,14 @@ public:
 	/// <returns>テクスチャハンドル</returns>
 	static uint32_t Load(const std::string& fileName);
 
+	/// <summary>
+	/// 非同期読み込み。デコードとミップマップ生成はワーカースレッドで行い、
+	/// UploadPendingで転送されるまではプレースホルダーが描画される
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>テクスチャハンドル</returns>
+	static uint32_t LoadAsync(const std::string& fileName);
+
 	/// <summary>
 	/// 読み込み解除
 	/// </summary>
@@ -53,6 +65,11 @@ public:
 	/// <param name="device">デバイス</param>
 	void Initialize(ID3D12Device* device, std::string directoryPath = "Resources/");
 
+	/// <summary>
+	/// 終了処理
+	/// </summary>
+	void Finalize();
+
 	/// <summary>
 	/// 全テクスチャリセット
 	/// </summary>
@@ -65,6 +82,28 @@ public:
 	/// <returns>リソース情報</returns>
 	const D3D12_RESOURCE_DESC GetResoureDesc(uint32_t textureHandle);
 
+	/// <summary>
+	/// デコード済みテクスチャをまとめてGPUに転送する（フレーム開始時に呼ぶ）
+	/// </summary>
+	void UploadPending();
+
+	/// <summary>
+	/// 非同期読み込みが全て終わるまで待って転送する
+	/// </summary>
+	void WaitPending();
+
+	/// <summary>
+	/// 読み込み完了しているか
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	/// <returns>完了していればtrue</returns>
+	bool IsReady(uint32_t textureHandle) const;
+
+	/// <summary>
+	/// デコード統計情報の取得
+	/// </summary>
+	TextureDecoder::Statistics GetDecodeStatistics() const { return decoder_.GetStatistics(); }
+
 	/// <summary>
 	/// デスクリプタテーブルをセット
 	/// </summary>
@@ -115,6 +154,12 @@ private:
 	// テクスチャコンテナ
 	std::array<Texture, kNumDescriptors> textures_;
 	Bitset<kNumDescriptors> useTable_;
+	// 読み込み中に代わりに描画するテクスチャ（最初に読み込むwhite1x1.png）
+	uint32_t placeholderHandle_ = 0;
+	// デコーダ
+	TextureDecoder decoder_;
+	// 転送待ちのデコード結果
+	std::vector<TextureDecoder::Result> decodedResults_;
 
 	/// <summary>
 	/// 読み込み
@@ -122,6 +167,38 @@ private:
 	/// <param name="fileName">ファイル名</param>
 	uint32_t LoadInternal(const std::string& fileName);
 
+	/// <summary>
+	/// 非同期読み込み
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	uint32_t LoadAsyncInternal(const std::string& fileName);
+
+	/// <summary>
+	/// テクスチャリソースとビューの生成
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="scratchImg">デコード済みイメージ</param>
+	void CreateTextureResource(uint32_t handle, const DirectX::ScratchImage& scratchImg);
+
+	/// <summary>
+	/// プレースホルダーのビューを共有させる
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	void CreatePlaceholderView(uint32_t handle);
+
+	/// <summary>
+	/// フルパスに変換
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>フルパス</returns>
+	std::wstring ConvertFullPath(const std::string& fileName) const;
+
+	/// <summary>
+	/// 読み込み失敗の通知
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	static void NotFoundTexture(const std::string& fileName);
+
 	/// <summary>
 	/// 読み込み解除
 	/// </summary>
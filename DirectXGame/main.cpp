@@ -1,14 +1,31 @@
 #include "Audio.h"
 #include "AxisIndicator.h"
+#include "ClusteredLighting.h"
+#include "ConstantBufferAllocator.h"
+#include "DebugDraw.h"
 #include "DirectXCommon.h"
+#include "FrameStatistics.h"
 #include "GameScene.h"
 #include "GameScene2.h"
 #include "GameScene3.h"
 #include "ImGuiManager.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include "ModelRenderQueue.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
 #include "PrimitiveDrawer.h"
+#include "RecordingRenderBackend.h"
+#include "ShadowCasterSystem.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
 #include "TextureManager.h"
 #include "TitleScene.h"
 #include "WinApp.h"
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
 
 GameScene* gameScene = nullptr;
 GameScene2* gameScene2 = nullptr;
@@ -25,6 +42,7 @@ enum class Scene {
 Scene scene = Scene::kUnknown;
 
 void ChengeScene() {
+	PROFILE_SCOPE("ChengeScene");
 
 	switch (scene) {
 	case Scene::kTitle:
@@ -82,6 +100,7 @@ void ChengeScene() {
 }
 
 void UpdateScene() {
+	PROFILE_SCOPE("UpdateScene");
 
 	switch (scene) {
 	case Scene::kTitle:
@@ -100,6 +119,7 @@ void UpdateScene() {
 }
 
 void DrawScene() {
+	PROFILE_SCOPE("DrawScene");
 
 	switch (scene) {
 	case Scene::kTitle:
@@ -117,8 +137,38 @@ void DrawScene() {
 	}
 }
 
+// UI画像をアトラスにまとめてレポートを書き出す
+// （ページ画像を含むPNGのDDS化はTools/TextureBakerで行う）
+void BakeAtlas() {
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	// UI画像をアトラスにまとめる
+	TextureAtlas::Statistics atlasStatistics;
+	HRESULT atlasResult = TextureAtlas::Build(
+	    "Resources/", {"images/key.png", "images/invert.png", "images/keyboard_.png",
+	                   "images/keyboard_a.png", "images/keyboard_s.png", "images/keyboard_w.png"},
+	    "atlas/ui", atlasStatistics);
+
+	std::string report = std::format(
+	    "atlas/ui: result 0x{:08X}, {} images, {} pages, occupancy {:.1f}%\n",
+	    uint32_t(atlasResult), atlasStatistics.packedCount, atlasStatistics.pageCount,
+	    atlasStatistics.GetOccupancy() * 100.0);
+
+	std::ofstream file("Resources/AtlasBakeReport.txt");
+	file << report;
+	OutputDebugStringA(report.c_str());
+
+	CoUninitialize();
+}
+
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
+	// アトラスのベイクのみ行って終了
+	if (std::strstr(lpCmdLine, "--bake-atlas")) {
+		BakeAtlas();
+		return 0;
+	}
+
 	WinApp* win = nullptr;
 	DirectXCommon* dxCommon = nullptr;
 	// 汎用機能
@@ -155,8 +205,30 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	// スプライト静的初期化
 	Sprite::StaticInitialize(dxCommon->GetDevice(), WinApp::kWindowWidth, WinApp::kWindowHeight);
 
+	// スプライトバッチ初期化
+	SpriteBatch* spriteBatch = SpriteBatch::GetInstance();
+	spriteBatch->Initialize(dxCommon->GetDevice(), WinApp::kWindowWidth, WinApp::kWindowHeight);
+
+	// フレームごとの定数バッファ割り当て初期化
+	ConstantBufferAllocator* constantBufferAllocator = ConstantBufferAllocator::GetInstance();
+	constantBufferAllocator->Initialize(dxCommon->GetRenderDevice(), dxCommon->GetFrameScheduler());
+
 	// 3Dモデル静的初期化
 	Model::StaticInitialize();
+	ModelRenderQueue* modelRenderQueue = ModelRenderQueue::GetInstance();
+	// クラスタ化ライティング初期化
+	ClusteredLighting* clusteredLighting = ClusteredLighting::GetInstance();
+	clusteredLighting->Initialize(dxCommon->GetDevice(), dxCommon->GetRenderDevice());
+	// 丸影のキャスター管理初期化
+	ShadowCasterSystem* shadowCasterSystem = ShadowCasterSystem::GetInstance();
+	shadowCasterSystem->Initialize();
+
+	// パーティクル静的初期化
+	ParticleSystem::StaticInitialize(dxCommon->GetDevice());
+
+	// デバッグ表示初期化
+	DebugDraw* debugDraw = DebugDraw::GetInstance();
+	debugDraw->Initialize(dxCommon->GetDevice());
 
 	// 軸方向表示初期化
 	axisIndicator = AxisIndicator::GetInstance();
@@ -174,13 +246,58 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	// gameScene = new GameScene();
 	// gameScene->Initialize();
 
+	// CPU区間の計測（デバッグビルドでは最初から有効。リリースビルドも区間は残しておき、
+	// --frame-statisticsを付けて起動したときは引っかかりの内訳を取るために有効にする）
+	Profiler* profiler = Profiler::GetInstance();
+	profiler->SetThreadName("Main");
+
+	// 毎フレームの処理を分けるジョブシステム（メインスレッドの分を除いたコア数のワーカー）
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(JobSystem::GetDefaultWorkerCount());
+
+	// フレーム時間の統計（60fpsの1フレームに垂直同期の揺れの分だけ余裕を持たせた予算）
+	FrameStatistics frameStatistics;
+	frameStatistics.Initialize(20.0);
+	// 終了時の書き出しはデバッグビルドか、--frame-statisticsを付けて起動したときだけ
+#ifdef _DEBUG
+	bool writeFrameStatistics = true;
+#else
+	bool writeFrameStatistics = std::strstr(lpCmdLine, "--frame-statistics") != nullptr;
+#endif
+	if (writeFrameStatistics) {
+		Profiler::SetEnabled(true);
+	}
+	std::chrono::steady_clock::time_point frameBeginTime = std::chrono::steady_clock::now();
+
+#ifdef _DEBUG
+	// 描画コマンドを数える（モデルなどライブラリ内の描画はD3D12を直接呼ぶので含まれない）
+	RecordingRenderCommandList renderRecorder(dxCommon->GetRenderCommandList());
+	renderRecorder.SetRecordsCommands(false);
+	dxCommon->SetRenderCommandList(&renderRecorder);
+	RecordingRenderCommandList::Statistics renderStatistics;
+#endif
+
 	// メインループ
 	while (true) {
+		// 前のフレームの区間を集計してから次のフレームを測る
+		profiler->EndFrame();
+		MemoryTracker::EndFrame();
+		PROFILE_SCOPE("Frame");
+		// 前のフレームの時間を、そのフレームの区間と一緒に積む
+		std::chrono::steady_clock::time_point frameEndTime = std::chrono::steady_clock::now();
+		frameStatistics.AddFrame(
+		    std::chrono::duration<double, std::milli>(frameEndTime - frameBeginTime).count(),
+		    profiler->GetScopeStatistics());
+		frameBeginTime = frameEndTime;
+
 		// メッセージ処理
 		if (win->ProcessMessage()) {
 			break;
 		}
 
+		// 非同期読み込みが完了したテクスチャをまとめて転送
+		TextureManager::GetInstance()->UploadPending();
+
 		// ImGui受付開始
 		imguiManager->Begin();
 		// 入力関連の毎フレーム処理
@@ -193,25 +310,199 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		UpdateScene();
 		// 軸表示の更新
 		axisIndicator->Update();
+#ifdef _DEBUG
+		// スプライトバッチの統計（直前のフレーム）
+		const SpriteBatch::Statistics& spriteStatistics = spriteBatch->GetStatistics();
+		ImGui::Begin("SpriteBatch");
+		ImGui::Text("quads: %u", spriteStatistics.quadCount);
+		ImGui::Text("draw calls: %u", spriteStatistics.drawCallCount);
+		ImGui::Text("pipeline changes: %u", spriteStatistics.pipelineChangeCount);
+		ImGui::Text("texture changes: %u", spriteStatistics.textureChangeCount);
+		ImGui::Text("dropped quads: %u", spriteStatistics.droppedQuadCount);
+		ImGui::End();
+		// 定数バッファ割り当ての統計（直前のフレーム）
+		const ConstantBufferAllocator::Statistics& constantStatistics =
+		    constantBufferAllocator->GetStatistics();
+		ImGui::Begin("ConstantBufferAllocator");
+		ImGui::Text("allocations: %u", constantStatistics.allocationCount);
+		ImGui::Text("requested bytes: %llu", constantStatistics.requestedBytes);
+		ImGui::Text(
+		    "used bytes: %llu / %llu", constantStatistics.usedBytes,
+		    constantStatistics.capacityBytes);
+		ImGui::Text("failed: %u", constantStatistics.failedCount);
+		ImGui::End();
+		// モデル描画キューの統計（直前のフレーム）
+		const ModelRenderQueue::Statistics& modelStatistics = modelRenderQueue->GetStatistics();
+		ImGui::Begin("ModelRenderQueue");
+		ImGui::Text("packets: %u", modelStatistics.packetCount);
+		ImGui::Text("draw calls: %u", modelStatistics.drawCallCount);
+		ImGui::Text("emitted states: %u", modelStatistics.emittedStateCount);
+		ImGui::Text("skipped states: %u", modelStatistics.skippedStateCount);
+		ImGui::End();
+		// 点光源の格子割り当ての統計（直前のフレーム）
+		const ClusteredLighting::Statistics& lightStatistics = clusteredLighting->GetStatistics();
+		ImGui::Begin("ClusteredLighting");
+		ImGui::Text("point lights: %u", lightStatistics.lightCount);
+		ImGui::Text("visible lights: %u", lightStatistics.visibleLightCount);
+		ImGui::Text("light indices: %u", lightStatistics.indexCount);
+		ImGui::Text("dropped indices: %u", lightStatistics.droppedIndexCount);
+		ImGui::Text("max lights per cluster: %u", lightStatistics.maxClusterLightCount);
+		const ClusteredLighting::UploadStatistics& lightUploadStatistics =
+		    clusteredLighting->GetUploadStatistics();
+		ImGui::Text("light bytes: %llu", lightUploadStatistics.lightBytes);
+		ImGui::Text("skipped light bytes: %llu", lightUploadStatistics.skippedLightBytes);
+		ImGui::Text("cluster bytes: %llu", lightUploadStatistics.clusterBytes);
+		ImGui::End();
+		// 丸影のキャスター選択の統計（直前のフレーム）
+		const ShadowCasterSystem::Statistics& shadowStatistics = shadowCasterSystem->GetStatistics();
+		ImGui::Begin("ShadowCasterSystem");
+		ImGui::Text("casters: %u", shadowStatistics.casterCount);
+		ImGui::Text("visited cells: %u", shadowStatistics.visitedCellCount);
+		ImGui::Text("candidates: %u", shadowStatistics.candidateCount);
+		ImGui::Text("selected: %u", shadowStatistics.selectedCount);
+		ImGui::End();
+		// デバッグ表示の統計（直前のフレーム）
+		const DebugDraw::Statistics& debugDrawStatistics = debugDraw->GetStatistics();
+		ImGui::Begin("DebugDraw");
+		ImGui::Text("lines: %u", debugDrawStatistics.lineCount);
+		ImGui::Text("draw calls: %u", debugDrawStatistics.drawCallCount);
+		ImGui::Text("pipeline changes: %u", debugDrawStatistics.pipelineChangeCount);
+		ImGui::Text("chunks: %u", debugDrawStatistics.chunkCount);
+		ImGui::Text("upload bytes: %llu", debugDrawStatistics.uploadBytes);
+		ImGui::End();
+		// CPU区間の計測（直近のフレーム）
+		ImGui::Begin("Profiler");
+		bool profilerEnabled = Profiler::IsEnabled();
+		if (ImGui::Checkbox("enabled", &profilerEnabled)) {
+			Profiler::SetEnabled(profilerEnabled);
+		}
+		if (ImGui::Button("capture 120 frames")) {
+			profiler->BeginCapture(120);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("write trace")) {
+			profiler->WriteChromeTrace("ProfilerTrace.json");
+		}
+		ImGui::Text(
+		    "captured events: %zu%s", profiler->GetCapturedEvents().size(),
+		    profiler->IsCapturing() ? " (capturing)" : "");
+		ImGui::Text("dropped events: %llu", profiler->GetDroppedEventCount());
+		ImGui::Text(
+		    "%-32s %5s %7s %7s %7s %7s %7s", "scope [ms]", "calls", "avg", "p50", "p95", "p99",
+		    "max");
+		for (const Profiler::ScopeStatistics& scope : profiler->GetScopeStatistics()) {
+			ImGui::Text(
+			    "%-32.*s %5u %7.3f %7.3f %7.3f %7.3f %7.3f", int(scope.name.size()),
+			    scope.name.data(), scope.callCount, scope.averageMilliseconds,
+			    scope.p50Milliseconds, scope.p95Milliseconds, scope.p99Milliseconds,
+			    scope.maxMilliseconds);
+		}
+		ImGui::End();
+		// フレーム時間の統計
+		ImGui::Begin("FrameStatistics");
+		FrameStatistics::Summary frameSummary = frameStatistics.GetSummary();
+		ImGui::Text(
+		    "frames: %llu, hitches over %.1f ms: %llu", frameSummary.frameCount,
+		    frameStatistics.GetBudgetMilliseconds(), frameSummary.hitchCount);
+		ImGui::Text(
+		    "avg %.2f, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f [ms]",
+		    frameSummary.averageMilliseconds, frameSummary.p50Milliseconds,
+		    frameSummary.p95Milliseconds, frameSummary.p99Milliseconds,
+		    frameSummary.maxMilliseconds);
+		if (ImGui::Button("write report")) {
+			frameStatistics.WriteReport("FrameStatistics.txt");
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("reset")) {
+			frameStatistics.Initialize(frameStatistics.GetBudgetMilliseconds());
+		}
+		ImGui::End();
+		// 分類ごとのヒープ確保
+		ImGui::Begin("MemoryTracker");
+		ImGui::Text(
+		    "%-8s %10s %10s %8s %8s %9s", "tag", "live[KiB]", "peak[KiB]", "live", "frame",
+		    "max frame");
+		for (size_t i = 0; i < size_t(MemoryTracker::Tag::kCountOfTag); i++) {
+			MemoryTracker::Tag tag = MemoryTracker::Tag(i);
+			MemoryTracker::TagStatistics memoryStatistics = MemoryTracker::GetStatistics(tag);
+			ImGui::Text(
+			    "%-8s %10.1f %10.1f %8lld %8llu %9llu", MemoryTracker::GetTagName(tag),
+			    double(memoryStatistics.liveBytes) / 1024.0,
+			    double(memoryStatistics.peakBytes) / 1024.0, memoryStatistics.liveCount,
+			    memoryStatistics.frameAllocationCount, memoryStatistics.maxFrameAllocationCount);
+		}
+		if (ImGui::Button("write report")) {
+			MemoryTracker::WriteReport("MemoryReport.txt");
+		}
+		ImGui::End();
+		// 描画コマンドの統計（直前のフレーム）
+		ImGui::Begin("RenderBackend");
+		ImGui::Text("draw calls: %u", renderStatistics.drawCallCount);
+		ImGui::Text("instances: %u", renderStatistics.instanceCount);
+		ImGui::Text("state changes: %u", renderStatistics.stateChangeCount);
+		ImGui::Text("redundant states: %u", renderStatistics.redundantStateCount);
+		ImGui::Text("upload bytes: %llu", renderStatistics.uploadBytes);
+		ImGui::End();
+		// ジョブシステムの統計（累計）
+		ImGui::Begin("JobSystem");
+		JobSystem::Statistics jobStatistics = jobSystem->GetStatistics();
+		ImGui::Text("workers: %u", jobSystem->GetWorkerCount());
+		ImGui::Text("executed jobs: %llu", jobStatistics.executedJobCount);
+		ImGui::Text("stolen jobs: %llu", jobStatistics.stolenJobCount);
+		ImGui::End();
+#endif
 		// ImGui受付終了
 		imguiManager->End();
 
 		// 描画開始
 		dxCommon->PreDraw();
+		spriteBatch->BeginFrame();
+		modelRenderQueue->BeginFrame();
+		clusteredLighting->BeginFrame();
+		shadowCasterSystem->BeginFrame();
+		debugDraw->BeginFrame();
+		constantBufferAllocator->BeginFrame();
 		//// ゲームシーンの描画
 		// gameScene->Draw();
 		// タイトル
+#ifdef _DEBUG
+		renderRecorder.Reset();
+#endif
 		DrawScene();
+#ifdef _DEBUG
+		renderStatistics = renderRecorder.GetStatistics();
+#endif
 		// 軸表示の描画
 		axisIndicator->Draw();
 		// プリミティブ描画のリセット
 		primitiveDrawer->Reset();
+		debugDraw->Reset();
 		// ImGui描画
 		imguiManager->Draw();
+		constantBufferAllocator->EndFrame();
 		// 描画終了
 		dxCommon->PostDraw();
 	}
 
+	// 処理中のフレームを待ってから解放する
+	dxCommon->WaitForIdle();
+#ifdef _DEBUG
+	// renderRecorderはこの関数のローカルなので、DirectXCommonに残さない
+	dxCommon->SetRenderCommandList(nullptr);
+#endif
+
+	// フレーム時間の統計を書き出す
+	if (writeFrameStatistics) {
+		frameStatistics.WriteReport("FrameStatistics.txt");
+		OutputDebugStringA(frameStatistics.FormatReport().c_str());
+	}
+	// 分類ごとのヒープ確保を書き出す（最大はステージを通しての値。
+	// リリースビルドはMEMORY_TRACKER_DISABLEDで数えていないので書かない）
+	if (MemoryTracker::IsEnabled()) {
+		MemoryTracker::WriteReport("MemoryReport.txt");
+		OutputDebugStringA(MemoryTracker::FormatReport().c_str());
+	}
+
 	// 各種解放
 	delete gameScene3;
 	delete gameScene2;
@@ -219,6 +510,10 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	delete titeleScene;
 	// 3Dモデル解放
 	Model::StaticFinalize();
+	// ワーカー停止
+	jobSystem->Finalize();
+	// テクスチャデコーダ停止
+	TextureManager::GetInstance()->Finalize();
 	audio->Finalize();
 	// ImGui解放
 	imguiManager->Finalize();
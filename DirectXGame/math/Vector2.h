@@ -7,3 +7,14 @@ struct Vector2 final {
 	float x;
 	float y;
 };
+
+constexpr Vector2 operator+(const Vector2& v1, const Vector2& v2) noexcept { return {v1.x + v2.x, v1.y + v2.y}; }
+constexpr Vector2 operator-(const Vector2& v1, const Vector2& v2) noexcept { return {v1.x - v2.x, v1.y - v2.y}; }
+constexpr Vector2 operator-(const Vector2& v) noexcept { return {-v.x, -v.y}; }
+constexpr Vector2 operator*(const Vector2& v, float s) noexcept { return {v.x * s, v.y * s}; }
+constexpr Vector2 operator*(float s, const Vector2& v) noexcept { return {v.x * s, v.y * s}; }
+constexpr Vector2 operator/(const Vector2& v, float s) noexcept { return {v.x / s, v.y / s}; }
+constexpr Vector2& operator+=(Vector2& v1, const Vector2& v2) noexcept { return v1 = v1 + v2; }
+constexpr Vector2& operator-=(Vector2& v1, const Vector2& v2) noexcept { return v1 = v1 - v2; }
+constexpr bool operator==(const Vector2& v1, const Vector2& v2) noexcept { return v1.x == v2.x && v1.y == v2.y; }
+constexpr float Dot(const Vector2& v1, const Vector2& v2) noexcept { return v1.x * v2.x + v1.y * v2.y; }
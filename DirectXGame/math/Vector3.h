@@ -1,41 +1,95 @@
 #ifndef VECTOR3_H
 #define VECTOR3_H
 #include "Matrix4x4.h"  // Matrix4x4 の定義をインクルード
+#include <cmath>
 
+// 演算子はすべてヘッダー内で constexpr noexcept にして、翻訳単位をまたいでもインライン展開させる
 class Vector3 {
 public:
     float x, y, z;
 
     // Constructor
-    Vector3(float x = 0.0f, float y = 0.0f, float z = 0.0f)
+    constexpr Vector3(float x = 0.0f, float y = 0.0f, float z = 0.0f) noexcept
         : x(x), y(y), z(z) {}
 
     // += operator overload
-    Vector3& operator+=(const Vector3& other) {
+    constexpr Vector3& operator+=(const Vector3& other) noexcept {
         x += other.x;
         y += other.y;
         z += other.z;
         return *this;  // Return reference to self for chaining
     }
 
-    // Example of + operator overload (as a non-member function)
-    friend const Vector3 operator+(const Vector3& v1, const Vector3& v2);
-
-    // Other methods and operators can be defined here
-    Vector3 operator-(const Vector3& other) const {
+    constexpr Vector3 operator-(const Vector3& other) const noexcept {
         return Vector3(this->x - other.x, this->y - other.y, this->z - other.z);
     }
 
-    Vector3& operator-=(const Vector3& other) {
+    constexpr Vector3& operator-=(const Vector3& other) noexcept {
         this->x -= other.x;
         this->y -= other.y;
         this->z -= other.z;
         return *this;
     }
+
+    constexpr Vector3& operator*=(float s) noexcept {
+        x *= s;
+        y *= s;
+        z *= s;
+        return *this;
+    }
+
+    constexpr Vector3& operator/=(float s) noexcept {
+        x /= s;
+        y /= s;
+        z /= s;
+        return *this;
+    }
+
+    // 符号反転
+    constexpr Vector3 operator-() const noexcept { return Vector3(-x, -y, -z); }
+
+    constexpr bool operator==(const Vector3& other) const noexcept {
+        return x == other.x && y == other.y && z == other.z;
+    }
 };
 
+constexpr Vector3 operator+(const Vector3& v1, const Vector3& v2) noexcept {
+    return Vector3(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z);
+}
+
+// 成分ごとの積
+constexpr Vector3 operator*(const Vector3& v1, const Vector3& v2) noexcept {
+    return Vector3(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z);
+}
+
+constexpr Vector3 operator*(const Vector3& v, float s) noexcept { return Vector3(v.x * s, v.y * s, v.z * s); }
+
+constexpr Vector3 operator*(float s, const Vector3& v) noexcept { return v * s; }
+
+constexpr Vector3 operator/(const Vector3& v, float s) noexcept { return Vector3(v.x / s, v.y / s, v.z / s); }
+
+// 内積
+constexpr float Dot(const Vector3& v1, const Vector3& v2) noexcept { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+
+// クロス積
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) noexcept {
+    return Vector3(v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x);
+}
+
+// 長さの2乗
+constexpr float LengthSquared(const Vector3& v) noexcept { return Dot(v, v); }
+
+// 長さ（std::sqrt は constexpr ではないので inline のみ）
+inline float Length(const Vector3& v) noexcept { return std::sqrt(LengthSquared(v)); }
+
+// 正規化（長さ0ならそのまま返す）
+inline Vector3 Normalize(const Vector3& v) noexcept {
+    float length = Length(v);
+    return length != 0.0f ? v / length : v;
+}
+
 // MultiplyMatrixVector を Vector3 クラス外に静的関数として定義する
-inline Vector3 MultiplyMatrixVector(const Matrix4x4& mat, const Vector3& vec) {
+constexpr Vector3 MultiplyMatrixVector(const Matrix4x4& mat, const Vector3& vec) noexcept {
     Vector3 result;
     result.x = mat.m[0][0] * vec.x + mat.m[1][0] * vec.y + mat.m[2][0] * vec.z + mat.m[3][0];
     result.y = mat.m[0][1] * vec.x + mat.m[1][1] * vec.y + mat.m[2][1] * vec.z + mat.m[3][1];
@@ -43,4 +97,4 @@ inline Vector3 MultiplyMatrixVector(const Matrix4x4& mat, const Vector3& vec) {
     return result;
 }
 
-#endif // VECTOR3_H
\ No newline at end of file
+#endif // VECTOR3_H
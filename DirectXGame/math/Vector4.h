@@ -8,4 +8,21 @@ struct Vector4 final {
 	float y;
 	float z;
 	float w;
-};
\ No newline at end of file
+};
+
+constexpr Vector4 operator+(const Vector4& v1, const Vector4& v2) noexcept {
+	return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w};
+}
+constexpr Vector4 operator-(const Vector4& v1, const Vector4& v2) noexcept {
+	return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w};
+}
+constexpr Vector4 operator-(const Vector4& v) noexcept { return {-v.x, -v.y, -v.z, -v.w}; }
+constexpr Vector4 operator*(const Vector4& v, float s) noexcept { return {v.x * s, v.y * s, v.z * s, v.w * s}; }
+constexpr Vector4 operator*(float s, const Vector4& v) noexcept { return v * s; }
+constexpr Vector4 operator/(const Vector4& v, float s) noexcept { return {v.x / s, v.y / s, v.z / s, v.w / s}; }
+constexpr bool operator==(const Vector4& v1, const Vector4& v2) noexcept {
+	return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z && v1.w == v2.w;
+}
+constexpr float Dot(const Vector4& v1, const Vector4& v2) noexcept {
+	return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z + v1.w * v2.w;
+}
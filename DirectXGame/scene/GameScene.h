@@ -2,15 +2,21 @@
 
 #include "Audio.h"
 #include "CameraController.h"
+#include "ChunkedTerrain.h"
 #include "DebugCamera.h"
 #include "DirectXCommon.h"
+#include "LightCluster.h"
 #include "Input.h"
 #include "MapChipField.h"
 #include "Model.h"
 #include "MyMath.h"
 #include "Player.h" 
+#include "ShadowCasterGrid.h"
 #include "Skydome.h"
 #include "Sprite.h"
+#include "TextureAtlas.h"
+#include "TransformBuffer.h"
+#include "TransformHierarchy.h"
 #include "ViewProjection.h"
 #include "WorldTransform.h"
 #include "DeathParticles.h"
@@ -50,6 +56,33 @@ public: // メンバ関数
 	/// </summary>
 	void GenerateBlokcs();
 
+	/// <summary>
+	/// 背景の地形の生成（ノイズで高さを決める）
+	/// </summary>
+	void GenerateTerrain();
+
+	/// <summary>
+	/// マスにブロックかドアがあるか
+	/// </summary>
+	/// <param name="xIndex">横の番号</param>
+	/// <param name="yIndex">縦の番号</param>
+	bool HasBlock(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// 点光源の更新（ドアの位置に置いてクラスタに割り当てる）
+	/// </summary>
+	void UpdatePointLights();
+
+	/// <summary>
+	/// 丸影のキャスターの更新（プレイヤーとドアの位置に合わせて選び直す）
+	/// </summary>
+	void UpdateShadowCasters();
+
+	/// <summary>
+	/// 当たり判定の箱、マップの格子、デバッグカメラ中はゲームカメラの視錐台を溜める
+	/// </summary>
+	void AddDebugGeometry();
+
 	/// <summary>
 	/// 描画
 	/// </summary>
@@ -80,6 +113,9 @@ private: // メンバ変数
 	// テクスチャハンドル
 	uint32_t texturHandle_ = 0;
 
+	// UIアトラス
+	TextureAtlas uiAtlas_;
+
 	//キーボードテクスチャ
 	uint32_t keyHandle_ = 0;
 	Sprite* keySprite_ = nullptr;
@@ -110,10 +146,33 @@ private: // メンバ変数
 	// SkyDome
 	Skydome* skydome_ = nullptr;
 	Model* modelSkydome_ = nullptr;
-	std::vector<std::vector<WorldTransform*>> worldTransformBlocks_;
+
+	// 背景の地形（マップの奥に置く）
+	ChunkedTerrain terrain_;
+	WorldTransform terrainWorldTransform_;
+	uint32_t terrainTextureHandle_ = 0;
+	// 地形のマス数、1マスの大きさ、高さの幅
+	static inline const uint32_t kTerrainQuadCountX = 256;
+	static inline const uint32_t kTerrainQuadCountZ = 128;
+	static inline const float kTerrainCellSize = 0.5f;
+	static inline const float kTerrainHeight = 24.0f;
+	// 詳細度0で描く距離（地形のローカル座標）
+	static inline const float kTerrainLodDistance = 24.0f;
+
+	// ブロックとドアのトランスフォーム（マップ全体のノードを親に、全マスに1つずつ）
+	TransformHierarchy blockTransforms_;
+	// ブロックとドアのワールド行列の定数バッファ
+	TransformBuffer blockTransformBuffer_;
+	// マスのノード番号（[縦][横]）
+	std::vector<std::vector<uint32_t>> blockNodes_;
 
 	// Door
 	Model* doorModel_ = nullptr;
+	// ドアに置く点光源
+	std::vector<LightCluster::PointLight> pointLights_;
+	// 丸影のキャスターのハンドル
+	uint32_t playerShadowCaster_ = ShadowCasterGrid::kInvalidHandle;
+	std::vector<uint32_t> doorShadowCasters_;
 
 	// MapChipField
 	MapChipField* mapChipField_;
@@ -125,7 +184,6 @@ private: // メンバ変数
 
 	//死エフェクト
 	DeathParticles* deathParticles_ = nullptr;
-	Model* deathParticlesModel_ = nullptr;
 
 	//フェーズ
 	Phase phase_;
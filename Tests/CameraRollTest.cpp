@@ -0,0 +1,79 @@
+// カメラの反転演出のテスト（回転の経過と、クォータニオンから作るビュー行列）
+#include "CameraRoll.h"
+#include "MyMath.h"
+#include "Quaternion.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace {
+
+const float kPi = 3.14159265358979323846f;
+
+// 行列を要素ごとに比べる
+void ExpectMatrixNear(const Matrix4x4& actual, const Matrix4x4& expected, float tolerance) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			EXPECT_NEAR(actual.m[i][j], expected.m[i][j], tolerance) << i << "," << j;
+		}
+	}
+}
+
+// Z軸回りの角度（X軸を回した向きから求める。[0, 2π)）
+float GetRollAngle(const Quaternion& rotation) {
+	Vector3 x = rotation * Vector3(1.0f, 0.0f, 0.0f);
+	float angle = std::atan2(x.y, x.x);
+	return angle < 0.0f ? angle + 2.0f * kPi : angle;
+}
+
+TEST(CameraRollTest, HalfwayViewMatrixIsUpsideDown) {
+	// t=0.5でZ軸回り180度。ビュー行列はX、Yを反転し、平行移動も合わせて反転する
+	const Vector3 translation = {12.0f, 7.5f, -16.0f};
+	Matrix4x4 view = MakeViewMatrix(MakeCameraRollRotation(0.5f), translation);
+
+	Matrix4x4 expected = MakeIdentity4x4();
+	expected.m[0][0] = -1.0f;
+	expected.m[1][1] = -1.0f;
+	expected.m[3][0] = translation.x;
+	expected.m[3][1] = translation.y;
+	expected.m[3][2] = -translation.z;
+	ExpectMatrixNear(view, expected, 1e-5f);
+
+	// オイラー角で180度回したカメラと同じ
+	Matrix4x4 euler = InverseRigid(MakeAffineMatrix({1, 1, 1}, {0.0f, 0.0f, kPi}, translation));
+	ExpectMatrixNear(view, euler, 1e-5f);
+
+	// 注視点の上にあった点は画面の下に来る
+	Vector3 above = MultiplyMatrixVector(view, translation + Vector3(0.0f, 1.0f, 16.0f));
+	EXPECT_NEAR(above.x, 0.0f, 1e-5f);
+	EXPECT_NEAR(above.y, -1.0f, 1e-5f);
+	EXPECT_NEAR(above.z, 16.0f, 1e-5f);
+}
+
+TEST(CameraRollTest, StartAndEndAreUpright) {
+	// 0度と360度はどちらも回転なしのビュー行列
+	const Vector3 translation = {3.0f, -2.0f, -15.0f};
+	Matrix4x4 expected = MakeTranslateMatrix(-translation);
+	ExpectMatrixNear(MakeViewMatrix(MakeCameraRollRotation(0.0f), translation), expected, 1e-6f);
+	ExpectMatrixNear(MakeViewMatrix(MakeCameraRollRotation(1.0f), translation), expected, 1e-6f);
+
+	// 範囲外は端に寄せる
+	ExpectMatrixNear(MakeViewMatrix(MakeCameraRollRotation(-0.5f), translation), expected, 1e-6f);
+	ExpectMatrixNear(MakeViewMatrix(MakeCameraRollRotation(2.0f), translation), expected, 1e-6f);
+}
+
+TEST(CameraRollTest, AngleAdvancesAtConstantSpeedThroughFullTurn) {
+	// 最短経路で戻らず、角度は2πtで一周する
+	for (int i = 0; i < 100; i++) {
+		float t = float(i) / 100.0f;
+		Quaternion rotation = MakeCameraRollRotation(t);
+		EXPECT_NEAR(Dot(rotation, rotation), 1.0f, 1e-5f) << t;
+		EXPECT_NEAR(GetRollAngle(rotation), 2.0f * kPi * t, 1e-4f) << t;
+		// Z軸は動かさない
+		Vector3 z = rotation * Vector3(0.0f, 0.0f, 1.0f);
+		EXPECT_NEAR(z.z, 1.0f, 1e-5f) << t;
+	}
+	EXPECT_NEAR(GetRollAngle(MakeCameraRollRotation(0.25f)), kPi / 2.0f, 1e-5f);
+	EXPECT_NEAR(GetRollAngle(MakeCameraRollRotation(0.75f)), kPi * 1.5f, 1e-5f);
+}
+
+} // namespace
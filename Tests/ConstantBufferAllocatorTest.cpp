@@ -0,0 +1,129 @@
+// ConstantBufferAllocatorのテスト（記録用デバイスと模擬フェンスで、GPUなしで確かめる）
+#include "ConstantBufferAllocator.h"
+#include "RecordingRenderBackend.h"
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace {
+
+// 模擬フェンス（Waitで待った値まで完了させる）
+class MockFence : public FrameScheduler::Fence {
+public:
+	uint64_t GetCompletedValue() const override { return completedValue; }
+	void Signal(uint64_t value) override { signaledValue = value; }
+	void Wait(uint64_t value) override {
+		waitCount++;
+		completedValue = value;
+	}
+
+	uint64_t completedValue = 0;
+	uint64_t signaledValue = 0;
+	uint32_t waitCount = 0;
+};
+
+// 1フレーム分（DirectXCommonのPreDraw/PostDrawと同じ順序）
+struct Frame {
+	Frame(FrameScheduler& frameScheduler, ConstantBufferAllocator& allocator)
+	    : frameScheduler_(frameScheduler), allocator_(allocator) {
+		frameScheduler_.BeginFrame();
+		allocator_.BeginFrame();
+	}
+	~Frame() {
+		allocator_.EndFrame();
+		frameScheduler_.EndFrame();
+	}
+
+	FrameScheduler& frameScheduler_;
+	ConstantBufferAllocator& allocator_;
+};
+
+class ConstantBufferAllocatorTest : public testing::Test {
+protected:
+	void SetUp() override {
+		frameScheduler_.Initialize(&fence_, 2);
+		allocator_ = ConstantBufferAllocator::GetInstance();
+		allocator_->Initialize(&device_, &frameScheduler_, 1000);
+	}
+
+	MockFence fence_;
+	FrameScheduler frameScheduler_;
+	RecordingRenderDevice device_;
+	ConstantBufferAllocator* allocator_ = nullptr;
+};
+
+} // namespace
+
+TEST_F(ConstantBufferAllocatorTest, AllocationsAreAlignedAndWritable) {
+	Frame frame(frameScheduler_, *allocator_);
+	ConstantBufferAllocator::Allocation first = allocator_->Allocate(16);
+	ConstantBufferAllocator::Allocation second = allocator_->Allocate(300);
+	ASSERT_NE(first.cpuAddress, nullptr);
+	ASSERT_NE(second.cpuAddress, nullptr);
+	EXPECT_EQ(first.gpuAddress % ConstantBufferAllocator::kAlignment, 0u);
+	EXPECT_EQ(second.gpuAddress - first.gpuAddress, ConstantBufferAllocator::kAlignment);
+	EXPECT_EQ(
+	    static_cast<uint8_t*>(second.cpuAddress) - static_cast<uint8_t*>(first.cpuAddress),
+	    ptrdiff_t(ConstantBufferAllocator::kAlignment));
+
+	struct Parameters {
+		float values[4];
+	};
+	Parameters parameters = {{1.0f, 2.0f, 3.0f, 4.0f}};
+	uint64_t address = allocator_->Upload(parameters);
+	EXPECT_EQ(address, first.gpuAddress + 3 * ConstantBufferAllocator::kAlignment);
+	const uint8_t* written = static_cast<uint8_t*>(first.cpuAddress) + 3 * 256;
+	EXPECT_EQ(std::memcmp(written, &parameters, sizeof(parameters)), 0);
+}
+
+TEST_F(ConstantBufferAllocatorTest, CapacityIsRoundedUpAndOverflowReturnsNull) {
+	// 1000バイトは1024バイトに揃えられる
+	Frame frame(frameScheduler_, *allocator_);
+	for (int i = 0; i < 4; i++) {
+		EXPECT_NE(allocator_->Allocate(256).gpuAddress, 0u);
+	}
+	ConstantBufferAllocator::Allocation overflow = allocator_->Allocate(1);
+	EXPECT_EQ(overflow.cpuAddress, nullptr);
+	EXPECT_EQ(overflow.gpuAddress, 0u);
+}
+
+TEST_F(ConstantBufferAllocatorTest, StatisticsReportMeasuredUsage) {
+	{
+		Frame frame(frameScheduler_, *allocator_);
+		allocator_->Allocate(16);
+		allocator_->Allocate(64);
+		allocator_->Allocate(2048);
+	}
+	const ConstantBufferAllocator::Statistics& statistics = allocator_->GetStatistics();
+	EXPECT_EQ(statistics.allocationCount, 2u);
+	EXPECT_EQ(statistics.requestedBytes, 80u);
+	EXPECT_EQ(statistics.usedBytes, 256u + 64u);
+	EXPECT_EQ(statistics.capacityBytes, 1024u);
+	EXPECT_EQ(statistics.failedCount, 1u);
+}
+
+TEST_F(ConstantBufferAllocatorTest, FramesInFlightUseSeparateBuffers) {
+	uint64_t addresses[4];
+	for (uint64_t& address : addresses) {
+		Frame frame(frameScheduler_, *allocator_);
+		address = allocator_->Allocate(16).gpuAddress;
+	}
+	// 2フレーム分のバッファを交互に使う
+	EXPECT_NE(addresses[0], addresses[1]);
+	EXPECT_EQ(addresses[0], addresses[2]);
+	EXPECT_EQ(addresses[1], addresses[3]);
+}
+
+TEST_F(ConstantBufferAllocatorTest, WaitsForGpuBeforeReusingBuffer) {
+	// GPUが1フレームも終えていなければ、3フレーム目の開始で1フレーム目を待つ
+	for (int i = 0; i < 2; i++) {
+		Frame frame(frameScheduler_, *allocator_);
+		allocator_->Allocate(16);
+	}
+	EXPECT_EQ(fence_.waitCount, 0u);
+	EXPECT_EQ(fence_.completedValue, 0u);
+	{
+		Frame frame(frameScheduler_, *allocator_);
+		EXPECT_GE(fence_.completedValue, 1u);
+	}
+	EXPECT_EQ(fence_.waitCount, 1u);
+}
@@ -0,0 +1,71 @@
+// DebugGeometryの計測（1フレーム分を溜めてClearする。約30万本）
+#include "DebugGeometry.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using BlendMode = DebugGeometry::BlendMode;
+
+const Vector4 kWhite = {1.0f, 1.0f, 1.0f, 1.0f};
+
+// 線分30万本（2つのブレンドモードに交互に）
+void BM_Lines(benchmark::State& state) {
+	const uint32_t lineCount = 300000;
+	DebugGeometry geometry;
+	for (auto _ : state) {
+		geometry.Clear();
+		for (uint32_t i = 0; i < lineCount; i++) {
+			geometry.AddLine(
+			    {float(i), 0.0f, 0.0f}, {float(i), 1.0f, 0.0f}, kWhite, BlendMode(i % 2));
+		}
+		benchmark::DoNotOptimize(geometry.GetLineCount());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * lineCount);
+}
+BENCHMARK(BM_Lines)->Unit(benchmark::kMillisecond);
+
+// 箱2万5千個（30万本）
+void BM_Aabbs(benchmark::State& state) {
+	const uint32_t boxCount = 25000;
+	DebugGeometry geometry;
+	for (auto _ : state) {
+		geometry.Clear();
+		for (uint32_t i = 0; i < boxCount; i++) {
+			geometry.AddAabb({float(i), 0.0f, 0.0f}, {float(i) + 1.0f, 1.0f, 1.0f}, kWhite);
+		}
+		benchmark::DoNotOptimize(geometry.GetLineCount());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * boxCount * 12);
+}
+BENCHMARK(BM_Aabbs)->Unit(benchmark::kMillisecond);
+
+// 球5千個（24万本）
+void BM_Spheres(benchmark::State& state) {
+	const uint32_t sphereCount = 5000;
+	DebugGeometry geometry;
+	for (auto _ : state) {
+		geometry.Clear();
+		for (uint32_t i = 0; i < sphereCount; i++) {
+			geometry.AddSphere({float(i), 0.0f, 0.0f}, 1.0f, kWhite);
+		}
+		benchmark::DoNotOptimize(geometry.GetLineCount());
+	}
+	state.SetItemsProcessed(
+	    int64_t(state.iterations()) * sphereCount * DebugGeometry::kDefaultSphereSegmentCount * 3);
+}
+BENCHMARK(BM_Spheres)->Unit(benchmark::kMillisecond);
+
+// 格子1つ（30万本）
+void BM_Grid(benchmark::State& state) {
+	DebugGeometry geometry;
+	for (auto _ : state) {
+		geometry.Clear();
+		geometry.AddGrid(
+		    {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, 149999, 149999, kWhite);
+		benchmark::DoNotOptimize(geometry.GetLineCount());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * 300000);
+}
+BENCHMARK(BM_Grid)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,161 @@
+// DebugGeometryのテスト（線分への分解、チャンクの継ぎ足しと再利用）
+#include "DebugGeometry.h"
+#include "MyMath.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+
+namespace {
+
+using BlendMode = DebugGeometry::BlendMode;
+
+const Vector4 kWhite = {1.0f, 1.0f, 1.0f, 1.0f};
+
+float ManhattanDistance(const Vector3& a, const Vector3& b) {
+	return std::fabs(a.x - b.x) + std::fabs(a.y - b.y) + std::fabs(a.z - b.z);
+}
+
+} // namespace
+
+TEST(DebugGeometryTest, LinesAreCountedPerBlendMode) {
+	DebugGeometry geometry;
+	geometry.AddLine({0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}, {1.0f, 0.0f, 0.0f, 1.0f});
+	geometry.AddAabb({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, kWhite, BlendMode::kAdd);
+	EXPECT_EQ(geometry.GetLineCount(BlendMode::kNormal), 1u);
+	EXPECT_EQ(geometry.GetLineCount(BlendMode::kAdd), 12u);
+	EXPECT_EQ(geometry.GetLineCount(BlendMode::kNone), 0u);
+	EXPECT_EQ(geometry.GetLineCount(), 13u);
+	EXPECT_EQ(geometry.GetChunkCount(BlendMode::kNormal), 1u);
+	EXPECT_EQ(geometry.GetChunkCount(BlendMode::kAdd), 1u);
+	EXPECT_EQ(geometry.GetCapacityChunkCount(), 2u);
+
+	const DebugGeometry::Chunk& chunk = geometry.GetChunks(BlendMode::kNormal)[0];
+	ASSERT_EQ(chunk.vertexCount, 2u);
+	EXPECT_EQ(chunk.vertices[1].pos.z, 3.0f);
+	EXPECT_EQ(chunk.vertices[0].color.y, 0.0f);
+}
+
+TEST(DebugGeometryTest, AabbEdgesAreAxisAlignedAndCoverEveryCorner) {
+	DebugGeometry geometry;
+	geometry.AddAabb({-1.0f, 2.0f, 3.0f}, {1.0f, 5.0f, 7.0f}, kWhite);
+	const DebugGeometry::Chunk& chunk = geometry.GetChunks(BlendMode::kNormal)[0];
+	ASSERT_EQ(chunk.vertexCount, 24u);
+
+	// 各辺は1つの軸に沿い、長さは箱の幅のどれか
+	uint32_t axisCounts[3] = {};
+	for (uint32_t i = 0; i < 12; i++) {
+		Vector3 a = chunk.vertices[i * 2].pos;
+		Vector3 b = chunk.vertices[i * 2 + 1].pos;
+		int changed = (a.x != b.x) + (a.y != b.y) + (a.z != b.z);
+		ASSERT_EQ(changed, 1) << i;
+		axisCounts[a.x != b.x ? 0 : a.y != b.y ? 1 : 2]++;
+		float length = ManhattanDistance(a, b);
+		EXPECT_TRUE(length == 2.0f || length == 3.0f || length == 4.0f) << i;
+	}
+	EXPECT_EQ(axisCounts[0], 4u);
+	EXPECT_EQ(axisCounts[1], 4u);
+	EXPECT_EQ(axisCounts[2], 4u);
+}
+
+TEST(DebugGeometryTest, SphereCirclesLieOnSurfaceAndClose) {
+	DebugGeometry geometry;
+	const Vector3 center = {1.0f, 2.0f, 3.0f};
+	const uint32_t segmentCount = 16;
+	geometry.AddSphere(center, 2.0f, kWhite, segmentCount);
+	const DebugGeometry::Chunk& chunk = geometry.GetChunks(BlendMode::kNormal)[0];
+	ASSERT_EQ(chunk.vertexCount, segmentCount * 3 * 2);
+	EXPECT_EQ(geometry.GetLineCount(), segmentCount * 3);
+
+	for (uint32_t i = 0; i < chunk.vertexCount; i++) {
+		EXPECT_NEAR(Length(chunk.vertices[i].pos - center), 2.0f, 1e-5f) << i;
+	}
+	for (uint32_t circle = 0; circle < 3; circle++) {
+		const DebugGeometry::Vertex* vertices = chunk.vertices.get() + circle * segmentCount * 2;
+		// 線分は前の線分の終わりから始まり、最後は最初の点に戻る
+		for (uint32_t i = 1; i < segmentCount; i++) {
+			EXPECT_EQ(ManhattanDistance(vertices[i * 2 - 1].pos, vertices[i * 2].pos), 0.0f);
+		}
+		EXPECT_NEAR(
+		    ManhattanDistance(vertices[0].pos, vertices[segmentCount * 2 - 1].pos), 0.0f, 1e-5f);
+	}
+}
+
+TEST(DebugGeometryTest, GridHasOneLinePerEdgeAndSpansChunks) {
+	DebugGeometry geometry;
+	geometry.AddGrid(
+	    {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 40, 40, kWhite);
+	EXPECT_EQ(geometry.GetLineCount(), 82u);
+	const DebugGeometry::Chunk& chunk = geometry.GetChunks(BlendMode::kNormal)[0];
+	// 最初の線はV方向、最後の線はU方向に格子の端から端まで
+	EXPECT_EQ(chunk.vertices[1].pos.y, 40.0f);
+	EXPECT_EQ(chunk.vertices[chunk.vertexCount - 2].pos.y, 40.0f);
+	EXPECT_EQ(chunk.vertices[chunk.vertexCount - 1].pos.x, 40.0f);
+
+	// 1チャンクに収まらない格子は続きのチャンクへ
+	geometry.Clear();
+	geometry.AddGrid(
+	    {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, 40000, 40000, kWhite);
+	EXPECT_EQ(geometry.GetLineCount(), 80002u);
+	EXPECT_EQ(geometry.GetChunkCount(BlendMode::kNormal), 3u);
+	uint32_t vertexCount = 0;
+	for (uint32_t i = 0; i < geometry.GetChunkCount(BlendMode::kNormal); i++) {
+		vertexCount += geometry.GetChunks(BlendMode::kNormal)[i].vertexCount;
+	}
+	EXPECT_EQ(vertexCount, 80002u * 2);
+}
+
+TEST(DebugGeometryTest, FrustumCornersFollowCamera) {
+	DebugGeometry geometry;
+	// 90度、正方形なので奥の面の角は(±far, ±far, far)
+	geometry.AddFrustum(
+	    MakeIdentity4x4(), std::numbers::pi_v<float> / 2.0f, 1.0f, 1.0f, 10.0f, kWhite);
+	const DebugGeometry::Chunk& chunk = geometry.GetChunks(BlendMode::kNormal)[0];
+	ASSERT_EQ(chunk.vertexCount, 24u);
+	// 奥の面の最初の辺は角4から角5
+	EXPECT_NEAR(chunk.vertices[8].pos.x, -10.0f, 1e-4f);
+	EXPECT_NEAR(chunk.vertices[8].pos.y, -10.0f, 1e-4f);
+	EXPECT_NEAR(chunk.vertices[8].pos.z, 10.0f, 1e-4f);
+	EXPECT_NEAR(chunk.vertices[0].pos.z, 1.0f, 1e-5f);
+
+	// カメラを(0, 0, -5)に置くとワールドでは5手前
+	geometry.Clear();
+	geometry.AddFrustum(
+	    MakeTranslateMatrix({0.0f, 0.0f, 5.0f}), std::numbers::pi_v<float> / 2.0f, 1.0f, 1.0f,
+	    10.0f, kWhite);
+	EXPECT_NEAR(geometry.GetChunks(BlendMode::kNormal)[0].vertices[8].pos.z, 5.0f, 1e-4f);
+}
+
+TEST(DebugGeometryTest, ClearKeepsChunksForReuse) {
+	DebugGeometry geometry;
+	for (uint32_t i = 0; i < DebugGeometry::kChunkLineCount + 1; i++) {
+		geometry.AddLine({float(i), 0.0f, 0.0f}, {float(i), 1.0f, 0.0f}, kWhite);
+	}
+	EXPECT_EQ(geometry.GetChunkCount(BlendMode::kNormal), 2u);
+	EXPECT_EQ(
+	    geometry.GetChunks(BlendMode::kNormal)[0].vertexCount, DebugGeometry::kChunkVertexCount);
+	EXPECT_EQ(geometry.GetChunks(BlendMode::kNormal)[1].vertexCount, 2u);
+	const DebugGeometry::Vertex* first = geometry.GetChunks(BlendMode::kNormal)[0].vertices.get();
+
+	geometry.Clear();
+	EXPECT_EQ(geometry.GetLineCount(), 0u);
+	EXPECT_EQ(geometry.GetChunkCount(BlendMode::kNormal), 0u);
+	EXPECT_EQ(geometry.GetCapacityChunkCount(), 2u);
+
+	// 同じ量を溜め直しても確保し直さない
+	geometry.AddLine({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, kWhite);
+	EXPECT_EQ(geometry.GetChunks(BlendMode::kNormal)[0].vertices.get(), first);
+	EXPECT_EQ(geometry.GetChunks(BlendMode::kNormal)[0].vertexCount, 2u);
+	EXPECT_EQ(geometry.GetCapacityChunkCount(), 2u);
+}
+
+TEST(DebugGeometryTest, ShapesDoNotSplitAcrossChunks) {
+	DebugGeometry geometry;
+	// 残り11本のところに12本の箱を足すと次のチャンクに丸ごと入る
+	for (uint32_t i = 0; i < DebugGeometry::kChunkLineCount - 11; i++) {
+		geometry.AddLine({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, kWhite);
+	}
+	geometry.AddAabb({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, kWhite);
+	EXPECT_EQ(geometry.GetChunkCount(BlendMode::kNormal), 2u);
+	EXPECT_EQ(geometry.GetChunks(BlendMode::kNormal)[1].vertexCount, 24u);
+	EXPECT_EQ(geometry.GetLineCount(), DebugGeometry::kChunkLineCount + 1);
+}
@@ -0,0 +1,276 @@
+// DecodeWorkerPoolのテスト（作り物のデコード処理で、順序、統計、スループットを確かめる）
+#include "DecodeWorkerPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// パスから決まったバイト列を作るデコード処理。"missing"を含むパスは失敗にする
+struct MockSource {
+	using Image = std::vector<uint8_t>;
+	using Status = int;
+
+	static constexpr const char* kThreadName = "MockDecoder";
+	static constexpr const char* kScopeName = "MockDecoder::Decode";
+	static constexpr MemoryTracker::Tag kMemoryTag = MemoryTracker::Tag::kTexture;
+
+	static constexpr Status kSucceeded = 0;
+	static constexpr Status kNotFound = -1;
+
+	// 同期デコード（ワーカーの結果と比べる）
+	static Status DecodeNow(const std::wstring& filePath, Image& image) {
+		if (filePath.find(L"missing") != std::wstring::npos) {
+			return kNotFound;
+		}
+		image.resize(filePath.size() * 256);
+		uint32_t hash = 2166136261u;
+		for (wchar_t c : filePath) {
+			hash = (hash ^ uint32_t(c)) * 16777619u;
+		}
+		for (size_t i = 0; i < image.size(); i++) {
+			hash = hash * 1664525u + 1013904223u;
+			image[i] = uint8_t(hash >> 24);
+		}
+		return kSucceeded;
+	}
+
+	Status Decode(const std::wstring& filePath, Image& image) {
+		uint32_t running = ++runningCount;
+		uint32_t maxRunning = maxRunningCount.load();
+		while (maxRunning < running && !maxRunningCount.compare_exchange_weak(maxRunning, running)) {
+		}
+		if (MemoryTracker::GetCurrentTag() != kMemoryTag) {
+			untaggedDecodeCount++;
+		}
+		if (0 < delayMicroseconds.load()) {
+			std::this_thread::sleep_for(std::chrono::microseconds(delayMicroseconds.load()));
+		}
+		Status status = DecodeNow(filePath, image);
+		runningCount--;
+		return status;
+	}
+
+	static bool IsSucceeded(Status status) { return status == kSucceeded; }
+	static uint64_t GetByteSize(const Image& image) { return image.size(); }
+
+	bool BeginWorker() {
+		begunWorkerCount++;
+		return true;
+	}
+	void EndWorker(bool begun) {
+		if (begun) {
+			endedWorkerCount++;
+		}
+	}
+
+	// 1回のデコードに足す待ち時間
+	std::atomic<uint32_t> delayMicroseconds = 0;
+	// 同時にデコードしている数とその最大
+	std::atomic<uint32_t> runningCount = 0;
+	std::atomic<uint32_t> maxRunningCount = 0;
+	// 分類を積まずにデコードした数
+	std::atomic<uint32_t> untaggedDecodeCount = 0;
+	// ワーカーの開始と終了の数
+	std::atomic<uint32_t> begunWorkerCount = 0;
+	std::atomic<uint32_t> endedWorkerCount = 0;
+};
+
+using Pool = DecodeWorkerPool<MockSource>;
+
+// テスト用のパス
+std::wstring MakePath(uint32_t index) {
+	return L"Resources/texture" + std::to_wstring(index) + L".png";
+}
+
+// 積んだ要求を全て待って取り出す
+std::vector<Pool::Result> DecodeAll(Pool& pool, const std::vector<std::wstring>& paths) {
+	for (uint32_t i = 0; i < paths.size(); i++) {
+		pool.Push({i, std::to_string(i), paths[i]});
+	}
+	pool.WaitIdle();
+	EXPECT_FALSE(pool.IsBusy());
+	std::vector<Pool::Result> results;
+	pool.Collect(results);
+	return results;
+}
+
+class DecodeWorkerPoolTest : public testing::TestWithParam<uint32_t> {};
+
+TEST_P(DecodeWorkerPoolTest, WorkersMatchSynchronousDecode) {
+	std::vector<std::wstring> paths;
+	for (uint32_t i = 0; i < 64; i++) {
+		paths.push_back(i % 9 == 4 ? L"missing" + std::to_wstring(i) : MakePath(i));
+	}
+
+	Pool pool;
+	pool.Initialize(GetParam());
+	EXPECT_EQ(pool.GetWorkerCount(), GetParam());
+	std::vector<Pool::Result> results = DecodeAll(pool, paths);
+	ASSERT_EQ(results.size(), paths.size());
+
+	// 各要求の結果がちょうど1つずつ返り、同期デコードと同じ中身になる
+	std::set<uint32_t> handles;
+	for (const Pool::Result& result : results) {
+		ASSERT_LT(result.handle, paths.size());
+		handles.insert(result.handle);
+		EXPECT_EQ(result.name, std::to_string(result.handle));
+		MockSource::Image expected;
+		EXPECT_EQ(result.result, MockSource::DecodeNow(paths[result.handle], expected));
+		EXPECT_EQ(result.image, expected) << result.handle;
+	}
+	EXPECT_EQ(handles.size(), paths.size());
+	EXPECT_EQ(pool.GetSource().untaggedDecodeCount.load(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    WorkerCounts, DecodeWorkerPoolTest, testing::Values(1u, 2u, 4u),
+    [](const testing::TestParamInfo<uint32_t>& info) {
+	    return "Workers" + std::to_string(info.param);
+    });
+
+TEST(DecodeWorkerPoolSingleTest, OneWorkerKeepsPushOrder) {
+	Pool pool;
+	pool.Initialize(1);
+	std::vector<std::wstring> paths;
+	for (uint32_t i = 0; i < 100; i++) {
+		paths.push_back(MakePath(i));
+	}
+	std::vector<Pool::Result> results = DecodeAll(pool, paths);
+	ASSERT_EQ(results.size(), paths.size());
+	for (uint32_t i = 0; i < results.size(); i++) {
+		EXPECT_EQ(results[i].handle, i);
+	}
+	EXPECT_EQ(pool.GetSource().maxRunningCount.load(), 1u);
+}
+
+TEST(DecodeWorkerPoolSingleTest, StatisticsCountOnlySucceededDecodes) {
+	Pool pool;
+	EXPECT_EQ(pool.GetStatistics().GetMegaBytesPerSecond(), 0.0);
+	pool.Initialize(3);
+	std::vector<std::wstring> paths = {MakePath(1), L"missing.png", MakePath(22), MakePath(333)};
+	std::vector<Pool::Result> results = DecodeAll(pool, paths);
+	ASSERT_EQ(results.size(), paths.size());
+
+	uint64_t expectedBytes = 0;
+	for (const std::wstring& path : paths) {
+		MockSource::Image image;
+		if (MockSource::IsSucceeded(MockSource::DecodeNow(path, image))) {
+			expectedBytes += image.size();
+		}
+	}
+	Pool::Statistics statistics = pool.GetStatistics();
+	EXPECT_EQ(statistics.textureCount, 3u);
+	EXPECT_EQ(statistics.decodedBytes, expectedBytes);
+	EXPECT_GE(statistics.seconds, 0.0);
+
+	// MB/sはバイト数と時間の比
+	Pool::Statistics fixed;
+	fixed.decodedBytes = 3 * 1024 * 1024;
+	fixed.seconds = 1.5;
+	EXPECT_DOUBLE_EQ(fixed.GetMegaBytesPerSecond(), 2.0);
+}
+
+TEST(DecodeWorkerPoolSingleTest, Throughput) {
+	// デコード1回に待ちを入れ、ワーカーが重なって動くことと、ワーカー数ごとのMB/sを出す
+	const uint32_t kRequestCount = 48;
+	std::vector<std::wstring> paths;
+	for (uint32_t i = 0; i < kRequestCount; i++) {
+		paths.push_back(MakePath(i));
+	}
+
+	for (uint32_t workerCount : {1u, 2u, 4u}) {
+		Pool pool;
+		pool.GetSource().delayMicroseconds = 2000;
+		pool.Initialize(workerCount);
+		auto start = std::chrono::steady_clock::now();
+		std::vector<Pool::Result> results = DecodeAll(pool, paths);
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		ASSERT_EQ(results.size(), paths.size());
+
+		Pool::Statistics statistics = pool.GetStatistics();
+		EXPECT_EQ(statistics.textureCount, kRequestCount);
+		// 1回ごとの時間の合計は、少なくとも待ちの合計
+		EXPECT_GE(statistics.seconds, kRequestCount * 0.002);
+		double wallMegaBytesPerSecond =
+		    double(statistics.decodedBytes) / (1024.0 * 1024.0) / elapsed.count();
+		std::printf(
+		    "workers %u: %llu textures, %.2f MB/s per worker, %.2f MB/s wall, max concurrent %u\n",
+		    workerCount, static_cast<unsigned long long>(statistics.textureCount),
+		    statistics.GetMegaBytesPerSecond(), wallMegaBytesPerSecond,
+		    pool.GetSource().maxRunningCount.load());
+		RecordProperty(
+		    "megaBytesPerSecond" + std::to_string(workerCount),
+		    std::to_string(wallMegaBytesPerSecond));
+
+		EXPECT_LE(pool.GetSource().maxRunningCount.load(), workerCount);
+		if (1 < workerCount) {
+			// 待ちは重なるので、壁時計の時間は1回ごとの時間の合計より短い
+			EXPECT_GE(pool.GetSource().maxRunningCount.load(), 2u);
+			EXPECT_LT(elapsed.count(), statistics.seconds);
+		}
+	}
+}
+
+TEST(DecodeWorkerPoolSingleTest, DefaultWorkerCountIsAtLeastOne) {
+	// hardware_concurrencyが0を返す環境でも1本は起動する
+	Pool pool;
+	pool.Initialize();
+	EXPECT_GE(pool.GetWorkerCount(), 1u);
+	std::vector<Pool::Result> results = DecodeAll(pool, {MakePath(0)});
+	ASSERT_EQ(results.size(), 1u);
+	EXPECT_TRUE(MockSource::IsSucceeded(results[0].result));
+}
+
+TEST(DecodeWorkerPoolSingleTest, FinalizeDropsPendingRequestsAndEndsWorkers) {
+	Pool pool;
+	pool.GetSource().delayMicroseconds = 5000;
+	pool.Initialize(2);
+	for (uint32_t i = 0; i < 100; i++) {
+		pool.Push({i, std::to_string(i), MakePath(i)});
+	}
+	EXPECT_TRUE(pool.IsBusy());
+
+	// 取り出し済みの要求だけ終えて止まる
+	pool.Finalize();
+	EXPECT_FALSE(pool.IsBusy());
+	EXPECT_EQ(pool.GetWorkerCount(), 0u);
+	EXPECT_LT(pool.GetStatistics().textureCount, 100u);
+	EXPECT_EQ(pool.GetSource().begunWorkerCount.load(), 2u);
+	EXPECT_EQ(pool.GetSource().endedWorkerCount.load(), 2u);
+	std::vector<Pool::Result> results;
+	pool.Collect(results);
+	EXPECT_TRUE(results.empty());
+
+	// 止めた後にまた起動できる
+	pool.GetSource().delayMicroseconds = 0;
+	pool.Initialize(1);
+	EXPECT_EQ(DecodeAll(pool, {MakePath(7)}).size(), 1u);
+	pool.Finalize();
+	EXPECT_EQ(pool.GetSource().begunWorkerCount.load(), 3u);
+	EXPECT_EQ(pool.GetSource().endedWorkerCount.load(), 3u);
+}
+
+TEST(DecodeWorkerPoolSingleTest, CollectMovesResultsOut) {
+	Pool pool;
+	pool.Initialize(2);
+	std::vector<Pool::Result> results = DecodeAll(pool, {MakePath(1), MakePath(2)});
+	EXPECT_EQ(results.size(), 2u);
+
+	// 取り出した結果は残らず、追加先の既存の要素は消さない
+	pool.Collect(results);
+	EXPECT_EQ(results.size(), 2u);
+	pool.Push({5, "5", MakePath(5)});
+	pool.WaitIdle();
+	pool.Collect(results);
+	ASSERT_EQ(results.size(), 3u);
+	EXPECT_EQ(results.back().handle, 5u);
+}
+
+} // namespace
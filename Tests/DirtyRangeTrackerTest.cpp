@@ -0,0 +1,152 @@
+// DirtyRangeTrackerのテスト（フレームごとのマップ済みバッファの代わりにメモリ上の配列へ書く）
+#include "DirtyRangeTracker.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Range = DirtyRangeTracker::Range;
+
+// 書き込み先の数（同時に処理中になりうるフレーム数）
+const uint32_t kCopyCount = 3;
+
+// フレームごとのマップ済みバッファの代わり（未書き込みは-1）
+class MockMappedBuffers {
+public:
+	MockMappedBuffers(uint32_t elementCount, uint32_t copyCount)
+	    : copies_(copyCount, std::vector<int>(elementCount, -1)) {}
+
+	int* GetMappedPointer(uint32_t copy) { return copies_[copy].data(); }
+	const std::vector<int>& GetCopy(uint32_t copy) const { return copies_[copy]; }
+
+private:
+	std::vector<std::vector<int>> copies_;
+};
+
+std::vector<int> MakeSource(uint32_t elementCount) {
+	std::vector<int> source(elementCount);
+	for (uint32_t i = 0; i < elementCount; i++) {
+		source[i] = int(i);
+	}
+	return source;
+}
+
+} // namespace
+
+TEST(DirtyRangeTrackerTest, InitializeMarksEverythingForEveryCopy) {
+	DirtyRangeTracker tracker;
+	tracker.Initialize(200, kCopyCount);
+	EXPECT_EQ(tracker.GetElementCount(), 200u);
+	EXPECT_EQ(tracker.GetCopyCount(), kCopyCount);
+	for (uint32_t copy = 0; copy < kCopyCount; copy++) {
+		const std::vector<Range>& ranges = tracker.Collect(copy);
+		ASSERT_EQ(ranges.size(), 1u);
+		EXPECT_EQ(ranges[0].begin, 0u);
+		EXPECT_EQ(ranges[0].count, 200u);
+		// 取り出したら印は消える
+		EXPECT_TRUE(tracker.Collect(copy).empty());
+	}
+}
+
+TEST(DirtyRangeTrackerTest, CollectMergesRunsAcrossWordBoundaries) {
+	DirtyRangeTracker tracker;
+	tracker.Initialize(200, kCopyCount);
+	for (uint32_t copy = 0; copy < kCopyCount; copy++) {
+		tracker.Collect(copy);
+	}
+	for (uint32_t index : {5u, 6u, 63u, 64u, 65u, 100u, 103u, 199u}) {
+		tracker.Mark(index);
+	}
+
+	std::vector<Range> ranges = tracker.Collect(0);
+	ASSERT_EQ(ranges.size(), 5u);
+	EXPECT_EQ(ranges[0].begin, 5u);
+	EXPECT_EQ(ranges[0].count, 2u);
+	// 64bitの境界をまたいでも1区間
+	EXPECT_EQ(ranges[1].begin, 63u);
+	EXPECT_EQ(ranges[1].count, 3u);
+	EXPECT_EQ(ranges[2].begin, 100u);
+	EXPECT_EQ(ranges[2].count, 1u);
+	EXPECT_EQ(ranges[3].begin, 103u);
+	EXPECT_EQ(ranges[4].begin, 199u);
+
+	// 隙間が小さければ埋めて1区間にする
+	ranges = tracker.Collect(1, 3);
+	ASSERT_EQ(ranges.size(), 4u);
+	EXPECT_EQ(ranges[2].begin, 100u);
+	EXPECT_EQ(ranges[2].count, 4u);
+}
+
+TEST(DirtyRangeTrackerTest, FullWordIsOneRange) {
+	DirtyRangeTracker tracker;
+	tracker.Initialize(128, 1);
+	tracker.Collect(0);
+	tracker.Mark(0, 128);
+	const std::vector<Range>& ranges = tracker.Collect(0);
+	ASSERT_EQ(ranges.size(), 1u);
+	EXPECT_EQ(ranges[0].begin, 0u);
+	EXPECT_EQ(ranges[0].count, 128u);
+}
+
+TEST(DirtyRangeTrackerTest, UploadCopiesOnlyDirtyElements) {
+	DirtyRangeTracker tracker;
+	tracker.Initialize(200, kCopyCount);
+	std::vector<int> source = MakeSource(200);
+	MockMappedBuffers buffers(200, kCopyCount);
+	for (uint32_t copy = 0; copy < 2; copy++) {
+		tracker.Collect(copy);
+	}
+	// 書き込み先2は初期化時の全体の印が残っているので、いったん全部書く
+	EXPECT_EQ(tracker.Upload(2, source.data(), buffers.GetMappedPointer(2), sizeof(int)),
+	          200u * sizeof(int));
+
+	source[5] = 1000;
+	source[6] = 1001;
+	source[199] = 1002;
+	tracker.Mark(5, 2);
+	tracker.Mark(199);
+
+	uint64_t bytes = tracker.Upload(0, source.data(), buffers.GetMappedPointer(0), sizeof(int));
+	EXPECT_EQ(bytes, 3u * sizeof(int));
+	const std::vector<int>& copy0 = buffers.GetCopy(0);
+	EXPECT_EQ(copy0[4], -1);
+	EXPECT_EQ(copy0[5], 1000);
+	EXPECT_EQ(copy0[6], 1001);
+	EXPECT_EQ(copy0[7], -1);
+	EXPECT_EQ(copy0[199], 1002);
+	// 2回目は何も書かない
+	EXPECT_EQ(tracker.Upload(0, source.data(), buffers.GetMappedPointer(0), sizeof(int)), 0u);
+
+	// 隙間を埋める場合は隙間の要素も書く
+	bytes = tracker.Upload(1, source.data(), buffers.GetMappedPointer(1), sizeof(int), 200);
+	EXPECT_EQ(bytes, 195u * sizeof(int));
+	EXPECT_EQ(buffers.GetCopy(1)[100], 100);
+}
+
+TEST(DirtyRangeTrackerTest, RotatingCopiesStayInSyncWithSource) {
+	// 毎フレーム一部を変え、フレーム番号 % kCopyCount の書き込み先へ差分だけ書く
+	const uint32_t elementCount = 1000;
+	DirtyRangeTracker tracker;
+	tracker.Initialize(elementCount, kCopyCount);
+	std::vector<int> source = MakeSource(elementCount);
+	MockMappedBuffers buffers(elementCount, kCopyCount);
+
+	std::mt19937 random(3);
+	uint64_t totalBytes = 0;
+	const uint32_t frameCount = 300;
+	for (uint32_t frame = 0; frame < frameCount; frame++) {
+		for (uint32_t k = 0; k < 10; k++) {
+			uint32_t index = uint32_t(random() % elementCount);
+			source[index] = int(frame * 10000 + k);
+			tracker.Mark(index);
+		}
+		uint32_t copy = frame % kCopyCount;
+		totalBytes +=
+		    tracker.Upload(copy, source.data(), buffers.GetMappedPointer(copy), sizeof(int));
+		// 書いた直後の書き込み先は元データと一致する
+		ASSERT_EQ(buffers.GetCopy(copy), source) << "frame " << frame;
+	}
+	// 全体を毎フレーム書くより大幅に少ない
+	EXPECT_LT(totalBytes, uint64_t(frameCount) * elementCount * sizeof(int) / 10);
+}
@@ -0,0 +1,181 @@
+// FrameSchedulerのテスト（GPUの代わりに、完了させるフェンス値をテストが決める模擬フェンスを使う）
+#include "FrameScheduler.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// 模擬フェンス（Signalは記録するだけ。Waitで待った値まで完了させる）
+class MockFence : public FrameScheduler::Fence {
+public:
+	uint64_t GetCompletedValue() const override { return completedValue; }
+	void Signal(uint64_t value) override { signaledValues.push_back(value); }
+	void Wait(uint64_t value) override {
+		waitedValues.push_back(value);
+		completedValue = value;
+	}
+
+	uint64_t completedValue = 0;
+	std::vector<uint64_t> signaledValues;
+	std::vector<uint64_t> waitedValues;
+};
+
+} // namespace
+
+TEST(FrameSchedulerTest, FrameIndexCyclesAndFenceValuesIncrease) {
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2);
+
+	EXPECT_EQ(scheduler.GetFrameCount(), 2u);
+	EXPECT_EQ(scheduler.GetFrameIndex(), 0u);
+	EXPECT_EQ(scheduler.GetCurrentFenceValue(), 1u);
+
+	for (uint64_t frame = 0; frame < 5; frame++) {
+		EXPECT_EQ(scheduler.GetFrameIndex(), uint32_t(frame % 2));
+		// GPUはすぐ終わる
+		fence.completedValue = scheduler.GetSignaledValue();
+		scheduler.BeginFrame();
+		EXPECT_EQ(scheduler.EndFrame(), frame + 1);
+	}
+	EXPECT_EQ(fence.signaledValues, (std::vector<uint64_t>{1, 2, 3, 4, 5}));
+	EXPECT_TRUE(fence.waitedValues.empty());
+	EXPECT_EQ(scheduler.GetStatistics().frameCount, 5u);
+	EXPECT_EQ(scheduler.GetStatistics().waitCount, 0u);
+}
+
+TEST(FrameSchedulerTest, StartsFromInitialFenceValue) {
+	MockFence fence;
+	fence.completedValue = 10;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2, 10);
+
+	EXPECT_EQ(scheduler.GetCurrentFenceValue(), 11u);
+	scheduler.BeginFrame();
+	EXPECT_EQ(scheduler.EndFrame(), 11u);
+	EXPECT_TRUE(fence.waitedValues.empty());
+}
+
+TEST(FrameSchedulerTest, WaitsOnlyForFrameThatLastUsedTheSlot) {
+	// GPUが何も終えていなくても、2フレーム目までは待たずに記録できる
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2);
+
+	scheduler.BeginFrame();
+	scheduler.EndFrame();
+	scheduler.BeginFrame();
+	scheduler.EndFrame();
+	EXPECT_TRUE(fence.waitedValues.empty());
+
+	// 3フレーム目は0番を使った1フレーム目（フェンス値1）だけを待ち、2フレーム目は待たない
+	scheduler.BeginFrame();
+	EXPECT_EQ(fence.waitedValues, (std::vector<uint64_t>{1}));
+	scheduler.EndFrame();
+
+	// 4フレーム目の前にGPUが2を終えていれば待たない
+	fence.completedValue = 2;
+	scheduler.BeginFrame();
+	scheduler.EndFrame();
+	EXPECT_EQ(fence.waitedValues.size(), 1u);
+	EXPECT_EQ(scheduler.GetStatistics().waitCount, 1u);
+}
+
+TEST(FrameSchedulerTest, SingleFrameWaitsEveryFrame) {
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 1);
+
+	for (int frame = 0; frame < 3; frame++) {
+		scheduler.BeginFrame();
+		scheduler.EndFrame();
+	}
+	// 最初のフレームは待つものがない
+	EXPECT_EQ(fence.waitedValues, (std::vector<uint64_t>{1, 2}));
+}
+
+TEST(FrameSchedulerTest, DeferredTasksRunAfterTheirFrameCompletes) {
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2);
+	std::vector<int> executed;
+
+	scheduler.BeginFrame();
+	scheduler.Defer([&] { executed.push_back(1); });
+	scheduler.EndFrame();
+
+	scheduler.BeginFrame();
+	scheduler.Defer([&] { executed.push_back(2); });
+	EXPECT_EQ(scheduler.GetStatistics().pendingTaskCount, 2u);
+	scheduler.EndFrame();
+
+	// GPUが1フレーム目を終えるまでは実行しない
+	fence.completedValue = 0;
+	scheduler.BeginFrame();
+	// 0番を待つので1フレーム目の処理だけが実行される
+	EXPECT_EQ(executed, (std::vector<int>{1}));
+	EXPECT_EQ(scheduler.GetStatistics().pendingTaskCount, 1u);
+	scheduler.EndFrame();
+
+	fence.completedValue = 2;
+	scheduler.BeginFrame();
+	EXPECT_EQ(executed, (std::vector<int>{1, 2}));
+	EXPECT_EQ(scheduler.GetStatistics().pendingTaskCount, 0u);
+	scheduler.EndFrame();
+}
+
+TEST(FrameSchedulerTest, TaskDeferredFromTaskRunsLater) {
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2);
+	std::vector<int> executed;
+
+	scheduler.BeginFrame();
+	scheduler.Defer([&] {
+		executed.push_back(1);
+		// 実行中に登録した処理は、そのとき記録中のフレームが終わってから
+		scheduler.Defer([&] { executed.push_back(2); });
+	});
+	scheduler.EndFrame();
+
+	fence.completedValue = 1;
+	scheduler.BeginFrame();
+	EXPECT_EQ(executed, (std::vector<int>{1}));
+	scheduler.EndFrame();
+
+	scheduler.WaitForIdle();
+	EXPECT_EQ(executed, (std::vector<int>{1, 2}));
+}
+
+TEST(FrameSchedulerTest, WaitForIdleWaitsForLastSignaledValue) {
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2);
+	bool isExecuted = false;
+
+	scheduler.BeginFrame();
+	scheduler.EndFrame();
+	scheduler.BeginFrame();
+	scheduler.Defer([&] { isExecuted = true; });
+	scheduler.EndFrame();
+
+	scheduler.WaitForIdle();
+	EXPECT_EQ(fence.waitedValues, (std::vector<uint64_t>{2}));
+	EXPECT_TRUE(isExecuted);
+
+	// 終わっていれば待たない
+	scheduler.WaitForIdle();
+	EXPECT_EQ(fence.waitedValues.size(), 1u);
+}
+
+TEST(FrameSchedulerTest, WaitForValueSkipsCompletedValues) {
+	MockFence fence;
+	FrameScheduler scheduler;
+	scheduler.Initialize(&fence, 2);
+	fence.completedValue = 3;
+
+	scheduler.WaitForValue(2);
+	EXPECT_TRUE(fence.waitedValues.empty());
+	scheduler.WaitForValue(5);
+	EXPECT_EQ(fence.waitedValues, (std::vector<uint64_t>{5}));
+}
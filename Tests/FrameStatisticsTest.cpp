@@ -0,0 +1,229 @@
+// FrameStatisticsのテスト（ヒストグラムからの百分位と、引っかかりの記録）
+#include "FrameStatistics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// 区間の集計を作る
+Profiler::ScopeStatistics MakeScope(const char* name, double milliseconds, uint32_t callCount) {
+	Profiler::ScopeStatistics scope;
+	scope.name = name;
+	scope.lastMilliseconds = milliseconds;
+	scope.callCount = callCount;
+	return scope;
+}
+
+TEST(FrameStatisticsTest, EmptyStatisticsAreZero) {
+	FrameStatistics statistics;
+	statistics.Initialize(20.0);
+	FrameStatistics::Summary summary = statistics.GetSummary();
+	EXPECT_EQ(summary.frameCount, 0u);
+	EXPECT_EQ(summary.hitchCount, 0u);
+	EXPECT_EQ(summary.averageMilliseconds, 0.0);
+	EXPECT_EQ(statistics.GetPercentile(50.0), 0.0);
+	EXPECT_TRUE(statistics.GetHitches().empty());
+	EXPECT_EQ(statistics.GetHistogram().size(), size_t(FrameStatistics::kBinCount));
+}
+
+TEST(FrameStatisticsTest, PercentilesOfUniformFrames) {
+	FrameStatistics statistics;
+	statistics.Initialize(20.0);
+	for (int i = 1; i <= 100; i++) {
+		statistics.AddFrame(double(i));
+	}
+
+	// 1区間の幅以内で合う（区間の境目ちょうどの値は丸めでどちらにも入りうる）
+	const double kTolerance = FrameStatistics::kBinMilliseconds + 1e-9;
+	FrameStatistics::Summary summary = statistics.GetSummary();
+	EXPECT_EQ(summary.frameCount, 100u);
+	EXPECT_NEAR(summary.averageMilliseconds, 50.5, 1e-9);
+	EXPECT_NEAR(summary.p50Milliseconds, 50.0, kTolerance);
+	EXPECT_NEAR(summary.p95Milliseconds, 95.0, kTolerance);
+	EXPECT_NEAR(summary.p99Milliseconds, 99.0, kTolerance);
+	EXPECT_EQ(summary.minMilliseconds, 1.0);
+	EXPECT_EQ(summary.maxMilliseconds, 100.0);
+
+	// 端は実測の範囲に収まる
+	EXPECT_EQ(statistics.GetPercentile(0.0), 1.0);
+	EXPECT_EQ(statistics.GetPercentile(100.0), 100.0);
+	EXPECT_EQ(statistics.GetPercentile(-5.0), 1.0);
+	EXPECT_EQ(statistics.GetPercentile(200.0), 100.0);
+}
+
+TEST(FrameStatisticsTest, PercentilesMatchSortedSamples) {
+	FrameStatistics statistics;
+	statistics.Initialize(20.0);
+	std::mt19937 random(1);
+	std::lognormal_distribution<double> distribution(std::log(16.0), 0.2);
+	std::vector<double> samples;
+	for (int i = 0; i < 100000; i++) {
+		samples.push_back(distribution(random));
+		statistics.AddFrame(samples.back());
+	}
+	std::sort(samples.begin(), samples.end());
+
+	for (double percent : {50.0, 95.0, 99.0}) {
+		double exact = samples[size_t(percent / 100.0 * double(samples.size() - 1))];
+		EXPECT_NEAR(statistics.GetPercentile(percent), exact, FrameStatistics::kBinMilliseconds)
+		    << percent;
+	}
+}
+
+TEST(FrameStatisticsTest, HistogramCountsBinsAndClampsOverflow) {
+	FrameStatistics statistics;
+	statistics.Initialize(1000.0);
+	statistics.AddFrame(0.05);
+	statistics.AddFrame(16.66);
+	statistics.AddFrame(-1.0);
+	statistics.AddFrame(1.0e6);
+
+	const std::vector<uint32_t>& histogram = statistics.GetHistogram();
+	EXPECT_EQ(histogram[0], 2u);
+	EXPECT_EQ(histogram[166], 1u);
+	EXPECT_EQ(histogram[FrameStatistics::kBinCount - 1], 1u);
+
+	// 最後の区間の上端は実測の最大
+	FrameStatistics::Summary summary = statistics.GetSummary();
+	EXPECT_EQ(summary.minMilliseconds, 0.0);
+	EXPECT_EQ(summary.maxMilliseconds, 1.0e6);
+	EXPECT_EQ(statistics.GetPercentile(100.0), 1.0e6);
+}
+
+TEST(FrameStatisticsTest, HitchesKeepLatestFramesOverBudget) {
+	FrameStatistics statistics;
+	statistics.Initialize(20.0);
+	for (int i = 1; i <= 100; i++) {
+		statistics.AddFrame(double(i));
+	}
+
+	// 予算ちょうどは引っかかりにしない。21～100msの80件のうち直近kMaxHitchCount件が残る
+	EXPECT_EQ(statistics.GetSummary().hitchCount, 80u);
+	std::vector<FrameStatistics::Hitch> hitches = statistics.GetHitches();
+	ASSERT_EQ(hitches.size(), size_t(FrameStatistics::kMaxHitchCount));
+	EXPECT_EQ(hitches.front().frameIndex, 100u - FrameStatistics::kMaxHitchCount);
+	EXPECT_EQ(hitches.back().frameIndex, 99u);
+	for (size_t i = 0; i < hitches.size(); i++) {
+		EXPECT_EQ(hitches[i].milliseconds, double(hitches[i].frameIndex + 1));
+		EXPECT_EQ(hitches[i].scopeCount, 0u);
+	}
+}
+
+TEST(FrameStatisticsTest, HitchKeepsLongestCalledScopes) {
+	FrameStatistics statistics;
+	statistics.Initialize(16.0);
+	const char* names[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i"};
+	std::vector<Profiler::ScopeStatistics> scopes;
+	for (uint32_t i = 0; i < 9; i++) {
+		scopes.push_back(MakeScope(names[i], double((i * 7) % 9), i == 4 ? 0 : 1 + i % 2));
+	}
+
+	// 予算内のフレームは区間を見ない
+	statistics.AddFrame(10.0, scopes);
+	EXPECT_TRUE(statistics.GetHitches().empty());
+
+	statistics.AddFrame(30.0, scopes);
+	std::vector<FrameStatistics::Hitch> hitches = statistics.GetHitches();
+	ASSERT_EQ(hitches.size(), 1u);
+	const FrameStatistics::Hitch& hitch = hitches[0];
+	EXPECT_EQ(hitch.frameIndex, 1u);
+	ASSERT_EQ(hitch.scopeCount, FrameStatistics::kMaxHitchScopeCount);
+
+	// 長い順で、そのフレームに呼ばれなかった区間（e）は入らない
+	// 時間は a0 b7 c5 d3 e1 f8 g6 h4 i2 なので f b g c h d
+	const char* expected[] = {"f", "b", "g", "c", "h", "d"};
+	for (uint32_t i = 0; i < hitch.scopeCount; i++) {
+		EXPECT_EQ(hitch.scopes[i].name, expected[i]) << i;
+	}
+	EXPECT_EQ(hitch.scopes[0].milliseconds, 8.0);
+	EXPECT_EQ(hitch.scopes[0].callCount, 2u);
+	EXPECT_EQ(hitch.scopes[1].callCount, 2u);
+	EXPECT_EQ(hitch.scopes[2].callCount, 1u);
+}
+
+TEST(FrameStatisticsTest, HitchCarriesScopesRecordedByProfiler) {
+	// リリースビルドも区間を残しているので、計測を有効にすれば引っかかりに内訳が付く
+	Profiler* profiler = Profiler::GetInstance();
+	Profiler::SetEnabled(false);
+	profiler->EndFrame();
+	profiler->Reset();
+
+	FrameStatistics statistics;
+	statistics.Initialize(16.0);
+	// 計測が無効の間は区間が無い
+	{
+		PROFILE_SCOPE("FrameStatisticsTest::Update");
+	}
+	profiler->EndFrame();
+	statistics.AddFrame(30.0, profiler->GetScopeStatistics());
+
+	Profiler::SetEnabled(true);
+	{
+		PROFILE_SCOPE("FrameStatisticsTest::Update");
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	for (int i = 0; i < 3; i++) {
+		PROFILE_SCOPE("FrameStatisticsTest::Draw");
+	}
+	profiler->EndFrame();
+	statistics.AddFrame(30.0, profiler->GetScopeStatistics());
+	Profiler::SetEnabled(false);
+
+	std::vector<FrameStatistics::Hitch> hitches = statistics.GetHitches();
+	ASSERT_EQ(hitches.size(), 2u);
+	EXPECT_EQ(hitches[0].scopeCount, 0u);
+	ASSERT_EQ(hitches[1].scopeCount, 2u);
+	EXPECT_EQ(hitches[1].scopes[0].name, "FrameStatisticsTest::Update");
+	EXPECT_GE(hitches[1].scopes[0].milliseconds, 5.0);
+	EXPECT_EQ(hitches[1].scopes[0].callCount, 1u);
+	EXPECT_EQ(hitches[1].scopes[1].name, "FrameStatisticsTest::Draw");
+	EXPECT_EQ(hitches[1].scopes[1].callCount, 3u);
+	EXPECT_NE(
+	    statistics.FormatReport().find("  frame 1: 30.00 ms | FrameStatisticsTest::Update "),
+	    std::string::npos);
+}
+
+TEST(FrameStatisticsTest, InitializeDiscardsStatistics) {
+	FrameStatistics statistics;
+	statistics.Initialize(20.0);
+	statistics.AddFrame(50.0);
+	statistics.Initialize(10.0);
+	EXPECT_EQ(statistics.GetBudgetMilliseconds(), 10.0);
+	EXPECT_EQ(statistics.GetSummary().frameCount, 0u);
+	EXPECT_EQ(statistics.GetSummary().hitchCount, 0u);
+	EXPECT_TRUE(statistics.GetHitches().empty());
+	const std::vector<uint32_t>& histogram = statistics.GetHistogram();
+	EXPECT_EQ(size_t(std::count(histogram.begin(), histogram.end(), 0u)), histogram.size());
+}
+
+TEST(FrameStatisticsTest, ReportListsSummaryAndHitches) {
+	FrameStatistics statistics;
+	statistics.Initialize(16.0);
+	statistics.AddFrame(10.0);
+	statistics.AddFrame(40.0, {MakeScope("Update", 30.0, 1), MakeScope("Draw", 5.0, 3)});
+
+	std::string report = statistics.FormatReport();
+	EXPECT_NE(report.find("frames 2, avg 25.00 ms"), std::string::npos) << report;
+	EXPECT_NE(report.find("hitches over 16.00 ms: 1 (last 1 kept)"), std::string::npos) << report;
+	EXPECT_NE(report.find("  frame 1: 40.00 ms | Update 30.00, Draw 5.00 x3\n"), std::string::npos)
+	    << report;
+
+	std::filesystem::path path =
+	    std::filesystem::temp_directory_path() / "FrameStatisticsTestReport.txt";
+	ASSERT_TRUE(statistics.WriteReport(path.string()));
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream text;
+	text << file.rdbuf();
+	file.close();
+	std::filesystem::remove(path);
+	EXPECT_EQ(text.str(), report);
+}
+
+} // namespace
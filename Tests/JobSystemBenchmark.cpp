@@ -0,0 +1,69 @@
+// ジョブシステムの計測（スレッド数を1から増やしたときの伸びと、1ジョブあたりの手間）
+#include "JobSystem.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// 計算が重い要素ごとの処理（メモリ帯域で頭打ちにならないようにする）
+void ComputeElements(std::vector<float>& data, uint32_t begin, uint32_t end) {
+	for (uint32_t i = begin; i < end; i++) {
+		float x = float(i) * 1.0e-4f;
+		for (int k = 0; k < 16; k++) {
+			x = std::sin(x) + 0.5f;
+		}
+		data[i] = x;
+	}
+}
+
+// 呼び出し元を含めたスレッド数1～N（Nはハードウェアのスレッド数、少なくとも8）
+void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+	uint32_t maxWorkerCount = std::max(JobSystem::GetDefaultWorkerCount(), 7u);
+	for (uint32_t workerCount = 0; workerCount <= maxWorkerCount; workerCount++) {
+		benchmark->Arg(workerCount);
+	}
+}
+
+// ParallelForの伸び（ワーカー数0が1スレッドの基準）
+void BM_ParallelForScaling(benchmark::State& state) {
+	const uint32_t kCount = 1 << 20;
+	const uint32_t kGrainSize = 4096;
+	JobSystem jobSystem;
+	jobSystem.Initialize(uint32_t(state.range(0)));
+	std::vector<float> data(kCount);
+	auto function = [&](uint32_t begin, uint32_t end) { ComputeElements(data, begin, end); };
+
+	for (auto _ : state) {
+		jobSystem.ParallelFor(kCount, kGrainSize, function);
+		benchmark::DoNotOptimize(data.data());
+		benchmark::ClobberMemory();
+	}
+	jobSystem.Finalize();
+
+	state.counters["threads"] = double(state.range(0) + 1);
+	state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+// ワーカーの時間も入るよう経過時間で計る
+BENCHMARK(BM_ParallelForScaling)
+    ->Apply(ThreadCounts)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// 空のジョブを細かく分けたときの1ジョブあたりの手間（ワーカー数0は分けずに呼ぶだけなので計らない）
+void BM_JobOverhead(benchmark::State& state) {
+	const uint32_t kJobCount = 64;
+	JobSystem jobSystem;
+	jobSystem.Initialize(uint32_t(state.range(0)));
+
+	for (auto _ : state) {
+		jobSystem.ParallelFor(kJobCount, 1, [](uint32_t, uint32_t) {});
+	}
+	jobSystem.Finalize();
+
+	state.SetItemsProcessed(int64_t(state.iterations()) * kJobCount);
+}
+BENCHMARK(BM_JobOverhead)->Arg(1)->Arg(3)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,196 @@
+// JobSystemのテスト（ワーカー数を変えて、分割の漏れ、依存の順序、カウンタの待ちを確かめる）
+#include "JobSystem.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// ワーカー数ごとに作り直す
+class JobSystemTest : public testing::TestWithParam<uint32_t> {
+protected:
+	void SetUp() override { jobSystem_.Initialize(GetParam()); }
+	void TearDown() override { jobSystem_.Finalize(); }
+
+	JobSystem jobSystem_;
+};
+
+TEST_P(JobSystemTest, ParallelForVisitsEveryIndexOnce) {
+	for (uint32_t count : {0u, 1u, 7u, 1000u, 100003u}) {
+		for (uint32_t grainSize : {1u, 3u, 64u, 5000u}) {
+			std::vector<std::atomic<int>> visits(count);
+			// ワーカーがいなければ全体を1回で呼ぶ
+			uint32_t maxRange = GetParam() > 0 ? grainSize : count;
+			std::atomic<int> badRanges = 0;
+			jobSystem_.ParallelFor(count, grainSize, [&](uint32_t begin, uint32_t end) {
+				if (begin >= end || end > count || end - begin > maxRange) {
+					badRanges++;
+					return;
+				}
+				for (uint32_t i = begin; i < end; i++) {
+					visits[i]++;
+				}
+			});
+			EXPECT_EQ(badRanges.load(), 0) << count << " " << grainSize;
+			int missed = 0;
+			for (const std::atomic<int>& visit : visits) {
+				missed += visit.load() != 1;
+			}
+			EXPECT_EQ(missed, 0) << count << " " << grainSize;
+		}
+	}
+}
+
+TEST_P(JobSystemTest, NestedParallelFor) {
+	// ジョブの中から積んで待っても、待つ側が実行を手伝うので止まらない
+	std::atomic<uint64_t> sum = 0;
+	jobSystem_.ParallelFor(64, 1, [&](uint32_t outerBegin, uint32_t outerEnd) {
+		for (uint32_t outer = outerBegin; outer < outerEnd; outer++) {
+			jobSystem_.ParallelFor(1000, 10, [&](uint32_t begin, uint32_t end) {
+				uint64_t partial = 0;
+				for (uint32_t i = begin; i < end; i++) {
+					partial += i + outer;
+				}
+				sum += partial;
+			});
+		}
+	});
+
+	uint64_t expected = 0;
+	for (uint32_t outer = 0; outer < 64; outer++) {
+		for (uint32_t i = 0; i < 1000; i++) {
+			expected += i + outer;
+		}
+	}
+	EXPECT_EQ(sum.load(), expected);
+}
+
+TEST_P(JobSystemTest, RunCountsJobsAndWaitRunsThem) {
+	JobSystem::Statistics before = jobSystem_.GetStatistics();
+	std::vector<std::atomic<int>> results(100);
+	auto function = [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++) {
+			results[i] += int(i);
+		}
+	};
+
+	// 1つずつとまとめての両方を同じカウンタで待つ
+	JobSystem::Counter counter;
+	std::vector<JobSystem::Job> jobs;
+	for (uint32_t i = 0; i < 90; i += 10) {
+		jobs.push_back(JobSystem::MakeJob(function, i, i + 10));
+	}
+	jobSystem_.Run(jobs.data(), uint32_t(jobs.size()), &counter);
+	jobSystem_.Run(JobSystem::MakeJob(function, 90, 100), &counter);
+	jobSystem_.Run(nullptr, 0, &counter);
+	jobSystem_.Wait(counter);
+	EXPECT_TRUE(counter.IsDone());
+
+	for (uint32_t i = 0; i < 100; i++) {
+		EXPECT_EQ(results[i].load(), int(i));
+	}
+	JobSystem::Statistics after = jobSystem_.GetStatistics();
+	EXPECT_EQ(after.executedJobCount - before.executedJobCount, 10u);
+	EXPECT_LE(after.stolenJobCount - before.stolenJobCount, 10u);
+	if (GetParam() == 0) {
+		// 横取りする相手がいない
+		EXPECT_EQ(after.stolenJobCount, before.stolenJobCount);
+	}
+}
+
+TEST_P(JobSystemTest, RunAfterOrdersStages) {
+	for (int repeat = 0; repeat < 100; repeat++) {
+		std::vector<int> stages(100, 0);
+		std::atomic<int> outOfOrder = 0;
+		auto first = [&](uint32_t i, uint32_t) { stages[i] = 1; };
+		auto second = [&](uint32_t i, uint32_t) {
+			if (stages[i] != 1) {
+				outOfOrder++;
+			}
+			stages[i] = 2;
+		};
+		auto last = [&](uint32_t, uint32_t) {
+			for (int stage : stages) {
+				if (stage != 2) {
+					outOfOrder++;
+				}
+			}
+		};
+
+		JobSystem::Counter firstCounter;
+		JobSystem::Counter secondCounter;
+		JobSystem::Counter lastCounter;
+		std::vector<JobSystem::Job> firstJobs;
+		for (uint32_t i = 0; i < 100; i++) {
+			firstJobs.push_back(JobSystem::MakeJob(first, i, i + 1));
+		}
+		jobSystem_.Run(firstJobs.data(), uint32_t(firstJobs.size()), &firstCounter);
+		for (uint32_t i = 0; i < 100; i++) {
+			jobSystem_.RunAfter(firstCounter, JobSystem::MakeJob(second, i, i + 1), &secondCounter);
+		}
+		jobSystem_.RunAfter(secondCounter, JobSystem::MakeJob(last), &lastCounter);
+
+		// 最後の段を待てば、前の段も終わっている
+		jobSystem_.Wait(lastCounter);
+		EXPECT_TRUE(firstCounter.IsDone());
+		EXPECT_TRUE(secondCounter.IsDone());
+		jobSystem_.Wait(firstCounter);
+		jobSystem_.Wait(secondCounter);
+		ASSERT_EQ(outOfOrder.load(), 0) << repeat;
+	}
+}
+
+TEST_P(JobSystemTest, RunAfterDoneCounterRunsImmediately) {
+	JobSystem::Counter done;
+	EXPECT_TRUE(done.IsDone());
+
+	int runCount = 0;
+	auto function = [&](uint32_t, uint32_t) { runCount++; };
+	JobSystem::Counter counter;
+	jobSystem_.RunAfter(done, JobSystem::MakeJob(function), &counter);
+	jobSystem_.Wait(counter);
+	EXPECT_EQ(runCount, 1);
+}
+
+TEST_P(JobSystemTest, WorkersRunJobsWithoutWaiting) {
+	if (GetParam() == 0) {
+		GTEST_SKIP() << "no workers";
+	}
+	// 待たずに積んだだけのジョブも、寝ているワーカーが起きて実行する
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	std::atomic<int> runCount = 0;
+	auto function = [&](uint32_t, uint32_t) { runCount++; };
+	JobSystem::Counter counter;
+	for (int i = 0; i < 8; i++) {
+		jobSystem_.Run(JobSystem::MakeJob(function), &counter);
+	}
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (!counter.IsDone() && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_TRUE(counter.IsDone());
+	jobSystem_.Wait(counter);
+	EXPECT_EQ(runCount.load(), 8);
+}
+
+TEST_P(JobSystemTest, ReinitializeAfterFinalize) {
+	jobSystem_.Finalize();
+	EXPECT_EQ(jobSystem_.GetWorkerCount(), 0u);
+	jobSystem_.Initialize(GetParam());
+	EXPECT_EQ(jobSystem_.GetWorkerCount(), GetParam());
+
+	std::atomic<uint32_t> sum = 0;
+	jobSystem_.ParallelFor(100, 7, [&](uint32_t begin, uint32_t end) { sum += end - begin; });
+	EXPECT_EQ(sum.load(), 100u);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    WorkerCounts, JobSystemTest, testing::Values(0u, 1u, 3u, 8u),
+    [](const testing::TestParamInfo<uint32_t>& info) {
+	    return "Workers" + std::to_string(info.param);
+    });
+
+} // namespace
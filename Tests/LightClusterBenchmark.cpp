@@ -0,0 +1,41 @@
+// LightClusterの計測（1万個の点光源を16x9x24の格子に割り当てる）
+#include "LightCluster.h"
+#include "MyMath.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+void BM_Build(benchmark::State& state) {
+	uint32_t lightCount = uint32_t(state.range(0));
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distributionX(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> distributionZ(-5.0f, 150.0f);
+	std::uniform_real_distribution<float> distributionRadius(0.5f, 4.0f);
+	std::vector<LightCluster::PointLight> lights(lightCount);
+	for (LightCluster::PointLight& light : lights) {
+		light.position = {
+		    distributionX(random), distributionX(random) * 0.5f, distributionZ(random)};
+		light.radius = distributionRadius(random);
+	}
+
+	LightCluster::Frustum frustum;
+	frustum.matView = MakeIdentity4x4();
+	frustum.fovAngleY = 45.0f * 3.14159265f / 180.0f;
+	frustum.aspectRatio = 16.0f / 9.0f;
+	frustum.nearZ = 0.1f;
+	frustum.farZ = 1000.0f;
+
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	for (auto _ : state) {
+		lightCluster.Build(frustum, lights.data(), lightCount);
+		benchmark::DoNotOptimize(lightCluster.GetLightIndices().data());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * lightCount);
+	state.counters["indices"] = double(lightCluster.GetStatistics().indexCount);
+}
+BENCHMARK(BM_Build)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,217 @@
+// LightClusterのテスト（球の中の点が入る格子には必ずその光源が載っていることを総当たりで確かめる）
+#include "LightCluster.h"
+#include "MyMath.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 原点から+zを見るカメラ
+LightCluster::Frustum MakeFrustum() {
+	LightCluster::Frustum frustum;
+	frustum.matView = MakeIdentity4x4();
+	frustum.fovAngleY = 45.0f * 3.14159265f / 180.0f;
+	frustum.aspectRatio = 16.0f / 9.0f;
+	frustum.nearZ = 0.1f;
+	frustum.farZ = 1000.0f;
+	return frustum;
+}
+
+std::vector<LightCluster::PointLight> MakeRandomLights(uint32_t count) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distributionX(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> distributionZ(-5.0f, 150.0f);
+	std::uniform_real_distribution<float> distributionRadius(0.5f, 4.0f);
+	std::vector<LightCluster::PointLight> lights(count);
+	for (LightCluster::PointLight& light : lights) {
+		light.position = {
+		    distributionX(random), distributionX(random) * 0.5f, distributionZ(random)};
+		light.radius = distributionRadius(random);
+	}
+	return lights;
+}
+
+// 格子cluster（番号）の一覧にライトlightがあるか
+bool ClusterContains(const LightCluster& lightCluster, uint32_t cluster, uint32_t light) {
+	const LightCluster::Cluster& range = lightCluster.GetClusters()[cluster];
+	const std::vector<uint32_t>& indices = lightCluster.GetLightIndices();
+	for (uint32_t j = 0; j < range.count; j++) {
+		if (indices[range.offset + j] == light) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// ビュー空間の点が入る格子番号（視錐台の外ならfalse）
+bool FindCluster(
+    const LightCluster& lightCluster, const LightCluster::Frustum& frustum, const Vector3& point,
+    uint32_t& cluster) {
+	float tanHalfY = std::tan(frustum.fovAngleY * 0.5f);
+	float tanHalfX = tanHalfY * frustum.aspectRatio;
+	if (point.z <= frustum.nearZ || point.z >= frustum.farZ) {
+		return false;
+	}
+	float ndcX = point.x / (point.z * tanHalfX);
+	float ndcY = point.y / (point.z * tanHalfY);
+	if (std::fabs(ndcX) >= 1.0f || std::fabs(ndcY) >= 1.0f) {
+		return false;
+	}
+	uint32_t x = uint32_t((ndcX + 1.0f) * 0.5f * float(lightCluster.GetTileCountX()));
+	uint32_t y = uint32_t((1.0f - ndcY) * 0.5f * float(lightCluster.GetTileCountY()));
+	cluster = lightCluster.GetClusterIndex(x, y, lightCluster.GetSliceIndex(point.z));
+	return true;
+}
+
+} // namespace
+
+TEST(LightClusterTest, SliceIndexFollowsLogFormulaAndClamps) {
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	LightCluster::Frustum frustum = MakeFrustum();
+	lightCluster.Build(frustum, nullptr, 0);
+
+	EXPECT_EQ(lightCluster.GetSliceIndex(0.0f), 0u);
+	EXPECT_EQ(lightCluster.GetSliceIndex(frustum.nearZ), 0u);
+	EXPECT_EQ(lightCluster.GetSliceIndex(1e6f), lightCluster.GetSliceCount() - 1);
+
+	// シェーダと同じ式で、奥へ行くほど増える
+	uint32_t previous = 0;
+	for (float z = 0.2f; z < frustum.farZ; z *= 1.1f) {
+		uint32_t slice = lightCluster.GetSliceIndex(z);
+		float expected = std::floor(
+		    std::log(z) * lightCluster.GetSliceScale() + lightCluster.GetSliceBias());
+		EXPECT_EQ(slice, uint32_t(expected)) << z;
+		EXPECT_GE(slice, previous);
+		previous = slice;
+	}
+}
+
+TEST(LightClusterTest, EveryPointInsideLightLandsInClusterListingIt) {
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	LightCluster::Frustum frustum = MakeFrustum();
+	std::vector<LightCluster::PointLight> lights = MakeRandomLights(10000);
+	lightCluster.Build(frustum, lights.data(), uint32_t(lights.size()));
+	ASSERT_EQ(lightCluster.GetStatistics().droppedIndexCount, 0u);
+
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	uint32_t checkedCount = 0;
+	for (uint32_t i = 0; i < 2000; i++) {
+		const LightCluster::PointLight& light = lights[i];
+		for (uint32_t k = 0; k < 50; k++) {
+			Vector3 offset = {
+			    distribution(random) * light.radius, distribution(random) * light.radius,
+			    distribution(random) * light.radius};
+			if (LengthSquared(offset) > light.radius * light.radius) {
+				continue;
+			}
+			uint32_t cluster = 0;
+			if (!FindCluster(lightCluster, frustum, light.position + offset, cluster)) {
+				continue;
+			}
+			ASSERT_TRUE(ClusterContains(lightCluster, cluster, i)) << "light " << i;
+			checkedCount++;
+		}
+	}
+	EXPECT_GT(checkedCount, 10000u);
+}
+
+TEST(LightClusterTest, ClusterListsAreContiguousAndAscending) {
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	std::vector<LightCluster::PointLight> lights = MakeRandomLights(10000);
+	lightCluster.Build(MakeFrustum(), lights.data(), uint32_t(lights.size()));
+
+	const LightCluster::Statistics& statistics = lightCluster.GetStatistics();
+	const std::vector<uint32_t>& indices = lightCluster.GetLightIndices();
+	uint32_t offset = 0;
+	uint32_t maxCount = 0;
+	for (const LightCluster::Cluster& cluster : lightCluster.GetClusters()) {
+		EXPECT_EQ(cluster.offset, offset);
+		for (uint32_t j = 1; j < cluster.count; j++) {
+			EXPECT_LT(indices[cluster.offset + j - 1], indices[cluster.offset + j]);
+		}
+		offset += cluster.count;
+		maxCount = std::max(maxCount, cluster.count);
+	}
+	EXPECT_EQ(offset, statistics.indexCount);
+	EXPECT_EQ(indices.size(), size_t(statistics.indexCount));
+	EXPECT_EQ(maxCount, statistics.maxClusterLightCount);
+	EXPECT_EQ(statistics.lightCount, 10000u);
+	EXPECT_LT(statistics.visibleLightCount, statistics.lightCount);
+}
+
+TEST(LightClusterTest, LightsOutsideFrustumAreCulled) {
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	std::vector<LightCluster::PointLight> lights(4);
+	// カメラの後ろ、奥の限界より遠く、横にはみ出す、手前の限界をまたぐ
+	lights[0].position = {0.0f, 0.0f, -5.0f};
+	lights[1].position = {0.0f, 0.0f, 2000.0f};
+	lights[2].position = {500.0f, 0.0f, 10.0f};
+	lights[3].position = {0.0f, 0.0f, 0.0f};
+	lightCluster.Build(MakeFrustum(), lights.data(), uint32_t(lights.size()));
+
+	EXPECT_EQ(lightCluster.GetStatistics().visibleLightCount, 1u);
+	for (uint32_t index : lightCluster.GetLightIndices()) {
+		EXPECT_EQ(index, 3u);
+	}
+	// 手前の限界をまたぐ光源は最初のスライスだけに載る
+	for (uint32_t cluster = 0; cluster < lightCluster.GetClusterCount(); cluster++) {
+		uint32_t slice = cluster / (lightCluster.GetTileCountX() * lightCluster.GetTileCountY());
+		if (lightCluster.GetClusters()[cluster].count > 0) {
+			EXPECT_LT(slice, lightCluster.GetSliceIndex(1.0f) + 1);
+		}
+	}
+}
+
+TEST(LightClusterTest, SmallLightTouchesFewClusters) {
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	LightCluster::PointLight light;
+	light.position = {0.3f, 0.2f, 50.0f};
+	light.radius = 0.5f;
+	lightCluster.Build(MakeFrustum(), &light, 1);
+	// 奥行き1スライス程度、画面の1～2タイル四方に収まる
+	EXPECT_GE(lightCluster.GetStatistics().indexCount, 1u);
+	EXPECT_LE(lightCluster.GetStatistics().indexCount, 8u);
+}
+
+TEST(LightClusterTest, ViewMatrixMovesLightsIntoViewSpace) {
+	LightCluster lightCluster;
+	lightCluster.Initialize();
+	// カメラを+z方向に100進めると、z=50の光源は後ろになる
+	LightCluster::Frustum frustum = MakeFrustum();
+	frustum.matView = MakeTranslateMatrix({0.0f, 0.0f, -100.0f});
+	LightCluster::PointLight lights[2];
+	lights[0].position = {0.0f, 0.0f, 50.0f};
+	lights[1].position = {0.0f, 0.0f, 150.0f};
+	lightCluster.Build(frustum, lights, 2);
+
+	EXPECT_EQ(lightCluster.GetStatistics().visibleLightCount, 1u);
+	uint32_t cluster = 0;
+	ASSERT_TRUE(FindCluster(lightCluster, frustum, {0.0f, 0.0f, 50.0f}, cluster));
+	EXPECT_TRUE(ClusterContains(lightCluster, cluster, 1));
+	EXPECT_FALSE(ClusterContains(lightCluster, cluster, 0));
+}
+
+TEST(LightClusterTest, IndicesBeyondCapacityAreDropped) {
+	LightCluster lightCluster;
+	lightCluster.Initialize(
+	    LightCluster::kDefaultTileCountX, LightCluster::kDefaultTileCountY,
+	    LightCluster::kDefaultSliceCount, 100);
+	std::vector<LightCluster::PointLight> lights = MakeRandomLights(10000);
+	lightCluster.Build(MakeFrustum(), lights.data(), uint32_t(lights.size()));
+
+	const LightCluster::Statistics& statistics = lightCluster.GetStatistics();
+	EXPECT_EQ(statistics.indexCount, 100u);
+	EXPECT_GT(statistics.droppedIndexCount, 0u);
+	EXPECT_EQ(lightCluster.GetLightIndices().size(), 100u);
+	for (const LightCluster::Cluster& cluster : lightCluster.GetClusters()) {
+		EXPECT_LE(cluster.offset + cluster.count, 100u);
+	}
+}
@@ -0,0 +1,82 @@
+// LinearAllocatorのテスト（配置、容量不足、フェンス値による領域の再利用）
+#include "LinearAllocator.h"
+#include <gtest/gtest.h>
+
+TEST(LinearAllocatorTest, AllocatesAlignedOffsetsFromRegionStart) {
+	LinearAllocator allocator;
+	allocator.Initialize(2, 1024);
+	ASSERT_TRUE(allocator.BeginFrame(0));
+	EXPECT_EQ(allocator.GetRegionIndex(), 0u);
+
+	EXPECT_EQ(allocator.Allocate(10, 256), 0u);
+	EXPECT_EQ(allocator.Allocate(10, 256), 256u);
+	EXPECT_EQ(allocator.Allocate(4, 4), 268u);
+	EXPECT_EQ(allocator.Allocate(1, 16), 272u);
+	allocator.EndFrame(1);
+
+	const LinearAllocator::Statistics& statistics = allocator.GetStatistics();
+	EXPECT_EQ(statistics.allocationCount, 4u);
+	EXPECT_EQ(statistics.requestedBytes, 25u);
+	EXPECT_EQ(statistics.usedBytes, 273u);
+	EXPECT_EQ(statistics.failedCount, 0u);
+}
+
+TEST(LinearAllocatorTest, FailsWhenRegionIsFull) {
+	LinearAllocator allocator;
+	allocator.Initialize(1, 1024);
+	ASSERT_TRUE(allocator.BeginFrame(0));
+
+	EXPECT_EQ(allocator.Allocate(1024, 256), 0u);
+	EXPECT_EQ(allocator.Allocate(1, 1), LinearAllocator::kInvalidOffset);
+	allocator.EndFrame(1);
+
+	ASSERT_TRUE(allocator.BeginFrame(1));
+	// 配置調整で溢れる場合も失敗し、使用量は変わらない
+	EXPECT_EQ(allocator.Allocate(800, 256), 0u);
+	EXPECT_EQ(allocator.Allocate(200, 256), LinearAllocator::kInvalidOffset);
+	EXPECT_EQ(allocator.Allocate(224, 1), 800u);
+	allocator.EndFrame(2);
+
+	const LinearAllocator::Statistics& statistics = allocator.GetStatistics();
+	EXPECT_EQ(statistics.allocationCount, 2u);
+	EXPECT_EQ(statistics.usedBytes, 1024u);
+	EXPECT_EQ(statistics.failedCount, 1u);
+}
+
+TEST(LinearAllocatorTest, ReusesRegionOnlyAfterItsFenceCompletes) {
+	LinearAllocator allocator;
+	allocator.Initialize(2, 1024);
+
+	ASSERT_TRUE(allocator.BeginFrame(0));
+	allocator.Allocate(512, 256);
+	allocator.EndFrame(1);
+
+	ASSERT_TRUE(allocator.BeginFrame(0));
+	EXPECT_EQ(allocator.GetRegionIndex(), 1u);
+	// 別の領域なので前のフレームの割り当てと重ならない
+	EXPECT_EQ(allocator.Allocate(1024, 256), 0u);
+	allocator.EndFrame(2);
+
+	// 0番の領域はフェンス値1が終わるまで使えない
+	EXPECT_FALSE(allocator.BeginFrame(0));
+	EXPECT_EQ(allocator.GetNextRegionFenceValue(), 1u);
+	ASSERT_TRUE(allocator.BeginFrame(1));
+	EXPECT_EQ(allocator.GetRegionIndex(), 0u);
+	// 再利用した領域は先頭から
+	EXPECT_EQ(allocator.Allocate(16, 256), 0u);
+	allocator.EndFrame(3);
+}
+
+TEST(LinearAllocatorTest, StatisticsResetEachFrame) {
+	LinearAllocator allocator;
+	allocator.Initialize(3, 4096);
+	for (uint64_t frame = 0; frame < 6; frame++) {
+		ASSERT_TRUE(allocator.BeginFrame(frame));
+		for (uint64_t i = 0; i <= frame; i++) {
+			allocator.Allocate(64, 256);
+		}
+		allocator.EndFrame(frame + 1);
+		EXPECT_EQ(allocator.GetStatistics().allocationCount, frame + 1);
+		EXPECT_EQ(allocator.GetStatistics().usedBytes, frame * 256 + 64);
+	}
+}
@@ -0,0 +1,30 @@
+// MEMORY_TRACKER_DISABLEDを定義したビルド（リリース）のMemoryTrackerのテスト
+#include "MemoryTracker.h"
+#include <gtest/gtest.h>
+
+#ifndef MEMORY_TRACKER_DISABLED
+#error "MemoryTrackerDisabledTest must be built with MEMORY_TRACKER_DISABLED"
+#endif
+
+namespace {
+
+// 確保を最適化で消されないよう、ポインタを外に出す
+void* volatile gEscaped = nullptr;
+
+TEST(MemoryTrackerDisabledTest, IsDisabled) { EXPECT_FALSE(MemoryTracker::IsEnabled()); }
+
+TEST(MemoryTrackerDisabledTest, NewIsNotReplacedAndTagsAreNotPushed) {
+	MemoryTracker::TagStatistics before = MemoryTracker::GetTotalStatistics();
+	{
+		MEMORY_TAG_SCOPE(MemoryTracker::Tag::kMap);
+		EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTracker::Tag::kOther);
+		int* values = new int[100];
+		gEscaped = values;
+		delete[] values;
+	}
+	MemoryTracker::TagStatistics after = MemoryTracker::GetTotalStatistics();
+	EXPECT_EQ(after.allocationCount, before.allocationCount);
+	EXPECT_EQ(after.liveBytes, 0);
+}
+
+} // namespace
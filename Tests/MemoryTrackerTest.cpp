@@ -0,0 +1,228 @@
+// MemoryTrackerのテスト（operator new/deleteの差し替えと、分類ごとの集計）
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Tag = MemoryTracker::Tag;
+
+// 確保を最適化で消されないよう、ポインタを外に出す
+void* volatile gEscaped = nullptr;
+template<typename T> T* Escape(T* pointer) {
+	gEscaped = pointer;
+	return pointer;
+}
+
+// アラインメントの大きい型
+struct alignas(64) CacheLine {
+	uint8_t bytes[64];
+};
+
+// 集計は全体で共有なので、テスト前との差で見る
+struct Delta {
+	int64_t liveBytes;
+	int64_t liveCount;
+	uint64_t allocationCount;
+	uint64_t allocatedBytes;
+};
+Delta GetDelta(Tag tag, const MemoryTracker::TagStatistics& before) {
+	MemoryTracker::TagStatistics after = MemoryTracker::GetStatistics(tag);
+	return {
+	    after.liveBytes - before.liveBytes, after.liveCount - before.liveCount,
+	    after.allocationCount - before.allocationCount,
+	    after.allocatedBytes - before.allocatedBytes};
+}
+
+TEST(MemoryTrackerTest, IsEnabled) { EXPECT_TRUE(MemoryTracker::IsEnabled()); }
+
+TEST(MemoryTrackerTest, TagScopesNest) {
+	EXPECT_EQ(MemoryTracker::GetCurrentTag(), Tag::kOther);
+	{
+		MEMORY_TAG_SCOPE(Tag::kMap);
+		EXPECT_EQ(MemoryTracker::GetCurrentTag(), Tag::kMap);
+		{
+			MEMORY_TAG_SCOPE(Tag::kModel);
+			EXPECT_EQ(MemoryTracker::GetCurrentTag(), Tag::kModel);
+		}
+		EXPECT_EQ(MemoryTracker::GetCurrentTag(), Tag::kMap);
+	}
+	EXPECT_EQ(MemoryTracker::GetCurrentTag(), Tag::kOther);
+
+	// 分類スタックはスレッドごと
+	MEMORY_TAG_SCOPE(Tag::kAudio);
+	Tag workerTag = Tag::kAudio;
+	std::thread worker([&] { workerTag = MemoryTracker::GetCurrentTag(); });
+	worker.join();
+	EXPECT_EQ(workerTag, Tag::kOther);
+}
+
+TEST(MemoryTrackerTest, AllocationsCountToCurrentTag) {
+	MemoryTracker::TagStatistics mapBefore = MemoryTracker::GetStatistics(Tag::kMap);
+	MemoryTracker::TagStatistics modelBefore = MemoryTracker::GetStatistics(Tag::kModel);
+	{
+		MEMORY_TAG_SCOPE(Tag::kMap);
+		int* values = Escape(new int[100]);
+		Delta map = GetDelta(Tag::kMap, mapBefore);
+		EXPECT_EQ(map.liveBytes, 400);
+		EXPECT_EQ(map.liveCount, 1);
+		EXPECT_EQ(map.allocationCount, 1u);
+		EXPECT_EQ(map.allocatedBytes, 400u);
+
+		// 内側の分類に数え、外側には数えない
+		{
+			MEMORY_TAG_SCOPE(Tag::kModel);
+			delete Escape(new int(1));
+		}
+		EXPECT_EQ(GetDelta(Tag::kModel, modelBefore).allocationCount, 1u);
+		EXPECT_EQ(GetDelta(Tag::kMap, mapBefore).allocationCount, 1u);
+
+		delete[] values;
+	}
+
+	// 解放は確保時の分類から引く（累計は残る）
+	Delta map = GetDelta(Tag::kMap, mapBefore);
+	EXPECT_EQ(map.liveBytes, 0);
+	EXPECT_EQ(map.liveCount, 0);
+	EXPECT_EQ(map.allocationCount, 1u);
+	EXPECT_EQ(GetDelta(Tag::kModel, modelBefore).liveBytes, 0);
+}
+
+TEST(MemoryTrackerTest, OverAlignedAllocationsAreAligned) {
+	MemoryTracker::TagStatistics before = MemoryTracker::GetStatistics(Tag::kModel);
+	CacheLine* singles[16];
+	CacheLine* arrays[16];
+	{
+		MEMORY_TAG_SCOPE(Tag::kModel);
+		for (int i = 0; i < 16; i++) {
+			singles[i] = Escape(new CacheLine);
+			arrays[i] = Escape(new CacheLine[3]);
+		}
+	}
+	for (int i = 0; i < 16; i++) {
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(singles[i]) % alignof(CacheLine), 0u);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(arrays[i]) % alignof(CacheLine), 0u);
+	}
+	EXPECT_EQ(GetDelta(Tag::kModel, before).liveBytes, 16 * 4 * 64);
+	for (int i = 0; i < 16; i++) {
+		delete singles[i];
+		delete[] arrays[i];
+	}
+	EXPECT_EQ(GetDelta(Tag::kModel, before).liveBytes, 0);
+}
+
+TEST(MemoryTrackerTest, PeakKeepsMaximumLiveBytes) {
+	MemoryTracker::TagStatistics before = MemoryTracker::GetStatistics(Tag::kUI);
+	MEMORY_TAG_SCOPE(Tag::kUI);
+	delete[] Escape(new char[before.peakBytes - before.liveBytes + 4096]);
+	delete[] Escape(new char[16]);
+
+	MemoryTracker::TagStatistics after = MemoryTracker::GetStatistics(Tag::kUI);
+	EXPECT_EQ(after.liveBytes, before.liveBytes);
+	EXPECT_EQ(after.peakBytes, before.peakBytes + 4096);
+}
+
+TEST(MemoryTrackerTest, FailedAllocationsAreNotCounted) {
+	MemoryTracker::TagStatistics before = MemoryTracker::GetStatistics(Tag::kTexture);
+	MEMORY_TAG_SCOPE(Tag::kTexture);
+	// 定数にするとコンパイラが大きすぎる確保を警告するので、実行時の値にする
+	volatile size_t hugeSize = SIZE_MAX - 4;
+	EXPECT_EQ(::operator new(hugeSize, std::nothrow), nullptr);
+	EXPECT_THROW(Escape(::operator new(hugeSize)), std::bad_alloc);
+	EXPECT_EQ(GetDelta(Tag::kTexture, before).allocationCount, 0u);
+	// 空のポインタの解放は何もしない
+	::operator delete(nullptr);
+	EXPECT_EQ(GetDelta(Tag::kTexture, before).liveCount, 0);
+}
+
+TEST(MemoryTrackerTest, FreeOnAnotherThreadBalances) {
+	MemoryTracker::TagStatistics before = MemoryTracker::GetStatistics(Tag::kTexture);
+	std::vector<int*> values(4000);
+	std::thread allocator([&] {
+		MEMORY_TAG_SCOPE(Tag::kTexture);
+		for (int*& value : values) {
+			value = Escape(new int(1));
+		}
+	});
+	allocator.join();
+	EXPECT_EQ(GetDelta(Tag::kTexture, before).liveCount, 4000);
+	EXPECT_EQ(GetDelta(Tag::kTexture, before).liveBytes, 4000 * int64_t(sizeof(int)));
+
+	// 分類を積んでいないスレッドで解放しても、確保時の分類から引く
+	std::thread releaser([&] {
+		for (int* value : values) {
+			delete value;
+		}
+	});
+	releaser.join();
+	Delta delta = GetDelta(Tag::kTexture, before);
+	EXPECT_EQ(delta.liveCount, 0);
+	EXPECT_EQ(delta.liveBytes, 0);
+	EXPECT_EQ(delta.allocationCount, 4000u);
+}
+
+TEST(MemoryTrackerTest, ThreadsBeyondLimitUseSharedCounters) {
+	MemoryTracker::TagStatistics before = MemoryTracker::GetStatistics(Tag::kAudio);
+	const uint32_t kThreadCount = MemoryTracker::kMaxThreadCount + 36;
+	std::vector<std::thread> threads;
+	std::vector<int*> kept(kThreadCount);
+	for (uint32_t i = 0; i < kThreadCount; i++) {
+		threads.emplace_back([&kept, i] {
+			MEMORY_TAG_SCOPE(Tag::kAudio);
+			for (int k = 0; k < 100; k++) {
+				delete Escape(new int(k));
+			}
+			kept[i] = Escape(new int(int(i)));
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	Delta delta = GetDelta(Tag::kAudio, before);
+	EXPECT_EQ(delta.liveCount, int64_t(kThreadCount));
+	EXPECT_EQ(delta.allocationCount, kThreadCount * 101u);
+	EXPECT_EQ(delta.liveBytes, int64_t(kThreadCount * sizeof(int)));
+	for (int* value : kept) {
+		delete value;
+	}
+	delta = GetDelta(Tag::kAudio, before);
+	EXPECT_EQ(delta.liveCount, 0);
+	EXPECT_EQ(delta.liveBytes, 0);
+}
+
+TEST(MemoryTrackerTest, EndFrameCountsFrameAllocations) {
+	MemoryTracker::EndFrame();
+	{
+		MEMORY_TAG_SCOPE(Tag::kUI);
+		for (int i = 0; i < 5; i++) {
+			delete[] Escape(new char[100]);
+		}
+	}
+	MemoryTracker::EndFrame();
+	MemoryTracker::TagStatistics statistics = MemoryTracker::GetStatistics(Tag::kUI);
+	EXPECT_EQ(statistics.frameAllocationCount, 5u);
+	EXPECT_EQ(statistics.frameAllocatedBytes, 500u);
+	EXPECT_GE(statistics.maxFrameAllocationCount, 5u);
+
+	// 確保しなかったフレームは0回。最大は残る
+	MemoryTracker::EndFrame();
+	statistics = MemoryTracker::GetStatistics(Tag::kUI);
+	EXPECT_EQ(statistics.frameAllocationCount, 0u);
+	EXPECT_GE(statistics.maxFrameAllocationCount, 5u);
+}
+
+TEST(MemoryTrackerTest, ReportListsEveryTagAndTotal) {
+	std::string report = MemoryTracker::FormatReport();
+	for (size_t i = 0; i < size_t(Tag::kCountOfTag); i++) {
+		EXPECT_NE(report.find(MemoryTracker::GetTagName(Tag(i))), std::string::npos) << i;
+	}
+	EXPECT_NE(report.find("Total"), std::string::npos);
+	EXPECT_EQ(std::count(report.begin(), report.end(), '\n'), ptrdiff_t(Tag::kCountOfTag) + 2);
+}
+
+} // namespace
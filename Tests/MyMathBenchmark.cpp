@@ -0,0 +1,91 @@
+// MyMathの行列演算の計測（SIMD版とMYMATH_NO_SIMD版）
+#include "MyMath.h"
+#include "MyMathScalar.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 計測に使う行列（逆行列が安定するよう対角成分を大きくする）
+std::vector<Matrix4x4> MakeMatrices(size_t count) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+	std::vector<Matrix4x4> matrices(count);
+	for (Matrix4x4& matrix : matrices) {
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				matrix.m[i][j] = distribution(random) + (i == j ? 8.0f : 0.0f);
+			}
+		}
+	}
+	return matrices;
+}
+
+// 1024個の行列を順に処理する（キャッシュに乗る大きさ）
+const size_t kMatrixCount = 1024;
+
+template<Matrix4x4 (*Function)(const Matrix4x4&, const Matrix4x4&)>
+void BM_Binary(benchmark::State& state) {
+	std::vector<Matrix4x4> matrices = MakeMatrices(kMatrixCount);
+	std::vector<Matrix4x4> results(kMatrixCount);
+	for (auto _ : state) {
+		for (size_t i = 0; i < kMatrixCount; i++) {
+			results[i] = Function(matrices[i], matrices[(i + 1) % kMatrixCount]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kMatrixCount);
+}
+
+template<Matrix4x4 (*Function)(const Matrix4x4&)> void BM_Unary(benchmark::State& state) {
+	std::vector<Matrix4x4> matrices = MakeMatrices(kMatrixCount);
+	std::vector<Matrix4x4> results(kMatrixCount);
+	for (auto _ : state) {
+		for (size_t i = 0; i < kMatrixCount; i++) {
+			results[i] = Function(matrices[i]);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kMatrixCount);
+}
+
+template<void (*Function)(const TransformArrays&, size_t, Matrix4x4*)>
+void BM_AffineMatrices(benchmark::State& state) {
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+	std::vector<float> values[9];
+	for (std::vector<float>& stream : values) {
+		for (size_t i = 0; i < kMatrixCount; i++) {
+			stream.push_back(distribution(random));
+		}
+	}
+	TransformArrays transforms = {
+	    {values[0].data(), values[1].data(), values[2].data()},
+	    {values[3].data(), values[4].data(), values[5].data()},
+	    {values[6].data(), values[7].data(), values[8].data()}};
+	std::vector<Matrix4x4> results(kMatrixCount);
+	for (auto _ : state) {
+		Function(transforms, kMatrixCount, results.data());
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kMatrixCount);
+}
+
+BENCHMARK(BM_Binary<Add>)->Name("Add/simd");
+BENCHMARK(BM_Binary<scalar::Add>)->Name("Add/scalar");
+BENCHMARK(BM_Binary<Multiply>)->Name("Multiply/simd");
+BENCHMARK(BM_Binary<scalar::Multiply>)->Name("Multiply/scalar");
+BENCHMARK(BM_Unary<Transpose>)->Name("Transpose/simd");
+BENCHMARK(BM_Unary<scalar::Transpose>)->Name("Transpose/scalar");
+BENCHMARK(BM_Unary<Inverse>)->Name("Inverse/simd");
+BENCHMARK(BM_Unary<scalar::Inverse>)->Name("Inverse/scalar");
+BENCHMARK(BM_Unary<InverseAffine>)->Name("InverseAffine");
+BENCHMARK(BM_Unary<InverseRigid>)->Name("InverseRigid");
+BENCHMARK(BM_AffineMatrices<MakeAffineMatrices>)->Name("MakeAffineMatrices/simd");
+BENCHMARK(BM_AffineMatrices<scalar::MakeAffineMatrices>)->Name("MakeAffineMatrices/scalar");
+
+} // namespace
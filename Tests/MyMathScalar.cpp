@@ -0,0 +1,8 @@
+// MyMath.cppをSIMD無しでもう一度コンパイルし、scalar名前空間に入れる
+// （MyMath.hは先に読んでいるので、MyMath.cpp内の#includeは何もしない）
+#include "MyMathScalar.h"
+
+#define MYMATH_NO_SIMD
+namespace scalar {
+#include "MyMath.cpp"
+} // namespace scalar
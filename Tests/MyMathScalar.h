@@ -0,0 +1,23 @@
+#pragma once
+
+#include "MyMath.h"
+
+/// <summary>
+/// MYMATH_NO_SIMDでコンパイルしたMyMath.cpp（SIMD版と同じプログラムで比べるため）
+/// </summary>
+namespace scalar {
+
+Matrix4x4 MakeRotateXMatrix(float radian);
+Matrix4x4 MakeRotateYMatrix(float radian);
+Matrix4x4 MakeRotateZMatrix(float radian);
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+void MakeAffineMatrices(const TransformArrays& transforms, size_t count, Matrix4x4* matrices);
+Matrix4x4 Add(const Matrix4x4& mt1, const Matrix4x4& mt2);
+Matrix4x4 Subtract(const Matrix4x4& mt1, const Matrix4x4& mt2);
+Matrix4x4 Multiply(const Matrix4x4& mt1, const Matrix4x4& mt2);
+Matrix4x4 Inverse(const Matrix4x4& m);
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+Matrix4x4 InverseRigid(const Matrix4x4& m);
+Matrix4x4 Transpose(const Matrix4x4& mt1);
+
+} // namespace scalar
@@ -0,0 +1,433 @@
+// MyMathの行列演算のテスト（SIMD版とMYMATH_NO_SIMD版、倍精度の参照実装を比べる）
+#include "MyMath.h"
+#include "MyMathScalar.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 倍精度の4x4行列（参照実装用）
+struct Matrix4x4d {
+	double m[4][4];
+};
+
+Matrix4x4d ToDouble(const Matrix4x4& matrix) {
+	Matrix4x4d result;
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			result.m[i][j] = matrix.m[i][j];
+		}
+	}
+	return result;
+}
+
+Matrix4x4d MultiplyReference(const Matrix4x4d& a, const Matrix4x4d& b) {
+	Matrix4x4d result{};
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			for (int k = 0; k < 4; k++) {
+				result.m[i][j] += a.m[i][k] * b.m[k][j];
+			}
+		}
+	}
+	return result;
+}
+
+// 部分ピボット付きのガウス・ジョルダン法
+Matrix4x4d InverseReference(Matrix4x4d a) {
+	Matrix4x4d result{};
+	for (int i = 0; i < 4; i++) {
+		result.m[i][i] = 1.0;
+	}
+	for (int column = 0; column < 4; column++) {
+		int pivot = column;
+		for (int row = column + 1; row < 4; row++) {
+			if (std::abs(a.m[row][column]) > std::abs(a.m[pivot][column])) {
+				pivot = row;
+			}
+		}
+		std::swap(a.m[column], a.m[pivot]);
+		std::swap(result.m[column], result.m[pivot]);
+		double inverse = 1.0 / a.m[column][column];
+		for (int j = 0; j < 4; j++) {
+			a.m[column][j] *= inverse;
+			result.m[column][j] *= inverse;
+		}
+		for (int row = 0; row < 4; row++) {
+			if (row == column) {
+				continue;
+			}
+			double factor = a.m[row][column];
+			for (int j = 0; j < 4; j++) {
+				a.m[row][j] -= factor * a.m[column][j];
+				result.m[row][j] -= factor * result.m[column][j];
+			}
+		}
+	}
+	return result;
+}
+
+// 要素ごとの相対誤差の最大値（0付近は絶対誤差）
+double MaxRelativeError(const Matrix4x4& actual, const Matrix4x4d& expected) {
+	double maxError = 0.0;
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			double error =
+			    std::abs(actual.m[i][j] - expected.m[i][j]) / (1.0 + std::abs(expected.m[i][j]));
+			maxError = std::max(maxError, error);
+		}
+	}
+	return maxError;
+}
+
+double MaxRelativeError(const Matrix4x4& actual, const Matrix4x4& expected) {
+	return MaxRelativeError(actual, ToDouble(expected));
+}
+
+// [-3, 3]の一様乱数の行列
+Matrix4x4 RandomMatrix(std::mt19937& random) {
+	std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+	Matrix4x4 matrix;
+	for (auto& row : matrix.m) {
+		for (float& value : row) {
+			value = distribution(random);
+		}
+	}
+	return matrix;
+}
+
+// 条件数が大きすぎない行列（ランダム行列に対角成分を足す）
+Matrix4x4 RandomWellConditionedMatrix(std::mt19937& random) {
+	Matrix4x4 matrix = RandomMatrix(random);
+	for (int i = 0; i < 4; i++) {
+		matrix.m[i][i] += matrix.m[i][i] < 0.0f ? -8.0f : 8.0f;
+	}
+	return matrix;
+}
+
+// ランダムな拡大縮小、回転、平行移動のアフィン行列（拡大率が0.1～10なので条件数は最大100）
+Matrix4x4 RandomAffineMatrix(std::mt19937& random, bool isRigid) {
+	std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+	std::uniform_real_distribution<float> logScale(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> translate(-100.0f, 100.0f);
+	Vector3 scale = {1.0f, 1.0f, 1.0f};
+	if (!isRigid) {
+		scale = {
+		    std::pow(10.0f, logScale(random)), std::pow(10.0f, logScale(random)),
+		    std::pow(10.0f, logScale(random))};
+	}
+	Matrix4x4 rotation = Multiply(
+	    Multiply(MakeRotateXMatrix(angle(random)), MakeRotateYMatrix(angle(random))),
+	    MakeRotateZMatrix(angle(random)));
+	Matrix4x4 matrix = Multiply(MakeScaleMatrix(scale), rotation);
+	matrix.m[3][0] = translate(random);
+	matrix.m[3][1] = translate(random);
+	matrix.m[3][2] = translate(random);
+	return matrix;
+}
+
+// A * A^-1 と単位行列の差の最大値
+double MaxIdentityResidual(const Matrix4x4& a, const Matrix4x4& inverse) {
+	Matrix4x4d identity = MultiplyReference(ToDouble(a), ToDouble(inverse));
+	double maxResidual = 0.0;
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			maxResidual =
+			    std::max(maxResidual, std::abs(identity.m[i][j] - (i == j ? 1.0 : 0.0)));
+		}
+	}
+	return maxResidual;
+}
+
+const int kSampleCount = 10000;
+
+} // namespace
+
+TEST(MyMathTest, AddSubtractTransposeAreExact) {
+	std::mt19937 random(1);
+	for (int n = 0; n < kSampleCount; n++) {
+		Matrix4x4 a = RandomMatrix(random);
+		Matrix4x4 b = RandomMatrix(random);
+		Matrix4x4 add = Add(a, b);
+		Matrix4x4 subtract = Subtract(a, b);
+		Matrix4x4 transpose = Transpose(a);
+		Matrix4x4 scalarAdd = scalar::Add(a, b);
+		Matrix4x4 scalarSubtract = scalar::Subtract(a, b);
+		Matrix4x4 scalarTranspose = scalar::Transpose(a);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				ASSERT_EQ(add.m[i][j], a.m[i][j] + b.m[i][j]);
+				ASSERT_EQ(subtract.m[i][j], a.m[i][j] - b.m[i][j]);
+				ASSERT_EQ(transpose.m[i][j], a.m[j][i]);
+				ASSERT_EQ(scalarAdd.m[i][j], add.m[i][j]);
+				ASSERT_EQ(scalarSubtract.m[i][j], subtract.m[i][j]);
+				ASSERT_EQ(scalarTranspose.m[i][j], transpose.m[i][j]);
+			}
+		}
+	}
+}
+
+TEST(MyMathTest, MultiplyMatchesScalarAndReference) {
+	std::mt19937 random(2);
+	double maxSimdError = 0.0;
+	double maxScalarError = 0.0;
+	double maxDifference = 0.0;
+	for (int n = 0; n < kSampleCount; n++) {
+		Matrix4x4 a = RandomMatrix(random);
+		Matrix4x4 b = RandomMatrix(random);
+		Matrix4x4d expected = MultiplyReference(ToDouble(a), ToDouble(b));
+		Matrix4x4 simd = Multiply(a, b);
+		Matrix4x4 reference = scalar::Multiply(a, b);
+		maxSimdError = std::max(maxSimdError, MaxRelativeError(simd, expected));
+		maxScalarError = std::max(maxScalarError, MaxRelativeError(reference, expected));
+		maxDifference = std::max(maxDifference, MaxRelativeError(simd, reference));
+	}
+	// 4項の和なので、単精度の丸め数回分
+	EXPECT_LT(maxSimdError, 1e-6);
+	EXPECT_LT(maxScalarError, 1e-6);
+	EXPECT_LT(maxDifference, 1e-6);
+}
+
+TEST(MyMathTest, MultiplyOperatorMatchesConstexprEvaluation) {
+	constexpr Matrix4x4 a = {{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}}};
+	constexpr Matrix4x4 b = MakeTranslateMatrix({1.0f, -2.0f, 3.0f});
+	// 定数式ではループ、実行時はMultiplyになる
+	constexpr Matrix4x4 compileTime = a * b;
+	Matrix4x4 runTime = a * b;
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			EXPECT_EQ(runTime.m[i][j], compileTime.m[i][j]);
+		}
+	}
+}
+
+TEST(MyMathTest, InverseMatchesScalarAndReference) {
+	std::mt19937 random(3);
+	double maxSimdError = 0.0;
+	double maxScalarError = 0.0;
+	double maxIdentityResidual = 0.0;
+	for (int n = 0; n < kSampleCount; n++) {
+		Matrix4x4 a = RandomWellConditionedMatrix(random);
+		Matrix4x4d expected = InverseReference(ToDouble(a));
+		Matrix4x4 simd = Inverse(a);
+		Matrix4x4 reference = scalar::Inverse(a);
+		maxSimdError = std::max(maxSimdError, MaxRelativeError(simd, expected));
+		maxScalarError = std::max(maxScalarError, MaxRelativeError(reference, expected));
+
+		// A * A^-1 = I
+		Matrix4x4d identity = MultiplyReference(ToDouble(a), ToDouble(simd));
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				maxIdentityResidual = std::max(
+				    maxIdentityResidual, std::abs(identity.m[i][j] - (i == j ? 1.0 : 0.0)));
+			}
+		}
+	}
+	EXPECT_LT(maxSimdError, 1e-5);
+	EXPECT_LT(maxScalarError, 1e-5);
+	EXPECT_LT(maxIdentityResidual, 1e-5);
+}
+
+TEST(MyMathTest, RotationMatricesMatchScalar) {
+	for (int n = -1000; n <= 1000; n++) {
+		float radian = float(n) * 0.01f;
+		EXPECT_LT(
+		    MaxRelativeError(MakeRotateXMatrix(radian), scalar::MakeRotateXMatrix(radian)), 1e-6);
+		EXPECT_LT(
+		    MaxRelativeError(MakeRotateYMatrix(radian), scalar::MakeRotateYMatrix(radian)), 1e-6);
+		EXPECT_LT(
+		    MaxRelativeError(MakeRotateZMatrix(radian), scalar::MakeRotateZMatrix(radian)), 1e-6);
+	}
+}
+
+TEST(MyMathTest, InverseAffineMatchesReference) {
+	std::mt19937 random(4);
+	double maxError = 0.0;
+	double maxScalarDifference = 0.0;
+	double maxResidual = 0.0;
+	for (int n = 0; n < kSampleCount; n++) {
+		Matrix4x4 a = RandomAffineMatrix(random, false);
+		Matrix4x4 inverse = InverseAffine(a);
+		maxError = std::max(maxError, MaxRelativeError(inverse, InverseReference(ToDouble(a))));
+		maxScalarDifference =
+		    std::max(maxScalarDifference, MaxRelativeError(inverse, scalar::InverseAffine(a)));
+		maxResidual = std::max(maxResidual, MaxIdentityResidual(a, inverse));
+		// 4列目は厳密に(0,0,0,1)
+		ASSERT_EQ(inverse.m[0][3], 0.0f);
+		ASSERT_EQ(inverse.m[1][3], 0.0f);
+		ASSERT_EQ(inverse.m[2][3], 0.0f);
+		ASSERT_EQ(inverse.m[3][3], 1.0f);
+	}
+	// 条件数κ≦100なので、相対誤差は κ×単精度の丸め数回分（100×4×6e-8≒2.4e-5）程度
+	EXPECT_LT(maxError, 5e-5);
+	EXPECT_EQ(maxScalarDifference, 0.0);
+	// 平行移動(最大100)の打ち消し分だけ大きくなる
+	EXPECT_LT(maxResidual, 5e-4);
+}
+
+TEST(MyMathTest, InverseAffineMatchesInverse) {
+	std::mt19937 random(5);
+	double maxDifference = 0.0;
+	for (int n = 0; n < kSampleCount; n++) {
+		Matrix4x4 a = RandomAffineMatrix(random, false);
+		maxDifference = std::max(maxDifference, MaxRelativeError(InverseAffine(a), Inverse(a)));
+	}
+	// 汎用のInverseに置き換えても結果が変わらない（どちらも上の誤差の範囲）
+	EXPECT_LT(maxDifference, 5e-5);
+}
+
+TEST(MyMathTest, InverseRigidMatchesReference) {
+	std::mt19937 random(6);
+	double maxError = 0.0;
+	double maxResidual = 0.0;
+	for (int n = 0; n < kSampleCount; n++) {
+		Matrix4x4 a = RandomAffineMatrix(random, true);
+		Matrix4x4 inverse = InverseRigid(a);
+		maxError = std::max(maxError, MaxRelativeError(inverse, InverseReference(ToDouble(a))));
+		maxResidual = std::max(maxResidual, MaxIdentityResidual(a, inverse));
+	}
+	// 回転行列の直交性の誤差（単精度の丸め数回分）が平行移動(最大100)に掛かる
+	EXPECT_LT(maxError, 1e-5);
+	EXPECT_LT(maxResidual, 1e-4);
+}
+
+TEST(MyMathTest, InverseRigidOfPureRotationIsTranspose) {
+	Matrix4x4 rotation = Multiply(MakeRotateXMatrix(0.3f), MakeRotateZMatrix(-1.2f));
+	Matrix4x4 inverse = InverseRigid(rotation);
+	Matrix4x4 transpose = Transpose(rotation);
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			EXPECT_EQ(inverse.m[i][j], transpose.m[i][j]);
+		}
+	}
+}
+
+namespace {
+
+// S * Rx * Ry * Rz * T を倍精度で掛けて作る
+Matrix4x4d AffineReference(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	auto rotation = [](int axis, double radian) {
+		Matrix4x4d matrix{};
+		int a = (axis + 1) % 3;
+		int b = (axis + 2) % 3;
+		matrix.m[axis][axis] = 1.0;
+		matrix.m[3][3] = 1.0;
+		matrix.m[a][a] = std::cos(radian);
+		matrix.m[a][b] = std::sin(radian);
+		matrix.m[b][a] = -std::sin(radian);
+		matrix.m[b][b] = std::cos(radian);
+		return matrix;
+	};
+	Matrix4x4d scaleMatrix{};
+	scaleMatrix.m[0][0] = scale.x;
+	scaleMatrix.m[1][1] = scale.y;
+	scaleMatrix.m[2][2] = scale.z;
+	scaleMatrix.m[3][3] = 1.0;
+	Matrix4x4d result = MultiplyReference(
+	    MultiplyReference(
+	        MultiplyReference(scaleMatrix, rotation(0, rotate.x)), rotation(1, rotate.y)),
+	    rotation(2, rotate.z));
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	return result;
+}
+
+// SoAの変換配列
+struct TransformStreams {
+	std::vector<float> values[9];
+
+	explicit TransformStreams(size_t count, std::mt19937& random, float maxRadian) {
+		std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+		std::uniform_real_distribution<float> angle(-maxRadian, maxRadian);
+		std::uniform_real_distribution<float> translate(-100.0f, 100.0f);
+		for (int axis = 0; axis < 3; axis++) {
+			for (size_t i = 0; i < count; i++) {
+				values[axis].push_back(scale(random));
+				values[3 + axis].push_back(angle(random));
+				values[6 + axis].push_back(translate(random));
+			}
+		}
+	}
+
+	TransformArrays GetArrays() const {
+		return {
+		    {values[0].data(), values[1].data(), values[2].data()},
+		    {values[3].data(), values[4].data(), values[5].data()},
+		    {values[6].data(), values[7].data(), values[8].data()}};
+	}
+
+	Vector3 Get(int stream, size_t i) const {
+		return {values[stream][i], values[stream + 1][i], values[stream + 2][i]};
+	}
+};
+
+} // namespace
+
+TEST(MyMathTest, MakeAffineMatrixMatchesReference) {
+	std::mt19937 random(7);
+	TransformStreams streams(kSampleCount, random, 3.14159265f);
+	double maxError = 0.0;
+	for (size_t i = 0; i < kSampleCount; i++) {
+		Vector3 scale = streams.Get(0, i);
+		Vector3 rotate = streams.Get(3, i);
+		Vector3 translate = streams.Get(6, i);
+		Matrix4x4 matrix = MakeAffineMatrix(scale, rotate, translate);
+		maxError =
+		    std::max(maxError, MaxRelativeError(matrix, AffineReference(scale, rotate, translate)));
+
+		// 行列を掛けて作った場合とも一致する
+		Matrix4x4 composed = Multiply(
+		    Multiply(
+		        Multiply(MakeScaleMatrix(scale), MakeRotateXMatrix(rotate.x)),
+		        MakeRotateYMatrix(rotate.y)),
+		    Multiply(MakeRotateZMatrix(rotate.z), MakeTranslateMatrix(translate)));
+		ASSERT_LT(MaxRelativeError(matrix, composed), 1e-5) << "sample " << i;
+	}
+	// 拡大率が最大10なので、相対誤差は単精度の丸め数回分
+	EXPECT_LT(maxError, 1e-6);
+}
+
+TEST(MyMathTest, MakeAffineMatricesMatchesReference) {
+	// 4の倍数でない数で、SIMDの端数も通る。角度は範囲の折り返しも確かめる
+	const size_t kCount = 4099;
+	for (float maxRadian : {3.14159265f, 100.0f}) {
+		std::mt19937 random(8);
+		TransformStreams streams(kCount, random, maxRadian);
+		std::vector<Matrix4x4> matrices(kCount);
+		MakeAffineMatrices(streams.GetArrays(), kCount, matrices.data());
+
+		double maxError = 0.0;
+		double maxSingleDifference = 0.0;
+		for (size_t i = 0; i < kCount; i++) {
+			Vector3 scale = streams.Get(0, i);
+			Vector3 rotate = streams.Get(3, i);
+			Vector3 translate = streams.Get(6, i);
+			maxError = std::max(
+			    maxError, MaxRelativeError(matrices[i], AffineReference(scale, rotate, translate)));
+			maxSingleDifference = std::max(
+			    maxSingleDifference,
+			    MaxRelativeError(matrices[i], MakeAffineMatrix(scale, rotate, translate)));
+		}
+		// SIMD版のsin/cosは多項式近似（誤差は数ulp）なので、1つずつ作った場合と完全には一致しない
+		EXPECT_LT(maxError, 5e-6) << "max radian " << maxRadian;
+		EXPECT_LT(maxSingleDifference, 5e-6) << "max radian " << maxRadian;
+	}
+}
+
+TEST(MyMathTest, ScalarMakeAffineMatricesIsExact) {
+	// SIMD無しでは1つずつ作るのと同じ計算
+	const size_t kCount = 1001;
+	std::mt19937 random(9);
+	TransformStreams streams(kCount, random, 3.14159265f);
+	std::vector<Matrix4x4> matrices(kCount);
+	scalar::MakeAffineMatrices(streams.GetArrays(), kCount, matrices.data());
+	for (size_t i = 0; i < kCount; i++) {
+		Matrix4x4 single =
+		    scalar::MakeAffineMatrix(streams.Get(0, i), streams.Get(3, i), streams.Get(6, i));
+		ASSERT_EQ(MaxRelativeError(matrices[i], single), 0.0) << "sample " << i;
+	}
+}
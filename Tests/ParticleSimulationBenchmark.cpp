@@ -0,0 +1,57 @@
+// パーティクル更新の計測（1ミリ秒あたりに更新できる数）
+#include "JobSystem.h"
+#include "ParticleSimulation.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// 寿命が尽きないように放出して、毎回同じ数を更新する
+void BM_Update(benchmark::State& state) {
+	uint32_t count = uint32_t(state.range(0));
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(uint32_t(state.range(1)));
+
+	ParticleSimulation simulation;
+	simulation.Initialize(count, 1);
+	ParticleSimulation::EmitterDesc desc;
+	desc.lifetime = 1.0e6f;
+	simulation.Emit(desc, count);
+	simulation.SetAcceleration({0.0f, -9.8f, 0.0f});
+
+	for (auto _ : state) {
+		simulation.Update(1.0f / 60.0f);
+		benchmark::ClobberMemory();
+	}
+	jobSystem->Finalize();
+
+	// 毎秒の数を1000で割って表示する（表示の単位は"/s"になるが値は1ミリ秒あたり）
+	state.counters["particles/ms"] = benchmark::Counter(
+	    double(count) * double(state.iterations()) / 1000.0, benchmark::Counter::kIsRate);
+}
+// 粒数, ワーカー数。ワーカーの時間も入るよう経過時間で計る
+BENCHMARK(BM_Update)
+    ->ArgsProduct({{1000, 10000, 100000, 1000000}, {0, 3}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// 描画用のインスタンスデータ書き出し
+void BM_WriteInstances(benchmark::State& state) {
+	uint32_t count = uint32_t(state.range(0));
+	ParticleSimulation simulation;
+	simulation.Initialize(count, 1);
+	simulation.Emit(ParticleSimulation::EmitterDesc{}, count);
+	std::vector<ParticleSimulation::Instance> instances(count);
+
+	for (auto _ : state) {
+		simulation.WriteInstances(instances.data());
+		benchmark::DoNotOptimize(instances.data());
+		benchmark::ClobberMemory();
+	}
+	state.counters["particles/ms"] = benchmark::Counter(
+	    double(count) * double(state.iterations()) / 1000.0, benchmark::Counter::kIsRate);
+	state.SetBytesProcessed(
+	    int64_t(state.iterations()) * count * int64_t(sizeof(ParticleSimulation::Instance)));
+}
+BENCHMARK(BM_WriteInstances)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+} // namespace
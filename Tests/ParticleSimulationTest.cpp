@@ -0,0 +1,108 @@
+// パーティクル更新（SoA、SIMD）のテスト
+#include "ParticleSimulation.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+ParticleSimulation::EmitterDesc MakeDesc() {
+	ParticleSimulation::EmitterDesc desc;
+	desc.position = {1.0f, 2.0f, 3.0f};
+	desc.speed = 2.0f;
+	desc.lifetime = 1.0f;
+	desc.color = {0.5f, 0.5f, 0.5f, 1.0f};
+	return desc;
+}
+
+} // namespace
+
+TEST(ParticleSimulationTest, CapacityIsNotLimitedByConstantBuffer) {
+	// 共有の定数バッファ（1MiB）に収まらない数でも全て生きている
+	const uint32_t kCount = 100000;
+	ParticleSimulation simulation;
+	simulation.Initialize(kCount, 1);
+	simulation.Emit(MakeDesc(), kCount);
+	simulation.Update(1.0f / 60.0f);
+	EXPECT_EQ(simulation.GetAliveCount(), kCount);
+
+	std::vector<ParticleSimulation::Instance> instances(simulation.GetAliveCount());
+	simulation.WriteInstances(instances.data());
+	EXPECT_GT(sizeof(ParticleSimulation::Instance) * instances.size(), 1024u * 1024u);
+}
+
+TEST(ParticleSimulationTest, EmitStopsAtCapacity) {
+	ParticleSimulation simulation;
+	simulation.Initialize(10, 1);
+	// SIMD幅に切り上げられる
+	EXPECT_EQ(simulation.GetCapacity(), 12u);
+	simulation.Emit(MakeDesc(), 100);
+	EXPECT_EQ(simulation.GetAliveCount(), 12u);
+}
+
+TEST(ParticleSimulationTest, IntegrateMatchesScalarEuler) {
+	ParticleSimulation simulation;
+	simulation.Initialize(7, 1);
+	simulation.SetAcceleration({0.0f, -9.8f, 0.0f});
+	Vector3 direction = {1.0f, 0.0f, 0.0f};
+	std::vector<Vector3> directions(7, direction);
+	simulation.Emit(MakeDesc(), directions.data(), 7);
+
+	const float kDeltaTime = 0.1f;
+	simulation.Update(kDeltaTime);
+
+	// v += a dt; p += v dt（SIMD幅の端数の粒も同じ結果）
+	float velocityY = -9.8f * kDeltaTime;
+	std::vector<ParticleSimulation::Instance> instances(simulation.GetAliveCount());
+	simulation.WriteInstances(instances.data());
+	ASSERT_EQ(instances.size(), 7u);
+	for (const ParticleSimulation::Instance& instance : instances) {
+		EXPECT_FLOAT_EQ(instance.position.x, 1.0f + 2.0f * kDeltaTime);
+		EXPECT_FLOAT_EQ(instance.position.y, 2.0f + velocityY * kDeltaTime);
+		EXPECT_FLOAT_EQ(instance.position.z, 3.0f);
+		// 残り寿命0.9/1.0でフェード
+		EXPECT_NEAR(instance.color.w, 0.9f, 1e-5f);
+	}
+}
+
+TEST(ParticleSimulationTest, ExpiredParticlesAreCompacted) {
+	ParticleSimulation simulation;
+	simulation.Initialize(64, 1);
+	ParticleSimulation::EmitterDesc shortLived = MakeDesc();
+	shortLived.lifetime = 0.05f;
+	simulation.Emit(shortLived, 20);
+	simulation.Emit(MakeDesc(), 30);
+
+	simulation.Update(0.1f);
+	EXPECT_EQ(simulation.GetAliveCount(), 30u);
+	EXPECT_EQ(simulation.GetStatistics().killedCount, 20u);
+
+	// 残ったのは寿命の長い方だけ
+	std::vector<ParticleSimulation::Instance> instances(simulation.GetAliveCount());
+	simulation.WriteInstances(instances.data());
+	for (const ParticleSimulation::Instance& instance : instances) {
+		EXPECT_GT(instance.color.w, 0.0f);
+	}
+}
+
+TEST(ParticleSimulationTest, EmitterPoolReusesSlots) {
+	ParticleSimulation simulation;
+	simulation.Initialize(1000, 2);
+	ParticleSimulation::EmitterDesc desc = MakeDesc();
+	desc.rate = 100.0f;
+	desc.duration = 0.5f;
+
+	uint32_t a = simulation.CreateEmitter(desc);
+	uint32_t b = simulation.CreateEmitter(desc);
+	EXPECT_NE(a, ParticleSimulation::kInvalidEmitter);
+	EXPECT_NE(b, ParticleSimulation::kInvalidEmitter);
+	EXPECT_EQ(simulation.CreateEmitter(desc), ParticleSimulation::kInvalidEmitter);
+
+	// 0.1秒で各10粒
+	simulation.Update(0.1f);
+	EXPECT_EQ(simulation.GetStatistics().emittedCount, 20u);
+
+	// 時間切れで自動的に返される
+	for (int i = 0; i < 5; i++) {
+		simulation.Update(0.1f);
+	}
+	EXPECT_NE(simulation.CreateEmitter(desc), ParticleSimulation::kInvalidEmitter);
+}
@@ -0,0 +1,32 @@
+// PROFILER_DISABLEDを定義したビルド（区間の計測をまるごと外したいとき）のProfilerのテスト
+#include "Profiler.h"
+#include <gtest/gtest.h>
+
+#ifndef PROFILER_DISABLED
+#error "ProfilerDisabledTest must be built with PROFILER_DISABLED"
+#endif
+
+namespace {
+
+TEST(ProfilerDisabledTest, SetEnabledIsIgnored) {
+	Profiler::SetEnabled(true);
+	EXPECT_FALSE(Profiler::IsEnabled());
+}
+
+TEST(ProfilerDisabledTest, ScopesCompileAwayAndRecordNothing) {
+	Profiler* profiler = Profiler::GetInstance();
+	Profiler::SetEnabled(true);
+	for (int i = 0; i < 100; i++) {
+		PROFILE_SCOPE("Disabled");
+	}
+	// 直接作ったマーカーも有効フラグを見るので記録しない
+	{
+		Profiler::ScopedMarker marker("DisabledMarker");
+	}
+	profiler->EndFrame();
+	EXPECT_TRUE(profiler->GetFrameEvents().empty());
+	EXPECT_TRUE(profiler->GetScopeStatistics().empty());
+	EXPECT_EQ(profiler->GetDroppedEventCount(), 0u);
+}
+
+} // namespace
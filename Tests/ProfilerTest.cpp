@@ -0,0 +1,284 @@
+// Profilerのテスト（リングバッファへの記録、集計、キャプチャとChrome traceの書き出し）
+#include "Profiler.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// 文字列中の部分文字列の数
+size_t CountOccurrences(const std::string& text, const std::string& pattern) {
+	size_t count = 0;
+	for (size_t position = text.find(pattern); position != std::string::npos;
+	     position = text.find(pattern, position + pattern.size())) {
+		count++;
+	}
+	return count;
+}
+
+// 名前の区間を直前のフレームから探す
+std::vector<Profiler::Event> FindEvents(const Profiler* profiler, std::string_view name) {
+	std::vector<Profiler::Event> events;
+	for (const Profiler::Event& event : profiler->GetFrameEvents()) {
+		if (name == event.name) {
+			events.push_back(event);
+		}
+	}
+	return events;
+}
+
+// シングルトンなので、テストごとにリングを空にして集計を捨てる
+class ProfilerTest : public testing::Test {
+protected:
+	void SetUp() override {
+		profiler_ = Profiler::GetInstance();
+		Profiler::SetEnabled(false);
+		profiler_->EndFrame();
+		profiler_->Reset();
+		Profiler::SetEnabled(true);
+	}
+	void TearDown() override { Profiler::SetEnabled(false); }
+
+	Profiler* profiler_ = nullptr;
+};
+
+TEST_F(ProfilerTest, DisabledScopesAreNotRecorded) {
+	Profiler::SetEnabled(false);
+	for (int i = 0; i < 100; i++) {
+		PROFILE_SCOPE("Disabled");
+	}
+	profiler_->EndFrame();
+	EXPECT_TRUE(profiler_->GetFrameEvents().empty());
+	EXPECT_TRUE(profiler_->GetScopeStatistics().empty());
+}
+
+TEST_F(ProfilerTest, ScopeUsesStateAtBegin) {
+	// 無効の間に始めた区間は、途中で有効にしても記録しない
+	Profiler::SetEnabled(false);
+	{
+		PROFILE_SCOPE("StartedDisabled");
+		Profiler::SetEnabled(true);
+	}
+	// 有効の間に始めた区間は、途中で無効にしても記録する
+	{
+		PROFILE_SCOPE("StartedEnabled");
+		Profiler::SetEnabled(false);
+	}
+	profiler_->EndFrame();
+	EXPECT_TRUE(FindEvents(profiler_, "StartedDisabled").empty());
+	EXPECT_EQ(FindEvents(profiler_, "StartedEnabled").size(), 1u);
+}
+
+TEST_F(ProfilerTest, NestedScopesRecordDepthAndContainment) {
+	{
+		PROFILE_SCOPE("Outer");
+		{
+			PROFILE_SCOPE("Inner");
+		}
+		{
+			PROFILE_SCOPE("Inner");
+		}
+	}
+	profiler_->EndFrame();
+
+	// 内側から先に閉じるので、リングには内側が先に入る
+	const std::vector<Profiler::Event>& events = profiler_->GetFrameEvents();
+	ASSERT_EQ(events.size(), 3u);
+	EXPECT_STREQ(events[0].name, "Inner");
+	EXPECT_STREQ(events[1].name, "Inner");
+	EXPECT_STREQ(events[2].name, "Outer");
+
+	const Profiler::Event& outer = events[2];
+	EXPECT_EQ(outer.depth, 0u);
+	for (size_t i = 0; i < 2; i++) {
+		EXPECT_EQ(events[i].depth, 1u);
+		EXPECT_LE(events[i].begin, events[i].end);
+		EXPECT_GE(events[i].begin, outer.begin);
+		EXPECT_LE(events[i].end, outer.end);
+	}
+	EXPECT_LE(events[0].end, events[1].begin);
+}
+
+TEST_F(ProfilerTest, EndFrameDrainsRing) {
+	for (int frame = 0; frame < 3; frame++) {
+		for (int i = 0; i < 10; i++) {
+			PROFILE_SCOPE("Drained");
+		}
+		profiler_->EndFrame();
+		EXPECT_EQ(profiler_->GetFrameEvents().size(), 10u);
+	}
+	profiler_->EndFrame();
+	EXPECT_TRUE(profiler_->GetFrameEvents().empty());
+}
+
+TEST_F(ProfilerTest, FullRingDropsAndCountsEvents) {
+	// 捨てた数はリングごとの累計なので、差で見る
+	uint64_t droppedBefore = profiler_->GetDroppedEventCount();
+	const uint32_t kOverflow = 100;
+	for (uint32_t i = 0; i < Profiler::kRingCapacity + kOverflow; i++) {
+		PROFILE_SCOPE("Overflow");
+	}
+	profiler_->EndFrame();
+	EXPECT_EQ(profiler_->GetFrameEvents().size(), size_t(Profiler::kRingCapacity));
+	EXPECT_EQ(profiler_->GetDroppedEventCount() - droppedBefore, kOverflow);
+
+	// 回収した後は、また全部入る
+	for (uint32_t i = 0; i < Profiler::kRingCapacity; i++) {
+		PROFILE_SCOPE("Overflow");
+	}
+	profiler_->EndFrame();
+	EXPECT_EQ(profiler_->GetFrameEvents().size(), size_t(Profiler::kRingCapacity));
+	EXPECT_EQ(profiler_->GetDroppedEventCount() - droppedBefore, kOverflow);
+}
+
+TEST_F(ProfilerTest, ScopeStatisticsTrackCallsAndOrderedPercentiles) {
+	for (int frame = 0; frame < 10; frame++) {
+		for (int i = 0; i <= frame; i++) {
+			PROFILE_SCOPE("Counted");
+		}
+		profiler_->EndFrame();
+	}
+
+	const std::vector<Profiler::ScopeStatistics>& statistics = profiler_->GetScopeStatistics();
+	ASSERT_EQ(statistics.size(), 1u);
+	const Profiler::ScopeStatistics& counted = statistics[0];
+	EXPECT_EQ(counted.name, "Counted");
+	EXPECT_EQ(counted.callCount, 10u);
+	EXPECT_GE(counted.lastMilliseconds, 0.0);
+	EXPECT_LE(counted.p50Milliseconds, counted.p95Milliseconds);
+	EXPECT_LE(counted.p95Milliseconds, counted.p99Milliseconds);
+	EXPECT_LE(counted.p99Milliseconds, counted.maxMilliseconds);
+	EXPECT_LE(counted.averageMilliseconds, counted.maxMilliseconds);
+	EXPECT_LE(counted.lastMilliseconds, counted.maxMilliseconds);
+
+	// 呼ばれなかったフレームは0回になる
+	profiler_->EndFrame();
+	EXPECT_EQ(profiler_->GetScopeStatistics()[0].callCount, 0u);
+	EXPECT_EQ(profiler_->GetScopeStatistics()[0].lastMilliseconds, 0.0);
+}
+
+TEST_F(ProfilerTest, WorkerThreadEventsHaveTheirOwnThreadId) {
+	PROFILE_SCOPE("MainThread");
+	std::thread worker([] {
+		Profiler::GetInstance()->SetThreadName("Worker");
+		for (int i = 0; i < 5; i++) {
+			PROFILE_SCOPE("WorkerThread");
+		}
+	});
+	worker.join();
+	profiler_->EndFrame();
+
+	std::vector<Profiler::Event> workerEvents = FindEvents(profiler_, "WorkerThread");
+	ASSERT_EQ(workerEvents.size(), 5u);
+	std::set<uint32_t> threadIds;
+	for (const Profiler::Event& event : workerEvents) {
+		threadIds.insert(event.threadId);
+		EXPECT_EQ(event.depth, 0u);
+	}
+	EXPECT_EQ(threadIds.size(), 1u);
+
+	// メインスレッドの区間はまだ閉じていないので、このフレームには無い
+	EXPECT_TRUE(FindEvents(profiler_, "MainThread").empty());
+}
+
+TEST_F(ProfilerTest, CaptureStopsAfterRequestedFrames) {
+	EXPECT_FALSE(profiler_->IsCapturing());
+	profiler_->BeginCapture(2);
+	EXPECT_TRUE(profiler_->IsCapturing());
+	for (int frame = 0; frame < 4; frame++) {
+		PROFILE_SCOPE("Captured");
+		for (int i = 0; i < frame; i++) {
+			PROFILE_SCOPE("CapturedInner");
+		}
+		profiler_->EndFrame();
+	}
+	EXPECT_FALSE(profiler_->IsCapturing());
+
+	// CapturedはEndFrameの後に閉じるので次のフレームで回収される。
+	// 2フレーム分は、1フレーム目の内側（無し）と2フレーム目の内側1回、1フレーム目のCaptured
+	size_t innerCount = 0;
+	for (const Profiler::Event& event : profiler_->GetCapturedEvents()) {
+		innerCount += std::string_view(event.name) == "CapturedInner";
+	}
+	EXPECT_EQ(profiler_->GetCapturedEvents().size(), 2u);
+	EXPECT_EQ(innerCount, 1u);
+}
+
+TEST_F(ProfilerTest, ChromeTraceListsThreadsAndCapturedEvents) {
+	std::thread worker([] {
+		Profiler::GetInstance()->SetThreadName("Worker \"A\"\\");
+		PROFILE_SCOPE("Worker::Job");
+	});
+	worker.join();
+
+	profiler_->BeginCapture(1);
+	{
+		PROFILE_SCOPE("Update");
+		PROFILE_SCOPE("Update\tInner");
+	}
+	profiler_->EndFrame();
+	ASSERT_EQ(profiler_->GetCapturedEvents().size(), 3u);
+
+	std::string json = profiler_->ToChromeTrace();
+	EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", 0), 0u);
+	EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+
+	// 区間は完了イベント、スレッド名はメタデータ
+	EXPECT_EQ(CountOccurrences(json, "\"ph\":\"X\""), 3u);
+	EXPECT_NE(json.find("\"name\":\"Worker::Job\""), std::string::npos);
+	EXPECT_NE(json.find("\"name\":\"Update\""), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"M\""), std::string::npos);
+
+	// 引用符、バックスラッシュ、制御文字はエスケープする
+	EXPECT_NE(json.find("\"args\":{\"name\":\"Worker \\\"A\\\"\\\\\"}"), std::string::npos);
+	EXPECT_NE(json.find("\"name\":\"Update\\u0009Inner\""), std::string::npos);
+	EXPECT_EQ(json.find('\t'), std::string::npos);
+
+	// 時刻はキャプチャの最初の区間からなので、最小は0で負にならない
+	EXPECT_NE(json.find("\"ts\":0.000,"), std::string::npos);
+	EXPECT_EQ(json.find("\"ts\":-"), std::string::npos);
+	EXPECT_EQ(json.find("\"dur\":-"), std::string::npos);
+
+	// 括弧が対応している
+	EXPECT_EQ(std::count(json.begin(), json.end(), '['), std::count(json.begin(), json.end(), ']'));
+}
+
+TEST_F(ProfilerTest, WriteChromeTraceWritesSameText) {
+	profiler_->BeginCapture(1);
+	{
+		PROFILE_SCOPE("Written");
+	}
+	profiler_->EndFrame();
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "ProfilerTestTrace.json";
+	ASSERT_TRUE(profiler_->WriteChromeTrace(path.string()));
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream text;
+	text << file.rdbuf();
+	file.close();
+	std::filesystem::remove(path);
+	EXPECT_EQ(text.str(), profiler_->ToChromeTrace());
+
+	EXPECT_FALSE(profiler_->WriteChromeTrace((path / "missing" / "trace.json").string()));
+}
+
+TEST_F(ProfilerTest, ResetClearsStatisticsAndCapture) {
+	profiler_->BeginCapture(5);
+	{
+		PROFILE_SCOPE("BeforeReset");
+	}
+	profiler_->EndFrame();
+	ASSERT_FALSE(profiler_->GetScopeStatistics().empty());
+
+	profiler_->Reset();
+	EXPECT_TRUE(profiler_->GetScopeStatistics().empty());
+	EXPECT_TRUE(profiler_->GetCapturedEvents().empty());
+	EXPECT_TRUE(profiler_->GetFrameEvents().empty());
+	EXPECT_FALSE(profiler_->IsCapturing());
+}
+
+} // namespace
@@ -0,0 +1,139 @@
+// クォータニオンから行列を作る経路の計測（オイラー角経由、直接、まとめて作る版）
+#include "MyMath.h"
+#include "Quaternion.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 1024個を順に処理する（キャッシュに乗る大きさ）
+const size_t kTransformCount = 1024;
+
+struct Transforms {
+	std::vector<Quaternion> rotates;
+	std::vector<Vector3> scales;
+	std::vector<Vector3> translates;
+	std::vector<Matrix4x4> matrices;
+
+	Transforms() {
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		for (size_t i = 0; i < kTransformCount; i++) {
+			Quaternion rotate(
+			    distribution(random), distribution(random), distribution(random),
+			    distribution(random));
+			rotate.Normalize();
+			rotates.push_back(rotate);
+			scales.push_back({1.0f, 1.0f, 1.0f});
+			translates.push_back(
+			    {distribution(random), distribution(random), distribution(random)});
+		}
+		matrices.resize(kTransformCount);
+	}
+};
+
+// 変更前の経路（オイラー角に戻して3つの回転行列を掛ける）
+void BM_MakeAffineMatrixViaEuler(benchmark::State& state) {
+	Transforms transforms;
+	for (auto _ : state) {
+		for (size_t i = 0; i < kTransformCount; i++) {
+			transforms.matrices[i] = MakeAffineMatrix(
+			    transforms.scales[i], QuaternionToEuler(transforms.rotates[i]),
+			    transforms.translates[i]);
+		}
+		benchmark::DoNotOptimize(transforms.matrices.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+void BM_MakeAffineMatrix(benchmark::State& state) {
+	Transforms transforms;
+	for (auto _ : state) {
+		for (size_t i = 0; i < kTransformCount; i++) {
+			transforms.matrices[i] = MakeAffineMatrix(
+			    transforms.scales[i], transforms.rotates[i], transforms.translates[i]);
+		}
+		benchmark::DoNotOptimize(transforms.matrices.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+void BM_MakeAffineMatrices(benchmark::State& state) {
+	Transforms transforms;
+	for (auto _ : state) {
+		MakeAffineMatrices(
+		    transforms.scales.data(), transforms.rotates.data(), transforms.translates.data(),
+		    kTransformCount, transforms.matrices.data());
+		benchmark::DoNotOptimize(transforms.matrices.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+// ベクトルの回転（変更前のq * v * q^-1と、展開した式）
+void BM_RotateVectorSandwich(benchmark::State& state) {
+	Transforms transforms;
+	Vector3 v = {0.1f, 0.2f, 0.3f};
+	for (auto _ : state) {
+		for (size_t i = 0; i < kTransformCount; i++) {
+			const Quaternion& q = transforms.rotates[i];
+			Quaternion result = q * Quaternion(0.0f, v.x, v.y, v.z) * q.Conjugate();
+			v = {result.x, result.y, result.z};
+		}
+		benchmark::DoNotOptimize(v);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+void BM_RotateVector(benchmark::State& state) {
+	Transforms transforms;
+	Vector3 v = {0.1f, 0.2f, 0.3f};
+	for (auto _ : state) {
+		for (size_t i = 0; i < kTransformCount; i++) {
+			v = transforms.rotates[i] * v;
+		}
+		benchmark::DoNotOptimize(v);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+void BM_Slerp(benchmark::State& state) {
+	Transforms transforms;
+	std::vector<Quaternion> results(kTransformCount);
+	for (auto _ : state) {
+		for (size_t i = 0; i < kTransformCount; i++) {
+			results[i] = Slerp(
+			    transforms.rotates[i], transforms.rotates[(i + 1) % kTransformCount], 0.3f);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+void BM_Nlerp(benchmark::State& state) {
+	Transforms transforms;
+	std::vector<Quaternion> results(kTransformCount);
+	for (auto _ : state) {
+		for (size_t i = 0; i < kTransformCount; i++) {
+			results[i] = Nlerp(
+			    transforms.rotates[i], transforms.rotates[(i + 1) % kTransformCount], 0.3f);
+		}
+		benchmark::DoNotOptimize(results.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kTransformCount);
+}
+
+} // namespace
+
+BENCHMARK(BM_MakeAffineMatrixViaEuler)->Name("MakeAffineMatrix/euler");
+BENCHMARK(BM_MakeAffineMatrix)->Name("MakeAffineMatrix/quaternion");
+BENCHMARK(BM_MakeAffineMatrices)->Name("MakeAffineMatrices/quaternion");
+BENCHMARK(BM_RotateVectorSandwich)->Name("RotateVector/sandwich");
+BENCHMARK(BM_RotateVector)->Name("RotateVector/fused");
+BENCHMARK(BM_Slerp)->Name("Slerp");
+BENCHMARK(BM_Nlerp)->Name("Nlerp");
@@ -0,0 +1,214 @@
+// クォータニオンから行列を作る経路のテスト（オイラー角経由、倍精度の参照、まとめて作る版を比べる）
+#include "MyMath.h"
+#include "Quaternion.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// SIMDで4個ずつ処理した後の端数も通る数
+const size_t kSampleCount = 4099;
+
+// ランダムな単位クォータニオンと拡大率、平行移動
+struct Samples {
+	std::vector<Quaternion> rotates;
+	std::vector<Vector3> scales;
+	std::vector<Vector3> translates;
+};
+
+Samples MakeSamples(size_t count) {
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	Samples samples;
+	for (size_t i = 0; i < count; i++) {
+		Quaternion rotate(
+		    distribution(random), distribution(random), distribution(random), distribution(random));
+		rotate.Normalize();
+		samples.rotates.push_back(rotate);
+		samples.scales.push_back(
+		    {distribution(random) + 2.0f, distribution(random) + 2.0f, distribution(random) + 2.0f});
+		samples.translates.push_back(
+		    {distribution(random) * 10.0f, distribution(random) * 10.0f, distribution(random) * 10.0f});
+	}
+	return samples;
+}
+
+// 倍精度で求めたアフィン行列（行ベクトル形式）
+void AffineReference(
+    const Vector3& scale, const Quaternion& q, const Vector3& translate, double result[4][4]) {
+	double w = q.w, x = q.x, y = q.y, z = q.z;
+	double rotate[3][3] = {
+	    {1 - 2 * (y * y + z * z), 2 * (x * y + z * w), 2 * (x * z - y * w)},
+	    {2 * (x * y - z * w), 1 - 2 * (x * x + z * z), 2 * (y * z + x * w)},
+	    {2 * (x * z + y * w), 2 * (y * z - x * w), 1 - 2 * (x * x + y * y)},
+	};
+	double scales[3] = {scale.x, scale.y, scale.z};
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			result[i][j] = rotate[i][j] * scales[i];
+		}
+		result[i][3] = 0.0;
+	}
+	result[3][0] = translate.x;
+	result[3][1] = translate.y;
+	result[3][2] = translate.z;
+	result[3][3] = 1.0;
+}
+
+double MaxDifference(const Matrix4x4& a, const Matrix4x4& b) {
+	double maxError = 0.0;
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			maxError = std::max(maxError, double(std::abs(a.m[i][j] - b.m[i][j])));
+		}
+	}
+	return maxError;
+}
+
+double MaxDifference(const Vector3& a, const Vector3& b) {
+	return std::max({std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z)});
+}
+
+// 変更前のoperator*(Vector3)（q * v * q^-1 をそのまま計算する）
+Vector3 RotateBySandwich(const Quaternion& q, const Vector3& v) {
+	Quaternion result = q * Quaternion(0.0f, v.x, v.y, v.z) * q.Conjugate();
+	return {result.x, result.y, result.z};
+}
+
+} // namespace
+
+TEST(QuaternionTest, ToMatrixFillsFourthRowAndColumn) {
+	Quaternion rotate(0.5f, 0.5f, -0.5f, 0.5f);
+	Matrix4x4 matrix = rotate.ToMatrix();
+	for (int i = 0; i < 3; i++) {
+		EXPECT_EQ(matrix.m[i][3], 0.0f);
+		EXPECT_EQ(matrix.m[3][i], 0.0f);
+	}
+	EXPECT_EQ(matrix.m[3][3], 1.0f);
+}
+
+TEST(QuaternionTest, ToMatrixMatchesRotateMatrices) {
+	// 行ベクトル形式でMakeRotateXMatrix等と同じ向きに回る
+	const float angle = 0.7f;
+	const Vector3 axes[] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+	const Matrix4x4 expected[] = {
+	    MakeRotateXMatrix(angle), MakeRotateYMatrix(angle), MakeRotateZMatrix(angle)};
+	for (int axis = 0; axis < 3; axis++) {
+		Matrix4x4 matrix = Quaternion::FromAxisAngle(axes[axis], angle).ToMatrix();
+		EXPECT_LT(MaxDifference(matrix, expected[axis]), 1e-6) << "axis " << axis;
+	}
+}
+
+TEST(QuaternionTest, MakeAffineMatrixMatchesReference) {
+	Samples samples = MakeSamples(kSampleCount);
+	double maxError = 0.0;
+	for (size_t i = 0; i < kSampleCount; i++) {
+		Matrix4x4 matrix =
+		    MakeAffineMatrix(samples.scales[i], samples.rotates[i], samples.translates[i]);
+		double expected[4][4];
+		AffineReference(samples.scales[i], samples.rotates[i], samples.translates[i], expected);
+		for (int row = 0; row < 4; row++) {
+			for (int column = 0; column < 4; column++) {
+				maxError =
+				    std::max(maxError, std::abs(matrix.m[row][column] - expected[row][column]));
+			}
+		}
+	}
+	// 拡大率は3未満なので、floatの丸め数回分
+	EXPECT_LT(maxError, 2e-6);
+}
+
+TEST(QuaternionTest, MakeAffineMatricesMatchesSingleExactly) {
+	// SIMD版も同じ順序で同じ演算をするので、1個ずつ作ったものとビット単位で一致する
+	Samples samples = MakeSamples(kSampleCount);
+	std::vector<Matrix4x4> matrices(kSampleCount);
+	MakeAffineMatrices(
+	    samples.scales.data(), samples.rotates.data(), samples.translates.data(), kSampleCount,
+	    matrices.data());
+	for (size_t i = 0; i < kSampleCount; i++) {
+		Matrix4x4 expected =
+		    MakeAffineMatrix(samples.scales[i], samples.rotates[i], samples.translates[i]);
+		ASSERT_EQ(MaxDifference(matrices[i], expected), 0.0) << "index " << i;
+	}
+}
+
+TEST(QuaternionTest, EulerPathMatchesQuaternionPath) {
+	// 変更前の経路（オイラー角に戻してから3つの回転行列）と同じ行列になる
+	Samples samples = MakeSamples(kSampleCount);
+	double maxError = 0.0;
+	size_t comparedCount = 0;
+	for (size_t i = 0; i < kSampleCount; i++) {
+		Vector3 euler = QuaternionToEuler(samples.rotates[i]);
+		// ジンバルロック付近はオイラー角の精度が落ちるので比べない
+		if (std::abs(std::abs(euler.y) - 1.5707963f) < 0.05f) {
+			continue;
+		}
+		Matrix4x4 viaEuler = MakeAffineMatrix(samples.scales[i], euler, samples.translates[i]);
+		Matrix4x4 direct =
+		    MakeAffineMatrix(samples.scales[i], samples.rotates[i], samples.translates[i]);
+		maxError = std::max(maxError, MaxDifference(viaEuler, direct));
+		comparedCount++;
+	}
+	EXPECT_GT(comparedCount, kSampleCount * 9 / 10);
+	EXPECT_LT(maxError, 2e-5);
+}
+
+TEST(QuaternionTest, RotateVectorMatchesSandwichAndMatrix) {
+	Samples samples = MakeSamples(kSampleCount);
+	std::mt19937 random(6);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	double maxError = 0.0;
+	for (size_t i = 0; i < kSampleCount; i++) {
+		const Quaternion& rotate = samples.rotates[i];
+		Vector3 v = {distribution(random), distribution(random), distribution(random)};
+		Vector3 fused = rotate * v;
+		maxError = std::max(maxError, MaxDifference(fused, RotateBySandwich(rotate, v)));
+		maxError = std::max(maxError, MaxDifference(fused, TransformVector3(v, rotate.ToMatrix())));
+	}
+	EXPECT_LT(maxError, 1e-6);
+}
+
+TEST(QuaternionTest, SlerpKeepsUnitLengthAndEndpoints) {
+	Samples samples = MakeSamples(256);
+	for (size_t i = 0; i + 1 < samples.rotates.size(); i++) {
+		const Quaternion& q0 = samples.rotates[i];
+		const Quaternion& q1 = samples.rotates[i + 1];
+		EXPECT_NEAR(std::abs(Dot(Slerp(q0, q1, 0.0f), q0)), 1.0f, 1e-5f);
+		EXPECT_NEAR(std::abs(Dot(Slerp(q0, q1, 1.0f), q1)), 1.0f, 1e-5f);
+		for (float t = 0.125f; t < 1.0f; t += 0.125f) {
+			Quaternion slerp = Slerp(q0, q1, t);
+			Quaternion nlerp = Nlerp(q0, q1, t);
+			EXPECT_NEAR(Dot(slerp, slerp), 1.0f, 1e-5f);
+			EXPECT_NEAR(Dot(nlerp, nlerp), 1.0f, 1e-5f);
+		}
+	}
+}
+
+TEST(QuaternionTest, SlerpTakesShortestPath) {
+	// q1と-q1は同じ回転なので、どちらに補間しても同じ回転になる
+	Quaternion q0 = Quaternion::FromAxisAngle({0.0f, 0.0f, 1.0f}, 0.2f);
+	Quaternion q1 = Quaternion::FromAxisAngle({0.0f, 0.0f, 1.0f}, 1.0f);
+	for (float t = 0.0f; t <= 1.0f; t += 0.25f) {
+		Matrix4x4 expected = MakeRotateZMatrix(0.2f + 0.8f * t);
+		EXPECT_LT(MaxDifference(Slerp(q0, q1, t).ToMatrix(), expected), 1e-6);
+		EXPECT_LT(MaxDifference(Slerp(q0, -q1, t).ToMatrix(), expected), 1e-6);
+	}
+}
+
+TEST(QuaternionTest, SlerpHasConstantAngularVelocity) {
+	// カメラ反転と同じく、0→180度と180→360度の2区間を30フレームで回す
+	const Quaternion keys[] = {
+	    Quaternion::Identity(), Quaternion(0.0f, 0.0f, 0.0f, 1.0f), -Quaternion::Identity()};
+	double maxError = 0.0;
+	for (int frame = 0; frame <= 30; frame++) {
+		float t = float(frame) / 30.0f;
+		int segment = t < 0.5f ? 0 : 1;
+		Quaternion rotate = Slerp(keys[segment], keys[segment + 1], t * 2.0f - float(segment));
+		Matrix4x4 expected = MakeRotateZMatrix(3.14159265f * 2.0f * t);
+		maxError = std::max(maxError, MaxDifference(rotate.ToMatrix(), expected));
+	}
+	EXPECT_LT(maxError, 1e-6);
+}
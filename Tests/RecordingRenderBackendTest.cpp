@@ -0,0 +1,192 @@
+// RecordingRenderBackendのテスト（GPUなしでコマンドの記録、冗長な状態設定の検出、転送を確かめる）
+#include "RecordingRenderBackend.h"
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace {
+
+using Command = RecordingRenderCommandList::Command;
+
+// 仮のルートシグネチャとパイプラインステート（アドレスだけ使う）
+int rootSignatureA;
+int rootSignatureB;
+int pipelineStateA;
+int pipelineStateB;
+
+} // namespace
+
+TEST(RecordingRenderDeviceTest, UploadBuffersAreWritableAndDoNotOverlap) {
+	RecordingRenderDevice device;
+	RenderDevice::UploadBuffer first = device.CreateUploadBuffer(100);
+	RenderDevice::UploadBuffer second = device.CreateUploadBuffer(0x20000);
+	RenderDevice::UploadBuffer third = device.CreateUploadBuffer(16);
+
+	ASSERT_NE(first.cpuAddress, nullptr);
+	ASSERT_NE(second.cpuAddress, nullptr);
+	EXPECT_EQ(first.gpuAddress, RecordingRenderDevice::kBaseGpuAddress);
+	EXPECT_EQ(first.size, 100u);
+	// 実機と同じく64KB単位で並ぶ
+	EXPECT_EQ(second.gpuAddress, first.gpuAddress + 0x10000);
+	EXPECT_EQ(third.gpuAddress, second.gpuAddress + 0x20000);
+	EXPECT_EQ(device.GetAllocatedBytes(), 0x40000u);
+
+	std::memset(first.cpuAddress, 0xAB, size_t(first.size));
+	std::memset(second.cpuAddress, 0xCD, size_t(second.size));
+	EXPECT_EQ(first.cpuAddress[99], 0xAB);
+	EXPECT_EQ(second.cpuAddress[0], 0xCD);
+}
+
+TEST(RecordingRenderCommandListTest, RecordsCommandsInOrder) {
+	RecordingRenderCommandList commandList;
+	commandList.SetRootSignature(&rootSignatureA);
+	commandList.SetPipelineState(&pipelineStateA);
+	commandList.SetPrimitiveTopology(RenderCommandList::PrimitiveTopology::kTriangleList);
+	commandList.SetVertexBuffer({0x1000, 96, 32});
+	commandList.SetIndexBuffer({0x2000, 12, false});
+	commandList.SetConstantBuffer(0, 0x3000);
+	commandList.SetShaderResource(1, 0x4000);
+	commandList.SetTexture(2, 7);
+	commandList.DrawIndexed(6, 2, 3, -1, 4);
+	commandList.Draw(3, 1, 0, 0);
+
+	const std::vector<Command>& commands = commandList.GetCommands();
+	ASSERT_EQ(commands.size(), 10u);
+	EXPECT_EQ(commands[0].type, Command::Type::kSetRootSignature);
+	EXPECT_EQ(commands[0].value, uint64_t(reinterpret_cast<uintptr_t>(&rootSignatureA)));
+	EXPECT_EQ(commands[2].value, uint64_t(RenderCommandList::PrimitiveTopology::kTriangleList));
+	EXPECT_EQ(commands[3].value, 0x1000u);
+	EXPECT_EQ(commands[3].count, 96u);
+	EXPECT_EQ(commands[5].type, Command::Type::kSetConstantBuffer);
+	EXPECT_EQ(commands[5].rootParameterIndex, 0u);
+	EXPECT_EQ(commands[6].type, Command::Type::kSetShaderResource);
+	EXPECT_EQ(commands[7].type, Command::Type::kSetTexture);
+	EXPECT_EQ(commands[7].value, 7u);
+
+	const Command& drawIndexed = commands[8];
+	EXPECT_EQ(drawIndexed.type, Command::Type::kDrawIndexed);
+	EXPECT_EQ(drawIndexed.count, 6u);
+	EXPECT_EQ(drawIndexed.instanceCount, 2u);
+	EXPECT_EQ(drawIndexed.start, 3u);
+	EXPECT_EQ(drawIndexed.baseVertex, -1);
+	EXPECT_EQ(drawIndexed.startInstance, 4u);
+
+	const RecordingRenderCommandList::Statistics& statistics = commandList.GetStatistics();
+	EXPECT_EQ(statistics.drawCallCount, 2u);
+	EXPECT_EQ(statistics.instanceCount, 3u);
+	EXPECT_EQ(statistics.stateChangeCount, 8u);
+	EXPECT_EQ(statistics.redundantStateCount, 0u);
+	EXPECT_EQ(statistics.pipelineChangeCount, 1u);
+	EXPECT_EQ(statistics.textureChangeCount, 1u);
+}
+
+TEST(RecordingRenderCommandListTest, CountsRedundantStates) {
+	RecordingRenderCommandList commandList;
+	commandList.SetRootSignature(&rootSignatureA);
+	commandList.SetPipelineState(&pipelineStateA);
+	commandList.SetConstantBuffer(0, 0x3000);
+	commandList.SetTexture(1, 5);
+
+	// 同じ値の設定し直し
+	commandList.SetRootSignature(&rootSignatureA);
+	commandList.SetPipelineState(&pipelineStateA);
+	commandList.SetConstantBuffer(0, 0x3000);
+	commandList.SetTexture(1, 5);
+	// 違うルートパラメータ番号は別の状態
+	commandList.SetConstantBuffer(2, 0x3000);
+	commandList.SetPipelineState(&pipelineStateB);
+
+	const RecordingRenderCommandList::Statistics& statistics = commandList.GetStatistics();
+	EXPECT_EQ(statistics.stateChangeCount, 6u);
+	EXPECT_EQ(statistics.redundantStateCount, 4u);
+	EXPECT_EQ(statistics.pipelineChangeCount, 2u);
+	EXPECT_EQ(statistics.textureChangeCount, 1u);
+
+	const std::vector<Command>& commands = commandList.GetCommands();
+	ASSERT_EQ(commands.size(), 10u);
+	for (size_t i = 0; i < commands.size(); i++) {
+		EXPECT_EQ(commands[i].isRedundant, 4 <= i && i < 8) << "command " << i;
+	}
+}
+
+TEST(RecordingRenderCommandListTest, RootSignatureChangeInvalidatesRootParameters) {
+	RecordingRenderCommandList commandList;
+	commandList.SetRootSignature(&rootSignatureA);
+	commandList.SetConstantBuffer(0, 0x3000);
+	commandList.SetTexture(1, 5);
+
+	// ルートシグネチャが変わると同じ値でも設定し直しが必要
+	commandList.SetRootSignature(&rootSignatureB);
+	commandList.SetConstantBuffer(0, 0x3000);
+	commandList.SetTexture(1, 5);
+	EXPECT_EQ(commandList.GetStatistics().redundantStateCount, 0u);
+
+	// 同じルートシグネチャの設定し直しでは無効にならない
+	commandList.SetRootSignature(&rootSignatureB);
+	commandList.SetConstantBuffer(0, 0x3000);
+	EXPECT_EQ(commandList.GetStatistics().redundantStateCount, 2u);
+}
+
+TEST(RecordingRenderCommandListTest, ResetClearsRecordAndState) {
+	RecordingRenderCommandList commandList;
+	commandList.SetPipelineState(&pipelineStateA);
+	commandList.Draw(3, 1, 0, 0);
+	commandList.AddUploadBytes(128);
+
+	commandList.Reset();
+	EXPECT_TRUE(commandList.GetCommands().empty());
+	EXPECT_EQ(commandList.GetStatistics().drawCallCount, 0u);
+	EXPECT_EQ(commandList.GetStatistics().uploadBytes, 0u);
+
+	// リセット後の最初の設定は冗長扱いにならない
+	commandList.SetPipelineState(&pipelineStateA);
+	EXPECT_EQ(commandList.GetStatistics().redundantStateCount, 0u);
+	EXPECT_EQ(commandList.GetStatistics().pipelineChangeCount, 1u);
+}
+
+TEST(RecordingRenderCommandListTest, StatisticsOnlyModeKeepsNoCommands) {
+	RecordingRenderCommandList commandList;
+	commandList.SetRecordsCommands(false);
+	commandList.SetPipelineState(&pipelineStateA);
+	commandList.SetPipelineState(&pipelineStateA);
+	commandList.Draw(3, 4, 0, 0);
+	commandList.AddUploadBytes(64);
+	commandList.AddUploadBytes(32);
+
+	EXPECT_TRUE(commandList.GetCommands().empty());
+	const RecordingRenderCommandList::Statistics& statistics = commandList.GetStatistics();
+	EXPECT_EQ(statistics.drawCallCount, 1u);
+	EXPECT_EQ(statistics.instanceCount, 4u);
+	EXPECT_EQ(statistics.redundantStateCount, 1u);
+	EXPECT_EQ(statistics.uploadBytes, 96u);
+}
+
+TEST(RecordingRenderCommandListTest, ForwardsEveryCommandIncludingRedundantOnes) {
+	// 流し先にはそのまま全部渡す（冗長かどうかは数えるだけ）
+	RecordingRenderCommandList target;
+	RecordingRenderCommandList recorder(&target);
+	recorder.SetRecordsCommands(false);
+
+	recorder.SetRootSignature(&rootSignatureA);
+	recorder.SetPipelineState(&pipelineStateA);
+	recorder.SetPipelineState(&pipelineStateA);
+	recorder.SetPrimitiveTopology(RenderCommandList::PrimitiveTopology::kLineList);
+	recorder.SetVertexBuffer({0x1000, 96, 32});
+	recorder.SetIndexBuffer({0x2000, 12, true});
+	recorder.SetConstantBuffer(0, 0x3000);
+	recorder.SetShaderResource(1, 0x4000);
+	recorder.SetTexture(2, 9);
+	recorder.Draw(2, 1, 0, 0);
+	recorder.DrawIndexed(6, 1, 0, 0, 0);
+	recorder.AddUploadBytes(48);
+
+	EXPECT_EQ(target.GetCommands().size(), 11u);
+	EXPECT_EQ(target.GetStatistics().drawCallCount, 2u);
+	EXPECT_EQ(target.GetStatistics().redundantStateCount, 1u);
+	EXPECT_EQ(target.GetStatistics().uploadBytes, 48u);
+
+	// 流し先を外すと記録側だけに残る
+	recorder.SetForward(nullptr);
+	recorder.Draw(3, 1, 0, 0);
+	EXPECT_EQ(target.GetStatistics().drawCallCount, 2u);
+	EXPECT_EQ(recorder.GetStatistics().drawCallCount, 3u);
+}
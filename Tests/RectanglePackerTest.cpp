@@ -0,0 +1,112 @@
+// アトラスの矩形パッキングのテスト
+#include "RectanglePacker.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+using Sizes = std::vector<std::pair<uint32_t, uint32_t>>;
+
+// 同じページの矩形が余白込みで重ならず、ページからはみ出さないこと
+void ExpectNoOverlap(
+    const Sizes& sizes, const std::vector<RectanglePacker::Placement>& placements,
+    uint32_t pageSize, uint32_t padding) {
+	for (size_t i = 0; i < sizes.size(); i++) {
+		const RectanglePacker::Placement& a = placements[i];
+		if (a.page == RectanglePacker::kInvalidPage) {
+			continue;
+		}
+		EXPECT_GE(a.x, padding) << "image " << i;
+		EXPECT_GE(a.y, padding) << "image " << i;
+		EXPECT_LE(a.x + sizes[i].first + padding, pageSize) << "image " << i;
+		EXPECT_LE(a.y + sizes[i].second + padding, pageSize) << "image " << i;
+
+		for (size_t j = i + 1; j < sizes.size(); j++) {
+			const RectanglePacker::Placement& b = placements[j];
+			if (b.page != a.page) {
+				continue;
+			}
+			bool separated = a.x + sizes[i].first + padding * 2 <= b.x ||
+			                 b.x + sizes[j].first + padding * 2 <= a.x ||
+			                 a.y + sizes[i].second + padding * 2 <= b.y ||
+			                 b.y + sizes[j].second + padding * 2 <= a.y;
+			EXPECT_TRUE(separated) << "images " << i << " and " << j;
+		}
+	}
+}
+
+} // namespace
+
+TEST(RectanglePackerTest, EmptyInputHasNoPages) {
+	RectanglePacker::Statistics statistics;
+	std::vector<RectanglePacker::Placement> placements =
+	    RectanglePacker::Pack({}, 256, 2, statistics);
+	EXPECT_TRUE(placements.empty());
+	EXPECT_EQ(statistics.pageCount, 0u);
+	EXPECT_EQ(statistics.GetOccupancy(), 0.0);
+}
+
+TEST(RectanglePackerTest, UiImagesFitOnePage) {
+	// Resources/images のUI画像と同じ大きさ
+	Sizes sizes = {{256, 256}, {512, 256}, {64, 64}, {64, 64}, {64, 64}, {64, 64}};
+	RectanglePacker::Statistics statistics;
+	std::vector<RectanglePacker::Placement> placements =
+	    RectanglePacker::Pack(sizes, 2048, 2, statistics);
+
+	EXPECT_EQ(statistics.pageCount, 1u);
+	EXPECT_EQ(statistics.packedCount, 6u);
+	EXPECT_EQ(statistics.failedCount, 0u);
+	EXPECT_EQ(statistics.usedPixels, 256u * 256 + 512 * 256 + 4 * 64 * 64);
+	EXPECT_EQ(statistics.pagePixels, 2048u * 2048);
+	ExpectNoOverlap(sizes, placements, 2048, 2);
+}
+
+TEST(RectanglePackerTest, OverflowGoesToNextPage) {
+	// 余白込みで1ページに2枚しか入らない
+	Sizes sizes(5, {60, 124});
+	RectanglePacker::Statistics statistics;
+	std::vector<RectanglePacker::Placement> placements =
+	    RectanglePacker::Pack(sizes, 128, 2, statistics);
+
+	EXPECT_EQ(statistics.pageCount, 3u);
+	EXPECT_EQ(statistics.packedCount, 5u);
+	std::vector<uint32_t> perPage(statistics.pageCount);
+	for (const RectanglePacker::Placement& placement : placements) {
+		ASSERT_LT(placement.page, statistics.pageCount);
+		perPage[placement.page]++;
+	}
+	EXPECT_EQ(perPage, (std::vector<uint32_t>{2, 2, 1}));
+	ExpectNoOverlap(sizes, placements, 128, 2);
+}
+
+TEST(RectanglePackerTest, TooLargeImageIsReported) {
+	// 余白を足すとページより大きい
+	Sizes sizes = {{32, 32}, {128, 16}};
+	RectanglePacker::Statistics statistics;
+	std::vector<RectanglePacker::Placement> placements =
+	    RectanglePacker::Pack(sizes, 128, 1, statistics);
+
+	EXPECT_EQ(statistics.packedCount, 1u);
+	EXPECT_EQ(statistics.failedCount, 1u);
+	EXPECT_EQ(placements[0].page, 0u);
+	EXPECT_EQ(placements[1].page, RectanglePacker::kInvalidPage);
+}
+
+TEST(RectanglePackerTest, RandomSizesDoNotOverlap) {
+	std::mt19937 random(7);
+	std::uniform_int_distribution<uint32_t> size(1, 200);
+	Sizes sizes(300);
+	for (std::pair<uint32_t, uint32_t>& s : sizes) {
+		s = {size(random), size(random)};
+	}
+	RectanglePacker::Statistics statistics;
+	std::vector<RectanglePacker::Placement> placements =
+	    RectanglePacker::Pack(sizes, 1024, 2, statistics);
+
+	EXPECT_EQ(statistics.packedCount, 300u);
+	EXPECT_EQ(statistics.failedCount, 0u);
+	ExpectNoOverlap(sizes, placements, 1024, 2);
+	// 余白と端の隙間があるので100%にはならないが、ページを無駄に増やしていないこと
+	EXPECT_GT(statistics.GetOccupancy(), 0.6);
+	EXPECT_LE(statistics.GetOccupancy(), 1.0);
+}
@@ -0,0 +1,194 @@
+// RenderQueueのテスト（記録用コマンドリストに流して、並び順と省いた状態設定を確かめる）
+#include "RecordingRenderBackend.h"
+#include "RenderQueue.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+using Command = RecordingRenderCommandList::Command;
+
+// 仮のルートシグネチャとパイプラインステート（アドレスだけ使う）
+int rootSignatureA;
+int rootSignatureB;
+int pipelineStateA;
+int pipelineStateB;
+
+// ゲームのブロックとドアを模した描画要求
+RenderQueue::Packet MakePacket(uint32_t index, bool isDoor, float depth) {
+	RenderQueue::Packet packet;
+	packet.rootSignature = &rootSignatureA;
+	packet.pipelineState = &pipelineStateA;
+	packet.vertexBuffer = {isDoor ? 0x2000u : 0x1000u, 96, 32};
+	packet.indexBuffer = {isDoor ? 0x3000u : 0x4000u, 36, true};
+	// 0番はオブジェクトごとのワールド行列、それ以外は共通
+	packet.constantBuffers[0] = 0x10000 + uint64_t(index) * 256;
+	packet.constantBuffers[1] = 0x9000;
+	packet.constantBuffers[2] = isDoor ? 0x7000 : 0x7100;
+	packet.textureRootParameterIndex = 3;
+	packet.textureHandle = isDoor ? 3 : 2;
+	packet.indexCount = 36;
+	packet.sortKey = RenderQueue::MakeSortKey(0, packet.textureHandle, isDoor ? 1 : 0, depth);
+	return packet;
+}
+
+// 描画ごとに、直前に設定されたワールド行列（0番の定数バッファ）を集める
+std::vector<uint64_t> CollectDrawnWorldTransforms(const RecordingRenderCommandList& commandList) {
+	std::vector<uint64_t> drawn;
+	uint64_t current = 0;
+	for (const Command& command : commandList.GetCommands()) {
+		if (command.type == Command::Type::kSetConstantBuffer && command.rootParameterIndex == 0) {
+			current = command.value;
+		} else if (command.type == Command::Type::kDrawIndexed) {
+			drawn.push_back(current);
+		}
+	}
+	return drawn;
+}
+
+} // namespace
+
+TEST(RenderQueueTest, SortKeyOrdersPipelineTextureMaterialThenDepth) {
+	// 上位の項目は下位の項目より優先される
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 4095, 65535, 1e30f), RenderQueue::MakeSortKey(1, 0, 0, 0.0f));
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 1, 65535, 1e30f), RenderQueue::MakeSortKey(0, 2, 0, 0.0f));
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 0, 1, 1e30f), RenderQueue::MakeSortKey(0, 0, 2, 0.0f));
+
+	// 深度は手前から奥へ
+	float depths[] = {0.0f, 1e-6f, 0.5f, 1.0f, 2.0f, 100.0f, 1e6f};
+	for (size_t i = 1; i < std::size(depths); i++) {
+		EXPECT_LT(
+		    RenderQueue::MakeSortKey(0, 0, 0, depths[i - 1]),
+		    RenderQueue::MakeSortKey(0, 0, 0, depths[i]));
+	}
+	// カメラの後ろは0扱い
+	EXPECT_EQ(RenderQueue::MakeSortKey(0, 0, 0, -5.0f), RenderQueue::MakeSortKey(0, 0, 0, 0.0f));
+	// 範囲外のビットは隣の項目に漏れない
+	EXPECT_EQ(RenderQueue::MakeSortKey(0x10, 0x1000, 0x10000, 0.0f), 0u);
+}
+
+TEST(RenderQueueTest, FlushDrawsInSortKeyOrderAndKeepsPushOrderForEqualKeys) {
+	RenderQueue queue;
+	RecordingRenderCommandList commandList;
+	// ブロックとドアを交互に、奥から手前へ積む
+	for (uint32_t i = 0; i < 20; i++) {
+		queue.Push(MakePacket(i, i % 2 == 1, float(20 - i)));
+	}
+	// 同じキー（同じ深度のブロック）は積んだ順
+	queue.Push(MakePacket(20, false, 5.0f));
+	queue.Push(MakePacket(21, false, 5.0f));
+	queue.Flush(&commandList);
+
+	std::vector<uint64_t> expected;
+	// テクスチャ2（ブロック）を手前から、次にテクスチャ3（ドア）を手前から
+	for (uint32_t i : {18u, 16u, 20u, 21u, 14u, 12u, 10u, 8u, 6u, 4u, 2u, 0u}) {
+		expected.push_back(0x10000 + uint64_t(i) * 256);
+	}
+	for (uint32_t i : {19u, 17u, 15u, 13u, 11u, 9u, 7u, 5u, 3u, 1u}) {
+		expected.push_back(0x10000 + uint64_t(i) * 256);
+	}
+	EXPECT_EQ(CollectDrawnWorldTransforms(commandList), expected);
+}
+
+TEST(RenderQueueTest, FlushSkipsRedundantStates) {
+	RenderQueue queue;
+	RecordingRenderCommandList commandList;
+	for (uint32_t i = 0; i < 20; i++) {
+		queue.Push(MakePacket(i, i % 2 == 1, float(20 - i)));
+	}
+	queue.Flush(&commandList);
+
+	const RenderQueue::Statistics& statistics = queue.GetStatistics();
+	const RecordingRenderCommandList::Statistics& recorded = commandList.GetStatistics();
+	EXPECT_EQ(statistics.packetCount, 20u);
+	EXPECT_EQ(statistics.drawCallCount, 20u);
+	EXPECT_EQ(recorded.drawCallCount, 20u);
+	// 流したコマンドに冗長なものは無い
+	EXPECT_EQ(recorded.redundantStateCount, 0u);
+	EXPECT_EQ(statistics.emittedStateCount, recorded.stateChangeCount);
+	// テクスチャ、頂点、インデックス、マテリアルの切り替えはグループごとに1回だけ
+	EXPECT_EQ(recorded.textureChangeCount, 2u);
+	EXPECT_EQ(recorded.pipelineChangeCount, 1u);
+	// 1要求あたり5状態＋定数バッファ3つ＋テクスチャ
+	EXPECT_EQ(statistics.emittedStateCount + statistics.skippedStateCount, 20u * 9u);
+	// 最初の要求で9、ドアに切り替わるときに頂点、インデックス、2番の定数バッファ、テクスチャ、
+	// 残りはワールド行列だけ
+	EXPECT_EQ(statistics.emittedStateCount, 9u + 4u + 19u);
+}
+
+TEST(RenderQueueTest, RootSignatureChangeResetsRootParameters) {
+	RenderQueue queue;
+	RecordingRenderCommandList commandList;
+	RenderQueue::Packet first = MakePacket(0, false, 1.0f);
+	RenderQueue::Packet second = first;
+	second.rootSignature = &rootSignatureB;
+	second.pipelineState = &pipelineStateB;
+	second.sortKey = RenderQueue::MakeSortKey(1, 2, 0, 1.0f);
+	queue.Push(second);
+	queue.Push(first);
+	queue.Flush(&commandList);
+
+	// 同じアドレスでもルートシグネチャが変わった後は設定し直す
+	uint32_t constantBufferCount = 0;
+	uint32_t textureCount = 0;
+	for (const Command& command : commandList.GetCommands()) {
+		constantBufferCount += command.type == Command::Type::kSetConstantBuffer ? 1 : 0;
+		textureCount += command.type == Command::Type::kSetTexture ? 1 : 0;
+	}
+	EXPECT_EQ(constantBufferCount, 6u);
+	EXPECT_EQ(textureCount, 2u);
+	EXPECT_EQ(commandList.GetStatistics().redundantStateCount, 0u);
+	EXPECT_EQ(commandList.GetStatistics().pipelineChangeCount, 2u);
+}
+
+TEST(RenderQueueTest, UnsetParametersAreNotEmitted) {
+	RenderQueue queue;
+	RecordingRenderCommandList commandList;
+	RenderQueue::Packet packet;
+	packet.rootSignature = &rootSignatureA;
+	packet.pipelineState = &pipelineStateA;
+	packet.shaderResources[4] = 0x5000;
+	packet.indexCount = 3;
+	packet.instanceCount = 7;
+	queue.Push(packet);
+	queue.Flush(&commandList);
+
+	const std::vector<Command>& commands = commandList.GetCommands();
+	// ルートシグネチャ、パイプライン、形状、頂点、インデックス、シェーダリソース、描画
+	ASSERT_EQ(commands.size(), 7u);
+	EXPECT_EQ(commands[5].type, Command::Type::kSetShaderResource);
+	EXPECT_EQ(commands[5].rootParameterIndex, 4u);
+	EXPECT_EQ(commands[6].type, Command::Type::kDrawIndexed);
+	EXPECT_EQ(commands[6].count, 3u);
+	EXPECT_EQ(commands[6].instanceCount, 7u);
+}
+
+TEST(RenderQueueTest, EachFlushStartsFromUnknownState) {
+	// Flushの間に誰が何を設定したか分からないので、次のFlushでは全部設定し直す
+	RenderQueue queue;
+	RecordingRenderCommandList commandList;
+	queue.Push(MakePacket(0, false, 1.0f));
+	queue.Flush(&commandList);
+	EXPECT_EQ(queue.GetPacketCount(), 0u);
+
+	queue.Push(MakePacket(0, false, 1.0f));
+	queue.Flush(&commandList);
+	EXPECT_EQ(queue.GetStatistics().emittedStateCount, 18u);
+	EXPECT_EQ(queue.GetStatistics().packetCount, 2u);
+	EXPECT_EQ(commandList.GetStatistics().redundantStateCount, 9u);
+
+	queue.ResetStatistics();
+	EXPECT_EQ(queue.GetStatistics().packetCount, 0u);
+}
+
+TEST(RenderQueueTest, ClearDropsPacketsWithoutDrawing) {
+	RenderQueue queue;
+	RecordingRenderCommandList commandList;
+	queue.Push(MakePacket(0, false, 1.0f));
+	queue.Push(MakePacket(1, true, 1.0f));
+	EXPECT_EQ(queue.GetPacketCount(), 2u);
+	queue.Clear();
+	queue.Flush(&commandList);
+	EXPECT_TRUE(commandList.GetCommands().empty());
+	EXPECT_EQ(queue.GetStatistics().drawCallCount, 0u);
+}
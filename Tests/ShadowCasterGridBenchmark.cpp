@@ -0,0 +1,69 @@
+// ShadowCasterGridの計測（近い順に32個選ぶ。格子と全件の部分ソートを比べる）
+#include "ShadowCasterGrid.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// 選ぶ数
+const uint32_t kSelectCount = 32;
+
+// 横長のステージに散らばったキャスター
+std::vector<Vector3> MakePositions(uint32_t count) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distributionX(0.0f, 2000.0f);
+	std::uniform_real_distribution<float> distributionY(0.0f, 200.0f);
+	std::uniform_real_distribution<float> distributionZ(-1.0f, 1.0f);
+	std::vector<Vector3> positions(count);
+	for (Vector3& position : positions) {
+		position = {distributionX(random), distributionY(random), distributionZ(random)};
+	}
+	return positions;
+}
+
+void BM_GridSelect(benchmark::State& state) {
+	std::vector<Vector3> positions = MakePositions(uint32_t(state.range(0)));
+	ShadowCasterGrid grid;
+	grid.Initialize(4.0f);
+	for (const Vector3& position : positions) {
+		grid.Add(position);
+	}
+	Vector3 center = {1000.0f, 100.0f, -50.0f};
+	for (auto _ : state) {
+		// 毎回少しずつ動かして同じ結果の使い回しを避ける
+		center.x += 0.5f;
+		if (center.x > 1500.0f) {
+			center.x = 500.0f;
+		}
+		benchmark::DoNotOptimize(grid.Select(center, kSelectCount).data());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+	state.counters["cells"] = double(grid.GetStatistics().visitedCellCount);
+	state.counters["candidates"] = double(grid.GetStatistics().candidateCount);
+}
+BENCHMARK(BM_GridSelect)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+// 参照: 全件の距離を出して部分ソート
+void BM_BruteForceSelect(benchmark::State& state) {
+	std::vector<Vector3> positions = MakePositions(uint32_t(state.range(0)));
+	std::vector<std::pair<float, uint32_t>> distances(positions.size());
+	Vector3 center = {1000.0f, 100.0f, -50.0f};
+	for (auto _ : state) {
+		center.x += 0.5f;
+		if (center.x > 1500.0f) {
+			center.x = 500.0f;
+		}
+		for (uint32_t i = 0; i < uint32_t(positions.size()); i++) {
+			distances[i] = {LengthSquared(positions[i] - center), i};
+		}
+		std::partial_sort(distances.begin(), distances.begin() + kSelectCount, distances.end());
+		benchmark::DoNotOptimize(distances.data());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_BruteForceSelect)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+} // namespace
@@ -0,0 +1,86 @@
+// ShadowCasterGridのテスト（追加、移動、削除を混ぜて、全件を距離順に並べた結果と比べる）
+#include "ShadowCasterGrid.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+TEST(ShadowCasterGridTest, SelectMatchesBruteForceNearest) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-60.0f, 60.0f);
+	for (uint32_t trial = 0; trial < 300; trial++) {
+		ShadowCasterGrid grid;
+		grid.Initialize(std::uniform_real_distribution<float>(0.5f, 8.0f)(random));
+
+		// 奇数回目は平らに並べる
+		float flatten = trial % 2 ? 0.01f : 1.0f;
+		uint32_t count = random() % 500 + 1;
+		std::vector<uint32_t> live;
+		for (uint32_t i = 0; i < count; i++) {
+			live.push_back(grid.Add(
+			    {distribution(random), distribution(random) * 0.3f,
+			     distribution(random) * flatten}));
+		}
+		for (uint32_t i = 0; i < count / 3; i++) {
+			grid.SetPosition(
+			    live[random() % live.size()],
+			    {distribution(random), distribution(random), distribution(random)});
+		}
+		for (uint32_t i = 0; i < count / 4 && live.size() > 1; i++) {
+			size_t k = random() % live.size();
+			grid.Remove(live[k]);
+			live.erase(live.begin() + k);
+		}
+		// 削除で空いたハンドルの再利用
+		for (uint32_t i = 0; i < 20; i++) {
+			live.push_back(
+			    grid.Add({distribution(random), distribution(random), distribution(random)}));
+		}
+		ASSERT_EQ(grid.GetCasterCount(), uint32_t(live.size()));
+
+		Vector3 center = {
+		    distribution(random) * 3.0f, distribution(random) * 3.0f, distribution(random) * 3.0f};
+		uint32_t maxCount = random() % 40 + 1;
+		std::vector<uint32_t> selected = grid.Select(center, maxCount);
+
+		std::vector<float> expected;
+		for (uint32_t handle : live) {
+			expected.push_back(LengthSquared(grid.GetPosition(handle) - center));
+		}
+		std::sort(expected.begin(), expected.end());
+		expected.resize(std::min<size_t>(maxCount, expected.size()));
+
+		ASSERT_EQ(selected.size(), expected.size()) << "trial " << trial;
+		for (size_t i = 0; i < selected.size(); i++) {
+			EXPECT_EQ(LengthSquared(grid.GetPosition(selected[i]) - center), expected[i])
+			    << "trial " << trial << " rank " << i;
+		}
+		EXPECT_EQ(grid.GetStatistics().selectedCount, uint32_t(selected.size()));
+	}
+}
+
+TEST(ShadowCasterGridTest, SelectVisitsFewCellsInLargeScene) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distributionX(0.0f, 2000.0f);
+	std::uniform_real_distribution<float> distributionY(0.0f, 200.0f);
+	ShadowCasterGrid grid;
+	grid.Initialize(4.0f);
+	for (uint32_t i = 0; i < 100000; i++) {
+		grid.Add({distributionX(random), distributionY(random), 0.0f});
+	}
+	EXPECT_EQ(grid.Select({1000.0f, 100.0f, 0.0f}, 32).size(), 32u);
+	// 全件ではなく周りだけ調べる
+	EXPECT_LT(grid.GetStatistics().candidateCount, 1000u);
+}
+
+TEST(ShadowCasterGridTest, ClearAndEmptySelect) {
+	ShadowCasterGrid grid;
+	grid.Initialize();
+	EXPECT_TRUE(grid.Select({0.0f, 0.0f, 0.0f}, 8).empty());
+	grid.Add({1.0f, 2.0f, 3.0f});
+	grid.Add({4.0f, 5.0f, 6.0f});
+	EXPECT_EQ(grid.Select({0.0f, 0.0f, 0.0f}, 8).size(), 2u);
+	grid.Clear();
+	EXPECT_EQ(grid.GetCasterCount(), 0u);
+	EXPECT_TRUE(grid.Select({0.0f, 0.0f, 0.0f}, 8).empty());
+}
@@ -0,0 +1,283 @@
+// SpriteBatchBuilderのテスト（レイヤー順、同じ状態のまとめ、頂点の生成、描画数の統計）
+#include "SpriteBatchBuilder.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+using Item = SpriteBatchBuilder::Item;
+using Batch = SpriteBatchBuilder::Batch;
+using Vertex = SpriteBatchBuilder::Vertex;
+using Statistics = SpriteBatchBuilder::Statistics;
+
+// ブレンドモード（Sprite::BlendModeの値）
+const uint32_t kNormal = 1;
+const uint32_t kAdd = 2;
+
+// 頂点の並び
+enum { LB, LT, RB, RT };
+
+// 状態と順番の目印だけ決めた描画要求
+Item MakeItem(uint32_t textureHandle, uint32_t blendMode, int32_t layer, float id = 0.0f) {
+	Item item;
+	item.textureHandle = textureHandle;
+	item.blendMode = blendMode;
+	item.layer = layer;
+	item.position = {id, 0.0f};
+	return item;
+}
+
+// 並び替え後の目印
+std::vector<float> GetIds(const std::vector<Item>& items) {
+	std::vector<float> ids;
+	for (const Item& item : items) {
+		ids.push_back(item.position.x);
+	}
+	return ids;
+}
+
+// クリップ空間の頂点をスクリーン座標[px]に戻す
+Vector2 ToScreen(const Vertex& vertex, const Vector2& screenSize) {
+	return {
+	    (vertex.pos.x + 1.0f) * 0.5f * screenSize.x, (1.0f - vertex.pos.y) * 0.5f * screenSize.y};
+}
+
+TEST(SpriteBatchTest, SortsByLayerKeepingPushOrderWithinLayer) {
+	// 同じレイヤーの中は、状態が違っても積んだ順のまま（半透明の重なりを壊さない）
+	std::vector<Item> items = {
+	    MakeItem(1, kNormal, 2, 0), MakeItem(2, kAdd, 0, 1),  MakeItem(1, kNormal, 1, 2),
+	    MakeItem(3, kNormal, 0, 3), MakeItem(2, kAdd, 2, 4),  MakeItem(1, kNormal, 0, 5),
+	    MakeItem(1, kAdd, -1, 6),   MakeItem(2, kNormal, 1, 7),
+	};
+	std::vector<Batch> batches;
+	Statistics statistics;
+	SpriteBatchBuilder::BuildBatches(items, 100, batches, statistics);
+
+	EXPECT_EQ(GetIds(items), (std::vector<float>{6, 1, 3, 5, 2, 7, 0, 4}));
+	for (size_t i = 1; i < items.size(); i++) {
+		EXPECT_LE(items[i - 1].layer, items[i].layer);
+	}
+}
+
+TEST(SpriteBatchTest, MergesOnlyAdjacentItemsWithSameState) {
+	std::vector<Item> items = {
+	    // 3つを1つに
+	    MakeItem(1, kNormal, 0), MakeItem(1, kNormal, 0), MakeItem(1, kNormal, 0),
+	    // テクスチャ違い
+	    MakeItem(2, kNormal, 0),
+	    // 同じ状態でも間に挟まれたので別
+	    MakeItem(1, kNormal, 0),
+	    // ブレンド違い
+	    MakeItem(1, kAdd, 0), MakeItem(1, kAdd, 0),
+	};
+	std::vector<Batch> batches;
+	Statistics statistics;
+	SpriteBatchBuilder::BuildBatches(items, 100, batches, statistics);
+
+	ASSERT_EQ(batches.size(), 4u);
+	// テクスチャ、ブレンド、先頭、数
+	const uint32_t expected[4][4] = {
+	    {1, kNormal, 0, 3},
+	    {2, kNormal, 3, 1},
+	    {1, kNormal, 4, 1},
+	    {1, kAdd, 5, 2},
+	};
+	for (size_t i = 0; i < batches.size(); i++) {
+		EXPECT_EQ(batches[i].textureHandle, expected[i][0]) << i;
+		EXPECT_EQ(batches[i].blendMode, expected[i][1]) << i;
+		EXPECT_EQ(batches[i].quadStart, expected[i][2]) << i;
+		EXPECT_EQ(batches[i].quadCount, expected[i][3]) << i;
+	}
+
+	// 切り替えは前のバッチと比べる。先頭は常に切り替える
+	EXPECT_TRUE(batches[0].isPipelineChanged);
+	EXPECT_TRUE(batches[0].isTextureChanged);
+	EXPECT_FALSE(batches[1].isPipelineChanged);
+	EXPECT_TRUE(batches[1].isTextureChanged);
+	EXPECT_FALSE(batches[2].isPipelineChanged);
+	EXPECT_TRUE(batches[2].isTextureChanged);
+	EXPECT_TRUE(batches[3].isPipelineChanged);
+	EXPECT_FALSE(batches[3].isTextureChanged);
+}
+
+TEST(SpriteBatchTest, StatisticsCountDrawsAndStateChanges) {
+	std::vector<Item> items;
+	// 1つの文字列（同じフォント）と、アトラスのUI2枚
+	for (int i = 0; i < 12; i++) {
+		items.push_back(MakeItem(7, kNormal, 0));
+	}
+	items.push_back(MakeItem(9, kNormal, 0));
+	items.push_back(MakeItem(9, kNormal, 0));
+	items.push_back(MakeItem(9, kAdd, 1));
+
+	std::vector<Batch> batches;
+	Statistics statistics;
+	SpriteBatchBuilder::BuildBatches(items, 100, batches, statistics);
+	EXPECT_EQ(statistics.quadCount, 15u);
+	EXPECT_EQ(statistics.drawCallCount, 3u);
+	EXPECT_EQ(statistics.pipelineChangeCount, 2u);
+	EXPECT_EQ(statistics.textureChangeCount, 2u);
+	EXPECT_EQ(statistics.droppedQuadCount, 0u);
+
+	// 同じフレームの2回目は加算する
+	SpriteBatchBuilder::BuildBatches(items, 100, batches, statistics);
+	EXPECT_EQ(statistics.quadCount, 30u);
+	EXPECT_EQ(statistics.drawCallCount, 6u);
+	EXPECT_EQ(statistics.pipelineChangeCount, 4u);
+	EXPECT_EQ(statistics.textureChangeCount, 4u);
+
+	// 空なら何も増えない
+	std::vector<Item> empty;
+	SpriteBatchBuilder::BuildBatches(empty, 100, batches, statistics);
+	EXPECT_TRUE(batches.empty());
+	EXPECT_EQ(statistics.drawCallCount, 6u);
+}
+
+TEST(SpriteBatchTest, CapacityDropsTrailingItems) {
+	std::vector<Item> items = {
+	    MakeItem(1, kNormal, 1, 0), MakeItem(2, kNormal, 0, 1), MakeItem(2, kNormal, 0, 2),
+	    MakeItem(3, kNormal, 2, 3), MakeItem(3, kNormal, 2, 4),
+	};
+	std::vector<Batch> batches;
+	Statistics statistics;
+	SpriteBatchBuilder::BuildBatches(items, 3, batches, statistics);
+
+	// 並べた後の後ろ（上に描くもの）から捨てる
+	ASSERT_EQ(batches.size(), 2u);
+	EXPECT_EQ(batches[0].textureHandle, 2u);
+	EXPECT_EQ(batches[0].quadCount, 2u);
+	EXPECT_EQ(batches[1].textureHandle, 1u);
+	EXPECT_EQ(batches[1].quadStart + batches[1].quadCount, 3u);
+	EXPECT_EQ(statistics.quadCount, 3u);
+	EXPECT_EQ(statistics.droppedQuadCount, 2u);
+	EXPECT_EQ(statistics.drawCallCount, 2u);
+
+	SpriteBatchBuilder::BuildBatches(items, 0, batches, statistics);
+	EXPECT_TRUE(batches.empty());
+	EXPECT_EQ(statistics.droppedQuadCount, 7u);
+}
+
+TEST(SpriteBatchTest, QuadCoversWholeTextureByDefault) {
+	const Vector2 screenSize = {1280.0f, 720.0f};
+	Item item;
+	item.position = {100.0f, 50.0f};
+	item.size = {64.0f, 32.0f};
+	item.color = {0.1f, 0.2f, 0.3f, 0.4f};
+	Vertex vertices[4];
+	SpriteBatchBuilder::BuildQuad(item, {256.0f, 128.0f}, screenSize, vertices);
+
+	// 左上が座標、右下が座標+サイズ。uvは全体
+	const Vector2 expectedScreen[4] = {
+	    {100.0f, 82.0f},
+	    {100.0f, 50.0f},
+	    {164.0f, 82.0f},
+	    {164.0f, 50.0f},
+	};
+	const Vector2 expectedUv[4] = {
+	    {0.0f, 1.0f},
+	    {0.0f, 0.0f},
+	    {1.0f, 1.0f},
+	    {1.0f, 0.0f},
+	};
+	for (int i = LB; i <= RT; i++) {
+		Vector2 screen = ToScreen(vertices[i], screenSize);
+		EXPECT_NEAR(screen.x, expectedScreen[i].x, 1e-3f) << i;
+		EXPECT_NEAR(screen.y, expectedScreen[i].y, 1e-3f) << i;
+		EXPECT_FLOAT_EQ(vertices[i].uv.x, expectedUv[i].x) << i;
+		EXPECT_FLOAT_EQ(vertices[i].uv.y, expectedUv[i].y) << i;
+		EXPECT_EQ(vertices[i].pos.z, 0.0f);
+		EXPECT_EQ(vertices[i].color.w, 0.4f);
+	}
+
+	// 画面の四隅はクリップ空間の-1～1
+	item.position = {0.0f, 0.0f};
+	item.size = screenSize;
+	SpriteBatchBuilder::BuildQuad(item, {256.0f, 128.0f}, screenSize, vertices);
+	EXPECT_FLOAT_EQ(vertices[LT].pos.x, -1.0f);
+	EXPECT_FLOAT_EQ(vertices[LT].pos.y, 1.0f);
+	EXPECT_FLOAT_EQ(vertices[RB].pos.x, 1.0f);
+	EXPECT_FLOAT_EQ(vertices[RB].pos.y, -1.0f);
+}
+
+TEST(SpriteBatchTest, QuadUsesTextureRegion) {
+	// フォント画像の1文字分のように、テクスチャの一部を切り出す
+	Item item;
+	item.texBase = {18.0f, 36.0f};
+	item.texSize = {9.0f, 18.0f};
+	Vertex vertices[4];
+	SpriteBatchBuilder::BuildQuad(item, {126.0f, 144.0f}, {640.0f, 480.0f}, vertices);
+	EXPECT_FLOAT_EQ(vertices[LT].uv.x, 18.0f / 126.0f);
+	EXPECT_FLOAT_EQ(vertices[LT].uv.y, 36.0f / 144.0f);
+	EXPECT_FLOAT_EQ(vertices[RB].uv.x, 27.0f / 126.0f);
+	EXPECT_FLOAT_EQ(vertices[RB].uv.y, 54.0f / 144.0f);
+
+	// 幅か高さが0なら全体
+	item.texSize = {9.0f, 0.0f};
+	SpriteBatchBuilder::BuildQuad(item, {126.0f, 144.0f}, {640.0f, 480.0f}, vertices);
+	EXPECT_FLOAT_EQ(vertices[LT].uv.x, 0.0f);
+	EXPECT_FLOAT_EQ(vertices[RB].uv.x, 1.0f);
+}
+
+TEST(SpriteBatchTest, AnchorAndFlipMirrorAroundPosition) {
+	const Vector2 screenSize = {800.0f, 600.0f};
+	Item item;
+	item.position = {400.0f, 300.0f};
+	item.size = {40.0f, 20.0f};
+	item.anchorPoint = {0.5f, 0.5f};
+	Vertex vertices[4];
+	SpriteBatchBuilder::BuildQuad(item, {32.0f, 32.0f}, screenSize, vertices);
+
+	// 中心がアンカー
+	Vector2 lt = ToScreen(vertices[LT], screenSize);
+	Vector2 rb = ToScreen(vertices[RB], screenSize);
+	EXPECT_NEAR(lt.x, 380.0f, 1e-3f);
+	EXPECT_NEAR(lt.y, 290.0f, 1e-3f);
+	EXPECT_NEAR(rb.x, 420.0f, 1e-3f);
+	EXPECT_NEAR(rb.y, 310.0f, 1e-3f);
+
+	// 左アンカーの左右反転は、座標を軸に鏡に映した位置になり、uvは変えない
+	item.anchorPoint = {0.0f, 0.0f};
+	item.isFlipX = true;
+	SpriteBatchBuilder::BuildQuad(item, {32.0f, 32.0f}, screenSize, vertices);
+	lt = ToScreen(vertices[LT], screenSize);
+	rb = ToScreen(vertices[RB], screenSize);
+	EXPECT_NEAR(lt.x, 400.0f, 1e-3f);
+	EXPECT_NEAR(rb.x, 360.0f, 1e-3f);
+	EXPECT_NEAR(lt.y, 300.0f, 1e-3f);
+	EXPECT_NEAR(rb.y, 320.0f, 1e-3f);
+	EXPECT_FLOAT_EQ(vertices[LT].uv.x, 0.0f);
+	EXPECT_FLOAT_EQ(vertices[RB].uv.x, 1.0f);
+
+	// 上下反転も同じ
+	item.isFlipX = false;
+	item.isFlipY = true;
+	SpriteBatchBuilder::BuildQuad(item, {32.0f, 32.0f}, screenSize, vertices);
+	lt = ToScreen(vertices[LT], screenSize);
+	rb = ToScreen(vertices[RB], screenSize);
+	EXPECT_NEAR(lt.y, 300.0f, 1e-3f);
+	EXPECT_NEAR(rb.y, 280.0f, 1e-3f);
+	EXPECT_NEAR(rb.x, 440.0f, 1e-3f);
+}
+
+TEST(SpriteBatchTest, RotationTurnsAroundPosition) {
+	const Vector2 screenSize = {800.0f, 600.0f};
+	Item item;
+	item.position = {400.0f, 300.0f};
+	item.size = {40.0f, 20.0f};
+	item.rotation = 3.14159265f * 0.5f;
+	Vertex vertices[4];
+	SpriteBatchBuilder::BuildQuad(item, {32.0f, 32.0f}, screenSize, vertices);
+
+	// 90度でローカルの(40, 0)は(0, 40)へ、(0, 20)は(-20, 0)へ
+	Vector2 rt = ToScreen(vertices[RT], screenSize);
+	Vector2 lb = ToScreen(vertices[LB], screenSize);
+	Vector2 lt = ToScreen(vertices[LT], screenSize);
+	EXPECT_NEAR(lt.x, 400.0f, 1e-3f);
+	EXPECT_NEAR(lt.y, 300.0f, 1e-3f);
+	EXPECT_NEAR(rt.x, 400.0f, 1e-3f);
+	EXPECT_NEAR(rt.y, 340.0f, 1e-3f);
+	EXPECT_NEAR(lb.x, 380.0f, 1e-3f);
+	EXPECT_NEAR(lb.y, 300.0f, 1e-3f);
+}
+
+} // namespace
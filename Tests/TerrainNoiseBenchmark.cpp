@@ -0,0 +1,44 @@
+// TerrainNoiseの計測（2048x2048の格子をスカラー版とAVX2版で埋める。1スレッド）
+#include "JobSystem.h"
+#include "TerrainNoise.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+const uint32_t kGridSize = 2048;
+
+// 引数: オクターブ数, AVX2を使うか
+void BM_FractalGrid(benchmark::State& state) {
+	TerrainNoise noise;
+	noise.Initialize(7, state.range(1) != 0);
+	if (state.range(1) != 0 && !noise.IsSimdEnabled()) {
+		state.SkipWithError("AVX2 is not available");
+		return;
+	}
+	// ワーカーなし（呼び出したスレッドだけで実行する）
+	JobSystem jobSystem;
+	jobSystem.Initialize(0);
+
+	TerrainNoise::FractalDesc desc;
+	desc.octaveCount = uint32_t(state.range(0));
+	desc.frequency = 1.0f / 64.0f;
+	std::vector<float> result(size_t(kGridSize) * kGridSize);
+	for (auto _ : state) {
+		noise.FractalGrid(0.0f, 0.0f, 1.0f, kGridSize, kGridSize, desc, result.data(), &jobSystem);
+		benchmark::DoNotOptimize(result.data());
+	}
+	// 1オクターブ1サンプルを1つと数える
+	state.SetItemsProcessed(
+	    int64_t(state.iterations()) * kGridSize * kGridSize * desc.octaveCount);
+	jobSystem.Finalize();
+}
+BENCHMARK(BM_FractalGrid)
+    ->ArgNames({"octaves", "simd"})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({4, 0})
+    ->Args({4, 1})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
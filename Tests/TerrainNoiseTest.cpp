@@ -0,0 +1,146 @@
+// TerrainNoiseのテスト（AVX2版がスカラー版とビット単位で同じ値を返すことを確かめる）
+#include "JobSystem.h"
+#include "TerrainNoise.h"
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ビット単位で同じか（-0と0、NaNも区別する）
+bool BitEqual(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+class TerrainNoiseTest : public testing::Test {
+protected:
+	void SetUp() override {
+		simd_.Initialize(7, true);
+		scalar_.Initialize(7, false);
+	}
+
+	void SkipWithoutSimd() {
+		if (!simd_.IsSimdEnabled()) {
+			GTEST_SKIP() << "AVX2 is not available";
+		}
+	}
+
+	TerrainNoise simd_;
+	TerrainNoise scalar_;
+};
+
+} // namespace
+
+TEST_F(TerrainNoiseTest, ScalarIsUsedWhenSimdIsNotRequested) {
+	EXPECT_FALSE(scalar_.IsSimdEnabled());
+}
+
+TEST_F(TerrainNoiseTest, PerlinIsInUnitRangeAndContinuous) {
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+	float minValue = 1.0f;
+	float maxValue = 0.0f;
+	for (uint32_t i = 0; i < 100000; i++) {
+		float n = scalar_.Perlin(distribution(random), distribution(random));
+		minValue = std::min(minValue, n);
+		maxValue = std::max(maxValue, n);
+	}
+	EXPECT_GE(minValue, 0.0f);
+	EXPECT_LE(maxValue, 1.0f);
+	// 値域をある程度使う
+	EXPECT_LT(minValue, 0.2f);
+	EXPECT_GT(maxValue, 0.8f);
+
+	// 格子の境界でつながる。格子点では0.5
+	EXPECT_NEAR(scalar_.Perlin(2.9999f, 0.3f), scalar_.Perlin(3.0f, 0.3f), 1e-3f);
+	EXPECT_FLOAT_EQ(scalar_.Perlin(5.0f, -7.0f), 0.5f);
+	// 並べ替え表の周期で繰り返す
+	EXPECT_EQ(scalar_.Perlin(1.25f, 3.5f), scalar_.Perlin(1.25f + 256.0f, 3.5f));
+}
+
+TEST_F(TerrainNoiseTest, SameSeedGivesSameNoise) {
+	TerrainNoise other;
+	other.Initialize(7, false);
+	TerrainNoise differentSeed;
+	differentSeed.Initialize(8, false);
+	EXPECT_EQ(other.Perlin(12.3f, 45.6f), scalar_.Perlin(12.3f, 45.6f));
+	EXPECT_NE(differentSeed.Perlin(12.3f, 45.6f), scalar_.Perlin(12.3f, 45.6f));
+}
+
+TEST_F(TerrainNoiseTest, Perlin8MatchesScalarBitForBit) {
+	SkipWithoutSimd();
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+	for (uint32_t k = 0; k < 100000; k++) {
+		float xs[TerrainNoise::kBatchSize];
+		float ys[TerrainNoise::kBatchSize];
+		float simdResult[TerrainNoise::kBatchSize];
+		float scalarResult[TerrainNoise::kBatchSize];
+		for (uint32_t i = 0; i < TerrainNoise::kBatchSize; i++) {
+			xs[i] = distribution(random);
+			ys[i] = distribution(random);
+		}
+		simd_.Perlin8(xs, ys, simdResult);
+		scalar_.Perlin8(xs, ys, scalarResult);
+		for (uint32_t i = 0; i < TerrainNoise::kBatchSize; i++) {
+			ASSERT_TRUE(BitEqual(simdResult[i], scalarResult[i]))
+			    << xs[i] << ", " << ys[i] << ": " << simdResult[i] << " vs " << scalarResult[i];
+		}
+	}
+}
+
+TEST_F(TerrainNoiseTest, FractalRowMatchesScalarBitForBit) {
+	SkipWithoutSimd();
+	TerrainNoise::FractalDesc desc;
+	desc.octaveCount = 5;
+	desc.frequency = 0.01f;
+	for (TerrainNoise::Type type : {TerrainNoise::Type::kFbm, TerrainNoise::Type::kRidged}) {
+		desc.type = type;
+		// 端数のバッチが出る長さ
+		for (uint32_t count : {1u, 7u, 8u, 37u, 256u}) {
+			std::vector<float> simdRow(count);
+			std::vector<float> scalarRow(count);
+			simd_.FractalRow(-3.0f, 0.7f, 5.5f, count, desc, simdRow.data());
+			scalar_.FractalRow(-3.0f, 0.7f, 5.5f, count, desc, scalarRow.data());
+			for (uint32_t i = 0; i < count; i++) {
+				ASSERT_TRUE(BitEqual(simdRow[i], scalarRow[i])) << "count " << count << " i " << i;
+			}
+		}
+	}
+}
+
+TEST_F(TerrainNoiseTest, FractalRowMatchesFractal) {
+	TerrainNoise::FractalDesc desc;
+	desc.octaveCount = 5;
+	desc.frequency = 0.01f;
+	for (TerrainNoise::Type type : {TerrainNoise::Type::kFbm, TerrainNoise::Type::kRidged}) {
+		desc.type = type;
+		std::vector<float> row(37);
+		scalar_.FractalRow(-3.0f, 0.7f, 5.5f, 37, desc, row.data());
+		for (uint32_t i = 0; i < 37; i++) {
+			EXPECT_NEAR(row[i], scalar_.Fractal(-3.0f + 0.7f * float(i), 5.5f, desc), 1e-6f);
+		}
+	}
+}
+
+TEST_F(TerrainNoiseTest, FractalGridDoesNotDependOnWorkerCount) {
+	JobSystem inlineJobs;
+	inlineJobs.Initialize(0);
+	JobSystem workerJobs;
+	workerJobs.Initialize(3);
+
+	TerrainNoise::FractalDesc desc;
+	std::vector<float> inlineGrid(100 * 100);
+	std::vector<float> workerGrid(100 * 100);
+	simd_.FractalGrid(0.0f, 0.0f, 0.1f, 100, 100, desc, inlineGrid.data(), &inlineJobs);
+	simd_.FractalGrid(0.0f, 0.0f, 0.1f, 100, 100, desc, workerGrid.data(), &workerJobs);
+	EXPECT_EQ(inlineGrid, workerGrid);
+
+	// 各行はFractalRowと同じ
+	std::vector<float> row(100);
+	simd_.FractalRow(0.0f, 0.1f, 0.1f * 42.0f, 100, desc, row.data());
+	EXPECT_TRUE(std::equal(row.begin(), row.end(), inlineGrid.begin() + 42 * 100));
+
+	workerJobs.Finalize();
+	inlineJobs.Finalize();
+}
@@ -0,0 +1,181 @@
+// TerrainPatchesのテスト（向き、作り直す区画、詳細度ごとの三角形数、差分転送のバイト数）
+#include "DirtyRangeTracker.h"
+#include "TerrainPatches.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// 区画の一辺のマス数
+const uint32_t kPatchQuadCount = 32;
+// 詳細度数
+const uint32_t kLodCount = 4;
+
+// 4x2区画の地形
+class TerrainPatchesTest : public testing::Test {
+protected:
+	void SetUp() override {
+		patches_.Initialize(128, 64, 1.0f, kPatchQuadCount, kLodCount, 2.0f);
+		patches_.Rebuild();
+	}
+
+	TerrainPatches patches_;
+};
+
+// 詳細度lの1区画の三角形数（格子とスカート）
+uint32_t ExpectedTriangleCount(uint32_t lod) {
+	uint32_t n = kPatchQuadCount >> lod;
+	return n * n * 2 + n * 4 * 2;
+}
+
+} // namespace
+
+TEST_F(TerrainPatchesTest, PatchLayoutAndLodIndexCounts) {
+	EXPECT_EQ(patches_.GetPatchCountX(), 4u);
+	EXPECT_EQ(patches_.GetPatchCountZ(), 2u);
+	EXPECT_EQ(patches_.GetPatchCount(), 8u);
+	EXPECT_EQ(patches_.GetPatchVertexCount(), 33u * 33u + 32u * 4u);
+	EXPECT_EQ(patches_.GetVertices().size(), size_t(8) * patches_.GetPatchVertexCount());
+	ASSERT_EQ(patches_.GetLodCount(), kLodCount);
+	for (uint32_t lod = 0; lod < kLodCount; lod++) {
+		EXPECT_EQ(patches_.GetLod(lod).indexCount, ExpectedTriangleCount(lod) * 3) << lod;
+		EXPECT_LE(
+		    patches_.GetLod(lod).indexOffset + patches_.GetLod(lod).indexCount,
+		    patches_.GetIndices().size());
+	}
+	for (uint16_t index : patches_.GetIndices()) {
+		EXPECT_LT(index, patches_.GetPatchVertexCount());
+	}
+}
+
+TEST_F(TerrainPatchesTest, TrianglesFaceUpAndSkirtsFaceOutward) {
+	// 平らな地形の区画0（中心は(16, _, 16)）
+	const std::vector<TerrainPatches::Vertex>& vertices = patches_.GetVertices();
+	const std::vector<uint16_t>& indices = patches_.GetIndices();
+	for (uint32_t lod = 0; lod < kLodCount; lod++) {
+		const TerrainPatches::Lod& range = patches_.GetLod(lod);
+		for (uint32_t i = range.indexOffset; i < range.indexOffset + range.indexCount; i += 3) {
+			Vector3 a = vertices[indices[i]].pos;
+			Vector3 b = vertices[indices[i + 1]].pos;
+			Vector3 c = vertices[indices[i + 2]].pos;
+			Vector3 normal = Cross(b - a, c - a);
+			if (std::fabs(normal.y) > 1e-6f) {
+				ASSERT_GT(normal.y, 0.0f) << "lod " << lod << " index " << i;
+			} else {
+				Vector3 center = (a + b + c) * (1.0f / 3.0f);
+				float outward = normal.x * (center.x - 16.0f) + normal.z * (center.z - 16.0f);
+				ASSERT_GT(outward, 0.0f) << "lod " << lod << " index " << i;
+			}
+		}
+	}
+}
+
+TEST_F(TerrainPatchesTest, RebuildOnlyTouchesAffectedPatches) {
+	// 最初のRebuildで全区画を作ったので、変更がなければ何も作り直さない
+	EXPECT_TRUE(patches_.Rebuild().empty());
+
+	// 区画の内側
+	patches_.Raise({10.0f, 10.0f}, 3.0f, 1.0f);
+	EXPECT_EQ(patches_.Rebuild(), std::vector<uint32_t>({0}));
+	patches_.SetHeight(5, 5, 3.0f);
+	EXPECT_EQ(patches_.Rebuild(), std::vector<uint32_t>({0}));
+	EXPECT_EQ(patches_.GetStatistics().rebuiltPatchCount, 1u);
+
+	// 区画0と1の境目の格子点は両方に属する
+	patches_.SetHeight(32, 5, 3.0f);
+	EXPECT_EQ(patches_.Rebuild(), std::vector<uint32_t>({0, 1}));
+
+	// 4区画の角の近く
+	patches_.Raise({31.0f, 33.0f}, 2.0f, 1.0f);
+	EXPECT_EQ(patches_.Rebuild(), std::vector<uint32_t>({0, 1, 4, 5}));
+}
+
+TEST_F(TerrainPatchesTest, NeighbourPatchesShareBorderVertices) {
+	patches_.Raise({32.0f, 16.0f}, 6.0f, 4.0f);
+	patches_.Rebuild();
+
+	// 区画0の東端と区画1の西端は同じ高さと法線
+	const std::vector<TerrainPatches::Vertex>& vertices = patches_.GetVertices();
+	uint32_t stride = kPatchQuadCount + 1;
+	for (uint32_t z = 0; z <= kPatchQuadCount; z++) {
+		const TerrainPatches::Vertex& east = vertices[z * stride + kPatchQuadCount];
+		const TerrainPatches::Vertex& west =
+		    vertices[patches_.GetPatchVertexCount() + z * stride];
+		EXPECT_EQ(east.pos.y, west.pos.y) << z;
+		EXPECT_EQ(east.normal.x, west.normal.x) << z;
+		EXPECT_EQ(east.normal.y, west.normal.y) << z;
+		EXPECT_EQ(east.normal.z, west.normal.z) << z;
+	}
+}
+
+TEST_F(TerrainPatchesTest, SelectLodsReportsTriangleCounts) {
+	// 区画0の上から見る
+	const std::vector<uint32_t>& lods = patches_.SelectLods({16.0f, 5.0f, 16.0f}, 20.0f);
+	ASSERT_EQ(lods.size(), 8u);
+	EXPECT_EQ(lods[0], 0u);
+	// 遠い区画ほど詳細度が下がる
+	EXPECT_LE(lods[0], lods[1]);
+	EXPECT_LE(lods[1], lods[2]);
+	EXPECT_LE(lods[2], lods[3]);
+	EXPECT_GT(lods[3], 0u);
+
+	uint32_t triangleCount = 0;
+	uint32_t lodPatchCounts[TerrainPatches::kMaxLodCount] = {};
+	for (uint32_t patch = 0; patch < patches_.GetPatchCount(); patch++) {
+		EXPECT_EQ(patches_.GetPatchLod(patch), lods[patch]);
+		triangleCount += ExpectedTriangleCount(lods[patch]);
+		lodPatchCounts[lods[patch]]++;
+	}
+	const TerrainPatches::Statistics& statistics = patches_.GetStatistics();
+	EXPECT_EQ(statistics.triangleCount, triangleCount);
+	EXPECT_EQ(statistics.fullDetailTriangleCount, 8u * ExpectedTriangleCount(0));
+	EXPECT_LT(statistics.triangleCount, statistics.fullDetailTriangleCount);
+	for (uint32_t lod = 0; lod < TerrainPatches::kMaxLodCount; lod++) {
+		EXPECT_EQ(statistics.lodPatchCounts[lod], lodPatchCounts[lod]) << lod;
+	}
+
+	// 十分遠ければ全区画が最低詳細度
+	patches_.SelectLods({1000.0f, 1000.0f, 1000.0f}, 20.0f);
+	EXPECT_EQ(patches_.GetStatistics().triangleCount, 8u * ExpectedTriangleCount(kLodCount - 1));
+}
+
+TEST_F(TerrainPatchesTest, UploadBytesCoverOnlyRebuiltPatches) {
+	// ChunkedTerrainと同じ手順（作り直した区画に全フレーム分の印を付け、今のフレームの分だけ書く）
+	const uint32_t frameCount = 2;
+	uint32_t patchVertexBytes = sizeof(TerrainPatches::Vertex) * patches_.GetPatchVertexCount();
+	uint64_t fullUploadBytes = uint64_t(patchVertexBytes) * patches_.GetPatchCount();
+	DirtyRangeTracker dirtyPatches;
+	dirtyPatches.Initialize(patches_.GetPatchCount(), frameCount);
+	std::vector<std::vector<TerrainPatches::Vertex>> vertexBuffers(
+	    frameCount, std::vector<TerrainPatches::Vertex>(patches_.GetVertices().size()));
+
+	auto updateFrame = [&](uint32_t frameIndex) {
+		for (uint32_t patch : patches_.Rebuild()) {
+			dirtyPatches.Mark(patch);
+		}
+		return dirtyPatches.Upload(
+		    frameIndex, patches_.GetVertices().data(), vertexBuffers[frameIndex].data(),
+		    patchVertexBytes);
+	};
+
+	// 最初はどちらのフレームも全区画
+	EXPECT_EQ(updateFrame(0), fullUploadBytes);
+	EXPECT_EQ(updateFrame(1), fullUploadBytes);
+	// 変更がなければ0
+	EXPECT_EQ(updateFrame(0), 0u);
+	EXPECT_EQ(updateFrame(1), 0u);
+
+	// 1区画を変えると、それぞれのフレームで1区画分ずつ
+	patches_.Raise({80.0f, 40.0f}, 3.0f, 2.0f);
+	EXPECT_EQ(updateFrame(0), patchVertexBytes);
+	EXPECT_EQ(updateFrame(1), patchVertexBytes);
+	EXPECT_EQ(updateFrame(0), 0u);
+	for (uint32_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+		EXPECT_TRUE(std::equal(
+		    vertexBuffers[frameIndex].begin(), vertexBuffers[frameIndex].end(),
+		    patches_.GetVertices().begin(), [](const auto& a, const auto& b) {
+			    return a.pos.y == b.pos.y && a.normal.y == b.normal.y;
+		    }));
+	}
+}
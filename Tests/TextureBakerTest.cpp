@@ -0,0 +1,252 @@
+// テクスチャベイカー（BC圧縮、ミップ生成、DDS、鮮度の判定）のテスト
+#include "BakedTexturePath.h"
+#include "BlockCompression.h"
+#include "TextureBaker.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+// 4x4画素のブロック
+struct Block {
+	uint8_t rgba[BlockCompression::kBlockPixelCount * 4];
+};
+
+Block MakeSolidBlock(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	Block block;
+	for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+		block.rgba[i * 4 + 0] = r;
+		block.rgba[i * 4 + 1] = g;
+		block.rgba[i * 4 + 2] = b;
+		block.rgba[i * 4 + 3] = a;
+	}
+	return block;
+}
+
+// チャンネルcの二乗平均平方根誤差
+double ChannelRmse(const Block& expected, const Block& actual, int c) {
+	double sum = 0.0;
+	for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+		double difference = double(expected.rgba[i * 4 + c]) - double(actual.rgba[i * 4 + c]);
+		sum += difference * difference;
+	}
+	return std::sqrt(sum / BlockCompression::kBlockPixelCount);
+}
+
+// テストごとの作業ディレクトリ
+class TemporaryDirectory {
+public:
+	TemporaryDirectory() {
+		path_ = std::filesystem::temp_directory_path() /
+		        ("TextureBakerTest_" + std::to_string(std::random_device{}()));
+		std::filesystem::create_directories(path_);
+	}
+	~TemporaryDirectory() { std::filesystem::remove_all(path_); }
+	const std::filesystem::path& GetPath() const { return path_; }
+
+private:
+	std::filesystem::path path_;
+};
+
+} // namespace
+
+TEST(BlockCompressionTest, SolidColorRepresentableIn565IsExact) {
+	// 565で表せる色（各チャンネルの下位ビットが上位ビットの繰り返し）
+	Block source = MakeSolidBlock(0xff, 0x82, 0x00, 255);
+	uint8_t encoded[BlockCompression::kBC1BlockBytes];
+	BlockCompression::EncodeBC1Block(source.rgba, encoded);
+	Block decoded;
+	BlockCompression::DecodeBC1Block(encoded, decoded.rgba);
+	for (int c = 0; c < 4; c++) {
+		EXPECT_EQ(ChannelRmse(source, decoded, c), 0.0) << "channel " << c;
+	}
+}
+
+TEST(BlockCompressionTest, GradientErrorIsSmall) {
+	Block source;
+	for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+		source.rgba[i * 4 + 0] = uint8_t(40 + i * 12);
+		source.rgba[i * 4 + 1] = uint8_t(200 - i * 8);
+		source.rgba[i * 4 + 2] = uint8_t(90 + i * 3);
+		source.rgba[i * 4 + 3] = 255;
+	}
+	uint8_t encoded[BlockCompression::kBC1BlockBytes];
+	BlockCompression::EncodeBC1Block(source.rgba, encoded);
+	Block decoded;
+	BlockCompression::DecodeBC1Block(encoded, decoded.rgba);
+	// 等間隔の16色を4色で表すと、最適でも誤差は4色の間隔の約0.37倍（赤は間隔60で約13.4）
+	for (int c = 0; c < 3; c++) {
+		EXPECT_LT(ChannelRmse(source, decoded, c), 15.0) << "channel " << c;
+	}
+}
+
+TEST(BlockCompressionTest, BC1AlwaysUsesFourColorMode) {
+	// 3色モード（color0 <= color1）だと4番目が透明になるので、不透明な入力では使わない
+	std::mt19937 random(1);
+	for (int trial = 0; trial < 1000; trial++) {
+		Block source;
+		for (uint8_t& value : source.rgba) {
+			value = uint8_t(random());
+		}
+		for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+			source.rgba[i * 4 + 3] = 255;
+		}
+		uint8_t encoded[BlockCompression::kBC1BlockBytes];
+		BlockCompression::EncodeBC1Block(source.rgba, encoded);
+		uint16_t color0 = uint16_t(encoded[0] | (encoded[1] << 8));
+		uint16_t color1 = uint16_t(encoded[2] | (encoded[3] << 8));
+		Block decoded;
+		BlockCompression::DecodeBC1Block(encoded, decoded.rgba);
+		ASSERT_GE(color0, color1);
+		for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+			ASSERT_EQ(decoded.rgba[i * 4 + 3], 255);
+		}
+	}
+}
+
+TEST(BlockCompressionTest, BC3AlphaErrorIsWithinOneStep) {
+	Block source = MakeSolidBlock(128, 64, 32, 0);
+	for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+		source.rgba[i * 4 + 3] = uint8_t(i * 17);
+	}
+	uint8_t encoded[BlockCompression::kBC3BlockBytes];
+	BlockCompression::EncodeBC3Block(source.rgba, encoded);
+	Block decoded;
+	BlockCompression::DecodeBC3Block(encoded, decoded.rgba);
+	// 0～255を8段階で表すので、誤差は1段階(255/7)の半分+丸め以内
+	for (uint32_t i = 0; i < BlockCompression::kBlockPixelCount; i++) {
+		EXPECT_LE(std::abs(int(source.rgba[i * 4 + 3]) - int(decoded.rgba[i * 4 + 3])), 19)
+		    << "pixel " << i;
+	}
+	// 端点はそのまま残る
+	EXPECT_EQ(decoded.rgba[3], 0);
+	EXPECT_EQ(decoded.rgba[15 * 4 + 3], 255);
+}
+
+TEST(TextureBakerTest, MipChainHalvesDownToOnePixel) {
+	TextureBaker::Image image;
+	image.width = 256;
+	image.height = 64;
+	image.pixels.assign(size_t(image.width) * image.height * 4, 200);
+	std::vector<TextureBaker::Image> mips = TextureBaker::GenerateMipChain(image);
+	ASSERT_EQ(mips.size(), 9u);
+	EXPECT_EQ(mips[1].width, 128u);
+	EXPECT_EQ(mips[1].height, 32u);
+	EXPECT_EQ(mips[6].height, 1u);
+	EXPECT_EQ(mips[8].width, 1u);
+	// 一様な画像は平均しても変わらない
+	EXPECT_EQ(mips[8].pixels[0], 200);
+}
+
+TEST(TextureBakerTest, MipOfCheckerIsAverage) {
+	TextureBaker::Image image;
+	image.width = 2;
+	image.height = 2;
+	image.pixels = {0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255};
+	std::vector<TextureBaker::Image> mips = TextureBaker::GenerateMipChain(image);
+	ASSERT_EQ(mips.size(), 2u);
+	EXPECT_EQ(mips[1].pixels[0], 128);
+	EXPECT_EQ(mips[1].pixels[3], 255);
+}
+
+TEST(TextureBakerTest, SelectFormat) {
+	TextureBaker::Image opaque;
+	opaque.width = 8;
+	opaque.height = 8;
+	opaque.pixels.assign(8 * 8 * 4, 255);
+	TextureBaker::Image translucent = opaque;
+	translucent.pixels[3] = 10;
+	TextureBaker::Image odd = opaque;
+	odd.width = 6;
+
+	EXPECT_EQ(
+	    TextureBaker::SelectFormat(opaque, TextureBaker::Compression::kAuto),
+	    DdsFile::Format::kBC1UnormSrgb);
+	EXPECT_EQ(
+	    TextureBaker::SelectFormat(translucent, TextureBaker::Compression::kAuto),
+	    DdsFile::Format::kBC3UnormSrgb);
+	EXPECT_EQ(
+	    TextureBaker::SelectFormat(odd, TextureBaker::Compression::kAuto),
+	    DdsFile::Format::kR8G8B8A8UnormSrgb);
+	EXPECT_EQ(
+	    TextureBaker::SelectFormat(opaque, TextureBaker::Compression::kNone),
+	    DdsFile::Format::kR8G8B8A8UnormSrgb);
+}
+
+TEST(TextureBakerTest, DdsRoundTrip) {
+	TemporaryDirectory directory;
+	TextureBaker::Image image;
+	image.width = 16;
+	image.height = 8;
+	image.pixels.resize(size_t(image.width) * image.height * 4);
+	for (size_t i = 0; i < image.pixels.size(); i++) {
+		image.pixels[i] = uint8_t(i * 7);
+	}
+	std::vector<TextureBaker::Image> mips = TextureBaker::GenerateMipChain(image);
+	DdsFile::Texture texture = TextureBaker::Compress(mips, DdsFile::Format::kBC3UnormSrgb);
+	ASSERT_EQ(texture.mips.size(), 5u);
+	// 16x8 → 4x2ブロック、4x2以下のミップも1ブロック
+	EXPECT_EQ(texture.mips[0].size(), 4u * 2 * 16);
+	EXPECT_EQ(texture.mips[4].size(), 16u);
+
+	std::filesystem::path path = directory.GetPath() / "roundtrip.dds";
+	ASSERT_TRUE(DdsFile::Write(path, texture));
+	// "DDS " + ヘッダー124 + DX10ヘッダー20
+	uint64_t dataBytes = 0;
+	for (const std::vector<uint8_t>& mip : texture.mips) {
+		dataBytes += mip.size();
+	}
+	EXPECT_EQ(std::filesystem::file_size(path), 4 + 124 + 20 + dataBytes);
+
+	DdsFile::Texture loaded;
+	ASSERT_TRUE(DdsFile::Read(path, loaded));
+	EXPECT_EQ(loaded.format, DdsFile::Format::kBC3UnormSrgb);
+	EXPECT_EQ(loaded.width, 16u);
+	EXPECT_EQ(loaded.height, 8u);
+	EXPECT_EQ(loaded.mips, texture.mips);
+}
+
+TEST(TextureBakerTest, BakeSkipsUpToDateAndRebakesEditedSource) {
+	TemporaryDirectory directory;
+	std::filesystem::path sourcePath = directory.GetPath() / "key.png";
+	std::filesystem::copy_file(std::filesystem::path(RESOURCES_DIR) / "images/key.png", sourcePath);
+	std::filesystem::path bakedPath = GetBakedTexturePath(sourcePath);
+	EXPECT_EQ(bakedPath.filename(), "key.dds");
+	EXPECT_FALSE(IsBakedTextureUpToDate(sourcePath, bakedPath));
+
+	TextureBaker::Report report = TextureBaker::Bake(sourcePath);
+	ASSERT_TRUE(report.succeeded) << report.error;
+	EXPECT_FALSE(report.skipped);
+	EXPECT_TRUE(IsBakedTextureUpToDate(sourcePath, bakedPath));
+	EXPECT_TRUE(TextureBaker::Bake(sourcePath).skipped);
+
+	// 元画像を編集したら古いベイクは使わず、次のベイクで作り直す
+	std::filesystem::last_write_time(
+	    bakedPath, std::filesystem::last_write_time(sourcePath) - std::chrono::seconds(1));
+	EXPECT_FALSE(IsBakedTextureUpToDate(sourcePath, bakedPath));
+	report = TextureBaker::Bake(sourcePath);
+	EXPECT_TRUE(report.succeeded);
+	EXPECT_FALSE(report.skipped);
+	EXPECT_TRUE(IsBakedTextureUpToDate(sourcePath, bakedPath));
+}
+
+TEST(TextureBakerTest, BakeResourcesReportsSavings) {
+	// リソースを汚さないよう作業ディレクトリに写してベイクする
+	TemporaryDirectory directory;
+	std::filesystem::copy(
+	    std::filesystem::path(RESOURCES_DIR) / "images", directory.GetPath() / "images");
+	std::vector<TextureBaker::Report> reports = TextureBaker::BakeDirectory(directory.GetPath());
+	ASSERT_FALSE(reports.empty());
+	for (const TextureBaker::Report& report : reports) {
+		ASSERT_TRUE(report.succeeded) << report.sourcePath << ": " << report.error;
+		EXPECT_GT(report.mipLevels, 1u);
+		if (report.format != DdsFile::Format::kR8G8B8A8UnormSrgb) {
+			// BC1は1/8、BC3は1/4（4画素未満のミップの分だけ多い）
+			EXPECT_LT(report.bakedBytes * 3, report.sourceBytes) << report.sourcePath;
+		}
+	}
+	std::printf("%s", TextureBaker::FormatReport(reports).c_str());
+}
@@ -0,0 +1,110 @@
+// TextureDecoderのデコードとミップ生成（デバイス不要）をワーカーで回し、スループットを出す
+#include "TextureDecoder.h"
+#include <chrono>
+#include <combaseapi.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Resources以下のPNG
+std::vector<std::wstring> FindSourceImages() {
+	std::vector<std::wstring> paths;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(RESOURCES_DIR)) {
+		if (entry.is_regular_file() && entry.path().extension() == L".png") {
+			paths.push_back(entry.path().wstring());
+		}
+	}
+	return paths;
+}
+
+class TextureDecoderTest : public testing::Test {
+protected:
+	// 同期デコードはこのスレッドでWICを使う
+	void SetUp() override { coResult_ = CoInitializeEx(nullptr, COINIT_MULTITHREADED); }
+	void TearDown() override {
+		if (SUCCEEDED(coResult_)) {
+			CoUninitialize();
+		}
+	}
+
+	HRESULT coResult_ = S_FALSE;
+};
+
+} // namespace
+
+TEST_F(TextureDecoderTest, WorkersMatchSynchronousDecode) {
+	std::vector<std::wstring> paths = FindSourceImages();
+	ASSERT_FALSE(paths.empty());
+
+	TextureDecoder decoder;
+	decoder.Initialize(4);
+	for (uint32_t i = 0; i < paths.size(); i++) {
+		decoder.Push({i, std::to_string(i), paths[i]});
+	}
+	decoder.WaitIdle();
+	std::vector<TextureDecoder::Result> results;
+	decoder.Collect(results);
+	ASSERT_EQ(results.size(), paths.size());
+
+	for (const TextureDecoder::Result& result : results) {
+		ASSERT_TRUE(SUCCEEDED(result.result));
+		DirectX::ScratchImage expected;
+		ASSERT_TRUE(SUCCEEDED(TextureDecoder::DecodeSource(paths[result.handle], expected)));
+		EXPECT_EQ(result.image.GetMetadata().mipLevels, expected.GetMetadata().mipLevels);
+		ASSERT_EQ(result.image.GetPixelsSize(), expected.GetPixelsSize());
+		EXPECT_EQ(
+		    std::memcmp(result.image.GetPixels(), expected.GetPixels(), expected.GetPixelsSize()), 0);
+	}
+}
+
+TEST_F(TextureDecoderTest, Throughput) {
+	std::vector<std::wstring> paths = FindSourceImages();
+	ASSERT_FALSE(paths.empty());
+
+	// 全画像を数回ずつ積み、ワーカー数ごとのMB/sを出す
+	const uint32_t kRepeatCount = 8;
+	for (uint32_t workerCount : {1u, 2u, 4u}) {
+		TextureDecoder decoder;
+		decoder.Initialize(workerCount);
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t repeat = 0; repeat < kRepeatCount; repeat++) {
+			for (uint32_t i = 0; i < paths.size(); i++) {
+				decoder.Push({i, std::to_string(i), paths[i]});
+			}
+		}
+		decoder.WaitIdle();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		TextureDecoder::Statistics statistics = decoder.GetStatistics();
+		EXPECT_EQ(statistics.textureCount, uint64_t(paths.size()) * kRepeatCount);
+		double wallMegaBytesPerSecond =
+		    double(statistics.decodedBytes) / (1024.0 * 1024.0) / elapsed.count();
+		std::printf(
+		    "workers %u: %llu textures, %.1f MB decoded, %.1f MB/s per worker, %.1f MB/s wall\n",
+		    workerCount, statistics.textureCount,
+		    double(statistics.decodedBytes) / (1024.0 * 1024.0),
+		    statistics.GetMegaBytesPerSecond(), wallMegaBytesPerSecond);
+		RecordProperty(
+		    "megaBytesPerSecond" + std::to_string(workerCount),
+		    std::to_string(wallMegaBytesPerSecond));
+		EXPECT_GT(wallMegaBytesPerSecond, 0.0);
+	}
+}
+
+TEST_F(TextureDecoderTest, DefaultWorkerCountIsAtLeastOne) {
+	// hardware_concurrencyが0を返す環境でも1本は起動する
+	TextureDecoder decoder;
+	decoder.Initialize();
+	std::wstring path = FindSourceImages().front();
+	decoder.Push({0, "0", path});
+	decoder.WaitIdle();
+	std::vector<TextureDecoder::Result> results;
+	decoder.Collect(results);
+	ASSERT_EQ(results.size(), 1u);
+	EXPECT_TRUE(SUCCEEDED(results[0].result));
+}
@@ -0,0 +1,105 @@
+// TransformHierarchyの計測（10万ノード。全部更新、根を1つ動かす、何も変えない、1ノードずつの参照）
+#include "TransformHierarchy.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+const uint32_t kNodeCount = 100000;
+// 親なしのノード数
+const uint32_t kRootCount = 100;
+
+void BuildRandomHierarchy(TransformHierarchy& hierarchy) {
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	hierarchy.Reserve(kNodeCount);
+	for (uint32_t i = 0; i < kNodeCount; i++) {
+		uint32_t parent = i < kRootCount ? TransformHierarchy::kNoParent : uint32_t(random() % i);
+		hierarchy.Add(
+		    parent, {1.0f, 1.0f, 1.0f},
+		    {distribution(random), distribution(random), distribution(random)},
+		    {distribution(random), distribution(random), distribution(random)});
+	}
+	hierarchy.Update();
+}
+
+// 全ノードの回転を変えて更新する
+void BM_UpdateAllDirty(benchmark::State& state) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy);
+	float angle = 0.0f;
+	for (auto _ : state) {
+		angle += 0.01f;
+		for (uint32_t i = 0; i < kNodeCount; i++) {
+			hierarchy.SetRotation(i, {angle, 0.0f, 0.0f});
+		}
+		hierarchy.Update();
+		benchmark::DoNotOptimize(hierarchy.GetWorldMatrix(kNodeCount - 1));
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kNodeCount);
+}
+
+// 根を1つ動かして更新する（その子孫だけ計算し直す）
+void BM_UpdateOneRootDirty(benchmark::State& state) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy);
+	uint32_t root = 0;
+	float z = 0.0f;
+	for (auto _ : state) {
+		hierarchy.SetTranslation(root, {0.0f, 0.0f, z});
+		hierarchy.Update();
+		benchmark::DoNotOptimize(hierarchy.GetChangedIndices().data());
+		root = (root + 1) % kRootCount;
+		z += 1.0f;
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kNodeCount);
+}
+
+void BM_UpdateClean(benchmark::State& state) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy);
+	for (auto _ : state) {
+		hierarchy.Update();
+		benchmark::DoNotOptimize(hierarchy.GetChangedIndices().data());
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kNodeCount);
+}
+
+// WorldTransformと同じく1ノードずつMakeAffineMatrixとMultiplyで求める
+void BM_PerNodeReference(benchmark::State& state) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy);
+	std::vector<Vector3> scales(kNodeCount);
+	std::vector<Vector3> rotations(kNodeCount);
+	std::vector<Vector3> translations(kNodeCount);
+	std::vector<uint32_t> parents(kNodeCount);
+	for (uint32_t i = 0; i < kNodeCount; i++) {
+		scales[i] = hierarchy.GetScale(i);
+		rotations[i] = hierarchy.GetRotation(i);
+		translations[i] = hierarchy.GetTranslation(i);
+		parents[i] = hierarchy.GetParent(i);
+	}
+	std::vector<Matrix4x4> worldMatrices(kNodeCount);
+	float angle = 0.0f;
+	for (auto _ : state) {
+		angle += 0.01f;
+		for (uint32_t i = 0; i < kNodeCount; i++) {
+			rotations[i].x = angle;
+			Matrix4x4 local = MakeAffineMatrix(scales[i], rotations[i], translations[i]);
+			worldMatrices[i] = parents[i] == TransformHierarchy::kNoParent
+			                       ? local
+			                       : Multiply(local, worldMatrices[parents[i]]);
+		}
+		benchmark::DoNotOptimize(worldMatrices.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * kNodeCount);
+}
+
+} // namespace
+
+BENCHMARK(BM_UpdateAllDirty)->Name("Update/all_dirty")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UpdateOneRootDirty)->Name("Update/one_root_dirty")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UpdateClean)->Name("Update/clean")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PerNodeReference)->Name("PerNodeReference")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,148 @@
+// TransformHierarchyのテスト（1ノードずつMakeAffineMatrixとMultiplyで求めた行列と比べる）
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 親をランダムに選んだ階層（先頭のrootCount個は親なし）
+void BuildRandomHierarchy(TransformHierarchy& hierarchy, uint32_t count, uint32_t rootCount) {
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	hierarchy.Reserve(count);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t parent = i < rootCount ? TransformHierarchy::kNoParent : uint32_t(random() % i);
+		hierarchy.Add(
+		    parent, {1.0f + distribution(random) * 0.1f, 1.0f, 1.0f},
+		    {distribution(random), distribution(random), distribution(random)},
+		    {distribution(random), distribution(random), distribution(random)});
+	}
+}
+
+// 1ノードずつ求めたワールド行列
+std::vector<Matrix4x4> ComputeReference(const TransformHierarchy& hierarchy) {
+	std::vector<Matrix4x4> worldMatrices(hierarchy.GetCount());
+	for (uint32_t i = 0; i < hierarchy.GetCount(); i++) {
+		Matrix4x4 local = MakeAffineMatrix(
+		    hierarchy.GetScale(i), hierarchy.GetRotation(i), hierarchy.GetTranslation(i));
+		uint32_t parent = hierarchy.GetParent(i);
+		worldMatrices[i] = parent == TransformHierarchy::kNoParent
+		                       ? local
+		                       : Multiply(local, worldMatrices[parent]);
+	}
+	return worldMatrices;
+}
+
+// 要素ごとの相対誤差の最大値（0付近は絶対誤差）
+double MaxRelativeError(
+    const TransformHierarchy& hierarchy, const std::vector<Matrix4x4>& expected) {
+	double maxError = 0.0;
+	for (uint32_t index = 0; index < hierarchy.GetCount(); index++) {
+		const Matrix4x4& actual = hierarchy.GetWorldMatrix(index);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				double error = std::abs(actual.m[i][j] - expected[index].m[i][j]) /
+				               (1.0 + std::abs(expected[index].m[i][j]));
+				maxError = std::max(maxError, error);
+			}
+		}
+	}
+	return maxError;
+}
+
+// indexとその子孫のノード番号（昇順）
+std::vector<uint32_t> CollectSubtree(const TransformHierarchy& hierarchy, uint32_t index) {
+	std::vector<uint8_t> isInSubtree(hierarchy.GetCount(), 0);
+	std::vector<uint32_t> subtree;
+	for (uint32_t i = index; i < hierarchy.GetCount(); i++) {
+		uint32_t parent = hierarchy.GetParent(i);
+		if (i == index || (parent != TransformHierarchy::kNoParent && isInSubtree[parent])) {
+			isInSubtree[i] = 1;
+			subtree.push_back(i);
+		}
+	}
+	return subtree;
+}
+
+} // namespace
+
+TEST(TransformHierarchyTest, FirstUpdateMatchesReference) {
+	// まとめて作る版の端数（4で割り切れない数）も通る
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy, 10007, 100);
+	hierarchy.Update();
+
+	EXPECT_EQ(hierarchy.GetChangedIndices().size(), size_t(10007));
+	// 同じ行列を掛ける順序も同じなので、差はバッチ版のsin/cosの近似分だけ
+	EXPECT_LT(MaxRelativeError(hierarchy, ComputeReference(hierarchy)), 5e-6);
+}
+
+TEST(TransformHierarchyTest, UpdateWithoutChangesTouchesNothing) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy, 1000, 10);
+	hierarchy.Update();
+	std::vector<Matrix4x4> before = ComputeReference(hierarchy);
+
+	hierarchy.Update();
+	EXPECT_TRUE(hierarchy.GetChangedIndices().empty());
+	EXPECT_LT(MaxRelativeError(hierarchy, before), 5e-6);
+}
+
+TEST(TransformHierarchyTest, MovingNodeRecomputesExactlyItsSubtree) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy, 10000, 100);
+	hierarchy.Update();
+
+	const uint32_t kMovedIndex = 50;
+	hierarchy.SetTranslation(kMovedIndex, {5.0f, 5.0f, 5.0f});
+	hierarchy.Update();
+
+	std::vector<uint32_t> subtree = CollectSubtree(hierarchy, kMovedIndex);
+	EXPECT_GT(subtree.size(), size_t(1));
+	EXPECT_EQ(hierarchy.GetChangedIndices(), subtree);
+	EXPECT_LT(MaxRelativeError(hierarchy, ComputeReference(hierarchy)), 5e-6);
+}
+
+TEST(TransformHierarchyTest, ChangedIndicesAreSortedAndUnique) {
+	// 親子両方を変えても1回だけ入る
+	TransformHierarchy hierarchy;
+	uint32_t root = hierarchy.Add(TransformHierarchy::kNoParent);
+	uint32_t child = hierarchy.Add(root, {1, 1, 1}, {0, 0, 0}, {1, 0, 0});
+	uint32_t other = hierarchy.Add(TransformHierarchy::kNoParent);
+	hierarchy.Update();
+
+	hierarchy.SetRotation(root, {0.0f, 0.0f, 1.0f});
+	hierarchy.SetScale(child, {2.0f, 2.0f, 2.0f});
+	hierarchy.Update();
+	EXPECT_EQ(hierarchy.GetChangedIndices(), (std::vector<uint32_t>{root, child}));
+	(void)other;
+}
+
+TEST(TransformHierarchyTest, ChildFollowsParent) {
+	TransformHierarchy hierarchy;
+	uint32_t root = hierarchy.Add(TransformHierarchy::kNoParent, {2, 2, 2}, {0, 0, 0}, {10, 0, 0});
+	uint32_t child = hierarchy.Add(root, {1, 1, 1}, {0, 0, 0}, {1, 2, 3});
+	hierarchy.Update();
+
+	// 親のスケールが効いてから親の位置へ
+	const Matrix4x4& world = hierarchy.GetWorldMatrix(child);
+	EXPECT_FLOAT_EQ(world.m[3][0], 12.0f);
+	EXPECT_FLOAT_EQ(world.m[3][1], 4.0f);
+	EXPECT_FLOAT_EQ(world.m[3][2], 6.0f);
+	EXPECT_EQ(hierarchy.GetParent(child), root);
+	EXPECT_EQ(hierarchy.GetParent(root), TransformHierarchy::kNoParent);
+}
+
+TEST(TransformHierarchyTest, ClearRemovesEverything) {
+	TransformHierarchy hierarchy;
+	BuildRandomHierarchy(hierarchy, 100, 1);
+	hierarchy.Update();
+	hierarchy.Clear();
+	EXPECT_EQ(hierarchy.GetCount(), 0u);
+	EXPECT_TRUE(hierarchy.GetChangedIndices().empty());
+	hierarchy.Update();
+	EXPECT_TRUE(hierarchy.GetChangedIndices().empty());
+}
@@ -0,0 +1,71 @@
+// 自機の角の位置とAABBの当たり判定の計測（マップ衝突で毎フレーム行う計算）
+#include "MyMath.h"
+#include "PlayerShape.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 1ステージ分のブロック（20x100）の周りに自機を置き、各角が当たるブロックを数える
+void BM_CornerCollision(benchmark::State& state) {
+	uint32_t positionCount = uint32_t(state.range(0));
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distributionX(0.0f, 100.0f);
+	std::uniform_real_distribution<float> distributionY(0.0f, 20.0f);
+	std::vector<Vector3> centers(positionCount);
+	for (Vector3& center : centers) {
+		center = {distributionX(random), distributionY(random), 0.0f};
+	}
+
+	// 1つおきに置いたブロック
+	std::vector<AABB> blocks;
+	for (uint32_t y = 0; y < 20; y += 2) {
+		for (uint32_t x = 0; x < 100; x += 2) {
+			blocks.push_back(
+			    {{float(x) - 0.5f, float(y) - 0.5f, -0.5f}, {float(x) + 0.5f, float(y) + 0.5f, 0.5f}});
+		}
+	}
+
+	for (auto _ : state) {
+		uint32_t hitCount = 0;
+		for (const Vector3& center : centers) {
+			for (uint32_t corner = 0; corner < kNumCorner; corner++) {
+				Vector3 position = PlayerShape::CornerPosition(center, Corner(corner));
+				// 角の周りのブロック（マップチップの添字で引く分）だけ見る
+				uint32_t x = uint32_t(position.x + 0.5f) & ~1u;
+				uint32_t y = uint32_t(position.y + 0.5f) & ~1u;
+				if (x < 100 && y < 20) {
+					hitCount += IsCollision({position, position}, blocks[y / 2 * 50 + x / 2]);
+				}
+			}
+			hitCount += IsCollision(PlayerShape::MakeAABB(center), blocks[0]);
+		}
+		benchmark::DoNotOptimize(hitCount);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * positionCount);
+}
+BENCHMARK(BM_CornerCollision)->Arg(1)->Arg(1000)->Arg(100000);
+
+// 全ブロックとの総当たり（添字で引かない場合）
+void BM_PlayerBoxAgainstAllBlocks(benchmark::State& state) {
+	std::vector<AABB> blocks;
+	for (uint32_t y = 0; y < 20; y++) {
+		for (uint32_t x = 0; x < 100; x++) {
+			blocks.push_back(
+			    {{float(x) - 0.5f, float(y) - 0.5f, -0.5f}, {float(x) + 0.5f, float(y) + 0.5f, 0.5f}});
+		}
+	}
+	AABB player = PlayerShape::MakeAABB({37.3f, 8.6f, 0.0f});
+	for (auto _ : state) {
+		uint32_t hitCount = 0;
+		for (const AABB& block : blocks) {
+			hitCount += IsCollision(player, block);
+		}
+		benchmark::DoNotOptimize(hitCount);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(blocks.size()));
+}
+BENCHMARK(BM_PlayerBoxAgainstAllBlocks);
+
+} // namespace
@@ -0,0 +1,148 @@
+// Vector3の演算とMyMathの定数式関数のテスト（コンパイル時の値と、実行時の精度）
+#include "MyMath.h"
+#include "PlayerShape.h"
+#include "Vector3.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+
+// 定数式用の差の判定
+constexpr bool IsNear(float a, float b, float tolerance) {
+	return (a < b ? b - a : a - b) <= tolerance;
+}
+constexpr bool IsNear(const Vector3& a, const Vector3& b, float tolerance) {
+	return IsNear(a.x, b.x, tolerance) && IsNear(a.y, b.y, tolerance) &&
+	       IsNear(a.z, b.z, tolerance);
+}
+
+// 演算子とクロス積はコンパイル時に評価できる
+constexpr Vector3 kX = {1.0f, 0.0f, 0.0f};
+constexpr Vector3 kY = {0.0f, 1.0f, 0.0f};
+constexpr Vector3 kZ = {0.0f, 0.0f, 1.0f};
+static_assert(Cross(kX, kY) == kZ);
+static_assert(Cross(kY, kZ) == kX);
+static_assert(Cross(kZ, kX) == kY);
+static_assert(Cross(kY, kX) == -kZ);
+static_assert(Cross(Vector3{1, 2, 3}, Vector3{4, 5, 6}) == Vector3{-3, 6, -3});
+static_assert(Dot(Vector3{1, 2, 3}, Vector3{4, 5, 6}) == 32.0f);
+static_assert(LengthSquared(Vector3{2, 3, 6}) == 49.0f);
+static_assert(Vector3{2, 4, 8} / 2.0f == Vector3{1, 2, 4});
+static_assert(Vector3{1, 2, 3} * 2.0f == 2.0f * Vector3{1, 2, 3});
+static_assert(Vector3{1, 2, 3} * Vector3{4, 5, 6} == Vector3{4, 10, 18});
+static_assert(Lerp(Vector3{2, 2, 2}, Vector3{0, 0, 0}, 0.25f) == Vector3{0.5f, 0.5f, 0.5f});
+
+// 定数式のsin、cos
+static_assert(ConstexprSin(0.0f) == 0.0f);
+static_assert(ConstexprCos(0.0f) == 1.0f);
+static_assert(IsNear(ConstexprSin(kPi / 2.0f), 1.0f, 1e-6f));
+static_assert(IsNear(ConstexprCos(kPi), -1.0f, 1e-6f));
+static_assert(IsNear(ConstexprSin(kPi / 6.0f), 0.5f, 1e-6f));
+// [-π, π]の外は折り返す
+static_assert(IsNear(ConstexprSin(kPi / 6.0f + 4.0f * kPi), 0.5f, 2e-6f));
+static_assert(IsNear(ConstexprCos(-kPi / 3.0f - 6.0f * kPi), 0.5f, 2e-6f));
+
+// 自機の角は、名前の通りの向きに幅、高さの半分ずつずれる
+static_assert(PlayerShape::kCornerOffsets[kRightBottom] == Vector3{0.4f, -0.4f, 0.0f});
+static_assert(PlayerShape::kCornerOffsets[kLeftBottom] == Vector3{-0.4f, -0.4f, 0.0f});
+static_assert(PlayerShape::kCornerOffsets[kRightTop] == Vector3{0.4f, 0.4f, 0.0f});
+static_assert(PlayerShape::kCornerOffsets[kLeftTop] == Vector3{-0.4f, 0.4f, 0.0f});
+static_assert(IsNear(
+    PlayerShape::CornerPosition({10, 5, 0}, kLeftTop), Vector3{9.6f, 5.4f, 0.0f}, 1e-6f));
+
+// AABBの当たり判定（接しているものは当たり）
+constexpr AABB kUnitBox = {{0, 0, 0}, {1, 1, 1}};
+static_assert(IsCollision(kUnitBox, {{0.5f, 0.5f, 0.5f}, {2, 2, 2}}));
+static_assert(IsCollision(kUnitBox, {{1, 0, 0}, {2, 1, 1}}));
+static_assert(!IsCollision(kUnitBox, {{1.01f, 0, 0}, {2, 1, 1}}));
+static_assert(!IsCollision(kUnitBox, {{0, 0, -2}, {1, 1, -0.5f}}));
+static_assert(IsCollision(PlayerShape::MakeAABB({0.5f, 0.5f, 0.5f}), kUnitBox));
+static_assert(!IsCollision(PlayerShape::MakeAABB({2.0f, 0.5f, 0.5f}), kUnitBox));
+
+TEST(VectorMathTest, ConstexprSinCosMatchStandardLibrary) {
+	// 実行時にも呼べて、std::sin、std::cosとほぼ同じ値になる
+	float maxError = 0.0f;
+	for (int i = -20000; i <= 20000; i++) {
+		float radian = float(i) * (4.0f * kPi / 20000.0f);
+		maxError = std::max(maxError, std::abs(ConstexprSin(radian) - std::sin(radian)));
+		maxError = std::max(maxError, std::abs(ConstexprCos(radian) - std::cos(radian)));
+	}
+	EXPECT_LT(maxError, 2e-6f);
+}
+
+TEST(VectorMathTest, CrossIsPerpendicularAndAntiCommutative) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+	for (int i = 0; i < 1000; i++) {
+		Vector3 a = {distribution(random), distribution(random), distribution(random)};
+		Vector3 b = {distribution(random), distribution(random), distribution(random)};
+		Vector3 c = Cross(a, b);
+		float scale = Length(a) * Length(b);
+		EXPECT_NEAR(Dot(c, a) / scale, 0.0f, 1e-5f);
+		EXPECT_NEAR(Dot(c, b) / scale, 0.0f, 1e-5f);
+		EXPECT_EQ(Cross(b, a), -c);
+
+		// |a×b|² = |a|²|b|² - (a・b)²
+		double lhs = LengthSquared(c);
+		double rhs = double(LengthSquared(a)) * LengthSquared(b) - double(Dot(a, b)) * Dot(a, b);
+		EXPECT_NEAR(lhs, rhs, 1e-4 * double(scale) * scale);
+	}
+}
+
+TEST(VectorMathTest, NormalizeKeepsZeroVector) {
+	// 長さ0ならそのまま返し、NaNにしない
+	Vector3 zero = Normalize(Vector3{0.0f, 0.0f, 0.0f});
+	EXPECT_EQ(zero, Vector3(0.0f, 0.0f, 0.0f));
+	EXPECT_FALSE(std::isnan(zero.x) || std::isnan(zero.y) || std::isnan(zero.z));
+
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	for (int i = 0; i < 1000; i++) {
+		Vector3 v = {distribution(random), distribution(random), distribution(random)};
+		Vector3 n = Normalize(v);
+		EXPECT_NEAR(Length(n), 1.0f, 1e-6f);
+		EXPECT_GT(Dot(n, v), 0.0f);
+	}
+}
+
+TEST(VectorMathTest, DivisionMatchesComponentwiseDivide) {
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	for (int i = 0; i < 1000; i++) {
+		Vector3 v = {distribution(random), distribution(random), distribution(random)};
+		float s = distribution(random);
+		if (s == 0.0f) {
+			continue;
+		}
+		// 逆数を掛けるのではなく各成分を割るので、/=と同じ値になる
+		Vector3 quotient = v / s;
+		EXPECT_EQ(quotient.x, v.x / s);
+		EXPECT_EQ(quotient.y, v.y / s);
+		EXPECT_EQ(quotient.z, v.z / s);
+		Vector3 assigned = v;
+		assigned /= s;
+		EXPECT_EQ(assigned, quotient);
+		EXPECT_NEAR(Length(quotient * s - v), 0.0f, 1e-4f * Length(v));
+	}
+}
+
+TEST(VectorMathTest, CornersLieOnPlayerBox) {
+	std::mt19937 random(4);
+	std::uniform_real_distribution<float> distribution(-50.0f, 50.0f);
+	for (int i = 0; i < 100; i++) {
+		Vector3 center = {distribution(random), distribution(random), 0.0f};
+		AABB box = PlayerShape::MakeAABB(center);
+		for (uint32_t corner = 0; corner < kNumCorner; corner++) {
+			Vector3 position = PlayerShape::CornerPosition(center, Corner(corner));
+			// 角の位置はAABBの上下左右の端に一致する
+			EXPECT_TRUE(position.x == box.min.x || position.x == box.max.x) << corner;
+			EXPECT_TRUE(position.y == box.min.y || position.y == box.max.y) << corner;
+			EXPECT_TRUE(IsCollision({position, position}, box)) << corner;
+		}
+	}
+}
+
+} // namespace
@@ -0,0 +1,242 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 主軸を求める反復回数
+const int kPowerIterationCount = 8;
+
+// RGB888 → RGB565（四捨五入）
+uint16_t PackRgb565(float r, float g, float b) {
+	auto quantize = [](float value, int maxValue) {
+		int quantized = int(std::lround(std::clamp(value, 0.0f, 255.0f) * maxValue / 255.0f));
+		return std::clamp(quantized, 0, maxValue);
+	};
+	return uint16_t((quantize(r, 31) << 11) | (quantize(g, 63) << 5) | quantize(b, 31));
+}
+
+// RGB565 → RGB888（上位ビットで下位を埋める）
+void UnpackRgb565(uint16_t color, uint8_t rgb[3]) {
+	uint32_t r = (color >> 11) & 31;
+	uint32_t g = (color >> 5) & 63;
+	uint32_t b = color & 31;
+	rgb[0] = uint8_t((r << 3) | (r >> 2));
+	rgb[1] = uint8_t((g << 2) | (g >> 4));
+	rgb[2] = uint8_t((b << 3) | (b >> 2));
+}
+
+// 4色モードの色の表
+void MakeFourColorPalette(uint16_t color0, uint16_t color1, uint8_t palette[4][3]) {
+	UnpackRgb565(color0, palette[0]);
+	UnpackRgb565(color1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		palette[2][c] = uint8_t((2 * palette[0][c] + palette[1][c]) / 3);
+		palette[3][c] = uint8_t((palette[0][c] + 2 * palette[1][c]) / 3);
+	}
+}
+
+void WriteUint16(uint8_t* destination, uint16_t value) {
+	destination[0] = uint8_t(value & 0xff);
+	destination[1] = uint8_t(value >> 8);
+}
+
+uint16_t ReadUint16(const uint8_t* source) { return uint16_t(source[0] | (source[1] << 8)); }
+
+} // namespace
+
+void BlockCompression::EncodeBC1Block(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block) {
+	EncodeColorBlock(rgba, block);
+}
+
+void BlockCompression::EncodeBC3Block(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block) {
+	EncodeAlphaBlock(rgba, block);
+	EncodeColorBlock(rgba, block + 8);
+}
+
+void BlockCompression::DecodeBC1Block(const uint8_t* block, uint8_t rgba[kBlockPixelCount * 4]) {
+	DecodeColorBlock(block, false, rgba);
+}
+
+void BlockCompression::DecodeBC3Block(const uint8_t* block, uint8_t rgba[kBlockPixelCount * 4]) {
+	DecodeColorBlock(block + 8, true, rgba);
+
+	// αの表（alpha0 > alpha1なら8段階、それ以外は6段階と0と255）
+	uint32_t alpha0 = block[0];
+	uint32_t alpha1 = block[1];
+	uint8_t palette[8] = {uint8_t(alpha0), uint8_t(alpha1)};
+	if (alpha0 > alpha1) {
+		for (uint32_t i = 1; i < 7; i++) {
+			palette[i + 1] = uint8_t(((7 - i) * alpha0 + i * alpha1) / 7);
+		}
+	} else {
+		for (uint32_t i = 1; i < 5; i++) {
+			palette[i + 1] = uint8_t(((5 - i) * alpha0 + i * alpha1) / 5);
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t indices = 0;
+	for (int i = 0; i < 6; i++) {
+		indices |= uint64_t(block[2 + i]) << (8 * i);
+	}
+	for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+		rgba[i * 4 + 3] = palette[(indices >> (3 * i)) & 7];
+	}
+}
+
+void BlockCompression::EncodeColorBlock(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block) {
+	// 平均と共分散
+	float mean[3] = {};
+	for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+		for (int c = 0; c < 3; c++) {
+			mean[c] += rgba[i * 4 + c];
+		}
+	}
+	for (float& value : mean) {
+		value /= float(kBlockPixelCount);
+	}
+	float covariance[6] = {}; // rr rg rb gg gb bb
+	for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+		float r = rgba[i * 4 + 0] - mean[0];
+		float g = rgba[i * 4 + 1] - mean[1];
+		float b = rgba[i * 4 + 2] - mean[2];
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	// 累乗法で主軸を求める（単色なら軸は何でもよい）
+	float axis[3] = {1.0f, 1.0f, 1.0f};
+	for (int iteration = 0; iteration < kPowerIterationCount; iteration++) {
+		float next[3] = {
+		    covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+		    covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+		    covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+		};
+		float length = std::max({std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2])});
+		if (length <= 0.0f) {
+			break;
+		}
+		for (int c = 0; c < 3; c++) {
+			axis[c] = next[c] / length;
+		}
+	}
+
+	// 主軸に射影した両端を端点にし、量子化誤差を見越して1/16だけ内側に寄せる
+	float minProjection = 0.0f;
+	float maxProjection = 0.0f;
+	for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+		float projection = (rgba[i * 4 + 0] - mean[0]) * axis[0] +
+		                   (rgba[i * 4 + 1] - mean[1]) * axis[1] +
+		                   (rgba[i * 4 + 2] - mean[2]) * axis[2];
+		minProjection = std::min(minProjection, projection);
+		maxProjection = std::max(maxProjection, projection);
+	}
+	float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+	float inset = (maxProjection - minProjection) / 16.0f;
+	float maxEnd = (maxProjection - inset) / axisLengthSquared;
+	float minEnd = (minProjection + inset) / axisLengthSquared;
+	uint16_t color0 = PackRgb565(
+	    mean[0] + axis[0] * maxEnd, mean[1] + axis[1] * maxEnd, mean[2] + axis[2] * maxEnd);
+	uint16_t color1 = PackRgb565(
+	    mean[0] + axis[0] * minEnd, mean[1] + axis[1] * minEnd, mean[2] + axis[2] * minEnd);
+
+	// 4色モードはcolor0 > color1のときだけなので入れ替える。同じなら全画素color0
+	if (color0 < color1) {
+		std::swap(color0, color1);
+	}
+	uint32_t indices = 0;
+	if (color0 != color1) {
+		uint8_t palette[4][3];
+		MakeFourColorPalette(color0, color1, palette);
+		for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+			uint32_t bestIndex = 0;
+			int bestDistance = INT32_MAX;
+			for (uint32_t p = 0; p < 4; p++) {
+				int distance = 0;
+				for (int c = 0; c < 3; c++) {
+					int difference = int(rgba[i * 4 + c]) - int(palette[p][c]);
+					distance += difference * difference;
+				}
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (2 * i);
+		}
+	}
+
+	WriteUint16(block, color0);
+	WriteUint16(block + 2, color1);
+	std::memcpy(block + 4, &indices, sizeof(indices));
+}
+
+void BlockCompression::EncodeAlphaBlock(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block) {
+	uint8_t minAlpha = 255;
+	uint8_t maxAlpha = 0;
+	for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+		minAlpha = std::min(minAlpha, rgba[i * 4 + 3]);
+		maxAlpha = std::max(maxAlpha, rgba[i * 4 + 3]);
+	}
+
+	// 8段階モード（alpha0 > alpha1）。全て同じ値なら6段階モードの0番で表せる
+	block[0] = maxAlpha;
+	block[1] = minAlpha;
+	uint64_t indices = 0;
+	if (maxAlpha != minAlpha) {
+		uint8_t palette[8] = {maxAlpha, minAlpha};
+		for (uint32_t i = 1; i < 7; i++) {
+			palette[i + 1] = uint8_t(((7 - i) * maxAlpha + i * minAlpha) / 7);
+		}
+		for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+			uint32_t bestIndex = 0;
+			int bestDistance = INT32_MAX;
+			for (uint32_t p = 0; p < 8; p++) {
+				int distance = std::abs(int(rgba[i * 4 + 3]) - int(palette[p]));
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+			indices |= uint64_t(bestIndex) << (3 * i);
+		}
+	}
+	for (int i = 0; i < 6; i++) {
+		block[2 + i] = uint8_t(indices >> (8 * i));
+	}
+}
+
+void BlockCompression::DecodeColorBlock(
+    const uint8_t* block, bool forceFourColor, uint8_t rgba[kBlockPixelCount * 4]) {
+	uint16_t color0 = ReadUint16(block);
+	uint16_t color1 = ReadUint16(block + 2);
+	uint8_t palette[4][4];
+	UnpackRgb565(color0, palette[0]);
+	UnpackRgb565(color1, palette[1]);
+	palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+	if (forceFourColor || color0 > color1) {
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = uint8_t((2 * palette[0][c] + palette[1][c]) / 3);
+			palette[3][c] = uint8_t((palette[0][c] + 2 * palette[1][c]) / 3);
+		}
+	} else {
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = uint8_t((palette[0][c] + palette[1][c]) / 2);
+			palette[3][c] = 0;
+		}
+		palette[3][3] = 0;
+	}
+
+	uint32_t indices;
+	std::memcpy(&indices, block + 4, sizeof(indices));
+	for (uint32_t i = 0; i < kBlockPixelCount; i++) {
+		std::memcpy(&rgba[i * 4], palette[(indices >> (2 * i)) & 3], 4);
+	}
+}
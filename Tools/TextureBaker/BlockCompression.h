@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// BC1/BC3のブロック圧縮（4x4画素を1ブロックにする。CPUのみ）
+/// </summary>
+/// <remarks>
+/// 色は主軸（共分散の最大固有ベクトル）方向の両端を端点にし、各画素を4色の近い方に割り当てる。
+/// BC1は常に4色モード（color0 > color1）で書くので、BC3の色ブロックとしてもそのまま使える。
+/// αはBC3の8段階モード（alpha0 > alpha1）で最小値と最大値の間を割り当てる。
+/// </remarks>
+class BlockCompression {
+public:
+	// 1ブロックの画素数
+	static const uint32_t kBlockPixelCount = 16;
+	// BC1の1ブロックのバイト数
+	static const uint32_t kBC1BlockBytes = 8;
+	// BC3の1ブロックのバイト数
+	static const uint32_t kBC3BlockBytes = 16;
+
+	/// <summary>
+	/// BC1の1ブロックを作る（αは無視する）
+	/// </summary>
+	/// <param name="rgba">4x4画素のRGBA8（行ごと）</param>
+	/// <param name="block">出力（8バイト）</param>
+	static void EncodeBC1Block(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block);
+
+	/// <summary>
+	/// BC3の1ブロックを作る
+	/// </summary>
+	/// <param name="rgba">4x4画素のRGBA8（行ごと）</param>
+	/// <param name="block">出力（16バイト）</param>
+	static void EncodeBC3Block(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block);
+
+	/// <summary>
+	/// BC1の1ブロックを戻す（3色モードの透明も含む）
+	/// </summary>
+	/// <param name="block">入力（8バイト）</param>
+	/// <param name="rgba">4x4画素のRGBA8の出力</param>
+	static void DecodeBC1Block(const uint8_t* block, uint8_t rgba[kBlockPixelCount * 4]);
+
+	/// <summary>
+	/// BC3の1ブロックを戻す
+	/// </summary>
+	/// <param name="block">入力（16バイト）</param>
+	/// <param name="rgba">4x4画素のRGBA8の出力</param>
+	static void DecodeBC3Block(const uint8_t* block, uint8_t rgba[kBlockPixelCount * 4]);
+
+private:
+	/// <summary>
+	/// 色ブロック（BC1と同じ8バイト）を作る
+	/// </summary>
+	static void EncodeColorBlock(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block);
+
+	/// <summary>
+	/// BC3のαブロック（8バイト）を作る
+	/// </summary>
+	static void EncodeAlphaBlock(const uint8_t rgba[kBlockPixelCount * 4], uint8_t* block);
+
+	/// <summary>
+	/// 色ブロックを戻す
+	/// </summary>
+	/// <param name="forceFourColor">端点の大小に関わらず4色モードで読む（BC3）</param>
+	static void DecodeColorBlock(
+	    const uint8_t* block, bool forceFourColor, uint8_t rgba[kBlockPixelCount * 4]);
+};
@@ -0,0 +1,163 @@
+#include "DdsFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// "DDS "
+const uint32_t kMagic = 0x20534444;
+// "DX10"
+const uint32_t kFourCCDX10 = 0x30315844;
+
+// DDS_HEADERのフラグ
+const uint32_t kHeaderFlagsCaps = 0x1;
+const uint32_t kHeaderFlagsHeight = 0x2;
+const uint32_t kHeaderFlagsWidth = 0x4;
+const uint32_t kHeaderFlagsPitch = 0x8;
+const uint32_t kHeaderFlagsPixelFormat = 0x1000;
+const uint32_t kHeaderFlagsMipMapCount = 0x20000;
+const uint32_t kHeaderFlagsLinearSize = 0x80000;
+// DDS_PIXELFORMATのフラグ
+const uint32_t kPixelFormatFourCC = 0x4;
+// DDSCAPS
+const uint32_t kCapsComplex = 0x8;
+const uint32_t kCapsTexture = 0x1000;
+const uint32_t kCapsMipMap = 0x400000;
+// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+const uint32_t kDimensionTexture2D = 3;
+
+#pragma pack(push, 1)
+// DDS_PIXELFORMAT
+struct PixelFormat {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t bitMasks[4];
+};
+
+// DDS_HEADER
+struct Header {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11];
+	PixelFormat pixelFormat;
+	uint32_t caps[4];
+	uint32_t reserved2;
+};
+
+// DDS_HEADER_DXT10
+struct HeaderDX10 {
+	uint32_t dxgiFormat;
+	uint32_t resourceDimension;
+	uint32_t miscFlag;
+	uint32_t arraySize;
+	uint32_t miscFlags2;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Header) == 124 && sizeof(HeaderDX10) == 20);
+
+} // namespace
+
+bool DdsFile::IsCompressed(Format format) {
+	return format == Format::kBC1UnormSrgb || format == Format::kBC3UnormSrgb;
+}
+
+uint64_t DdsFile::GetMipBytes(Format format, uint32_t width, uint32_t height) {
+	// ブロック圧縮は4x4画素単位（4未満のミップも1ブロック）
+	uint64_t blockCountX = std::max(1u, (width + 3) / 4);
+	uint64_t blockCountY = std::max(1u, (height + 3) / 4);
+	switch (format) {
+	case Format::kBC1UnormSrgb:
+		return blockCountX * blockCountY * 8;
+	case Format::kBC3UnormSrgb:
+		return blockCountX * blockCountY * 16;
+	case Format::kR8G8B8A8UnormSrgb:
+		return uint64_t(width) * height * 4;
+	default:
+		return 0;
+	}
+}
+
+bool DdsFile::Write(const std::filesystem::path& filePath, const Texture& texture) {
+	if (texture.mips.empty()) {
+		return false;
+	}
+
+	Header header{};
+	header.size = sizeof(Header);
+	header.flags = kHeaderFlagsCaps | kHeaderFlagsHeight | kHeaderFlagsWidth |
+	               kHeaderFlagsPixelFormat | kHeaderFlagsMipMapCount;
+	if (IsCompressed(texture.format)) {
+		header.flags |= kHeaderFlagsLinearSize;
+		header.pitchOrLinearSize = uint32_t(texture.mips[0].size());
+	} else {
+		header.flags |= kHeaderFlagsPitch;
+		header.pitchOrLinearSize = texture.width * 4;
+	}
+	header.height = texture.height;
+	header.width = texture.width;
+	header.depth = 1;
+	header.mipMapCount = uint32_t(texture.mips.size());
+	header.pixelFormat.size = sizeof(PixelFormat);
+	header.pixelFormat.flags = kPixelFormatFourCC;
+	header.pixelFormat.fourCC = kFourCCDX10;
+	header.caps[0] = kCapsTexture | (texture.mips.size() > 1 ? kCapsComplex | kCapsMipMap : 0);
+
+	HeaderDX10 headerDX10{};
+	headerDX10.dxgiFormat = uint32_t(texture.format);
+	headerDX10.resourceDimension = kDimensionTexture2D;
+	headerDX10.arraySize = 1;
+
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(&kMagic), sizeof(kMagic));
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&headerDX10), sizeof(headerDX10));
+	for (const std::vector<uint8_t>& mip : texture.mips) {
+		file.write(reinterpret_cast<const char*>(mip.data()), std::streamsize(mip.size()));
+	}
+	return bool(file);
+}
+
+bool DdsFile::Read(const std::filesystem::path& filePath, Texture& texture) {
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	uint32_t magic = 0;
+	Header header{};
+	HeaderDX10 headerDX10{};
+	file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	file.read(reinterpret_cast<char*>(&headerDX10), sizeof(headerDX10));
+	if (!file || magic != kMagic || header.size != sizeof(Header) ||
+	    header.pixelFormat.fourCC != kFourCCDX10 ||
+	    headerDX10.resourceDimension != kDimensionTexture2D) {
+		return false;
+	}
+
+	texture.format = Format(headerDX10.dxgiFormat);
+	texture.width = header.width;
+	texture.height = header.height;
+	texture.mips.resize(std::max(1u, header.mipMapCount));
+	uint32_t width = header.width;
+	uint32_t height = header.height;
+	for (std::vector<uint8_t>& mip : texture.mips) {
+		mip.resize(size_t(GetMipBytes(texture.format, width, height)));
+		file.read(reinterpret_cast<char*>(mip.data()), std::streamsize(mip.size()));
+		width = std::max(1u, width / 2);
+		height = std::max(1u, height / 2);
+	}
+	return bool(file) && !texture.mips[0].empty();
+}
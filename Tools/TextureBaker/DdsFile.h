@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/// <summary>
+/// DDSファイル（DX10拡張ヘッダー付きの2Dテクスチャのみ）の書き出しと読み込み
+/// </summary>
+/// <remarks>
+/// 実行時はDirectXTexのLoadFromDDSFileで読むので、同じ形式（"DDS " + DDS_HEADER + DDS_HEADER_DXT10）で書く。
+/// </remarks>
+class DdsFile {
+public:
+	/// <summary>
+	/// フォーマット（値はDXGI_FORMATと同じ）
+	/// </summary>
+	enum class Format : uint32_t {
+		kUnknown = 0,
+		kR8G8B8A8UnormSrgb = 29,
+		kBC1UnormSrgb = 72,
+		kBC3UnormSrgb = 78,
+	};
+
+	/// <summary>
+	/// テクスチャ
+	/// </summary>
+	struct Texture {
+		// フォーマット
+		Format format = Format::kUnknown;
+		// 最上位ミップの幅と高さ[px]
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// ミップごとのデータ（0番が最上位）
+		std::vector<std::vector<uint8_t>> mips;
+	};
+
+	/// <summary>
+	/// ブロック圧縮フォーマットか
+	/// </summary>
+	static bool IsCompressed(Format format);
+
+	/// <summary>
+	/// 1ミップのバイト数
+	/// </summary>
+	/// <param name="format">フォーマット</param>
+	/// <param name="width">幅[px]</param>
+	/// <param name="height">高さ[px]</param>
+	static uint64_t GetMipBytes(Format format, uint32_t width, uint32_t height);
+
+	/// <summary>
+	/// 書き出し
+	/// </summary>
+	/// <param name="filePath">出力パス</param>
+	/// <param name="texture">テクスチャ</param>
+	/// <returns>成否</returns>
+	static bool Write(const std::filesystem::path& filePath, const Texture& texture);
+
+	/// <summary>
+	/// 読み込み（Writeで書いた形式のみ）
+	/// </summary>
+	/// <param name="filePath">入力パス</param>
+	/// <param name="texture">テクスチャの出力先</param>
+	/// <returns>成否</returns>
+	static bool Read(const std::filesystem::path& filePath, Texture& texture);
+};
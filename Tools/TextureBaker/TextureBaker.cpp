@@ -0,0 +1,290 @@
+#include "TextureBaker.h"
+#include "BakedTexturePath.h"
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <png.h>
+
+namespace {
+
+// 経過時間[ms]
+double ElapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+	    .count();
+}
+
+// フォーマット名
+const char* GetFormatName(DdsFile::Format format) {
+	switch (format) {
+	case DdsFile::Format::kBC1UnormSrgb:
+		return "BC1";
+	case DdsFile::Format::kBC3UnormSrgb:
+		return "BC3";
+	case DdsFile::Format::kR8G8B8A8UnormSrgb:
+		return "RGBA8";
+	default:
+		return "other";
+	}
+}
+
+// 行末に書式付きで足す
+template<typename... Args> void AppendFormat(std::string& text, const char* format, Args... args) {
+	char buffer[512];
+	std::snprintf(buffer, sizeof(buffer), format, args...);
+	text += buffer;
+}
+
+} // namespace
+
+bool TextureBaker::LoadPng(const std::filesystem::path& filePath, Image& image, std::string* error) {
+	png_image png{};
+	png.version = PNG_IMAGE_VERSION;
+	if (!png_image_begin_read_from_file(&png, filePath.string().c_str())) {
+		if (error) {
+			*error = png.message;
+		}
+		return false;
+	}
+
+	png.format = PNG_FORMAT_RGBA;
+	image.width = png.width;
+	image.height = png.height;
+	image.pixels.resize(PNG_IMAGE_SIZE(png));
+	if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) {
+		if (error) {
+			*error = png.message;
+		}
+		png_image_free(&png);
+		return false;
+	}
+	return true;
+}
+
+std::vector<TextureBaker::Image> TextureBaker::GenerateMipChain(Image image) {
+	std::vector<Image> mips;
+	mips.push_back(std::move(image));
+
+	while (mips.back().width > 1 || mips.back().height > 1) {
+		const Image& source = mips.back();
+		Image mip;
+		mip.width = std::max(1u, source.width / 2);
+		mip.height = std::max(1u, source.height / 2);
+		mip.pixels.resize(size_t(mip.width) * mip.height * 4);
+
+		// 2x2画素の平均（1画素しかない辺は同じ画素を2回使う）
+		for (uint32_t y = 0; y < mip.height; y++) {
+			uint32_t y0 = std::min(y * 2, source.height - 1);
+			uint32_t y1 = std::min(y * 2 + 1, source.height - 1);
+			for (uint32_t x = 0; x < mip.width; x++) {
+				uint32_t x0 = std::min(x * 2, source.width - 1);
+				uint32_t x1 = std::min(x * 2 + 1, source.width - 1);
+				for (uint32_t c = 0; c < 4; c++) {
+					uint32_t sum = source.pixels[(size_t(y0) * source.width + x0) * 4 + c] +
+					               source.pixels[(size_t(y0) * source.width + x1) * 4 + c] +
+					               source.pixels[(size_t(y1) * source.width + x0) * 4 + c] +
+					               source.pixels[(size_t(y1) * source.width + x1) * 4 + c];
+					mip.pixels[(size_t(y) * mip.width + x) * 4 + c] = uint8_t((sum + 2) / 4);
+				}
+			}
+		}
+		mips.push_back(std::move(mip));
+	}
+	return mips;
+}
+
+bool TextureBaker::IsAlphaAllOpaque(const Image& image) {
+	for (size_t i = 3; i < image.pixels.size(); i += 4) {
+		if (image.pixels[i] != 255) {
+			return false;
+		}
+	}
+	return true;
+}
+
+DdsFile::Format TextureBaker::SelectFormat(const Image& image, Compression compression) {
+	// BC圧縮は最上位ミップが4の倍数でないとD3D12で作れない
+	if (compression == Compression::kNone || image.width % 4 != 0 || image.height % 4 != 0) {
+		return DdsFile::Format::kR8G8B8A8UnormSrgb;
+	}
+
+	switch (compression) {
+	case Compression::kBC1:
+		return DdsFile::Format::kBC1UnormSrgb;
+	case Compression::kBC3:
+		return DdsFile::Format::kBC3UnormSrgb;
+	case Compression::kAuto:
+	default:
+		// 不透明ならBC1で十分
+		return IsAlphaAllOpaque(image) ? DdsFile::Format::kBC1UnormSrgb
+		                               : DdsFile::Format::kBC3UnormSrgb;
+	}
+}
+
+DdsFile::Texture TextureBaker::Compress(const std::vector<Image>& mips, DdsFile::Format format) {
+	DdsFile::Texture texture;
+	texture.format = format;
+	texture.width = mips.front().width;
+	texture.height = mips.front().height;
+
+	for (const Image& mip : mips) {
+		if (!DdsFile::IsCompressed(format)) {
+			texture.mips.push_back(mip.pixels);
+			continue;
+		}
+
+		bool isBC1 = format == DdsFile::Format::kBC1UnormSrgb;
+		uint32_t blockBytes =
+		    isBC1 ? BlockCompression::kBC1BlockBytes : BlockCompression::kBC3BlockBytes;
+		uint32_t blockCountX = std::max(1u, (mip.width + 3) / 4);
+		uint32_t blockCountY = std::max(1u, (mip.height + 3) / 4);
+		std::vector<uint8_t> data(size_t(blockCountX) * blockCountY * blockBytes);
+
+		// 4画素に満たない端は最後の画素を繰り返して埋める
+		uint8_t rgba[BlockCompression::kBlockPixelCount * 4];
+		for (uint32_t by = 0; by < blockCountY; by++) {
+			for (uint32_t bx = 0; bx < blockCountX; bx++) {
+				for (uint32_t py = 0; py < 4; py++) {
+					uint32_t y = std::min(by * 4 + py, mip.height - 1);
+					for (uint32_t px = 0; px < 4; px++) {
+						uint32_t x = std::min(bx * 4 + px, mip.width - 1);
+						std::memcpy(
+						    &rgba[(py * 4 + px) * 4], &mip.pixels[(size_t(y) * mip.width + x) * 4], 4);
+					}
+				}
+				uint8_t* block = &data[(size_t(by) * blockCountX + bx) * blockBytes];
+				if (isBC1) {
+					BlockCompression::EncodeBC1Block(rgba, block);
+				} else {
+					BlockCompression::EncodeBC3Block(rgba, block);
+				}
+			}
+		}
+		texture.mips.push_back(std::move(data));
+	}
+	return texture;
+}
+
+TextureBaker::Report TextureBaker::Bake(
+    const std::filesystem::path& sourcePath, Compression compression, bool force) {
+	Report report;
+	report.sourcePath = sourcePath;
+	report.bakedPath = GetBakedTexturePath(sourcePath);
+
+	if (!force && IsBakedTextureUpToDate(sourcePath, report.bakedPath)) {
+		report.succeeded = true;
+		report.skipped = true;
+		return report;
+	}
+
+	// 実行時と同じ手順（デコード＋ミップ生成）で読み込んで時間を計る
+	Image source;
+	auto start = std::chrono::steady_clock::now();
+	if (!LoadPng(sourcePath, source, &report.error)) {
+		return report;
+	}
+	std::vector<Image> mips = GenerateMipChain(std::move(source));
+	report.sourceLoadMilliseconds = ElapsedMilliseconds(start);
+
+	report.width = mips.front().width;
+	report.height = mips.front().height;
+	report.mipLevels = uint32_t(mips.size());
+	for (const Image& mip : mips) {
+		report.sourceBytes += mip.pixels.size();
+	}
+
+	// 圧縮して書き出す
+	report.format = SelectFormat(mips.front(), compression);
+	if (!DdsFile::Write(report.bakedPath, Compress(mips, report.format))) {
+		report.error = "failed to write " + report.bakedPath.string();
+		return report;
+	}
+
+	// 書いたものを読み戻して時間を計る
+	DdsFile::Texture loaded;
+	start = std::chrono::steady_clock::now();
+	if (!DdsFile::Read(report.bakedPath, loaded)) {
+		report.error = "failed to read back " + report.bakedPath.string();
+		return report;
+	}
+	report.bakedLoadMilliseconds = ElapsedMilliseconds(start);
+	for (const std::vector<uint8_t>& mip : loaded.mips) {
+		report.bakedBytes += mip.size();
+	}
+
+	report.succeeded = true;
+	return report;
+}
+
+std::vector<TextureBaker::Report> TextureBaker::BakeDirectory(
+    const std::filesystem::path& directoryPath, Compression compression, bool force) {
+	std::vector<std::filesystem::path> sourcePaths;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(directoryPath)) {
+		if (!entry.is_regular_file()) {
+			continue;
+		}
+		std::string extension = entry.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) {
+			return char(std::tolower(static_cast<unsigned char>(c)));
+		});
+		if (extension == ".png") {
+			sourcePaths.push_back(entry.path());
+		}
+	}
+	// 走査順はファイルシステム次第なので、レポートが比べやすいよう並べる
+	std::sort(sourcePaths.begin(), sourcePaths.end());
+
+	std::vector<Report> reports;
+	for (const std::filesystem::path& sourcePath : sourcePaths) {
+		reports.push_back(Bake(sourcePath, compression, force));
+	}
+	return reports;
+}
+
+std::string TextureBaker::FormatReport(const std::vector<Report>& reports) {
+	std::string text;
+	AppendFormat(
+	    text, "%-48s %11s %6s %10s %10s %7s %10s %10s\n", "asset", "size", "format", "VRAM src",
+	    "VRAM baked", "saved", "load src", "load baked");
+
+	uint64_t totalSourceBytes = 0;
+	uint64_t totalBakedBytes = 0;
+	double totalSourceMilliseconds = 0.0;
+	double totalBakedMilliseconds = 0.0;
+
+	for (const Report& report : reports) {
+		std::string name = report.sourcePath.generic_string();
+		if (report.skipped) {
+			AppendFormat(text, "%-48s up to date\n", name.c_str());
+			continue;
+		}
+		if (!report.succeeded) {
+			AppendFormat(text, "%-48s failed (%s)\n", name.c_str(), report.error.c_str());
+			continue;
+		}
+
+		double saved = report.sourceBytes
+		                   ? 100.0 * (1.0 - double(report.bakedBytes) / double(report.sourceBytes))
+		                   : 0.0;
+		AppendFormat(
+		    text, "%-48s %5ux%-5u %6s %8lluKB %8lluKB %6.1f%% %8.2fms %8.2fms\n", name.c_str(),
+		    report.width, report.height, GetFormatName(report.format),
+		    static_cast<unsigned long long>(report.sourceBytes / 1024),
+		    static_cast<unsigned long long>(report.bakedBytes / 1024), saved,
+		    report.sourceLoadMilliseconds, report.bakedLoadMilliseconds);
+
+		totalSourceBytes += report.sourceBytes;
+		totalBakedBytes += report.bakedBytes;
+		totalSourceMilliseconds += report.sourceLoadMilliseconds;
+		totalBakedMilliseconds += report.bakedLoadMilliseconds;
+	}
+
+	AppendFormat(
+	    text, "total: VRAM %lluKB -> %lluKB, load %.2fms -> %.2fms\n",
+	    static_cast<unsigned long long>(totalSourceBytes / 1024),
+	    static_cast<unsigned long long>(totalBakedBytes / 1024), totalSourceMilliseconds,
+	    totalBakedMilliseconds);
+	return text;
+}
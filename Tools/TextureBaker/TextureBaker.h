@@ -0,0 +1,138 @@
+#pragma once
+
+#include "DdsFile.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// テクスチャベイカー（PNG → ミップマップ付きBC圧縮DDS）
+/// </summary>
+/// <remarks>
+/// ゲームとは別の実行ファイルで、WindowsでもLinuxでも動く（PNGはlibpng、圧縮はBlockCompression）。
+/// ミップは実行時のGenerateMipMapsと同じく、ガンマ空間のまま2x2画素を平均して作る。
+/// 出力したDDSは、元のPNGより新しい間だけ実行時に使われる（BakedTexturePath.h）。
+/// </remarks>
+class TextureBaker {
+public:
+	/// <summary>
+	/// 圧縮形式
+	/// </summary>
+	enum class Compression {
+		kAuto, //!< αなしはBC1、αありはBC3
+		kBC1,  //!< RGB 4bpp（αは捨てる）
+		kBC3,  //!< RGBA 8bpp
+		kNone, //!< 無圧縮（ミップマップのみ）
+	};
+
+	/// <summary>
+	/// RGBA8の画像（1ミップ分）
+	/// </summary>
+	struct Image {
+		// 幅[px]
+		uint32_t width = 0;
+		// 高さ[px]
+		uint32_t height = 0;
+		// 行ごとに詰めたRGBA8
+		std::vector<uint8_t> pixels;
+	};
+
+	/// <summary>
+	/// 1アセット分の結果
+	/// </summary>
+	struct Report {
+		// 入力ファイル
+		std::filesystem::path sourcePath;
+		// 出力ファイル
+		std::filesystem::path bakedPath;
+		// 成功したか
+		bool succeeded = false;
+		// ベイク済みが新しいので何もしなかった
+		bool skipped = false;
+		// 失敗の理由
+		std::string error;
+		// 幅
+		uint32_t width = 0;
+		// 高さ
+		uint32_t height = 0;
+		// ミップ段数
+		uint32_t mipLevels = 0;
+		// 出力フォーマット
+		DdsFile::Format format = DdsFile::Format::kUnknown;
+		// 無圧縮時のVRAM使用量[byte]
+		uint64_t sourceBytes = 0;
+		// ベイク後のVRAM使用量[byte]
+		uint64_t bakedBytes = 0;
+		// PNGデコード＋ミップ生成時間[ms]
+		double sourceLoadMilliseconds = 0.0;
+		// DDS読み込み時間[ms]
+		double bakedLoadMilliseconds = 0.0;
+	};
+
+	/// <summary>
+	/// PNGの読み込み（パレットやグレースケールもRGBA8にする）
+	/// </summary>
+	/// <param name="filePath">入力パス</param>
+	/// <param name="image">出力画像</param>
+	/// <param name="error">失敗の理由の出力先（nullptr可）</param>
+	/// <returns>成否</returns>
+	static bool LoadPng(const std::filesystem::path& filePath, Image& image, std::string* error);
+
+	/// <summary>
+	/// 1x1までのミップチェーンを作る
+	/// </summary>
+	/// <param name="image">最上位の画像</param>
+	/// <returns>ミップ（0番が最上位）</returns>
+	static std::vector<Image> GenerateMipChain(Image image);
+
+	/// <summary>
+	/// 全画素が不透明か
+	/// </summary>
+	static bool IsAlphaAllOpaque(const Image& image);
+
+	/// <summary>
+	/// 出力フォーマットを決める
+	/// </summary>
+	/// <param name="image">最上位の画像</param>
+	/// <param name="compression">圧縮形式</param>
+	/// <returns>フォーマット（大きさが4の倍数でなければ無圧縮）</returns>
+	static DdsFile::Format SelectFormat(const Image& image, Compression compression);
+
+	/// <summary>
+	/// ミップチェーンを圧縮する
+	/// </summary>
+	/// <param name="mips">ミップ（0番が最上位）</param>
+	/// <param name="format">出力フォーマット</param>
+	/// <returns>DDSに書けるテクスチャ</returns>
+	static DdsFile::Texture Compress(const std::vector<Image>& mips, DdsFile::Format format);
+
+	/// <summary>
+	/// 1ファイルをベイク
+	/// </summary>
+	/// <param name="sourcePath">入力PNGのパス</param>
+	/// <param name="compression">圧縮形式</param>
+	/// <param name="force">ベイク済みが新しくてもやり直す</param>
+	/// <returns>結果</returns>
+	static Report Bake(
+	    const std::filesystem::path& sourcePath, Compression compression = Compression::kAuto,
+	    bool force = false);
+
+	/// <summary>
+	/// ディレクトリ以下のPNGを全てベイク
+	/// </summary>
+	/// <param name="directoryPath">ディレクトリパス</param>
+	/// <param name="compression">圧縮形式</param>
+	/// <param name="force">ベイク済みが新しくてもやり直す</param>
+	/// <returns>全アセットの結果（パス順）</returns>
+	static std::vector<Report> BakeDirectory(
+	    const std::filesystem::path& directoryPath, Compression compression = Compression::kAuto,
+	    bool force = false);
+
+	/// <summary>
+	/// 結果を表形式の文字列にする
+	/// </summary>
+	/// <param name="reports">結果</param>
+	/// <returns>レポート</returns>
+	static std::string FormatReport(const std::vector<Report>& reports);
+};
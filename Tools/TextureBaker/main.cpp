@@ -0,0 +1,55 @@
+#include "TextureBaker.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// 使い方: TextureBaker [ディレクトリ] [--bc1|--bc3|--none] [--force] [--report ファイル]
+// ディレクトリ以下のPNGのうち、ベイク済みDDSより新しいものだけをベイクしてレポートを出す
+int main(int argc, char** argv) {
+	std::filesystem::path directoryPath = "Resources";
+	TextureBaker::Compression compression = TextureBaker::Compression::kAuto;
+	bool force = false;
+	std::filesystem::path reportPath;
+
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--bc1") == 0) {
+			compression = TextureBaker::Compression::kBC1;
+		} else if (std::strcmp(argv[i], "--bc3") == 0) {
+			compression = TextureBaker::Compression::kBC3;
+		} else if (std::strcmp(argv[i], "--none") == 0) {
+			compression = TextureBaker::Compression::kNone;
+		} else if (std::strcmp(argv[i], "--force") == 0) {
+			force = true;
+		} else if (std::strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+			reportPath = argv[++i];
+		} else if (argv[i][0] == '-') {
+			std::fprintf(
+			    stderr,
+			    "usage: %s [directory] [--bc1|--bc3|--none] [--force] [--report file]\n",
+			    argv[0]);
+			return 2;
+		} else {
+			directoryPath = argv[i];
+		}
+	}
+
+	if (!std::filesystem::is_directory(directoryPath)) {
+		std::fprintf(stderr, "not a directory: %s\n", directoryPath.string().c_str());
+		return 2;
+	}
+
+	std::vector<TextureBaker::Report> reports =
+	    TextureBaker::BakeDirectory(directoryPath, compression, force);
+	std::string report = TextureBaker::FormatReport(reports);
+	std::fputs(report.c_str(), stdout);
+	if (!reportPath.empty()) {
+		std::ofstream(reportPath) << report;
+	}
+
+	for (const TextureBaker::Report& assetReport : reports) {
+		if (!assetReport.succeeded) {
+			return 1;
+		}
+	}
+	return 0;
+}